@@ -217,7 +217,9 @@ P_astra["filters"]["Algorithms\\source"] = [
 "src\\Algorithm.cpp",
 "src\\ArtAlgorithm.cpp",
 "src\\BackProjectionAlgorithm.cpp",
+"src\\BatchReconstruction2D.cpp",
 "src\\CglsAlgorithm.cpp",
+"src\\DataOperationAlgorithm.cpp",
 "src\\FilteredBackProjectionAlgorithm.cpp",
 "src\\ForwardProjectionAlgorithm.cpp",
 "src\\PluginAlgorithmFactory.cpp",
@@ -230,6 +232,14 @@ P_astra["filters"]["Data Structures\\source"] = [
 "95346487-8185-487b-a794-3e7fb5fcbd4c",
 "src\\Data2D.cpp",
 "src\\Data3D.cpp",
+"src\\DataBricked.cpp",
+"src\\DataMemory.cpp",
+"src\\DataMemoryPool.cpp",
+"src\\DataMemoryMapped.cpp",
+"src\\DataOperations.cpp",
+"src\\DLPack.cpp",
+"src\\ProjectionIngest.cpp",
+"src\\ProjectionStreamLoader.cpp",
 "src\\SheppLogan.cpp",
 "src\\SparseMatrix.cpp",
 ]
@@ -244,6 +254,8 @@ P_astra["filters"]["Global &amp; Other\\source"] = [
 "src\\Fourier.cpp",
 "src\\Globals.cpp",
 "src\\Logging.cpp",
+"src\\Profiler.cpp",
+"src\\ThreadPool.cpp",
 "src\\Utilities.cpp",
 "src\\XMLConfig.cpp",
 "src\\XMLDocument.cpp",
@@ -256,6 +268,7 @@ P_astra["filters"]["Geometries\\source"] = [
 "src\\CylConeVecProjectionGeometry3D.cpp",
 "src\\FanFlatProjectionGeometry2D.cpp",
 "src\\FanFlatVecProjectionGeometry2D.cpp",
+"src\\GeometryCache.cpp",
 "src\\GeometryUtil2D.cpp",
 "src\\GeometryUtil3D.cpp",
 "src\\ParallelProjectionGeometry2D.cpp",
@@ -274,13 +287,16 @@ P_astra["filters"]["Projectors\\source"] = [
 "2d60e3c8-7874-4cee-b139-991ac15e811d",
 "src\\DataProjector.cpp",
 "src\\DataProjectorPolicies.cpp",
+"src\\FanFlatBeamDistanceDrivenProjector2D.cpp",
 "src\\FanFlatBeamLineKernelProjector2D.cpp",
 "src\\FanFlatBeamStripKernelProjector2D.cpp",
+"src\\MaskIndex.cpp",
 "src\\ParallelBeamBlobKernelProjector2D.cpp",
 "src\\ParallelBeamDistanceDrivenProjector2D.cpp",
 "src\\ParallelBeamLinearKernelProjector2D.cpp",
 "src\\ParallelBeamLineKernelProjector2D.cpp",
 "src\\ParallelBeamStripKernelProjector2D.cpp",
+"src\\ProjectionOperator.cpp",
 "src\\Projector2D.cpp",
 "src\\Projector3D.cpp",
 "src\\SparseMatrixProjector2D.cpp",
@@ -347,9 +363,11 @@ P_astra["filters"]["Algorithms\\headers"] = [
 "include\\astra\\AlgorithmTypelist.h",
 "include\\astra\\ArtAlgorithm.h",
 "include\\astra\\BackProjectionAlgorithm.h",
+"include\\astra\\BatchReconstruction2D.h",
 "include\\astra\\CglsAlgorithm.h",
 "include\\astra\\CudaBackProjectionAlgorithm.h",
 "include\\astra\\CudaBackProjectionAlgorithm3D.h",
+"include\\astra\\DataOperationAlgorithm.h",
 "include\\astra\\FilteredBackProjectionAlgorithm.h",
 "include\\astra\\ForwardProjectionAlgorithm.h",
 "include\\astra\\PluginAlgorithmFactory.h",
@@ -363,6 +381,15 @@ P_astra["filters"]["Data Structures\\headers"] = [
 "include\\astra\\Data.h",
 "include\\astra\\Data2D.h",
 "include\\astra\\Data3D.h",
+"include\\astra\\DataBricked.h",
+"include\\astra\\DataExpression.h",
+"include\\astra\\DataMemoryMapped.h",
+"include\\astra\\DataMemoryPool.h",
+"include\\astra\\DataOperations.h",
+"include\\astra\\DLPack.h",
+"include\\astra\\Float16.h",
+"include\\astra\\ProjectionIngest.h",
+"include\\astra\\ProjectionStreamLoader.h",
 "include\\astra\\SheppLogan.h",
 "include\\astra\\SparseMatrix.h",
 ]
@@ -378,7 +405,9 @@ P_astra["filters"]["Global &amp; Other\\headers"] = [
 "include\\astra\\Fourier.h",
 "include\\astra\\Globals.h",
 "include\\astra\\Logging.h",
+"include\\astra\\Profiler.h",
 "include\\astra\\Singleton.h",
+"include\\astra\\ThreadPool.h",
 "include\\astra\\TypeList.h",
 "include\\astra\\Utilities.h",
 "include\\astra\\Vector3D.h",
@@ -393,6 +422,7 @@ P_astra["filters"]["Geometries\\headers"] = [
 "include\\astra\\CylConeVecProjectionGeometry3D.h",
 "include\\astra\\FanFlatProjectionGeometry2D.h",
 "include\\astra\\FanFlatVecProjectionGeometry2D.h",
+"include\\astra\\GeometryCache.h",
 "include\\astra\\GeometryUtil2D.h",
 "include\\astra\\GeometryUtil3D.h",
 "include\\astra\\ParallelProjectionGeometry2D.h",
@@ -411,13 +441,16 @@ P_astra["filters"]["Projectors\\headers"] = [
 "91ae2cfd-6b45-46eb-ad99-2f16e5ce4b1e",
 "include\\astra\\DataProjector.h",
 "include\\astra\\DataProjectorPolicies.h",
+"include\\astra\\FanFlatBeamDistanceDrivenProjector2D.h",
 "include\\astra\\FanFlatBeamLineKernelProjector2D.h",
 "include\\astra\\FanFlatBeamStripKernelProjector2D.h",
+"include\\astra\\MaskIndex.h",
 "include\\astra\\ParallelBeamBlobKernelProjector2D.h",
 "include\\astra\\ParallelBeamDistanceDrivenProjector2D.h",
 "include\\astra\\ParallelBeamLinearKernelProjector2D.h",
 "include\\astra\\ParallelBeamLineKernelProjector2D.h",
 "include\\astra\\ParallelBeamStripKernelProjector2D.h",
+"include\\astra\\ProjectionOperator.h",
 "include\\astra\\Projector2D.h",
 "include\\astra\\Projector3D.h",
 "include\\astra\\ProjectorTypelist.h",
@@ -448,6 +481,7 @@ P_astra["filters"]["CUDA\\astra headers"] = [
 P_astra["filters"]["Projectors\\inline"] = [
 "0daffd63-ba49-4a5f-8d7a-5322e0e74f22",
 "include\\astra\\DataProjectorPolicies.inl",
+"include\\astra\\FanFlatBeamDistanceDrivenProjector2D.inl",
 "include\\astra\\FanFlatBeamLineKernelProjector2D.inl",
 "include\\astra\\FanFlatBeamStripKernelProjector2D.inl",
 "include\\astra\\ParallelBeamBlobKernelProjector2D.inl",
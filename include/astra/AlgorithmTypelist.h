@@ -37,6 +37,7 @@ along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
 #include "ForwardProjectionAlgorithm.h"
 #include "BackProjectionAlgorithm.h"
 #include "FilteredBackProjectionAlgorithm.h"
+#include "DataOperationAlgorithm.h"
 #include "CudaBackProjectionAlgorithm.h"
 #include "CudaSartAlgorithm.h"
 #include "CudaSirtAlgorithm.h"
@@ -86,7 +87,8 @@ typedef TypeList<
 			CCglsAlgorithm,
 			CBackProjectionAlgorithm,
 			CForwardProjectionAlgorithm,
-			CFilteredBackProjectionAlgorithm
+			CFilteredBackProjectionAlgorithm,
+			CDataOperationAlgorithm
 	> AlgorithmTypeList;
 
 }
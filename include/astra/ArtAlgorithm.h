@@ -141,6 +141,10 @@ public:
 	 */
 	virtual bool run(int _iNrIterations = 0);
 
+	/** Forget the state kept between calls to run().
+	 */
+	virtual void reset();
+
 	/** Get a description of the class.
 	 *
 	 * @return description string
@@ -51,6 +51,7 @@ namespace astra {
  * \astra_xml_item{ReconstructionDataId, integer, Identifier of a volume data object as it is stored in the DataManager.}
  * \astra_xml_item_option{ReconstructionMaskId, integer, not used, Identifier of a volume data object that acts as a reconstruction mask. 1 = reconstruct on this pixel. 0 = don't reconstruct on this pixel.}
  * \astra_xml_item_option{SinogramMaskId, integer, not used, Identifier of a projection data object that acts as a projection mask. 1 = reconstruct using this ray. 0 = don't use this ray while reconstructing.}
+ * \astra_xml_item_option{VolumeWindow, integer array, not used, Sub-window [RowFrom RowTo ColFrom ColTo) of the volume to backproject into. Pixels outside it are set to zero.}
  *
  */
 class _AstraExport CBackProjectionAlgorithm : public CReconstructionAlgorithm2D {
@@ -63,6 +64,9 @@ protected:
 	 */
 	virtual bool _check();
 
+	//< Volume windows are supported
+	virtual bool supportsVolumeWindow() const { return true; }
+
 public:
 	
 	// type of the algorithm, needed to register with CAlgorithmFactory
@@ -0,0 +1,160 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+#ifndef _INC_ASTRA_BATCHRECONSTRUCTION2D
+#define _INC_ASTRA_BATCHRECONSTRUCTION2D
+
+#include "Globals.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace astra {
+
+class XMLConfig;
+class CProjector2D;
+class CReconstructionAlgorithm2D;
+class CFloat32ProjectionData2D;
+class CFloat32VolumeData2D;
+class CFloat32ProjectionData3D;
+class CFloat32VolumeData3D;
+
+/**
+ * Result of the reconstruction of a single slice by CBatchReconstruction2D.
+ */
+struct SBatchSliceStatus {
+	enum EState {
+		SLICE_PENDING,  ///< not processed (yet), for example after an abort
+		SLICE_DONE,
+		SLICE_FAILED
+	};
+	EState eState = SLICE_PENDING;
+	std::string sError;
+};
+
+/**
+ * Reconstruct a stack of independent 2D slices, such as the detector rows
+ * of a 3D parallel beam dataset, with a single 2D algorithm configuration.
+ *
+ * The slices are divided over a number of workers on the CThreadPool.
+ * Every worker links its own pair of 2D data objects to each of its slices
+ * in turn. It creates the algorithm from the shared configuration for its
+ * first slice, and only resets it for the next ones (see
+ * CReconstructionAlgorithm2D::reset), so its setup and buffers are reused.
+ * The projector (and with it the geometries) is shared by all slices.
+ *
+ * The sinogram of slice i is the i-th block of (angles x detectors) floats
+ * of the input, and the reconstruction of slice i is the i-th block of
+ * (rows x columns) floats of the output. This matches the memory layout of
+ * 3D parallel beam projection data and of 3D volume data.
+ */
+class _AstraExport CBatchReconstruction2D {
+public:
+	/** Called from the worker thread after each finished or failed slice.
+	 */
+	typedef void (*ProgressCallback)(void *_pCtx, int _iSlice, bool _bSuccess);
+
+	CBatchReconstruction2D();
+	~CBatchReconstruction2D();
+
+	/** Initialize from the configuration of a 2D reconstruction algorithm.
+	 *  The configuration must specify a ProjectorId; ProjectionDataId and
+	 *  ReconstructionDataId are ignored, since the batch driver passes the
+	 *  data objects of the slices. The configuration must stay alive while
+	 *  the batch is running.
+	 */
+	bool initialize(XMLConfig *_pAlgorithmConfig);
+
+	bool isInitialized() const { return m_bIsInitialized; }
+
+	/** Set the number of concurrent slices. 0 (the default) uses the
+	 *  number of threads of the CThreadPool, which is also the upper limit.
+	 *  If there are fewer slices than that, the default reconstructs them
+	 *  one at a time with multi-threaded projections instead. Projections
+	 *  inside concurrent slices are single-threaded, so an explicit count
+	 *  below the number of pool threads leaves the other threads idle.
+	 */
+	void setThreadCount(int _iThreads) { m_iThreads = _iThreads; }
+
+	void setProgressCallback(ProgressCallback _pCallback, void *_pCtx) {
+		m_pProgress = _pCallback;
+		m_pProgressCtx = _pCtx;
+	}
+
+	/** Stop starting new slices. Can be called from any thread, including
+	 *  from the progress callback. Slices that have not been started stay
+	 *  in the SLICE_PENDING state.
+	 */
+	void abort() { m_bAbort = true; }
+
+	/** Number of floats of a single slice of the input and output.
+	 */
+	size_t getSinogramSize() const;
+	size_t getSliceSize() const;
+
+	/** Reconstruct _iSlices slices from contiguous float32 host buffers.
+	 *  The output also serves as the initial reconstruction for algorithms
+	 *  that use one.
+	 *  @return true if all slices were reconstructed successfully
+	 */
+	bool run(const float32 *_pfSinograms, float32 *_pfVolumes, int _iSlices, int _iIterations);
+
+	/** Reconstruct all slices of a 3D parallel beam projection data object
+	 *  (one slice per detector row) into a 3D volume data object (one slice
+	 *  per z-slice). Both must be float32 host memory.
+	 */
+	bool run(const CFloat32ProjectionData3D *_pSinograms, CFloat32VolumeData3D *_pVolumes, int _iIterations);
+
+	/** Per-slice results of the last call to run().
+	 */
+	const std::vector<SBatchSliceStatus> &getSliceStatus() const { return m_status; }
+
+private:
+	void worker(const float32 *_pfSinograms, float32 *_pfVolumes, int _iSlices, int _iIterations);
+	bool reconstructSlice(std::unique_ptr<CReconstructionAlgorithm2D> &_pAlg,
+	                      CFloat32ProjectionData2D *_pSinogram, CFloat32VolumeData2D *_pVolume,
+	                      int _iIterations, std::string &_sError);
+
+	bool m_bIsInitialized;
+	XMLConfig *m_pConfig;
+	std::string m_sAlgorithmType;
+	CProjector2D *m_pProjector;
+
+	int m_iThreads;
+	ProgressCallback m_pProgress;
+	void *m_pProgressCtx;
+
+	std::atomic<bool> m_bAbort;
+	std::atomic<int> m_iNextSlice;
+	std::vector<SBatchSliceStatus> m_status;
+};
+
+} // end namespace
+
+#endif
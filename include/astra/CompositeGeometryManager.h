@@ -32,10 +32,12 @@ along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
 
 #include "Filters.h"
 
-#ifdef ASTRA_CUDA
-
+#include <atomic>
+#include <deque>
 #include <list>
 #include <map>
+#include <mutex>
+#include <string>
 #include <vector>
 #include <memory>
 
@@ -52,9 +54,16 @@ class CProjectionGeometry3D;
 class CProjector3D;
 
 
+// How CCompositeGeometryManager splits output data into parts
+enum ESplitStrategy {
+	SPLIT_LINEAR,  // parts of equal size
+	SPLIT_COST     // parts of about equal estimated compute and transfer cost
+};
+
 struct SGPUParams {
 	std::vector<int> GPUIndices;
 	size_t memory;
+	ESplitStrategy splitStrategy = SPLIT_LINEAR;
 };
 
 struct SFDKSettings {
@@ -67,6 +76,17 @@ class _AstraExport CCompositeGeometryManager {
 public:
 	CCompositeGeometryManager();
 
+	// Identifies the region of a data object that a part covers
+	struct SPartKey {
+		const CData3D *pData;
+		int eType;
+		unsigned int sub[3];
+		size_t dims[3];
+
+		bool operator==(const SPartKey &other) const;
+		bool operator<(const SPartKey &other) const;
+	};
+
 	class CPart;
 	typedef std::list<std::unique_ptr<CPart> > TPartList;
 	class CPart {
@@ -91,11 +111,13 @@ public:
 
 		bool canSplitAndReduce() const;
 		bool isFull() const;
+
+		SPartKey getKey() const;
 	};
 
 	class CVolumePart : public CPart {
 	public:
-		CVolumePart() { eType = PART_VOL; }
+		CVolumePart() : pGeom(0) { eType = PART_VOL; }
 		CVolumePart(const CVolumePart& other);
 		CVolumePart(CFloat32VolumeData3D *pVolData);
 
@@ -109,7 +131,7 @@ public:
 	};
 	class CProjectionPart : public CPart {
 	public:
-		CProjectionPart() { eType = PART_PROJ; }
+		CProjectionPart() : pGeom(0) { eType = PART_PROJ; }
 		CProjectionPart(const CProjectionPart& other);
 		CProjectionPart(CFloat32ProjectionData3D *pProjData);
 		virtual ~CProjectionPart();
@@ -149,6 +171,8 @@ public:
 	public:
 		SJobInternal(std::unique_ptr<CPart> &&_pInput)
 			: pInput(std::move(_pInput)), pProjector(0), FDKSettings{} { }
+		SJobInternal(std::unique_ptr<CPart> &&_pInput, const SFDKSettings &_FDKSettings)
+			: pInput(std::move(_pInput)), pProjector(0), FDKSettings(_FDKSettings) { }
 		std::unique_ptr<CPart> pInput;
 		CProjector3D *pProjector;
 		SFDKSettings FDKSettings;
@@ -161,6 +185,112 @@ public:
 	// pairs of (output part, list of jobs for that output)
 	typedef std::list<std::pair<std::unique_ptr<CPart>, TJobListInternal>> TJobSetInternal;
 
+	// Location of a part in its full data object. Offsets and dimensions
+	// are in the order of CPart::subX/Y/Z and CPart::getDims.
+	struct SPlanPart {
+		bool bVolume;
+		unsigned int offset[3];
+		size_t dims[3];
+	};
+
+	// A job of a plan: the input part projected into the output part it
+	// belongs to. Jobs of type JOB_NOP have an empty input.
+	struct SPlanJob {
+		EJobType eType;
+		EJobMode eMode;
+		SPlanPart input;
+		size_t iInputBytes;  // uploaded to the GPU
+		double fCost;        // relative compute estimate
+	};
+
+	struct SPlanOutput {
+		SPlanPart part;
+		size_t iUploadBytes;    // output data uploaded before the jobs
+		size_t iDownloadBytes;  // output data downloaded after the jobs
+		std::vector<SPlanJob> jobs;
+	};
+
+	// The split of a job into GPU sized parts, as done by doJobs
+	struct SJobPlan {
+		size_t iMaxSize;        // float32 elements of GPU memory to fit in
+		int iDeviceCount;
+		std::vector<SPlanOutput> outputs;
+		size_t iTransferBytes;  // total host/GPU transfers
+		double fCost;           // total compute estimate
+	};
+
+	// Compute how a single job on full data objects with the given
+	// geometries would be split by doJobs, without allocating data or
+	// running anything. This does not need a GPU.
+	//
+	// iMemory is the GPU memory in bytes, as in SGPUParams::memory
+	// (0 means 1GB). iDeviceCount is the number of GPUs that the parts are
+	// distributed over, and iMaxBlockDim the largest dimension of a 3D
+	// texture on the GPU. eStrategy is as in SGPUParams::splitStrategy.
+	static bool planJob(EJobType eType,
+	                    const CVolumeGeometry3D &volGeom,
+	                    const CProjectionGeometry3D &projGeom,
+	                    size_t iMemory, int iDeviceCount, int iMaxBlockDim,
+	                    SJobPlan &plan,
+	                    ESplitStrategy eStrategy = SPLIT_LINEAR);
+
+	// A device that runs the jobs for the output parts of a split job set.
+	// doJobs uses one for every GPU. A device may keep input parts resident
+	// between entries, which CJobScheduler tries to make use of.
+	class CJobDevice {
+	public:
+		virtual ~CJobDevice() { }
+
+		// Called in the thread running this device, before and after
+		// all its entries
+		virtual bool start() { return true; }
+		virtual void finish() { }
+
+		// Run all jobs for a single output part
+		virtual bool runEntry(const TJobSetInternal::value_type &entry) = 0;
+	};
+
+	// Hands out the entries of a split job set to a number of workers.
+	// Entries with the same input parts are grouped, and the groups are
+	// assigned to workers balancing the amount of data. A worker without
+	// entries left steals from the back of the queue of another worker,
+	// preferring entries with the inputs it used last.
+	class CJobScheduler {
+	public:
+		CJobScheduler(const TJobSetInternal &jobs, int iWorkerCount);
+
+		// Get the next entry for a worker. Returns false if there are no
+		// entries left, or a failure has been flagged.
+		bool receive(int iWorker, const TJobSetInternal::value_type *&entry);
+
+		void flagFailure(const std::string &err);
+		bool hasFailed() const { return m_bFailed; }
+		std::string getError() const;
+
+		size_t getGroupCount() const { return m_groups.size(); }
+		size_t getStealCount() const;
+
+	private:
+		struct SEntry {
+			const TJobSetInternal::value_type *pEntry;
+			size_t iGroup;
+		};
+
+		std::vector<std::vector<SPartKey>> m_groups;
+		std::vector<std::deque<SEntry>> m_queues;
+		std::vector<size_t> m_lastGroup;
+		size_t m_iSteals;
+
+		std::atomic<bool> m_bFailed;
+		std::string m_error;
+		mutable std::mutex m_mutex;
+	};
+
+	// Run a split job set on the given devices, each in its own thread.
+	// With a single device, it runs in the calling thread.
+	static bool runJobs(const TJobSetInternal &jobs, const std::vector<CJobDevice*> &devices);
+
+#ifdef ASTRA_CUDA
 	// Perform a list of jobs. The outputs are assumed to be disjoint.
 	bool doJobs(TJobList &jobs);
 
@@ -187,6 +317,7 @@ public:
 
 	bool doFP(CProjector3D *pProjector, const std::vector<CFloat32VolumeData3D *>& volData, const std::vector<CFloat32ProjectionData3D *>& projData, EJobMode eMode = MODE_SET);
 	bool doBP(CProjector3D *pProjector, const std::vector<CFloat32VolumeData3D *>& volData, const std::vector<CFloat32ProjectionData3D *>& projData, EJobMode eMode = MODE_SET);
+#endif
 
 	void setGPUIndices(const std::vector<int>& GPUIndices);
 
@@ -194,10 +325,15 @@ public:
 
 protected:
 
-	bool splitJobs(TJobSetInternal &jobs, size_t maxSize, int div, TJobSetInternal &split);
+	bool splitJobs(TJobSetInternal &jobs, size_t maxSize, int maxBlockDim, int div, TJobSetInternal &split);
+
+	// Convert GPU memory in bytes to the number of float32 elements that
+	// jobs are split to fit in
+	static size_t getSplitSize(size_t iMemory);
 
 	std::vector<int> m_GPUIndices;
 	size_t m_iMaxSize;
+	ESplitStrategy m_eSplitStrategy;
 
 
 	static SGPUParams* s_params;
@@ -206,5 +342,3 @@ protected:
 }
 
 #endif
-
-#endif
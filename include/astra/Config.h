@@ -33,6 +33,7 @@ along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
 #include "XMLDocument.h"
 
 #include <set>
+#include <vector>
 
 namespace astra {
 
@@ -43,6 +44,35 @@ struct ConfigCheckData {
 	unsigned int parseDepth;
 };
 
+/**
+ * Read-only numerical array from a Config. If the Config stores the array
+ * in binary form, this refers directly to that storage (which must then
+ * outlive this object). Otherwise it holds a parsed copy.
+ */
+class _AstraExport ConfigNumericalArray {
+public:
+	ConfigNumericalArray() : m_pData(nullptr), m_iSize(0) { }
+	ConfigNumericalArray(const ConfigNumericalArray &) = delete;
+	ConfigNumericalArray &operator=(const ConfigNumericalArray &) = delete;
+
+	void clear() { m_storage.clear(); m_pData = nullptr; m_iSize = 0; }
+	void assign(const double *_pData, size_t _iSize) {
+		m_storage.clear(); m_pData = _pData; m_iSize = _iSize;
+	}
+	void assign(std::vector<double> &&_values) {
+		m_storage = std::move(_values); m_pData = m_storage.data(); m_iSize = m_storage.size();
+	}
+
+	const double *data() const { return m_pData; }
+	size_t size() const { return m_iSize; }
+	double operator[](size_t i) const { return m_pData[i]; }
+
+private:
+	std::vector<double> m_storage;
+	const double *m_pData;
+	size_t m_iSize;
+};
+
 /**
  * Configuration options for an ASTRA class.
  */
@@ -65,6 +95,7 @@ protected:
 	virtual bool getInt(const std::string &name, int &iValue) const = 0;
 	virtual bool getFloat(const std::string &name, float &fValue) const = 0;
 	virtual bool getDoubleArray(const std::string &name, std::vector<double> &values) const = 0;
+	virtual bool getDoubleArray(const std::string &name, ConfigNumericalArray &values) const = 0;
 	virtual bool getIntArray(const std::string &name, std::vector<int> &values) const = 0;
 	virtual bool getString(const std::string &name, std::string &sValue) const = 0;
 
@@ -96,6 +127,7 @@ public:
 	bool getRequiredID(const std::string &name, int &iValue);
 
 	bool getRequiredNumericalArray(const std::string &name, std::vector<double> &values);
+	bool getRequiredNumericalArray(const std::string &name, ConfigNumericalArray &values);
 	bool getRequiredIntArray(const std::string &name, std::vector<int> &values);
 	bool getRequiredString(const std::string &name, std::string &sValue);
 
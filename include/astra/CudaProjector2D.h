@@ -97,6 +97,8 @@ public:
 	void projectSingleProjection(int _iProjection, Policy& _policy) {}
 	template <typename Policy>
 	void projectSingleRay(int _iProjection, int _iDetector, Policy& _policy) {}
+	template <typename Policy>
+	void projectSubset(int _iProjFrom, int _iProjTo, const SProjectionSubset& _subset, Policy& _policy) {}
 
 
 	/** Return the  type of this projector.
@@ -101,6 +101,8 @@ public:
 
 	virtual bool run(int _iNrIterations);
 
+	virtual void reset();
+
 	virtual bool getResidualNorm(float32& _fNorm);
 protected:
 
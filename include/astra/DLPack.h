@@ -0,0 +1,94 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+#ifndef _INC_ASTRA_DLPACK
+#define _INC_ASTRA_DLPACK
+
+#include "Globals.h"
+#include "Data.h"
+
+#include "dlpack/dlpack.h"
+
+#include <array>
+#include <functional>
+#include <string>
+
+namespace astra {
+
+/** Check if a DLPack device type refers to memory accessible from the host.
+ */
+_AstraExport bool isDLPackHostDevice(DLDeviceType type);
+
+/** Check the data type and shape of a DLPack tensor against ASTRA
+ *  dimensions (x, y[, z]). The tensor shape is in the reverse order.
+ *  float16/bfloat16 are only accepted if allowHalf is set.
+ */
+template<size_t D>
+_AstraExport bool checkDLTensor(const DLTensor *tensor, std::array<int, D> dims, std::string &error, bool allowHalf = false);
+
+/** Check if a DLPack tensor is C-contiguous. Singleton dimensions are
+ *  ignored.
+ */
+_AstraExport bool isContiguousDLTensor(const DLTensor *tensor);
+
+/** Check if the data of a DLPack tensor is aligned to its element size.
+ */
+_AstraExport bool isAlignedDLTensor(const DLTensor *tensor);
+
+/**
+ * Wrap a host memory DLPack tensor as CDataStorage for a data object of
+ * dimensions dims.
+ *
+ * C-contiguous, aligned tensors are linked without copying. Other
+ * (strided or misaligned) layouts are copied into a contiguous buffer if
+ * allowCopy is set, and copied back into the tensor when the storage is
+ * destroyed. Without allowCopy, they are rejected.
+ *
+ * On success the storage owns the tensor and calls its deleter when it is
+ * destroyed. On failure nullptr is returned, error is set, and the tensor
+ * is left untouched.
+ */
+template<class DLT, size_t D>
+_AstraExport CDataStorage *wrapDLTensorCPU(DLT *tensor_m, std::array<int, D> dims, std::string &error, bool allowCopy = true);
+
+/**
+ * Export the host memory of a float32/float16/bfloat16 data object as a
+ * C-contiguous kDLCPU DLPack tensor, without copying.
+ *
+ * The tensor does not own the data object, so it is only valid as long as
+ * the data object exists. onDelete (if set) is called by the tensor's
+ * deleter, and can be used to manage the lifetime of the data object.
+ *
+ * @return the tensor, or nullptr (with error set) if the data is not
+ * host memory of a supported type
+ */
+template<class DLT, size_t D>
+_AstraExport DLT *exportDLTensor(CData<D> *data, std::function<void()> onDelete, std::string &error);
+
+} // end namespace
+
+#endif
@@ -29,6 +29,7 @@ along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
 #define _INC_ASTRA_DATA
 
 #include "Globals.h"
+#include "Float16.h"
 
 #include <array>
 #include <memory>
@@ -46,26 +47,98 @@ public:
 	virtual bool isMemory() const =0;
 	virtual bool isGPU() const =0;
 	virtual bool isFloat32() const =0;
+
+	// 16-bit storage types. Only supported by a subset of the algorithms,
+	// which convert to float32 during computation.
+	virtual bool isFloat16() const { return false; }
+	virtual bool isBFloat16() const { return false; }
+
+	// Storage that must not be written to, such as a read-only file mapping
+	virtual bool isReadOnly() const { return false; }
 };
 
+/** Alignment (in bytes) of the buffers allocated by CDataMemory.
+ */
+const size_t DATA_MEMORY_ALIGNMENT = 64;
+
+/**
+ * Options for the allocation of CDataMemory buffers.
+ */
+struct SDataMemoryOptions {
+	/** Request (transparent) huge pages for buffers of at least
+	 *  iHugePageThreshold bytes. Only has an effect on Linux.
+	 */
+	bool bHugePages = false;
+	size_t iHugePageThreshold = (size_t)32 << 20;
+
+	/** Initialize buffers of at least iFirstTouchThreshold bytes from
+	 *  multiple threads, each zeroing one contiguous block. On NUMA systems
+	 *  this distributes the pages over the nodes of the threads that will
+	 *  later process the corresponding blocks.
+	 */
+	bool bParallelFirstTouch = true;
+	size_t iFirstTouchThreshold = (size_t)64 << 20;
+
+	/** Number of threads for the first touch, or 0 to use getNumThreads().
+	 */
+	int iFirstTouchThreads = 0;
+};
+
+_AstraExport void setDataMemoryOptions(const SDataMemoryOptions &options);
+_AstraExport SDataMemoryOptions getDataMemoryOptions();
+
+/** Allocate a DATA_MEMORY_ALIGNMENT-aligned host buffer according to the
+ *  current SDataMemoryOptions. Must be freed with freeDataMemory.
+ *
+ * @param bytes Size of the buffer.
+ * @param hugePages Set to true if huge pages were requested for the buffer.
+ */
+_AstraExport void *allocateDataMemory(size_t bytes, bool &hugePages);
+_AstraExport void freeDataMemory(void *ptr);
+
+/** Copy n elements between host memory storages of type float32, float16 or
+ *  bfloat16, converting between the types if necessary.
+ *
+ * @return false if either storage is not host memory of one of these types
+ */
+_AstraExport bool copyConvertMemory(const CDataStorage *src, size_t srcOffset, CDataStorage *dst, size_t dstOffset, size_t n);
+
+/** Set n elements of a float32, float16 or bfloat16 host memory storage to a
+ *  single value.
+ */
+_AstraExport bool fillMemory(CDataStorage *dst, size_t dstOffset, size_t n, float32 value);
+
 template <typename T>
 class _AstraExport CDataMemory : public CDataStorage {
 public:
 
-	CDataMemory(size_t size) : m_bOwnData(true), m_pfData(nullptr) { _allocateData(size); }
+	CDataMemory(size_t size) : m_bOwnData(true), m_bHugePages(false), m_pfData(nullptr) { _allocateData(size); }
 	virtual ~CDataMemory() { _freeData(); }
 
 	T* getData() { return m_pfData; }
 	const T* getData() const { return m_pfData; }
 
+	/** Check if the data is aligned to the given number of bytes. Buffers
+	 *  allocated by CDataMemory always are, but wrapped external memory
+	 *  might not be.
+	 */
+	bool isAligned(size_t alignment = DATA_MEMORY_ALIGNMENT) const { return ((size_t)m_pfData % alignment) == 0; }
+
+	/** Check if huge pages were requested for this buffer.
+	 */
+	bool isHugePageBacked() const { return m_bHugePages; }
+
 	virtual bool isMemory() const { return true; }
 	virtual bool isGPU() const { return false; }
 	virtual bool isFloat32() const { return std::is_same_v<T, float32>; }
+	virtual bool isFloat16() const { return std::is_same_v<T, float16>; }
+	virtual bool isBFloat16() const { return std::is_same_v<T, bfloat16>; }
 
 protected:
 	bool m_bOwnData;
+	bool m_bHugePages;
 	T* m_pfData;
-	CDataMemory() : m_bOwnData(false), m_pfData(nullptr) { }
+	CDataMemory() : m_bOwnData(false), m_bHugePages(false), m_pfData(nullptr) { }
 
 private:
 	void _allocateData(size_t size);
@@ -73,6 +146,19 @@ private:
 };
 
 
+/**
+ * Host memory owned by the caller. The wrapped buffer can be replaced
+ * between uses, so that a single data object can be reused for many
+ * buffers of the same shape.
+ */
+template <typename T>
+class CDataMemoryView : public CDataMemory<T> {
+public:
+	CDataMemoryView(T *data = nullptr) { this->m_pfData = data; }
+
+	void setData(T *data) { this->m_pfData = data; }
+};
+
 // TODO: Consider a common base class
 // Consider functions checking if two object have same dimensions and/or geom
 // Clean up arithmetic operations (in Data2D)
@@ -98,8 +184,31 @@ public:
 	float32 *getFloat32Memory() { return isFloat32Memory() ? dynamic_cast<CDataMemory<float32>*>(m_storage)->getData() : nullptr; }
 	const float32 *getFloat32Memory() const { return isFloat32Memory() ? dynamic_cast<const CDataMemory<float32>*>(m_storage)->getData() : nullptr; }
 
+	bool isFloat16Memory() const { return m_storage->isMemory() && m_storage->isFloat16(); }
+	float16 *getFloat16Memory() { return isFloat16Memory() ? dynamic_cast<CDataMemory<float16>*>(m_storage)->getData() : nullptr; }
+	const float16 *getFloat16Memory() const { return isFloat16Memory() ? dynamic_cast<const CDataMemory<float16>*>(m_storage)->getData() : nullptr; }
+
+	bool isBFloat16Memory() const { return m_storage->isMemory() && m_storage->isBFloat16(); }
+	bfloat16 *getBFloat16Memory() { return isBFloat16Memory() ? dynamic_cast<CDataMemory<bfloat16>*>(m_storage)->getData() : nullptr; }
+	const bfloat16 *getBFloat16Memory() const { return isBFloat16Memory() ? dynamic_cast<const CDataMemory<bfloat16>*>(m_storage)->getData() : nullptr; }
+
+	/** Typed access to host memory, or nullptr if the storage is not a
+	 *  CDataMemory<T>.
+	 */
+	template <typename T>
+	T *getMemory() { CDataMemory<T> *s = dynamic_cast<CDataMemory<T>*>(m_storage); return s ? s->getData() : nullptr; }
+	template <typename T>
+	const T *getMemory() const { const CDataMemory<T> *s = dynamic_cast<const CDataMemory<T>*>(m_storage); return s ? s->getData() : nullptr; }
+
+	/** Check if this is host memory of any of the float types supported by
+	 *  the converting projection policies (float32, float16, bfloat16).
+	 */
+	bool isFloatMemory() const { return isFloat32Memory() || isFloat16Memory() || isBFloat16Memory(); }
+
 	bool isFloat32GPU() const { return m_storage->isGPU() && m_storage->isFloat32(); }
 
+	bool isReadOnly() const { return m_storage->isReadOnly(); }
+
 	// Legacy function. Maybe remove?
 	bool isInitialized() const { return true; }
 
@@ -108,6 +108,11 @@ _AstraExport CFloat32ProjectionData2D *createCFloat32ProjectionData2DMemory(std:
 _AstraExport CFloat32VolumeData2D *createCFloat32VolumeData2DMemory(const CVolumeGeometry2D &geom);
 _AstraExport CFloat32VolumeData2D *createCFloat32VolumeData2DMemory(std::unique_ptr<CVolumeGeometry2D> &&geom);
 
+// Utility functions that create temporary Data2D objects with storage
+// borrowed from the CDataMemoryPool
+_AstraExport CFloat32ProjectionData2D *createCFloat32ProjectionData2DPooled(const CProjectionGeometry2D &geom);
+_AstraExport CFloat32VolumeData2D *createCFloat32VolumeData2DPooled(const CVolumeGeometry2D &geom);
+
 } // end namespace astra
 
 #endif // _INC_ASTRA_FLOAT32DATA2D
@@ -102,6 +102,14 @@ _AstraExport CFloat32ProjectionData3D *createCFloat32ProjectionData3DMemory(std:
 _AstraExport CFloat32VolumeData3D *createCFloat32VolumeData3DMemory(const CVolumeGeometry3D &geom);
 _AstraExport CFloat32VolumeData3D *createCFloat32VolumeData3DMemory(std::unique_ptr<CVolumeGeometry3D> &&geom);
 
+// Utility functions that create temporary Data3D objects with storage
+// borrowed from the CDataMemoryPool
+_AstraExport CFloat32ProjectionData3D *createCFloat32ProjectionData3DPooled(const CProjectionGeometry3D &geom);
+_AstraExport CFloat32VolumeData3D *createCFloat32VolumeData3DPooled(const CVolumeGeometry3D &geom);
+
+// Utility function that creates a volume with bricked (CDataBricked) storage
+_AstraExport CFloat32VolumeData3D *createCFloat32VolumeData3DBricked(const CVolumeGeometry3D &geom, int brickSize = 8);
+
 } // end namespace astra
 
 #endif // _INC_ASTRA_FLOAT32DATA2D
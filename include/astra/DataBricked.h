@@ -0,0 +1,129 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+#ifndef _INC_ASTRA_DATABRICKED
+#define _INC_ASTRA_DATABRICKED
+
+#include "Globals.h"
+#include "Data.h"
+
+#include <array>
+
+namespace astra {
+
+/**
+ * Host memory storage for 3D data with a bricked (tiled) layout.
+ *
+ * The data is divided into cubic bricks of brickSize^3 elements. Each brick
+ * is stored contiguously with x as the fastest-changing coordinate, and the
+ * bricks themselves are also stored in x-fastest order. Bricks at the upper
+ * borders are padded with zeroes if the dimensions are not a multiple of
+ * the brick size.
+ *
+ * Spatially close elements are close in memory in all three directions,
+ * which keeps the cache footprint of slanted traversals (such as cone beam
+ * rays, or z-slabs) small.
+ *
+ * This is not a CDataMemory, so isMemory() returns false. Use the copy
+ * functions to convert to and from the linear layout.
+ */
+template <typename T>
+class _AstraExport CDataBricked : public CDataStorage {
+public:
+	/** Allocate (zero-initialized) bricked storage.
+	 *
+	 * @param x,y,z Dimensions, with x the fastest-changing coordinate in the
+	 *              linear layout.
+	 * @param brickSize Edge length of a brick. Must be a power of two.
+	 */
+	CDataBricked(int x, int y, int z, int brickSize = 8);
+	virtual ~CDataBricked();
+
+	virtual bool isMemory() const { return false; }
+	virtual bool isGPU() const { return false; }
+	virtual bool isFloat32() const { return std::is_same_v<T, float32>; }
+
+	std::array<int, 3> getShape() const { return m_iDims; }
+	int getBrickSize() const { return 1 << m_iBrickShift; }
+	size_t getBrickVolume() const { return m_iBrickVolume; }
+	std::array<int, 3> getBrickCounts() const { return m_iBrickCounts; }
+	size_t getBrickCount() const { return (size_t)m_iBrickCounts[0] * m_iBrickCounts[1] * m_iBrickCounts[2]; }
+
+	/** Offset of the element (x,y,z) in the underlying buffer.
+	 */
+	size_t index(int x, int y, int z) const {
+		const int mask = (1 << m_iBrickShift) - 1;
+		size_t brick = ((size_t)(z >> m_iBrickShift) * m_iBrickCounts[1] + (y >> m_iBrickShift)) * m_iBrickCounts[0] + (x >> m_iBrickShift);
+		size_t inner = ((size_t)((z & mask) << m_iBrickShift) + (y & mask)) << m_iBrickShift;
+		return brick * m_iBrickVolume + inner + (x & mask);
+	}
+
+	T& at(int x, int y, int z) { return m_pfData[index(x, y, z)]; }
+	const T& at(int x, int y, int z) const { return m_pfData[index(x, y, z)]; }
+
+	/** Pointer to the start of brick (bx,by,bz). The brick contains
+	 * elements (bx*B + i, by*B + j, bz*B + k) at offset (k*B + j)*B + i,
+	 * where B is the brick size.
+	 */
+	T* getBrick(int bx, int by, int bz) { return m_pfData + brickOffset(bx, by, bz); }
+	const T* getBrick(int bx, int by, int bz) const { return m_pfData + brickOffset(bx, by, bz); }
+
+	T* getData() { return m_pfData; }
+	const T* getData() const { return m_pfData; }
+
+	/** Fill all elements with a single value. The padding is left as zero.
+	 */
+	void setData(T value);
+
+	/** Convert from or to a linear x-fastest array of x*y*z elements.
+	 */
+	void copyFromLinear(const T *src);
+	void copyToLinear(T *dst) const;
+
+	/** Copy the sub-block starting at (x0,y0,z0) of size (nx,ny,nz) from or to
+	 * a linear x-fastest array of nx*ny*nz elements. Only the bricks
+	 * intersecting the sub-block are touched, so this can be used to extract
+	 * slabs without converting the full volume.
+	 */
+	void copySubFromLinear(int x0, int y0, int z0, int nx, int ny, int nz, const T *src);
+	void copySubToLinear(int x0, int y0, int z0, int nx, int ny, int nz, T *dst) const;
+
+private:
+	size_t brickOffset(int bx, int by, int bz) const {
+		return (((size_t)bz * m_iBrickCounts[1] + by) * m_iBrickCounts[0] + bx) * m_iBrickVolume;
+	}
+
+	std::array<int, 3> m_iDims;
+	std::array<int, 3> m_iBrickCounts;
+	int m_iBrickShift;
+	size_t m_iBrickVolume;
+	T *m_pfData;
+};
+
+}
+
+#endif
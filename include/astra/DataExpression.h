@@ -0,0 +1,263 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+#ifndef _INC_ASTRA_DATAEXPRESSION
+#define _INC_ASTRA_DATAEXPRESSION
+
+#include "Globals.h"
+#include "Data.h"
+#include "VolumeGeometry2D.h"
+#include "ThreadPool.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace astra {
+
+/**
+ * Lazily evaluated element-wise expressions on float32 host data.
+ *
+ * Wrapping a data object with lazy() gives an expression that can be
+ * combined with other expressions and scalars using +, -, *, / and the
+ * functions below (minimum, maximum, clamp, sqr, safeInverse). Nothing is computed until the expression is passed to
+ * assign() or sum(). Each of these evaluates the whole expression in a
+ * single threaded loop, without temporary data objects. For example
+ *
+ *   assign(x, clamp(lazy(x) + lambda * lazy(w) * lazy(bp), lo, hi));
+ *
+ * makes one pass over x, w and bp. The destination of assign() may also
+ * appear in the expression.
+ *
+ * All data objects in an expression must have the same number of elements.
+ * Expressions hold pointers to the data, so they should not outlive it.
+ */
+namespace expr {
+
+// Fixed block size for partial sums of sum()
+static const size_t EXPRESSION_SUM_BLOCK = 1 << 14;
+
+/** Base class of all expressions */
+template<class E>
+struct Expr {
+	const E &self() const { return static_cast<const E&>(*this); }
+};
+
+/** The elements of a data object */
+class Data : public Expr<Data> {
+public:
+	// Number of data objects read per element, for profiling
+	static constexpr int iOperands = 1;
+
+	template<size_t D>
+	explicit Data(const CData<D> &_data) : m_pfData(_data.getFloat32Memory()), m_iSize(_data.getSize()) { ASTRA_ASSERT(m_pfData); }
+
+	float32 operator[](size_t i) const { return m_pfData[i]; }
+	size_t size() const { return m_iSize; }
+
+private:
+	const float32 *m_pfData;
+	size_t m_iSize;
+};
+
+/** A scalar, used for every element */
+class Scalar : public Expr<Scalar> {
+public:
+	static constexpr int iOperands = 0;
+
+	explicit Scalar(float32 _fValue) : m_fValue(_fValue) { }
+
+	float32 operator[](size_t) const { return m_fValue; }
+	size_t size() const { return 0; }
+
+private:
+	float32 m_fValue;
+};
+
+template<class Op, class A>
+class Unary : public Expr<Unary<Op, A>> {
+public:
+	static constexpr int iOperands = A::iOperands;
+
+	Unary(const A &_a, Op _op = Op()) : m_a(_a), m_op(_op) { }
+
+	float32 operator[](size_t i) const { return m_op(m_a[i]); }
+	size_t size() const { return m_a.size(); }
+
+private:
+	A m_a;
+	Op m_op;
+};
+
+template<class Op, class A, class B>
+class Binary : public Expr<Binary<Op, A, B>> {
+public:
+	static constexpr int iOperands = A::iOperands + B::iOperands;
+
+	Binary(const A &_a, const B &_b) : m_a(_a), m_b(_b)
+	{
+		ASTRA_ASSERT(m_a.size() == 0 || m_b.size() == 0 || m_a.size() == m_b.size());
+	}
+
+	float32 operator[](size_t i) const { return Op::apply(m_a[i], m_b[i]); }
+	size_t size() const { return std::max(m_a.size(), m_b.size()); }
+
+private:
+	A m_a;
+	B m_b;
+};
+
+struct OpAdd { static float32 apply(float32 a, float32 b) { return a + b; } };
+struct OpSub { static float32 apply(float32 a, float32 b) { return a - b; } };
+struct OpMul { static float32 apply(float32 a, float32 b) { return a * b; } };
+struct OpDiv { static float32 apply(float32 a, float32 b) { return a / b; } };
+// NaN in the first argument is passed through, as in CData2D::clampMin/Max
+struct OpMin { static float32 apply(float32 a, float32 b) { return (b < a) ? b : a; } };
+struct OpMax { static float32 apply(float32 a, float32 b) { return (a < b) ? b : a; } };
+
+struct OpNeg { float32 operator()(float32 a) const { return -a; } };
+struct OpSqr { float32 operator()(float32 a) const { return a * a; } };
+struct OpSafeInverse {
+	float32 fEpsilon;
+	float32 operator()(float32 a) const { return (a < -fEpsilon || a > fEpsilon) ? 1.0f / a : 0.0f; }
+};
+
+/** Wrap a float32 host memory data object as an expression */
+template<size_t D>
+Data lazy(const CData<D> &_data) { return Data(_data); }
+
+#define ASTRA_EXPR_BINARY(FUNC, OP) \
+template<class A, class B> \
+Binary<OP, A, B> FUNC(const Expr<A> &a, const Expr<B> &b) { return Binary<OP, A, B>(a.self(), b.self()); } \
+template<class A> \
+Binary<OP, A, Scalar> FUNC(const Expr<A> &a, float32 b) { return Binary<OP, A, Scalar>(a.self(), Scalar(b)); } \
+template<class B> \
+Binary<OP, Scalar, B> FUNC(float32 a, const Expr<B> &b) { return Binary<OP, Scalar, B>(Scalar(a), b.self()); }
+
+ASTRA_EXPR_BINARY(operator+, OpAdd)
+ASTRA_EXPR_BINARY(operator-, OpSub)
+ASTRA_EXPR_BINARY(operator*, OpMul)
+ASTRA_EXPR_BINARY(operator/, OpDiv)
+ASTRA_EXPR_BINARY(minimum, OpMin)
+ASTRA_EXPR_BINARY(maximum, OpMax)
+
+#undef ASTRA_EXPR_BINARY
+
+template<class A>
+Unary<OpNeg, A> operator-(const Expr<A> &a) { return Unary<OpNeg, A>(a.self()); }
+
+/** a * a */
+template<class A>
+Unary<OpSqr, A> sqr(const Expr<A> &a) { return Unary<OpSqr, A>(a.self()); }
+
+/** 1 / a where |a| > eps, and 0 elsewhere */
+template<class A>
+Unary<OpSafeInverse, A> safeInverse(const Expr<A> &a, float32 _fEpsilon) { return Unary<OpSafeInverse, A>(a.self(), OpSafeInverse{_fEpsilon}); }
+
+/** min(max(a, lo), hi) */
+template<class A>
+Binary<OpMin, Binary<OpMax, A, Scalar>, Scalar> clamp(const Expr<A> &a, float32 _fMin, float32 _fMax) { return minimum(maximum(a, _fMin), _fMax); }
+
+/** Evaluate an expression into a float32 host memory data object */
+template<size_t D, class E>
+void assign(CData<D> &_dst, const Expr<E> &_e)
+{
+	ASTRA_PROFILE_SCOPE(profile, "data/expression");
+	profile.addBytes(_dst.getSize() * sizeof(float32) * (E::iOperands + 1));
+
+	const E &e = _e.self();
+	float32 *pfDst = _dst.getFloat32Memory();
+	ASTRA_ASSERT(pfDst);
+	ASTRA_ASSERT(e.size() == 0 || e.size() == _dst.getSize());
+	parallelForBlocks(_dst.getSize(), ELEMENTWISE_GRAIN, [&](size_t iFrom, size_t iTo) {
+		for (size_t i = iFrom; i < iTo; ++i)
+			pfDst[i] = e[i];
+	});
+}
+
+/** Evaluate an expression into the pixels of a volume window only. The
+ *  other pixels of _dst are left unchanged.
+ */
+template<class E>
+void assign(CData<2> &_dst, const Expr<E> &_e, const SVolumeWindow &_window)
+{
+	const size_t iWindowCols = _window.iColTo - _window.iColFrom;
+	const size_t iWindowRows = _window.iRowTo - _window.iRowFrom;
+
+	ASTRA_PROFILE_SCOPE(profile, "data/expression");
+	profile.addBytes(iWindowRows * iWindowCols * sizeof(float32) * (E::iOperands + 1));
+
+	const E &e = _e.self();
+	float32 *pfDst = _dst.getFloat32Memory();
+	ASTRA_ASSERT(pfDst);
+	ASTRA_ASSERT(e.size() == 0 || e.size() == _dst.getSize());
+	const size_t iCols = _dst.getShape()[0];
+	parallelForBlocks(iWindowRows, std::max<size_t>(1, ELEMENTWISE_GRAIN / iWindowCols), [&](size_t iFrom, size_t iTo) {
+		for (size_t iRow = _window.iRowFrom + iFrom; iRow < _window.iRowFrom + iTo; ++iRow) {
+			const size_t iEnd = iRow * iCols + _window.iColTo;
+			for (size_t i = iRow * iCols + _window.iColFrom; i < iEnd; ++i)
+				pfDst[i] = e[i];
+		}
+	});
+}
+
+/** Sum of all elements of an expression, in double precision.
+ *
+ * The partial sums are taken over fixed blocks, so the result does not
+ * depend on the number of threads.
+ */
+template<class E>
+double sum(const Expr<E> &_e)
+{
+	const E &e = _e.self();
+	size_t iSize = e.size();
+
+	ASTRA_PROFILE_SCOPE(profile, "data/expression");
+	profile.addBytes(iSize * sizeof(float32) * E::iOperands);
+	size_t iBlocks = (iSize + EXPRESSION_SUM_BLOCK - 1) / EXPRESSION_SUM_BLOCK;
+	std::vector<double> partial(iBlocks, 0.0);
+	parallelForBlocks(iBlocks, ELEMENTWISE_GRAIN / EXPRESSION_SUM_BLOCK, [&](size_t iBlockFrom, size_t iBlockTo) {
+		for (size_t b = iBlockFrom; b < iBlockTo; ++b) {
+			size_t iTo = std::min((b + 1) * EXPRESSION_SUM_BLOCK, iSize);
+			double s = 0.0;
+			for (size_t i = b * EXPRESSION_SUM_BLOCK; i < iTo; ++i)
+				s += e[i];
+			partial[b] = s;
+		}
+	});
+
+	double total = 0.0;
+	for (double p : partial)
+		total += p;
+	return total;
+}
+
+} // end namespace expr
+
+} // end namespace astra
+
+#endif
@@ -0,0 +1,118 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+#ifndef _INC_ASTRA_DATAMEMORYMAPPED
+#define _INC_ASTRA_DATAMEMORYMAPPED
+
+#include "Globals.h"
+#include "Data.h"
+
+#include <string>
+
+namespace astra {
+
+enum EMemoryMapMode {
+	MEMMAP_READONLY,     //< map an existing file read-only
+	MEMMAP_READWRITE,    //< map an existing file, changes are written back
+	MEMMAP_COPYONWRITE,  //< map an existing file, changes stay private
+	MEMMAP_CREATE        //< create or truncate the file, then map it read-write
+};
+
+/**
+ * Data storage backed by a memory-mapped file.
+ *
+ * The file contains the raw data in the same (x-fastest) layout as
+ * CDataMemory, starting at a byte offset. Pages are loaded and evicted by
+ * the operating system on demand, so the data can be much larger than the
+ * available memory. Since this is a CDataMemory, it can be used everywhere
+ * host memory is accepted.
+ *
+ * Writing to a MEMMAP_READONLY mapping is not allowed, and will crash.
+ * Algorithms and other functions writing data objects refuse such storage
+ * (see CDataStorage::isReadOnly).
+ */
+template <typename T>
+class _AstraExport CDataMemoryMapped : public CDataMemory<T> {
+public:
+	/** Map size elements of type T from a file.
+	 *
+	 * Check isMapped() afterwards to see if this succeeded. Errors are
+	 * reported through the log.
+	 *
+	 * @param filename Name of the file
+	 * @param size Number of elements
+	 * @param mode Access mode
+	 * @param offset Offset of the data in the file, in bytes
+	 */
+	CDataMemoryMapped(const std::string &filename, size_t size, EMemoryMapMode mode, size_t offset = 0);
+	virtual ~CDataMemoryMapped();
+
+	bool isMapped() const { return this->m_pfData != nullptr; }
+	virtual bool isReadOnly() const { return m_eMode == MEMMAP_READONLY; }
+	EMemoryMapMode getMode() const { return m_eMode; }
+	const std::string &getFilename() const { return m_sFilename; }
+
+	/** Tell the operating system that elements [first, first+count) will
+	 * be accessed soon, so they can be read ahead.
+	 */
+	void prefetch(size_t first, size_t count);
+
+	/** Tell the operating system that elements [first, first+count) are
+	 * not needed for now. Their pages may be evicted. For MEMMAP_COPYONWRITE
+	 * this discards changes to these elements, but only for pages that lie
+	 * entirely within the range, so changes to other elements are kept.
+	 */
+	void release(size_t first, size_t count);
+
+	/** Write modified pages back to the file. This is done automatically
+	 * when the mapping is destroyed.
+	 */
+	bool flush();
+
+private:
+	bool _map(size_t size, size_t offset);
+	void _unmap();
+	bool _rangeToPages(size_t first, size_t count, char *&start, size_t &length, bool inside = false) const;
+
+	std::string m_sFilename;
+	EMemoryMapMode m_eMode;
+
+	// the actual mapping starts at a page boundary at or before the data
+	char *m_pMapping;
+	size_t m_iMappingSize;
+
+#ifdef _WIN32
+	void *m_hFile;
+	void *m_hMapping;
+#else
+	int m_iFd;
+#endif
+};
+
+}
+
+#endif
@@ -0,0 +1,121 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+#ifndef _INC_ASTRA_DATAMEMORYPOOL
+#define _INC_ASTRA_DATAMEMORYPOOL
+
+#include "Globals.h"
+#include "Data.h"
+#include "Singleton.h"
+
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace astra {
+
+/**
+ * Usage statistics of the CDataMemoryPool.
+ */
+struct SDataMemoryPoolStats {
+	size_t iHits = 0;        ///< acquisitions served from an idle buffer
+	size_t iMisses = 0;      ///< acquisitions requiring a new allocation
+	size_t iEvictions = 0;   ///< idle buffers freed to stay below the limit
+	size_t iBytesHeld = 0;   ///< bytes of idle buffers held by the pool
+	size_t iBytesInUse = 0;  ///< bytes of pool buffers currently lent out
+};
+
+/**
+ * Process-wide pool of host buffers for temporary data, such as the
+ * scratch data objects of the reconstruction algorithms.
+ *
+ * Requested sizes are rounded up to buckets with 8 steps per power of two,
+ * so a buffer can be reused for any request of a similar size, while at
+ * most 12.5% is wasted. Returned buffers are kept idle up to a total size
+ * limit; beyond that the largest idle buffers are freed.
+ */
+class _AstraExport CDataMemoryPool : public Singleton<CDataMemoryPool> {
+public:
+	CDataMemoryPool();
+	~CDataMemoryPool();
+
+	/** Get a buffer of at least the given size.
+	 *
+	 * @param bytes Requested size.
+	 * @param capacity Set to the actual size of the buffer, which must be
+	 *                 passed back to release().
+	 * @return the buffer, or nullptr if allocation failed
+	 */
+	void *acquire(size_t bytes, size_t &capacity);
+
+	/** Return a buffer obtained from acquire() to the pool.
+	 */
+	void release(void *ptr, size_t capacity);
+
+	/** Set the maximum total size of the idle buffers held by the pool.
+	 *  Setting it to 0 effectively disables pooling.
+	 */
+	void setLimit(size_t bytes);
+	size_t getLimit() const;
+
+	/** Free all idle buffers.
+	 */
+	void clear();
+
+	SDataMemoryPoolStats getStats() const;
+	void resetStats();
+
+	/** The bucket size that a request of the given size is rounded up to.
+	 */
+	static size_t getBucketSize(size_t bytes);
+
+private:
+	void _evict(size_t bytes);
+
+	mutable std::mutex m_mutex;
+	std::map<size_t, std::vector<void*> > m_buckets;
+	size_t m_iLimit;
+	SDataMemoryPoolStats m_stats;
+};
+
+/**
+ * CDataMemory storage with a buffer borrowed from the CDataMemoryPool,
+ * which is returned to the pool on destruction.
+ */
+template <typename T>
+class _AstraExport CDataMemoryPooled : public CDataMemory<T> {
+public:
+	CDataMemoryPooled(size_t size);
+	virtual ~CDataMemoryPooled();
+
+private:
+	size_t m_iCapacity;
+};
+
+}
+
+#endif
@@ -0,0 +1,133 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+#ifndef _INC_ASTRA_DATAOPERATIONALGORITHM
+#define _INC_ASTRA_DATAOPERATIONALGORITHM
+
+#include "Globals.h"
+#include "Config.h"
+#include "Algorithm.h"
+#include "Data2D.h"
+#include "Data3D.h"
+
+#include <vector>
+
+namespace astra {
+
+/**
+ * \brief
+ * CPU implementation of simple arithmetic on 2D or 3D data objects.
+ *
+ * This accepts the same configuration as DataOperation_CUDA, and can be used
+ * on nodes without a GPU. All data objects (and the mask) must be either 2D
+ * or 3D float32 host memory objects of the same size. The result is stored
+ * in the first data object ($1).
+ *
+ * Supported operations:
+ * - "$1*s1", "$1/s1", "$1+s1", "$1-s1": data and scalar
+ * - "$1.*$2", "$1+$2", "$1-$2": data and data
+ * - "$1./$2": division, setting $1 to 0 where |$2| <= s1 (default 0)
+ * - "axpby": $1 = s1 * $2 + s2 * $1
+ * - "clamp": $1 = min(max($1, s1), s2)
+ * - "dot", "norm": inner product of $1 and $2, and norm of $1. These leave
+ *   the data unchanged and store the value for getResult().
+ *
+ * \par XML Configuration
+ * \astra_xml_item{Operation, string, The operation to perform.}
+ * \astra_xml_item{DataId, integer array, Identifiers of the data objects $1, $2.}
+ * \astra_xml_item_option{Scalar, float array, empty, Scalars s1, s2.}
+ * \astra_xml_item_option{MaskId, integer, not used, Identifier of a data object that acts as a mask. Only elements where the mask is non-zero are used.}
+ */
+class _AstraExport CDataOperationAlgorithm : public CAlgorithm
+{
+
+public:
+
+	// type of the algorithm, needed to register with CAlgorithmFactory
+	static inline const char* const type = "DataOperation";
+
+	/** Default constructor, containing no code.
+	 */
+	CDataOperationAlgorithm();
+
+	/** Destructor.
+	 */
+	virtual ~CDataOperationAlgorithm();
+
+	/** Initialize the algorithm with a config object.
+	 *
+	 * @param _cfg Configuration Object
+	 * @return initialization successful?
+	 */
+	virtual bool initialize(const Config& _cfg);
+
+	/** Get a description of the class.
+	 *
+	 * @return description string
+	 */
+	virtual std::string description() const;
+
+	/** Perform the operation. The number of iterations is ignored.
+	 */
+	virtual bool run(int _iNrIterations = 0);
+
+	/** Get the value computed by the last run of a "dot" or "norm" operation.
+	 */
+	double getResult() const { return m_fResult; }
+
+protected:
+	/** Check this object.
+	 *
+	 * @return object initialized
+	 */
+	bool _check();
+
+	template<size_t D>
+	bool runOperation(const std::vector<CData<D>*> &_data, const CData<D> *_pMask);
+
+	template<size_t D>
+	bool checkData(const std::vector<CData<D>*> &_data, const CData<D> *_pMask);
+
+	std::vector<CData2D*> m_pData2D;
+	std::vector<CData3D*> m_pData3D;
+	CData2D* m_pMask2D;
+	CData3D* m_pMask3D;
+
+	std::vector<double> m_fScalar;
+
+	std::string m_sOperation;
+
+	double m_fResult;
+
+};
+
+// inline functions
+inline std::string CDataOperationAlgorithm::description() const { return CDataOperationAlgorithm::type; };
+
+} // end namespace
+
+#endif
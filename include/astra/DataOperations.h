@@ -0,0 +1,86 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+#ifndef _INC_ASTRA_DATAOPERATIONS
+#define _INC_ASTRA_DATAOPERATIONS
+
+#include "Globals.h"
+#include "Data.h"
+
+namespace astra {
+
+/**
+ * Element-wise and reduction operations on float32 host data (CData2D and
+ * CData3D objects).
+ *
+ * The operations run on the CThreadPool, with inner loops simple enough for
+ * the compiler to vectorise. If a mask is given, element-wise operations
+ * only change elements where the mask is non-zero, and reductions only
+ * include those elements. All data and masks must have the same size.
+ *
+ * Reductions are accumulated in double precision over fixed blocks, so
+ * their result does not depend on the number of threads.
+ *
+ * The functions return false (and log an error) if the data is not float32
+ * host memory or sizes do not match.
+ */
+
+/** y = a * x + b * y */
+template<size_t D>
+_AstraExport bool axpby(float32 _fA, const CData<D> &_x, float32 _fB, CData<D> &_y, const CData<D> *_pMask = nullptr);
+
+/** y = y .* x */
+template<size_t D>
+_AstraExport bool multiply(const CData<D> &_x, CData<D> &_y, const CData<D> *_pMask = nullptr);
+
+/** y = s * y */
+template<size_t D>
+_AstraExport bool scale(float32 _fScalar, CData<D> &_y, const CData<D> *_pMask = nullptr);
+
+/** y = y + s */
+template<size_t D>
+_AstraExport bool addScalar(float32 _fScalar, CData<D> &_y, const CData<D> *_pMask = nullptr);
+
+/** y = y ./ x where |x| > eps, and 0 elsewhere */
+template<size_t D>
+_AstraExport bool divideSafe(const CData<D> &_x, CData<D> &_y, float32 _fEpsilon = 0.0f, const CData<D> *_pMask = nullptr);
+
+/** y = min(max(y, lo), hi) */
+template<size_t D>
+_AstraExport bool clamp(CData<D> &_y, float32 _fMin, float32 _fMax, const CData<D> *_pMask = nullptr);
+
+/** Inner product of x and y */
+template<size_t D>
+_AstraExport bool dot(const CData<D> &_x, const CData<D> &_y, double &_fResult, const CData<D> *_pMask = nullptr);
+
+/** Euclidean norm of x */
+template<size_t D>
+_AstraExport bool norm(const CData<D> &_x, double &_fResult, const CData<D> *_pMask = nullptr);
+
+} // end namespace
+
+#endif
@@ -36,6 +36,17 @@ along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
 
 #include "DataProjectorPolicies.h"
 
+#include "MaskIndex.h"
+
+#include "ThreadPool.h"
+
+#include "Profiler.h"
+#include "SparseMatrixProjectionGeometry2D.h"
+
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
 namespace astra
 {
 
@@ -52,6 +63,16 @@ public:
 	virtual void projectSingleRay(int _iProjection, int _iDetector) = 0;
 //	virtual void projectSingleVoxel(int _iRow, int _iCol) = 0;
 //	virtual void projectAllVoxels() = 0;
+
+	/** Restrict project() and projectSingleProjection() to the active rays
+	 * and pixels of a mask index, or pass nullptr to project everything.
+	 * The index must have been built from the masks that the policies of
+	 * this data projector apply, and must outlive its use here.
+	 */
+	void setMaskIndex(const CMaskIndex* _pMaskIndex) { m_pMaskIndex = _pMaskIndex; }
+
+protected:
+	const CMaskIndex* m_pMaskIndex = nullptr;
 };
 
 /**
@@ -81,6 +102,11 @@ public:
 //	virtual void projectSingleVoxel(int _iRow, int _iCol);
 
 //	virtual void projectAllVoxels();
+
+private:
+	void projectParallel(int _iBlocks);
+	CProfilePhase &getProfilePhase();
+	size_t countNonZeros(int _iFirstRay, int _iRayCount);
 };
 
 //----------------------------------------------------------------------------------------
@@ -104,6 +130,33 @@ CDataProjector<Projector,Policy>::~CDataProjector()
 	// does nothing
 }
 
+//----------------------------------------------------------------------------------------
+/**
+ * Profiling phase of this projector type, shared by all policies
+*/
+template <typename Projector, typename Policy>
+CProfilePhase &CDataProjector<Projector,Policy>::getProfilePhase()
+{
+	static CProfilePhase &phase = CProfiler::getSingleton().getPhase(std::string("project/") + Projector::type);
+	return phase;
+}
+
+//----------------------------------------------------------------------------------------
+/**
+ * Number of matrix entries applied for a range of rays. Only known without
+ * extra work for projection by an explicit sparse matrix.
+*/
+template <typename Projector, typename Policy>
+size_t CDataProjector<Projector,Policy>::countNonZeros(int _iFirstRay, int _iRayCount)
+{
+	if constexpr (std::is_same<Projector, CSparseMatrixProjector2D>::value) {
+		const CSparseMatrix* pMatrix = dynamic_cast<const CSparseMatrixProjectionGeometry2D&>(m_pProjector->getProjectionGeometry()).getMatrix();
+		return pMatrix->m_plRowStarts[_iFirstRay + _iRayCount] - pMatrix->m_plRowStarts[_iFirstRay];
+	} else {
+		return 0;
+	}
+}
+
 //----------------------------------------------------------------------------------------
 /**
  * Compute projection using the algorithm specific to the projector type
@@ -111,7 +164,75 @@ CDataProjector<Projector,Policy>::~CDataProjector()
 template <typename Projector, typename Policy>
 void CDataProjector<Projector,Policy>::project() 
 { 
-	m_pProjector->project(m_pPolicy);
+	CProfileScope profile(getProfilePhase());
+	const CProjectionGeometry2D &geom = m_pProjector->getProjectionGeometry();
+	if (profile.isActive()) {
+		int iRays = geom.getProjectionAngleCount() * geom.getDetectorCount();
+		if (m_pMaskIndex) {
+			profile.addRays(m_pMaskIndex->getActiveRayCount());
+		} else {
+			profile.addRays(iRays);
+			profile.addNonZeros(countNonZeros(0, iRays));
+		}
+	}
+
+	if constexpr (PolicyTraits<Policy>::bRaySeparable || PolicyTraits<Policy>::bVolumeAdditive) {
+		int iBlocks = std::min(getNumThreads(), geom.getProjectionAngleCount());
+		if (iBlocks > 1 && !CThreadPool::inParallelRegion()) {
+			projectParallel(iBlocks);
+			return;
+		}
+	}
+
+	if (m_pMaskIndex)
+		m_pProjector->projectSubset(0, geom.getProjectionAngleCount(), m_pMaskIndex->getSubset(), m_pPolicy);
+	else
+		m_pProjector->project(m_pPolicy);
+}
+
+//----------------------------------------------------------------------------------------
+/**
+ * Split project() over blocks of angles on the thread pool. Each block uses
+ * its own copy of the policy. For volume additive policies, the first block
+ * adds to the actual output volume and the others to zeroed volumes that
+ * are summed into it afterwards.
+*/
+template <typename Projector, typename Policy>
+void CDataProjector<Projector,Policy>::projectParallel(int _iBlocks)
+{
+	int iAngleCount = m_pProjector->getProjectionGeometry().getProjectionAngleCount();
+	SProjectionSubset subset;
+	if (m_pMaskIndex)
+		subset = m_pMaskIndex->getSubset();
+
+	if constexpr (PolicyTraits<Policy>::bRaySeparable) {
+		parallelFor(0, iAngleCount, 1, [&](int iFrom, int iTo) {
+			Policy policy = m_pPolicy;
+			m_pProjector->projectSubset(iFrom, iTo, subset, policy);
+		});
+	} else {
+		size_t iVolumeSize = m_pProjector->getVolumeGeometry().getGridTotCount();
+		std::vector<std::vector<float32>> partial(_iBlocks - 1);
+		parallelFor(0, _iBlocks, 1, [&](int iBlockFrom, int iBlockTo) {
+			for (int iBlock = iBlockFrom; iBlock < iBlockTo; ++iBlock) {
+				Policy policy = m_pPolicy;
+				if (iBlock > 0) {
+					partial[iBlock - 1].assign(iVolumeSize, 0.0f);
+					policy.setVolumeOutput(partial[iBlock - 1].data());
+				}
+				m_pProjector->projectSubset((int)((size_t)iBlock * iAngleCount / _iBlocks),
+				                            (int)((size_t)(iBlock + 1) * iAngleCount / _iBlocks),
+				                            subset, policy);
+			}
+		});
+
+		float32 *pfOutput = m_pPolicy.getVolumeOutput();
+		parallelForBlocks(iVolumeSize, ELEMENTWISE_GRAIN, [&](size_t iFrom, size_t iTo) {
+			for (const std::vector<float32> &block : partial)
+				for (size_t i = iFrom; i < iTo; ++i)
+					pfOutput[i] += block[i];
+		});
+	}
 }
 
 //----------------------------------------------------------------------------------------
@@ -121,7 +242,21 @@ void CDataProjector<Projector,Policy>::project()
 template <typename Projector, typename Policy>
 void CDataProjector<Projector,Policy>::projectSingleProjection(int _iProjection) 
 { 
-	m_pProjector->projectSingleProjection(_iProjection, m_pPolicy);
+	CProfileScope profile(getProfilePhase());
+	if (profile.isActive()) {
+		int iDetectors = m_pProjector->getProjectionGeometry().getDetectorCount();
+		if (m_pMaskIndex) {
+			profile.addRays(m_pMaskIndex->getActiveRayCount(_iProjection));
+		} else {
+			profile.addRays(iDetectors);
+			profile.addNonZeros(countNonZeros(_iProjection * iDetectors, iDetectors));
+		}
+	}
+
+	if (m_pMaskIndex)
+		m_pProjector->projectSubset(_iProjection, _iProjection + 1, m_pMaskIndex->getSubset(), m_pPolicy);
+	else
+		m_pProjector->projectSingleProjection(_iProjection, m_pPolicy);
 }
 
 //----------------------------------------------------------------------------------------
@@ -131,6 +266,12 @@ void CDataProjector<Projector,Policy>::projectSingleProjection(int _iProjection)
 template <typename Projector, typename Policy>
 void CDataProjector<Projector,Policy>::projectSingleRay(int _iProjection, int _iDetector)
 { 
+	CProfileScope profile(getProfilePhase());
+	if (profile.isActive()) {
+		profile.addRays(1);
+		profile.addNonZeros(countNonZeros(_iProjection * m_pProjector->getProjectionGeometry().getDetectorCount() + _iDetector, 1));
+	}
+
 	m_pProjector->projectSingleRay(_iProjection, _iDetector, m_pPolicy);
 }
 
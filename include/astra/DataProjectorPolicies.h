@@ -84,6 +84,70 @@ public:
 	FORCEINLINE void addWeight(int _iRayIndex, int _iVolumeIndex, float32 weight);
 	FORCEINLINE void rayPosterior(int _iRayIndex);
 	FORCEINLINE void pixelPosterior(int _iVolumeIndex);
+
+	FORCEINLINE float32* getVolumeOutput();
+	FORCEINLINE void setVolumeOutput(float32* _pVolumeData);
+};
+
+
+
+//----------------------------------------------------------------------------------------
+/** Policy for Forward Projection of data stored as float32, float16 or
+ *  bfloat16. (Ray Driven)
+ *  Volume values are converted to float32 on load, and each ray is
+ *  accumulated in float32 before it is stored in the projection data.
+ */
+template<typename TVol, typename TProj>
+class ConvertingFPPolicy {
+
+	//< Projection Data
+	TProj* m_pProjectionData;
+	//< Volume Data
+	const TVol* m_pVolumeData;
+	//< Accumulator of the current ray
+	float32 m_fRaySum;
+
+public:
+	FORCEINLINE ConvertingFPPolicy();
+	FORCEINLINE ConvertingFPPolicy(const TVol* _pVolumeData, TProj* _pProjectionData);
+	FORCEINLINE ~ConvertingFPPolicy();
+
+	FORCEINLINE bool rayPrior(int _iRayIndex);
+	FORCEINLINE bool pixelPrior(int _iVolumeIndex);
+	FORCEINLINE void addWeight(int _iRayIndex, int _iVolumeIndex, float32 weight);
+	FORCEINLINE void rayPosterior(int _iRayIndex);
+	FORCEINLINE void pixelPosterior(int _iVolumeIndex);
+};
+
+
+//----------------------------------------------------------------------------------------
+/** Policy for Back Projection of projection data stored as float32, float16
+ *  or bfloat16 into a float32 volume. (Ray+Pixel Driven)
+ *  Each projection value is converted to float32 once per ray.
+ */
+template<typename TProj>
+class ConvertingBPPolicy {
+
+	//< Projection Data
+	const TProj* m_pProjectionData;
+	//< Volume Data
+	float32* m_pVolumeData;
+	//< Value of the current ray
+	float32 m_fRayValue;
+
+public:
+	FORCEINLINE ConvertingBPPolicy();
+	FORCEINLINE ConvertingBPPolicy(float32* _pVolumeData, const TProj* _pProjectionData);
+	FORCEINLINE ~ConvertingBPPolicy();
+
+	FORCEINLINE bool rayPrior(int _iRayIndex);
+	FORCEINLINE bool pixelPrior(int _iVolumeIndex);
+	FORCEINLINE void addWeight(int _iRayIndex, int _iVolumeIndex, float32 weight);
+	FORCEINLINE void rayPosterior(int _iRayIndex);
+	FORCEINLINE void pixelPosterior(int _iVolumeIndex);
+
+	FORCEINLINE float32* getVolumeOutput();
+	FORCEINLINE void setVolumeOutput(float32* _pVolumeData);
 };
 
 
@@ -153,6 +217,9 @@ public:
 	FORCEINLINE void addWeight(int _iRayIndex, int _iVolumeIndex, float32 weight);
 	FORCEINLINE void rayPosterior(int _iRayIndex);
 	FORCEINLINE void pixelPosterior(int _iVolumeIndex);
+
+	FORCEINLINE float32* getVolumeOutput();
+	FORCEINLINE void setVolumeOutput(float32* _pVolumeData);
 };
 
 //----------------------------------------------------------------------------------------
@@ -173,6 +240,9 @@ public:
 	FORCEINLINE void addWeight(int _iRayIndex, int _iVolumeIndex, float32 weight);
 	FORCEINLINE void rayPosterior(int _iRayIndex);
 	FORCEINLINE void pixelPosterior(int _iVolumeIndex);
+
+	FORCEINLINE float32* getVolumeOutput();
+	FORCEINLINE void setVolumeOutput(float32* _pVolumeData);
 };
 
 //----------------------------------------------------------------------------------------
@@ -216,6 +286,9 @@ public:
 	FORCEINLINE void addWeight(int _iRayIndex, int _iVolumeIndex, float32 weight);
 	FORCEINLINE void rayPosterior(int _iRayIndex);
 	FORCEINLINE void pixelPosterior(int _iVolumeIndex);
+
+	FORCEINLINE float32* getVolumeOutput();
+	FORCEINLINE void setVolumeOutput(float32* _pVolumeData);
 };
 
 //----------------------------------------------------------------------------------------
@@ -239,6 +312,9 @@ public:
 	FORCEINLINE void addWeight(int _iRayIndex, int _iVolumeIndex, float32 weight);
 	FORCEINLINE void rayPosterior(int _iRayIndex);
 	FORCEINLINE void pixelPosterior(int _iVolumeIndex);
+
+	FORCEINLINE float32* getVolumeOutput();
+	FORCEINLINE void setVolumeOutput(float32* _pVolumeData);
 };
 
 //----------------------------------------------------------------------------------------
@@ -263,6 +339,9 @@ public:
 	FORCEINLINE void addWeight(int _iRayIndex, int _iVolumeIndex, float32 weight);
 	FORCEINLINE void rayPosterior(int _iRayIndex);
 	FORCEINLINE void pixelPosterior(int _iVolumeIndex);
+
+	FORCEINLINE float32* getVolumeOutput();
+	FORCEINLINE void setVolumeOutput(float32* _pVolumeData);
 };
 
 //----------------------------------------------------------------------------------------
@@ -330,6 +409,9 @@ public:
 	FORCEINLINE void addWeight(int _iRayIndex, int _iVolumeIndex, float32 weight);
 	FORCEINLINE void rayPosterior(int _iRayIndex);
 	FORCEINLINE void pixelPosterior(int _iVolumeIndex);
+
+	FORCEINLINE float32* getVolumeOutput();
+	FORCEINLINE void setVolumeOutput(float32* _pVolumeData);
 };
 
 
@@ -373,6 +455,78 @@ public:
 	FORCEINLINE void pixelPosterior(int _iVolumeIndex);
 };
 
+//----------------------------------------------------------------------------------------
+/** Policy traits. A policy is ray separable if it only writes to data
+ *  indexed by ray, such as projection data. Such policies can be applied
+ *  to disjoint sets of projection angles concurrently (see
+ *  CDataProjector::project).
+ *
+ *  A policy is volume additive if its only writes that are not ray
+ *  separable add to one volume (getVolumeOutput), independently of the
+ *  values already there, and no part of the policy reads that volume.
+ *  Disjoint sets of angles can then be projected concurrently into
+ *  separate zeroed volumes (setVolumeOutput) that are summed afterwards.
+ *
+ *  A policy is ray interleavable if it keeps no state between rayPrior and
+ *  rayPosterior. The weights of the rays of one angle may then arrive in
+ *  any order, which pixel driven projectors rely on.
+ */
+template<typename Policy>
+struct PolicyTraits {
+	static constexpr bool bRaySeparable = false;
+	static constexpr bool bVolumeAdditive = false;
+	static constexpr bool bRayInterleavable = false;
+};
+
+template<> struct PolicyTraits<DefaultFPPolicy> { static constexpr bool bRaySeparable = true; static constexpr bool bVolumeAdditive = false; static constexpr bool bRayInterleavable = true; };
+template<> struct PolicyTraits<DefaultBPPolicy> { static constexpr bool bRaySeparable = false; static constexpr bool bVolumeAdditive = true; static constexpr bool bRayInterleavable = true; };
+template<typename TVol, typename TProj>
+struct PolicyTraits<ConvertingFPPolicy<TVol, TProj>> { static constexpr bool bRaySeparable = true; static constexpr bool bVolumeAdditive = false; static constexpr bool bRayInterleavable = false; };
+template<typename TProj>
+struct PolicyTraits<ConvertingBPPolicy<TProj>> { static constexpr bool bRaySeparable = false; static constexpr bool bVolumeAdditive = true; static constexpr bool bRayInterleavable = false; };
+template<> struct PolicyTraits<DiffFPPolicy> { static constexpr bool bRaySeparable = true; static constexpr bool bVolumeAdditive = false; static constexpr bool bRayInterleavable = true; };
+template<> struct PolicyTraits<TotalPixelWeightBySinogramPolicy> { static constexpr bool bRaySeparable = false; static constexpr bool bVolumeAdditive = true; static constexpr bool bRayInterleavable = true; };
+template<> struct PolicyTraits<TotalPixelWeightPolicy> { static constexpr bool bRaySeparable = false; static constexpr bool bVolumeAdditive = true; static constexpr bool bRayInterleavable = true; };
+template<> struct PolicyTraits<TotalRayLengthPolicy> { static constexpr bool bRaySeparable = true; static constexpr bool bVolumeAdditive = false; static constexpr bool bRayInterleavable = true; };
+template<> struct PolicyTraits<EmptyPolicy> { static constexpr bool bRaySeparable = true; static constexpr bool bVolumeAdditive = false; static constexpr bool bRayInterleavable = true; };
+template<> struct PolicyTraits<SIRTBPPolicy> { static constexpr bool bRaySeparable = false; static constexpr bool bVolumeAdditive = true; static constexpr bool bRayInterleavable = true; };
+template<> struct PolicyTraits<SinogramMaskPolicy> { static constexpr bool bRaySeparable = true; static constexpr bool bVolumeAdditive = false; static constexpr bool bRayInterleavable = true; };
+template<> struct PolicyTraits<ReconstructionMaskPolicy> { static constexpr bool bRaySeparable = true; static constexpr bool bVolumeAdditive = false; static constexpr bool bRayInterleavable = true; };
+
+// A combination is volume additive if exactly one part is, and all other
+// parts are ray separable
+template<typename... Ps>
+constexpr bool combinedVolumeAdditive()
+{
+	return ((PolicyTraits<Ps>::bVolumeAdditive ? 1 : 0) + ...) == 1 &&
+	       ((PolicyTraits<Ps>::bVolumeAdditive || PolicyTraits<Ps>::bRaySeparable) && ...);
+}
+
+template<typename P1, typename P2>
+struct PolicyTraits<CombinePolicy<P1, P2>> {
+	static constexpr bool bRaySeparable = PolicyTraits<P1>::bRaySeparable && PolicyTraits<P2>::bRaySeparable;
+	static constexpr bool bVolumeAdditive = combinedVolumeAdditive<P1, P2>();
+	static constexpr bool bRayInterleavable = PolicyTraits<P1>::bRayInterleavable && PolicyTraits<P2>::bRayInterleavable;
+};
+template<typename P1, typename P2, typename P3>
+struct PolicyTraits<Combine3Policy<P1, P2, P3>> {
+	static constexpr bool bRaySeparable = PolicyTraits<P1>::bRaySeparable && PolicyTraits<P2>::bRaySeparable && PolicyTraits<P3>::bRaySeparable;
+	static constexpr bool bVolumeAdditive = combinedVolumeAdditive<P1, P2, P3>();
+	static constexpr bool bRayInterleavable = PolicyTraits<P1>::bRayInterleavable && PolicyTraits<P2>::bRayInterleavable && PolicyTraits<P3>::bRayInterleavable;
+};
+template<typename P1, typename P2, typename P3, typename P4>
+struct PolicyTraits<Combine4Policy<P1, P2, P3, P4>> {
+	static constexpr bool bRaySeparable = PolicyTraits<P1>::bRaySeparable && PolicyTraits<P2>::bRaySeparable && PolicyTraits<P3>::bRaySeparable && PolicyTraits<P4>::bRaySeparable;
+	static constexpr bool bVolumeAdditive = combinedVolumeAdditive<P1, P2, P3, P4>();
+	static constexpr bool bRayInterleavable = PolicyTraits<P1>::bRayInterleavable && PolicyTraits<P2>::bRayInterleavable && PolicyTraits<P3>::bRayInterleavable && PolicyTraits<P4>::bRayInterleavable;
+};
+template<typename P>
+struct PolicyTraits<CombineListPolicy<P>> {
+	static constexpr bool bRaySeparable = PolicyTraits<P>::bRaySeparable;
+	static constexpr bool bVolumeAdditive = false;
+	static constexpr bool bRayInterleavable = PolicyTraits<P>::bRayInterleavable;
+};
+
 //----------------------------------------------------------------------------------------
 
 #include "DataProjectorPolicies.inl"
@@ -126,6 +126,146 @@ void DefaultBPPolicy::pixelPosterior(int _iVolumeIndex)
 	// nothing
 }
 //----------------------------------------------------------------------------------------
+float32* DefaultBPPolicy::getVolumeOutput()
+{
+	return m_pVolumeData;
+}
+//----------------------------------------------------------------------------------------
+void DefaultBPPolicy::setVolumeOutput(float32* _pVolumeData)
+{
+	m_pVolumeData = _pVolumeData;
+}
+//----------------------------------------------------------------------------------------
+
+
+
+
+//----------------------------------------------------------------------------------------
+// CONVERTING FORWARD PROJECTION (Ray Driven)
+//----------------------------------------------------------------------------------------
+template<typename TVol, typename TProj>
+ConvertingFPPolicy<TVol,TProj>::ConvertingFPPolicy() 
+{
+
+}
+//----------------------------------------------------------------------------------------
+template<typename TVol, typename TProj>
+ConvertingFPPolicy<TVol,TProj>::ConvertingFPPolicy(const TVol* _pVolumeData,
+                                                   TProj* _pProjectionData)
+{
+	m_pProjectionData = _pProjectionData;
+	m_pVolumeData = _pVolumeData;
+	m_fRaySum = 0.0f;
+}
+//----------------------------------------------------------------------------------------
+template<typename TVol, typename TProj>
+ConvertingFPPolicy<TVol,TProj>::~ConvertingFPPolicy() 
+{
+
+}
+//----------------------------------------------------------------------------------------	
+template<typename TVol, typename TProj>
+bool ConvertingFPPolicy<TVol,TProj>::rayPrior(int _iRayIndex) 
+{
+	m_fRaySum = 0.0f;
+	return true;
+}
+//----------------------------------------------------------------------------------------
+template<typename TVol, typename TProj>
+bool ConvertingFPPolicy<TVol,TProj>::pixelPrior(int _iVolumeIndex) 
+{
+	// do nothing
+	return true;
+}
+//----------------------------------------------------------------------------------------	
+template<typename TVol, typename TProj>
+void ConvertingFPPolicy<TVol,TProj>::addWeight(int _iRayIndex, int _iVolumeIndex, float32 _fWeight) 
+{
+	m_fRaySum += (float32)m_pVolumeData[_iVolumeIndex] * _fWeight;
+}
+//----------------------------------------------------------------------------------------
+template<typename TVol, typename TProj>
+void ConvertingFPPolicy<TVol,TProj>::rayPosterior(int _iRayIndex) 
+{
+	m_pProjectionData[_iRayIndex] = TProj(m_fRaySum);
+}
+//----------------------------------------------------------------------------------------
+template<typename TVol, typename TProj>
+void ConvertingFPPolicy<TVol,TProj>::pixelPosterior(int _iVolumeIndex) 
+{
+	// nothing
+}
+//----------------------------------------------------------------------------------------
+
+
+//----------------------------------------------------------------------------------------
+// CONVERTING BACK PROJECTION (Ray+Pixel Driven)
+//----------------------------------------------------------------------------------------
+template<typename TProj>
+ConvertingBPPolicy<TProj>::ConvertingBPPolicy() 
+{
+
+}
+//----------------------------------------------------------------------------------------
+template<typename TProj>
+ConvertingBPPolicy<TProj>::ConvertingBPPolicy(float32* _pVolumeData,
+                                              const TProj* _pProjectionData)
+{
+	m_pProjectionData = _pProjectionData;
+	m_pVolumeData = _pVolumeData;
+	m_fRayValue = 0.0f;
+}
+//----------------------------------------------------------------------------------------
+template<typename TProj>
+ConvertingBPPolicy<TProj>::~ConvertingBPPolicy() 
+{
+
+}
+//----------------------------------------------------------------------------------------	
+template<typename TProj>
+bool ConvertingBPPolicy<TProj>::rayPrior(int _iRayIndex) 
+{
+	m_fRayValue = (float32)m_pProjectionData[_iRayIndex];
+	return true;
+}
+//----------------------------------------------------------------------------------------
+template<typename TProj>
+bool ConvertingBPPolicy<TProj>::pixelPrior(int _iVolumeIndex) 
+{
+	// do nothing
+	return true;
+}
+//----------------------------------------------------------------------------------------	
+template<typename TProj>
+void ConvertingBPPolicy<TProj>::addWeight(int _iRayIndex, int _iVolumeIndex, float32 _fWeight) 
+{
+	m_pVolumeData[_iVolumeIndex] += m_fRayValue * _fWeight;
+}
+//----------------------------------------------------------------------------------------
+template<typename TProj>
+void ConvertingBPPolicy<TProj>::rayPosterior(int _iRayIndex) 
+{
+	// nothing
+}
+//----------------------------------------------------------------------------------------
+template<typename TProj>
+void ConvertingBPPolicy<TProj>::pixelPosterior(int _iVolumeIndex) 
+{
+	// nothing
+}
+//----------------------------------------------------------------------------------------
+template<typename TProj>
+float32* ConvertingBPPolicy<TProj>::getVolumeOutput()
+{
+	return m_pVolumeData;
+}
+//----------------------------------------------------------------------------------------
+template<typename TProj>
+void ConvertingBPPolicy<TProj>::setVolumeOutput(float32* _pVolumeData)
+{
+	m_pVolumeData = _pVolumeData;
+}
+//----------------------------------------------------------------------------------------
 
 
 
@@ -281,6 +421,16 @@ void TotalPixelWeightBySinogramPolicy::pixelPosterior(int _iVolumeIndex)
 	// nothing
 }
 //----------------------------------------------------------------------------------------
+float32* TotalPixelWeightBySinogramPolicy::getVolumeOutput()
+{
+	return m_pPixelWeight;
+}
+//----------------------------------------------------------------------------------------
+void TotalPixelWeightBySinogramPolicy::setVolumeOutput(float32* _pVolumeData)
+{
+	m_pPixelWeight = _pVolumeData;
+}
+//----------------------------------------------------------------------------------------
 
 
 
@@ -329,6 +479,16 @@ void TotalPixelWeightPolicy::pixelPosterior(int _iVolumeIndex)
 	// nothing
 }
 //----------------------------------------------------------------------------------------
+float32* TotalPixelWeightPolicy::getVolumeOutput()
+{
+	return m_pPixelWeight;
+}
+//----------------------------------------------------------------------------------------
+void TotalPixelWeightPolicy::setVolumeOutput(float32* _pVolumeData)
+{
+	m_pPixelWeight = _pVolumeData;
+}
+//----------------------------------------------------------------------------------------
 
 
 
@@ -438,6 +598,24 @@ void CombinePolicy<P1,P2>::pixelPosterior(int _iVolumeIndex)
 	policy2.pixelPosterior(_iVolumeIndex);
 }
 //----------------------------------------------------------------------------------------
+template<typename P1, typename P2>
+float32* CombinePolicy<P1,P2>::getVolumeOutput()
+{
+	if constexpr (PolicyTraits<P1>::bVolumeAdditive)
+		return policy1.getVolumeOutput();
+	else
+		return policy2.getVolumeOutput();
+}
+//----------------------------------------------------------------------------------------
+template<typename P1, typename P2>
+void CombinePolicy<P1,P2>::setVolumeOutput(float32* _pVolumeData)
+{
+	if constexpr (PolicyTraits<P1>::bVolumeAdditive)
+		policy1.setVolumeOutput(_pVolumeData);
+	else
+		policy2.setVolumeOutput(_pVolumeData);
+}
+//----------------------------------------------------------------------------------------
 
 
 
@@ -505,6 +683,28 @@ void Combine3Policy<P1,P2,P3>::pixelPosterior(int _iVolumeIndex)
 	policy3.pixelPosterior(_iVolumeIndex);
 }
 //----------------------------------------------------------------------------------------
+template<typename P1, typename P2, typename P3>
+float32* Combine3Policy<P1,P2,P3>::getVolumeOutput()
+{
+	if constexpr (PolicyTraits<P1>::bVolumeAdditive)
+		return policy1.getVolumeOutput();
+	else if constexpr (PolicyTraits<P2>::bVolumeAdditive)
+		return policy2.getVolumeOutput();
+	else
+		return policy3.getVolumeOutput();
+}
+//----------------------------------------------------------------------------------------
+template<typename P1, typename P2, typename P3>
+void Combine3Policy<P1,P2,P3>::setVolumeOutput(float32* _pVolumeData)
+{
+	if constexpr (PolicyTraits<P1>::bVolumeAdditive)
+		policy1.setVolumeOutput(_pVolumeData);
+	else if constexpr (PolicyTraits<P2>::bVolumeAdditive)
+		policy2.setVolumeOutput(_pVolumeData);
+	else
+		policy3.setVolumeOutput(_pVolumeData);
+}
+//----------------------------------------------------------------------------------------
 
 
 
@@ -580,6 +780,32 @@ void Combine4Policy<P1,P2,P3,P4>::pixelPosterior(int _iVolumeIndex)
 	policy4.pixelPosterior(_iVolumeIndex);
 }
 //----------------------------------------------------------------------------------------
+template<typename P1, typename P2, typename P3, typename P4>
+float32* Combine4Policy<P1,P2,P3,P4>::getVolumeOutput()
+{
+	if constexpr (PolicyTraits<P1>::bVolumeAdditive)
+		return policy1.getVolumeOutput();
+	else if constexpr (PolicyTraits<P2>::bVolumeAdditive)
+		return policy2.getVolumeOutput();
+	else if constexpr (PolicyTraits<P3>::bVolumeAdditive)
+		return policy3.getVolumeOutput();
+	else
+		return policy4.getVolumeOutput();
+}
+//----------------------------------------------------------------------------------------
+template<typename P1, typename P2, typename P3, typename P4>
+void Combine4Policy<P1,P2,P3,P4>::setVolumeOutput(float32* _pVolumeData)
+{
+	if constexpr (PolicyTraits<P1>::bVolumeAdditive)
+		policy1.setVolumeOutput(_pVolumeData);
+	else if constexpr (PolicyTraits<P2>::bVolumeAdditive)
+		policy2.setVolumeOutput(_pVolumeData);
+	else if constexpr (PolicyTraits<P3>::bVolumeAdditive)
+		policy3.setVolumeOutput(_pVolumeData);
+	else
+		policy4.setVolumeOutput(_pVolumeData);
+}
+//----------------------------------------------------------------------------------------
 
 
 
@@ -754,6 +980,16 @@ void SIRTBPPolicy::pixelPosterior(int _iVolumeIndex)
 	// nothing
 }
 //----------------------------------------------------------------------------------------
+float32* SIRTBPPolicy::getVolumeOutput()
+{
+	return m_pReconstruction;
+}
+//----------------------------------------------------------------------------------------
+void SIRTBPPolicy::setVolumeOutput(float32* _pVolumeData)
+{
+	m_pReconstruction = _pVolumeData;
+}
+//----------------------------------------------------------------------------------------
 
 
 
@@ -0,0 +1,199 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+
+#define policy_weight(p,rayindex,volindex,weight) do { if (p.pixelPrior(volindex)) { p.addWeight(rayindex, volindex, weight); p.pixelPosterior(volindex); } } while (false)
+
+template <typename Policy>
+void CFanFlatBeamDistanceDrivenProjector2D::project(Policy& p)
+{
+	projectBlock_internal(0, m_pProjectionGeometry->getProjectionAngleCount(),
+	                      0, m_pProjectionGeometry->getDetectorCount(), SProjectionSubset(), p);
+}
+
+template <typename Policy>
+void CFanFlatBeamDistanceDrivenProjector2D::projectSingleProjection(int _iProjection, Policy& p)
+{
+	projectBlock_internal(_iProjection, _iProjection + 1,
+	                      0, m_pProjectionGeometry->getDetectorCount(), SProjectionSubset(), p);
+}
+
+template <typename Policy>
+void CFanFlatBeamDistanceDrivenProjector2D::projectSingleRay(int _iProjection, int _iDetector, Policy& p)
+{
+	projectBlock_internal(_iProjection, _iProjection + 1,
+	                      _iDetector, _iDetector + 1, SProjectionSubset(), p);
+}
+
+template <typename Policy>
+void CFanFlatBeamDistanceDrivenProjector2D::projectSubset(int _iProjFrom, int _iProjTo, const SProjectionSubset& _subset, Policy& p)
+{
+	projectBlock_internal(_iProjFrom, _iProjTo,
+	                      0, m_pProjectionGeometry->getDetectorCount(), _subset, p);
+}
+
+//----------------------------------------------------------------------------------------
+// PROJECT BLOCK - vector projection geometry
+//
+// Neighbouring rays share a detector edge, so per line the edge positions are
+// computed once and the footprints of consecutive rays are merged with the
+// pixels of the line in a single pass. Policies that need the weights of a
+// ray consecutively get the same pass one ray at a time.
+template <typename Policy>
+void CFanFlatBeamDistanceDrivenProjector2D::projectBlock_internal(int _iProjFrom, int _iProjTo, int _iDetFrom, int _iDetTo, const SProjectionSubset& _subset, Policy& p)
+{
+	// get vector geometry
+	const CFanFlatVecProjectionGeometry2D* pVecProjectionGeometry;
+	if (dynamic_cast<CFanFlatProjectionGeometry2D*>(m_pProjectionGeometry.get())) {
+		pVecProjectionGeometry = dynamic_cast<CFanFlatProjectionGeometry2D*>(m_pProjectionGeometry.get())->toVectorGeometry();
+	} else {
+		pVecProjectionGeometry = dynamic_cast<CFanFlatVecProjectionGeometry2D*>(m_pProjectionGeometry.get());
+	}
+
+	// precomputations
+	const int colCount = m_pVolumeGeometry->getGridColCount();
+	const int rowCount = m_pVolumeGeometry->getGridRowCount();
+	const int detCount = pVecProjectionGeometry->getDetectorCount();
+
+	// window of the volume to traverse
+	const int rowFrom = _subset.iRowFrom;
+	const int rowTo = std::min(rowCount, _subset.iRowTo);
+	const int colFrom = _subset.iColFrom;
+	const int colTo = std::min(colCount, _subset.iColTo);
+
+	std::vector<float32> edgePos(detCount + 1), edgeDelta(detCount + 1), lengthPerLine(detCount);
+	std::vector<char> rayActive(detCount, 0);
+
+	// loop angles
+	for (int iAngle = _iProjFrom; iAngle < _iProjTo; ++iAngle) {
+
+		const bool vertical = computeProjectionTables(pVecProjectionGeometry->getProjectionVectors()[iAngle], _iDetFrom, _iDetTo,
+		                                              &edgePos[0], &edgeDelta[0], &lengthPerLine[0]);
+
+		// a line is a row of the volume if vertical, a column otherwise
+		const int lineFrom = vertical ? rowFrom : colFrom;
+		const int lineTo = vertical ? rowTo : colTo;
+		const int lineStride = vertical ? colCount : 1;
+		const int pixelStride = vertical ? 1 : colCount;
+
+		// project the active rays among detectors [detFrom, detTo)
+		auto projectLines = [&](int detFrom, int detTo) {
+			for (int line = lineFrom; line < lineTo; ++line) {
+
+				// active pixels of this line
+				int first, last;
+				if (vertical) {
+					first = colFrom; last = colTo - 1;
+					_subset.clipRow(line, first, last);
+				} else {
+					first = rowFrom; last = rowTo - 1;
+					_subset.clipCol(line, first, last);
+				}
+				if (first > last) continue;
+
+				float32 edge = edgePos[detFrom] + line * edgeDelta[detFrom];
+				for (int iDetector = detFrom; iDetector < detTo; ++iDetector) {
+					const float32 nextEdge = edgePos[iDetector+1] + line * edgeDelta[iDetector+1];
+
+					// extent of the ray in the centre of this line: [lo, hi]
+					float32 lo = std::min(edge, nextEdge);
+					float32 hi = std::max(edge, nextEdge);
+					edge = nextEdge;
+
+					if (!rayActive[iDetector] || hi <= first || lo >= last + 1)
+						continue;
+					const float32 width = hi - lo;
+					if (!(width > 0.0f) || !std::isfinite(width))
+						continue;
+
+					const int iRayIndex = iAngle * detCount + iDetector;
+					const float32 weight = lengthPerLine[iDetector] / width;
+
+					// |-gapBegin-*---|------|----*-gapEnd-|
+					// * = lo and hi, clipped to the active pixels
+					// | = pixel edges
+					lo = std::max(lo, (float32)first);
+					hi = std::min(hi, (float32)(last + 1));
+					const int begin = (int)floor(lo);
+					const int end = (int)ceil(hi);
+
+					int iVolumeIndex = line * lineStride + begin * pixelStride;
+					if (begin + 1 >= end) {
+						policy_weight(p, iRayIndex, iVolumeIndex, (hi - lo) * weight);
+					} else {
+						policy_weight(p, iRayIndex, iVolumeIndex, ((float32)(begin + 1) - lo) * weight);
+						for (int i = begin + 1; i < end - 1; ++i) {
+							iVolumeIndex += pixelStride;
+							policy_weight(p, iRayIndex, iVolumeIndex, weight);
+						}
+						iVolumeIndex += pixelStride;
+						policy_weight(p, iRayIndex, iVolumeIndex, (hi - (float32)(end - 1)) * weight);
+					}
+				}
+			}
+		};
+
+		if constexpr (PolicyTraits<Policy>::bRayInterleavable) {
+			// POLICY: RAY PRIOR
+			int detFirst = _iDetTo, detLast = _iDetFrom - 1;
+			for (int iDetector = _subset.firstRay(iAngle, _iDetFrom); iDetector < _iDetTo; iDetector = _subset.firstRay(iAngle, iDetector + 1)) {
+				if (!p.rayPrior(iAngle * detCount + iDetector)) continue;
+				rayActive[iDetector] = 1;
+				detFirst = std::min(detFirst, iDetector);
+				detLast = iDetector;
+			}
+			if (detFirst > detLast) continue;
+
+			projectLines(detFirst, detLast + 1);
+
+			// POLICY: RAY POSTERIOR
+			for (int iDetector = detFirst; iDetector <= detLast; ++iDetector) {
+				if (!rayActive[iDetector]) continue;
+				rayActive[iDetector] = 0;
+				p.rayPosterior(iAngle * detCount + iDetector);
+			}
+		} else {
+			for (int iDetector = _subset.firstRay(iAngle, _iDetFrom); iDetector < _iDetTo; iDetector = _subset.firstRay(iAngle, iDetector + 1)) {
+				const int iRayIndex = iAngle * detCount + iDetector;
+
+				// POLICY: RAY PRIOR
+				if (!p.rayPrior(iRayIndex)) continue;
+
+				rayActive[iDetector] = 1;
+				projectLines(iDetector, iDetector + 1);
+				rayActive[iDetector] = 0;
+
+				// POLICY: RAY POSTERIOR
+				p.rayPosterior(iRayIndex);
+			}
+		}
+	} // end loop angles
+
+	// Delete created vec geometry if required
+	if (dynamic_cast<CFanFlatProjectionGeometry2D*>(m_pProjectionGeometry.get()))
+		delete pVecProjectionGeometry;
+}
@@ -152,6 +152,17 @@ public:
 	template <typename Policy>
 	void projectSingleRay(int _iProjection, int _iDetector, Policy& _policy);
 
+	/** Policy-based projection of a range of projections, restricted to the
+	 * rays and pixels of a (mask) subset.
+	 *
+	 * @param _iProjFrom First projection (inclusive)
+	 * @param _iProjTo Last projection (exclusive)
+	 * @param _subset Rays and pixels to visit
+	 * @param _policy Policy object.  Should contain prior, addWeight and posterior function.
+	 */
+	template <typename Policy>
+	void projectSubset(int _iProjFrom, int _iProjTo, const SProjectionSubset& _subset, Policy& _policy);
+
 	/** Return the type of this projector.
 	 *
 	 * @return identification type of this projector
@@ -165,7 +176,8 @@ protected:
  	 * (_i*From is inclusive, _i*To exclusive) */
 	template <typename Policy>
 	void projectBlock_internal(int _iProjFrom, int _iProjTo,
-	                           int _iDetFrom, int _iDetTo, Policy& _policy);
+	                           int _iDetFrom, int _iDetTo,
+	                           const SProjectionSubset& _subset, Policy& _policy);
 
 };
 
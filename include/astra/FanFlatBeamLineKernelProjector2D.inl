@@ -31,27 +31,34 @@ template <typename Policy>
 void CFanFlatBeamLineKernelProjector2D::project(Policy& p)
 {
 	projectBlock_internal(0, m_pProjectionGeometry->getProjectionAngleCount(),
-	                      0, m_pProjectionGeometry->getDetectorCount(), p);
+	                      0, m_pProjectionGeometry->getDetectorCount(), SProjectionSubset(), p);
 }
 
 template <typename Policy>
 void CFanFlatBeamLineKernelProjector2D::projectSingleProjection(int _iProjection, Policy& p)
 {
 	projectBlock_internal(_iProjection, _iProjection + 1,
-	                      0, m_pProjectionGeometry->getDetectorCount(), p);
+	                      0, m_pProjectionGeometry->getDetectorCount(), SProjectionSubset(), p);
 }
 
 template <typename Policy>
 void CFanFlatBeamLineKernelProjector2D::projectSingleRay(int _iProjection, int _iDetector, Policy& p)
 {
 	projectBlock_internal(_iProjection, _iProjection + 1,
-	                      _iDetector, _iDetector + 1, p);
+	                      _iDetector, _iDetector + 1, SProjectionSubset(), p);
+}
+
+template <typename Policy>
+void CFanFlatBeamLineKernelProjector2D::projectSubset(int _iProjFrom, int _iProjTo, const SProjectionSubset& _subset, Policy& p)
+{
+	projectBlock_internal(_iProjFrom, _iProjTo,
+	                      0, m_pProjectionGeometry->getDetectorCount(), _subset, p);
 }
 
 //----------------------------------------------------------------------------------------
 // PROJECT BLOCK - vector projection geometry
 template <typename Policy>
-void CFanFlatBeamLineKernelProjector2D::projectBlock_internal(int _iProjFrom, int _iProjTo, int _iDetFrom, int _iDetTo, Policy& p)
+void CFanFlatBeamLineKernelProjector2D::projectBlock_internal(int _iProjFrom, int _iProjTo, int _iDetFrom, int _iDetTo, const SProjectionSubset& _subset, Policy& p)
 {
 	// get vector geometry
 	const CFanFlatVecProjectionGeometry2D* pVecProjectionGeometry;
@@ -72,6 +79,12 @@ void CFanFlatBeamLineKernelProjector2D::projectBlock_internal(int _iProjFrom, in
 	const float32 Ex = m_pVolumeGeometry->getWindowMinX() + pixelLengthX*0.5f;
 	const float32 Ey = m_pVolumeGeometry->getWindowMaxY() - pixelLengthY*0.5f;
 
+	// window of the volume to traverse
+	const int rowFrom = _subset.iRowFrom;
+	const int rowTo = std::min(rowCount, _subset.iRowTo);
+	const int colFrom = _subset.iColFrom;
+	const int colTo = std::min(colCount, _subset.iColTo);
+
 	// loop angles
 	for (int iAngle = _iProjFrom; iAngle < _iProjTo; ++iAngle) {
 
@@ -83,7 +96,7 @@ void CFanFlatBeamLineKernelProjector2D::projectBlock_internal(int _iProjFrom, in
 		const SFanProjection * proj = &pVecProjectionGeometry->getProjectionVectors()[iAngle];
 
 		// loop detectors
-		for (iDetector = _iDetFrom; iDetector < _iDetTo; ++iDetector) {
+		for (iDetector = _subset.firstRay(iAngle, _iDetFrom); iDetector < _iDetTo; iDetector = _subset.firstRay(iAngle, iDetector + 1)) {
 			
 			iRayIndex = iAngle * detCount + iDetector;
 
@@ -109,13 +122,15 @@ void CFanFlatBeamLineKernelProjector2D::projectBlock_internal(int _iProjFrom, in
 				invTminSTimesLengthPerRow = lengthPerRow / (T - S);
 
 				// calculate c for row 0
-				c = (Dx + (Ey - Dy)*RxOverRy - Ex) * inv_pixelLengthX;
+				const float32 c0 = (Dx + (Ey - Dy)*RxOverRy - Ex) * inv_pixelLengthX;
 
-				// for each row
-				for (row = 0; row < rowCount; ++row, c += deltac) {
+				// for each row of the window
+				for (row = rowFrom; row < rowTo; ++row) {
+					c = c0 + row * deltac;
 
 					col = int(floor(c+0.5f));
 					if (col < -1 || col > colCount) { if (!isin) continue; else break; }
+					if (!_subset.rowOverlaps(row, col - 1, col + 1)) continue;
 					offset = c - float32(col);
 
 					// left
@@ -159,13 +174,15 @@ void CFanFlatBeamLineKernelProjector2D::projectBlock_internal(int _iProjFrom, in
 				invTminSTimesLengthPerCol = lengthPerCol / (T - S);
 
 				// calculate r for col 0
-				r = -(Dy + (Ex - Dx)*RyOverRx - Ey) * inv_pixelLengthY;
+				const float32 r0 = -(Dy + (Ex - Dx)*RyOverRx - Ey) * inv_pixelLengthY;
 
-				// for each col
-				for (col = 0; col < colCount; ++col, r += deltar) {
+				// for each col of the window
+				for (col = colFrom; col < colTo; ++col) {
+					r = r0 + col * deltar;
 
 					row = int(floor(r+0.5f));
 					if (row < -1 || row > rowCount) { if (!isin) continue; else break; }
+					if (!_subset.colOverlaps(col, row - 1, row + 1)) continue;
 					offset = r - float32(row);
 
 					// up
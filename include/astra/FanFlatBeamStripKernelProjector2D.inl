@@ -30,27 +30,34 @@ template <typename Policy>
 void CFanFlatBeamStripKernelProjector2D::project(Policy& p)
 {
 	projectBlock_internal(0, m_pProjectionGeometry->getProjectionAngleCount(),
-	                      0, m_pProjectionGeometry->getDetectorCount(), p);
+	                      0, m_pProjectionGeometry->getDetectorCount(), SProjectionSubset(), p);
 }
 
 template <typename Policy>
 void CFanFlatBeamStripKernelProjector2D::projectSingleProjection(int _iProjection, Policy& p)
 {
 	projectBlock_internal(_iProjection, _iProjection + 1,
-	                      0, m_pProjectionGeometry->getDetectorCount(), p);
+	                      0, m_pProjectionGeometry->getDetectorCount(), SProjectionSubset(), p);
 }
 
 template <typename Policy>
 void CFanFlatBeamStripKernelProjector2D::projectSingleRay(int _iProjection, int _iDetector, Policy& p)
 {
 	projectBlock_internal(_iProjection, _iProjection + 1,
-	                      _iDetector, _iDetector + 1, p);
+	                      _iDetector, _iDetector + 1, SProjectionSubset(), p);
+}
+
+template <typename Policy>
+void CFanFlatBeamStripKernelProjector2D::projectSubset(int _iProjFrom, int _iProjTo, const SProjectionSubset& _subset, Policy& p)
+{
+	projectBlock_internal(_iProjFrom, _iProjTo,
+	                      0, m_pProjectionGeometry->getDetectorCount(), _subset, p);
 }
 
 //----------------------------------------------------------------------------------------
 // PROJECT BLOCK
 template <typename Policy>
-void CFanFlatBeamStripKernelProjector2D::projectBlock_internal(int _iProjFrom, int _iProjTo, int _iDetFrom, int _iDetTo, Policy& p)
+void CFanFlatBeamStripKernelProjector2D::projectBlock_internal(int _iProjFrom, int _iProjTo, int _iDetFrom, int _iDetTo, const SProjectionSubset& _subset, Policy& p)
 {
 	ASTRA_ASSERT(m_bIsInitialized);
 
@@ -72,15 +79,15 @@ void CFanFlatBeamStripKernelProjector2D::projectBlock_internal(int _iProjFrom, i
 	float32 inv_PW = 1.0f / PW;
 	float32 inv_PH = 1.0f / PH;
 
-	// calculate alpha's
-	float32 alpha;
-	float32* cos_alpha = new float32[m_pProjectionGeometry->getDetectorCount() + 1];
-	float32* sin_alpha = new float32[m_pProjectionGeometry->getDetectorCount() + 1];
-	for (int i = 0; i < m_pProjectionGeometry->getDetectorCount() + 1; ++i) {
-		alpha = -atan((i - m_pProjectionGeometry->getDetectorCount()*0.5f) * DW / projgeom->getSourceDetectorDistance());
-		cos_alpha[i] = cos(alpha);
-		sin_alpha[i] = sin(alpha);
-	}
+	// alpha's, computed once at initialization
+	const float32* cos_alpha = m_fCosAlpha.data();
+	const float32* sin_alpha = m_fSinAlpha.data();
+
+	// window of the volume to traverse
+	const int rowFrom = _subset.iRowFrom;
+	const int rowTo = std::min(m_pVolumeGeometry->getGridRowCount(), _subset.iRowTo);
+	const int colFrom = _subset.iColFrom;
+	const int colTo = std::min(m_pVolumeGeometry->getGridColCount(), _subset.iColTo);
 
 	// loop angles
 	for (iAngle = _iProjFrom; iAngle < _iProjTo; ++iAngle) {
@@ -102,7 +109,7 @@ void CFanFlatBeamStripKernelProjector2D::projectBlock_internal(int _iProjFrom, i
 		if (theta < PIdiv4) {
 
 			// loop detectors
-			for (iDetector = _iDetFrom; iDetector < _iDetTo; ++iDetector) {
+			for (iDetector = _subset.firstRay(iAngle, _iDetFrom); iDetector < _iDetTo; iDetector = _subset.firstRay(iAngle, iDetector + 1)) {
 
 				iRayIndex = iAngle * m_pProjectionGeometry->getDetectorCount() + iDetector;
 
@@ -171,14 +178,21 @@ void CFanFlatBeamStripKernelProjector2D::projectBlock_internal(int _iProjFrom, i
 				float32 PLimitR = PR - S_r * PH;
 				
 				// calculate strip extremes (pixel coordinates)
-				float32 XLimitL = (PLimitL - m_pVolumeGeometry->getWindowMinX()) * inv_PW;
-				float32 XLimitR = (PLimitR - m_pVolumeGeometry->getWindowMinX()) * inv_PW;
-				float32 xL = (PL - m_pVolumeGeometry->getWindowMinX()) * inv_PW;
-				float32 xR = (PR - m_pVolumeGeometry->getWindowMinX()) * inv_PW;
+				const float32 XLimitL0 = (PLimitL - m_pVolumeGeometry->getWindowMinX()) * inv_PW;
+				const float32 XLimitR0 = (PLimitR - m_pVolumeGeometry->getWindowMinX()) * inv_PW;
+				const float32 xL0 = (PL - m_pVolumeGeometry->getWindowMinX()) * inv_PW;
+				const float32 xR0 = (PR - m_pVolumeGeometry->getWindowMinX()) * inv_PW;
+
 	
-				// for each row
-				for (row = 0; row < m_pVolumeGeometry->getGridRowCount(); ++row) {
-				
+				// for each row of the window
+				for (row = rowFrom; row < rowTo; ++row) {
+
+					// strip extremes of this row
+					const float32 XLimitL = XLimitL0 + row * updateX_left;
+					const float32 XLimitR = XLimitR0 + row * updateX_right;
+					const float32 xL = xL0 + row * updateX_left;
+					const float32 xR = xR0 + row * updateX_right;
+
 					// get strip extremes in column indices
 					x1L = int((XLimitL > 0.0f) ? XLimitL : XLimitL-1.0f);
 					x1R = int((XLimitR > 0.0f) ? XLimitR : XLimitR-1.0f);
@@ -187,12 +201,6 @@ void CFanFlatBeamStripKernelProjector2D::projectBlock_internal(int _iProjFrom, i
 					x2L = xL - x1L; 
 					x2R = xR - x1L;
 					
-					// update strip extremes for the next row
-					XLimitL += updateX_left; 
-					XLimitR += updateX_right;
-					xL += updateX_left; 
-					xR += updateX_right; 
-
 					float32 diffSrcYSquared;
 					if (switch_t)
 						diffSrcYSquared = m_pVolumeGeometry->pixelRowToCenterY(row) + cos_theta * projgeom->getOriginSourceDistance();
@@ -200,8 +208,13 @@ void CFanFlatBeamStripKernelProjector2D::projectBlock_internal(int _iProjFrom, i
 						diffSrcYSquared = m_pVolumeGeometry->pixelRowToCenterY(row) - cos_theta * projgeom->getOriginSourceDistance();
 					diffSrcYSquared = diffSrcYSquared * diffSrcYSquared;
 
+					// restrict to the active pixels of this row
+					int colFirst = x1L;
+					_subset.clipRow(row, colFirst, x1R);
+					for (col = x1L; col < colFirst; ++col) { x2L -= 1.0f; x2R -= 1.0f; }
+
 					// for each affected col
-					for (col = x1L; col <= x1R; ++col) {
+					for (col = colFirst; col <= x1R; ++col) {
 
 						if (col < 0 || col >= m_pVolumeGeometry->getGridColCount()) { x2L -= 1.0f; x2R -= 1.0f;	continue; }
 
@@ -254,7 +267,7 @@ void CFanFlatBeamStripKernelProjector2D::projectBlock_internal(int _iProjFrom, i
 		} else {
 
 			// loop detectors
-			for (iDetector = _iDetFrom; iDetector < _iDetTo; ++iDetector) {
+			for (iDetector = _subset.firstRay(iAngle, _iDetFrom); iDetector < _iDetTo; iDetector = _subset.firstRay(iAngle, iDetector + 1)) {
 
 				iRayIndex = iAngle * m_pProjectionGeometry->getDetectorCount() + iDetector;
 
@@ -318,13 +331,20 @@ void CFanFlatBeamStripKernelProjector2D::projectBlock_internal(int _iProjFrom, i
 				float32 PLimitR = PR + S_r * PW;
 				
 				// calculate strip extremes (pixel coordinates)
-				float32 XLimitL = (m_pVolumeGeometry->getWindowMaxY() - PLimitL) * inv_PH;
-				float32 XLimitR = (m_pVolumeGeometry->getWindowMaxY() - PLimitR) * inv_PH;
-				float32 xL = (m_pVolumeGeometry->getWindowMaxY() - PL) * inv_PH;
-				float32 xR = (m_pVolumeGeometry->getWindowMaxY() - PR) * inv_PH;
+				const float32 XLimitL0 = (m_pVolumeGeometry->getWindowMaxY() - PLimitL) * inv_PH;
+				const float32 XLimitR0 = (m_pVolumeGeometry->getWindowMaxY() - PLimitR) * inv_PH;
+				const float32 xL0 = (m_pVolumeGeometry->getWindowMaxY() - PL) * inv_PH;
+				const float32 xR0 = (m_pVolumeGeometry->getWindowMaxY() - PR) * inv_PH;
+
 
-				// for each col
-				for (col = 0; col < m_pVolumeGeometry->getGridColCount(); ++col) {
+				// for each col of the window
+				for (col = colFrom; col < colTo; ++col) {
+
+					// strip extremes of this col
+					const float32 XLimitL = XLimitL0 + col * updateX_left;
+					const float32 XLimitR = XLimitR0 + col * updateX_right;
+					const float32 xL = xL0 + col * updateX_left;
+					const float32 xR = xR0 + col * updateX_right;
 
 					// get strip extremes in column indices
 					x1L = int((XLimitL > 0.0f) ? XLimitL : XLimitL-1.0f);
@@ -334,12 +354,6 @@ void CFanFlatBeamStripKernelProjector2D::projectBlock_internal(int _iProjFrom, i
 					x2L = xL - x1L; 
 					x2R = xR - x1L;
 					
-					// update strip extremes for the next row
-					XLimitL += updateX_left; 
-					XLimitR += updateX_right;
-					xL += updateX_left; 
-					xR += updateX_right; 
-
 					float32 diffSrcXSquared;
 					if (switch_t)
 						diffSrcXSquared = m_pVolumeGeometry->pixelColToCenterX(col) - sin_theta * projgeom->getOriginSourceDistance();
@@ -347,8 +361,13 @@ void CFanFlatBeamStripKernelProjector2D::projectBlock_internal(int _iProjFrom, i
 						diffSrcXSquared = m_pVolumeGeometry->pixelColToCenterX(col) + sin_theta * projgeom->getOriginSourceDistance();
 					diffSrcXSquared = diffSrcXSquared * diffSrcXSquared;
 
+					// restrict to the active pixels of this col
+					int rowFirst = x1L;
+					_subset.clipCol(col, rowFirst, x1R);
+					for (row = x1L; row < rowFirst; ++row) { x2L -= 1.0f; x2R -= 1.0f; }
+
 					// for each affected row
-					for (row = x1L; row <= x1R; ++row) {
+					for (row = rowFirst; row <= x1R; ++row) {
 
 						if (row < 0 || row >= m_pVolumeGeometry->getGridRowCount()) { x2L -= 1.0f; x2R -= 1.0f;	continue; }
 
@@ -400,8 +419,5 @@ void CFanFlatBeamStripKernelProjector2D::projectBlock_internal(int _iProjFrom, i
 		} // end theta switch
 
 	} // end angle loop
-
-	delete[] cos_alpha;
-	delete[] sin_alpha;
 }
 
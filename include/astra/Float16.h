@@ -0,0 +1,139 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+#ifndef _INC_ASTRA_FLOAT16
+#define _INC_ASTRA_FLOAT16
+
+#include <cstdint>
+#include <cstring>
+
+namespace astra {
+
+/**
+ * 16-bit storage types. These are only meant for storing data: they convert
+ * implicitly to float, and all computations are done in float32.
+ */
+
+/** IEEE 754 half precision (1 sign, 5 exponent, 10 mantissa bits).
+ */
+struct float16 {
+	uint16_t bits;
+
+	float16() = default;
+	explicit float16(float f) : bits(fromFloat(f)) { }
+	operator float() const { return toFloat(bits); }
+
+	static uint16_t fromFloat(float f) {
+		uint32_t x;
+		memcpy(&x, &f, 4);
+		uint16_t sign = (x >> 16) & 0x8000;
+		uint32_t absx = x & 0x7fffffff;
+
+		if (absx >= 0x7f800000) // inf or nan
+			return sign | 0x7c00 | (absx > 0x7f800000 ? 0x200 : 0);
+		if (absx >= 0x477ff000) // rounds to a value beyond max half
+			return sign | 0x7c00;
+		if (absx < 0x38800000) { // subnormal half, or zero
+			if (absx < 0x33000000)
+				return sign;
+			int shift = 126 - (absx >> 23);
+			uint32_t m = (absx & 0x7fffff) | 0x800000;
+			uint32_t r = m >> shift;
+			uint32_t rem = m & ((1u << shift) - 1);
+			uint32_t half = 1u << (shift - 1);
+			if (rem > half || (rem == half && (r & 1)))
+				r++;
+			return sign | r;
+		}
+		// normal: rebias exponent and round to nearest even
+		uint32_t r = (absx - 0x38000000) >> 13;
+		uint32_t rem = absx & 0x1fff;
+		if (rem > 0x1000 || (rem == 0x1000 && (r & 1)))
+			r++;
+		return sign | r;
+	}
+
+	static float toFloat(uint16_t h) {
+		uint32_t sign = (uint32_t)(h & 0x8000) << 16;
+		uint32_t exp = (h >> 10) & 0x1f;
+		uint32_t mant = h & 0x3ff;
+		uint32_t x;
+		if (exp == 0x1f) {
+			x = sign | 0x7f800000 | (mant << 13);
+		} else if (exp != 0) {
+			x = sign | ((exp + 112) << 23) | (mant << 13);
+		} else if (mant == 0) {
+			x = sign;
+		} else {
+			// subnormal half: normalize
+			exp = 113;
+			while (!(mant & 0x400)) {
+				mant <<= 1;
+				exp--;
+			}
+			x = sign | (exp << 23) | ((mant & 0x3ff) << 13);
+		}
+		float f;
+		memcpy(&f, &x, 4);
+		return f;
+	}
+};
+
+/** bfloat16: the upper half of an IEEE 754 float (1 sign, 8 exponent,
+ *  7 mantissa bits).
+ */
+struct bfloat16 {
+	uint16_t bits;
+
+	bfloat16() = default;
+	explicit bfloat16(float f) : bits(fromFloat(f)) { }
+	operator float() const { return toFloat(bits); }
+
+	static uint16_t fromFloat(float f) {
+		uint32_t x;
+		memcpy(&x, &f, 4);
+		if ((x & 0x7fffffff) > 0x7f800000) // nan: keep it a quiet nan
+			return (x >> 16) | 0x40;
+		// round to nearest even
+		x += 0x7fff + ((x >> 16) & 1);
+		return x >> 16;
+	}
+
+	static float toFloat(uint16_t b) {
+		uint32_t x = (uint32_t)b << 16;
+		float f;
+		memcpy(&f, &x, 4);
+		return f;
+	}
+};
+
+static_assert(sizeof(float16) == 2, "float16 must be 2 bytes");
+static_assert(sizeof(bfloat16) == 2, "bfloat16 must be 2 bytes");
+
+}
+
+#endif
@@ -48,6 +48,7 @@ namespace astra {
  * \astra_xml_item{ProjectionDataId, integer, Identifier of the resulting projection data object as it is stored in the DataManager.}
  * \astra_xml_item_option{VolumeMaskId, integer, not used, Identifier of a volume data object that acts as a volume mask. 0 = don't use this pixel. 1 = use this pixel. }
  * \astra_xml_item_option{SinogramMaskId, integer, not used, Identifier of a projection data object that acts as a projection mask. 0 = don't use this ray. 1 = use this ray.}
+ * \astra_xml_item_option{VolumeWindow, integer array, not used, Sub-window [RowFrom RowTo ColFrom ColTo) of the volume to project. Pixels outside it are not used.}
  *
  * \par MATLAB example
  * \astra_code{
@@ -88,6 +89,11 @@ protected:
 	//< Use the fixed reconstruction mask?
 	bool m_bUseSinogramMask;
 
+	//< Sub-window of the volume to project
+	SVolumeWindow m_volumeWindow;
+	//< Only project the volume window?
+	bool m_bUseVolumeWindow;
+
 public:
 	
 	// type of the algorithm, needed to register with CAlgorithmFactory
@@ -145,6 +151,12 @@ public:
 	 */
 	void setSinogramMask(CFloat32ProjectionData2D* _pMask, bool _bEnable = true);
 
+	/** Only project the pixels of a sub-window of the volume.
+	 *
+	 * @param _window Volume window to project
+	 */
+	void setVolumeWindow(const SVolumeWindow& _window);
+
 	/** Get projector object
 	 *
 	 * @return projector
@@ -0,0 +1,104 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+#ifndef _INC_ASTRA_GEOMETRYCACHE
+#define _INC_ASTRA_GEOMETRYCACHE
+
+#include "Globals.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace astra {
+
+/**
+ * Cache of data derived from a geometry object, such as converted
+ * projection vectors. Entries are immutable and reference counted, so
+ * copies of a geometry and concurrent users can share them.
+ *
+ * The owning geometry must call invalidate() whenever it is modified.
+ */
+class _AstraExport CGeometryCache {
+public:
+	CGeometryCache() { }
+	CGeometryCache(const CGeometryCache &_other);
+	CGeometryCache &operator=(const CGeometryCache &_other);
+
+	/** Remove all entries.
+	 */
+	void invalidate();
+
+	/** Get an entry, or nullptr if it is not present.
+	 */
+	template<class T>
+	std::shared_ptr<const T> get(const std::string &_sKey) const {
+		return std::static_pointer_cast<const T>(_get(_sKey));
+	}
+
+	/** Store an entry, replacing any existing entry with the same key.
+	 */
+	template<class T>
+	void set(const std::string &_sKey, std::shared_ptr<const T> _pValue) {
+		_set(_sKey, std::move(_pValue));
+	}
+
+	/** Get an entry, computing and storing it with _compute() if it is not
+	 *  present. _compute is called without holding the cache lock, and must
+	 *  return a std::shared_ptr<const T>.
+	 */
+	template<class T, class F>
+	std::shared_ptr<const T> getOrCompute(const std::string &_sKey, F &&_compute) {
+		std::shared_ptr<const T> p = get<T>(_sKey);
+		if (p)
+			return p;
+		p = _compute();
+		if (p)
+			set<T>(_sKey, p);
+		return p;
+	}
+
+	/** Number of times an entry was found or missing. (For testing.)
+	 */
+	size_t getHitCount() const { return m_iHits; }
+	size_t getMissCount() const { return m_iMisses; }
+
+private:
+	std::shared_ptr<const void> _get(const std::string &_sKey) const;
+	void _set(const std::string &_sKey, std::shared_ptr<const void> _pValue);
+
+	mutable std::mutex m_mutex;
+	std::vector<std::pair<std::string, std::shared_ptr<const void> > > m_entries;
+	mutable size_t m_iHits = 0;
+	mutable size_t m_iMisses = 0;
+};
+
+} // end namespace
+
+#endif
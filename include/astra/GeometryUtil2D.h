@@ -30,6 +30,7 @@ along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
 
 #include "Globals.h"
 
+#include <memory>
 #include <vector>
 #include <variant>
 
@@ -117,34 +118,41 @@ struct SFanProjection {
 
 class _AstraExport Geometry2DParameters {
 public:
-	using variant_t = std::variant<std::monostate, std::vector<SParProjection>, std::vector<SFanProjection> >;
+	// The projection vectors are shared (and immutable), so that
+	// copies are cheap and can refer to cached vectors.
+	template<class V>
+	using vectors_t = std::shared_ptr<const std::vector<V> >;
+	using variant_t = std::variant<std::monostate, vectors_t<SParProjection>, vectors_t<SFanProjection> >;
 
 	Geometry2DParameters() { }
-	Geometry2DParameters(variant_t && p, SDimensions d, float sc) : projs(std::move(p)), dims(d), fOutputScale(sc) { }
+	template<class V>
+	Geometry2DParameters(std::vector<V> && p, SDimensions d, float sc) : projs(std::make_shared<const std::vector<V> >(std::move(p))), dims(d), fOutputScale(sc) { }
+	template<class V>
+	Geometry2DParameters(vectors_t<V> p, SDimensions d, float sc) : projs(std::move(p)), dims(d), fOutputScale(sc) { }
 
 	bool isValid() const {
 		return !std::holds_alternative<std::monostate>(projs);
 	}
 
 	bool isParallel() const {
-		return std::holds_alternative<std::vector<SParProjection>>(projs);
+		return std::holds_alternative<vectors_t<SParProjection>>(projs);
 	}
 	bool isFan() const {
-		return std::holds_alternative<std::vector<SFanProjection>>(projs);
+		return std::holds_alternative<vectors_t<SFanProjection>>(projs);
 	}
 
 	const SParProjection *getParallel() const {
-		if (!std::holds_alternative<std::vector<SParProjection>>(projs))
+		if (!std::holds_alternative<vectors_t<SParProjection>>(projs))
 			return nullptr;
 
-		return &std::get<std::vector<SParProjection>>(projs)[0];
+		return std::get<vectors_t<SParProjection>>(projs)->data();
 	}
 
 	const SFanProjection *getFan() const {
-		if (!std::holds_alternative<std::vector<SFanProjection>>(projs))
+		if (!std::holds_alternative<vectors_t<SFanProjection>>(projs))
 			return nullptr;
 
-		return &std::get<std::vector<SFanProjection>>(projs)[0];
+		return std::get<vectors_t<SFanProjection>>(projs)->data();
 	}
 
 	const SDimensions& getDims() const {
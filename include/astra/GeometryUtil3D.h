@@ -31,6 +31,7 @@ along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
 #include "Globals.h"
 
 #include <cmath>
+#include <memory>
 #include <vector>
 #include <variant>
 
@@ -171,44 +172,51 @@ struct SVolScale3D {
 
 class _AstraExport Geometry3DParameters {
 public:
-	using variant_t = std::variant<std::monostate, std::vector<SPar3DProjection>, std::vector<SConeProjection>, std::vector<SCylConeProjection> >;
+	// The projection vectors are shared (and immutable), so that
+	// copies are cheap and can refer to cached vectors.
+	template<class V>
+	using vectors_t = std::shared_ptr<const std::vector<V> >;
+	using variant_t = std::variant<std::monostate, vectors_t<SPar3DProjection>, vectors_t<SConeProjection>, vectors_t<SCylConeProjection> >;
 
 	Geometry3DParameters() { }
-	Geometry3DParameters(variant_t && p, SDimensions3D d, SVolScale3D vs) : projs(std::move(p)), dims(d), volScale(vs) { }
+	template<class V>
+	Geometry3DParameters(std::vector<V> && p, SDimensions3D d, SVolScale3D vs) : projs(std::make_shared<const std::vector<V> >(std::move(p))), dims(d), volScale(vs) { }
+	template<class V>
+	Geometry3DParameters(vectors_t<V> p, SDimensions3D d, SVolScale3D vs) : projs(std::move(p)), dims(d), volScale(vs) { }
 
 	bool isValid() const {
 		return !std::holds_alternative<std::monostate>(projs);
 	}
 
 	bool isParallel() const {
-		return std::holds_alternative<std::vector<SPar3DProjection>>(projs);
+		return std::holds_alternative<vectors_t<SPar3DProjection>>(projs);
 	}
 	bool isCone() const {
-		return std::holds_alternative<std::vector<SConeProjection>>(projs);
+		return std::holds_alternative<vectors_t<SConeProjection>>(projs);
 	}
 	bool isCylCone() const {
-		return std::holds_alternative<std::vector<SCylConeProjection>>(projs);
+		return std::holds_alternative<vectors_t<SCylConeProjection>>(projs);
 	}
 
 
 	const SPar3DProjection *getParallel() const {
-		if (!std::holds_alternative<std::vector<SPar3DProjection>>(projs))
+		if (!std::holds_alternative<vectors_t<SPar3DProjection>>(projs))
 			return nullptr;
 
-		return &std::get<std::vector<SPar3DProjection>>(projs)[0];
+		return std::get<vectors_t<SPar3DProjection>>(projs)->data();
 	}
 
 	const SConeProjection *getCone() const {
-		if (!std::holds_alternative<std::vector<SConeProjection>>(projs))
+		if (!std::holds_alternative<vectors_t<SConeProjection>>(projs))
 			return nullptr;
 
-		return &std::get<std::vector<SConeProjection>>(projs)[0];
+		return std::get<vectors_t<SConeProjection>>(projs)->data();
 	}
 	const SCylConeProjection *getCylCone() const {
-		if (!std::holds_alternative<std::vector<SCylConeProjection>>(projs))
+		if (!std::holds_alternative<vectors_t<SCylConeProjection>>(projs))
 			return nullptr;
 
-		return &std::get<std::vector<SCylConeProjection>>(projs)[0];
+		return std::get<vectors_t<SCylConeProjection>>(projs)->data();
 	}
 
 	const SDimensions3D& getDims() const {
@@ -289,6 +297,27 @@ void computeBP_UV_Coeffs(const SConeProjection& proj,
                          double &fVX, double &fVY, double &fVZ, double &fVC,
                          double &fDX, double &fDY, double &fDZ, double &fDC);
 
+// Per-angle coefficients as computed by computeBP_UV_Coeffs
+struct SPar3DBPCoeffs {
+	double fUX, fUY, fUZ, fUC;
+	double fVX, fVY, fVZ, fVC;
+};
+
+struct SConeBPCoeffs {
+	double fUX, fUY, fUZ, fUC;
+	double fVX, fVY, fVZ, fVC;
+	double fDX, fDY, fDZ, fDC;
+};
+
+void computeBP_UV_Coeffs(const SPar3DProjection& proj, SPar3DBPCoeffs &coeffs);
+void computeBP_UV_Coeffs(const SConeProjection& proj, SConeBPCoeffs &coeffs);
+
+// Get the per-angle BP coefficients of a parallel(-vec) or cone(-vec)
+// geometry. They are computed once, and shared through the cache of the
+// geometry. Returns nullptr for other geometry types.
+std::shared_ptr<const std::vector<SPar3DBPCoeffs> > getParallelBP_UV_Coeffs(const CProjectionGeometry3D* pProjGeom);
+std::shared_ptr<const std::vector<SConeBPCoeffs> > getConeBP_UV_Coeffs(const CProjectionGeometry3D* pProjGeom);
+
 
 std::vector<SConeProjection> genConeProjections(unsigned int iProjAngles,
                                     unsigned int iProjU,
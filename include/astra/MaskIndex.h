@@ -0,0 +1,111 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+#ifndef _INC_ASTRA_MASKINDEX
+#define _INC_ASTRA_MASKINDEX
+
+#include "Globals.h"
+#include "Projector2D.h"
+
+#include <vector>
+
+namespace astra {
+
+class CFloat32ProjectionData2D;
+class CFloat32VolumeData2D;
+
+/** Create a mask that is 1 on the pixels of a volume window that are
+ *  also active in _pMask (if given), and 0 elsewhere.
+ *
+ * @param _volGeom Volume geometry of the mask
+ * @param _window Volume window
+ * @param _pMask Mask to intersect with, or nullptr
+ * @return a newly allocated mask. Delete afterwards.
+ */
+_AstraExport CFloat32VolumeData2D *createWindowMask(const CVolumeGeometry2D &_volGeom,
+                                                    const SVolumeWindow &_window,
+                                                    const CFloat32VolumeData2D *_pMask);
+
+/**
+ * Precomputed index of the active rays of a sinogram mask and the active
+ * pixels of a reconstruction mask (non-zero entries are active).
+ *
+ * Iterative algorithms build it once per run, and pass it to their data
+ * projectors (see CDataProjectorInterface::setMaskIndex). Projectors then
+ * only visit the active rays, and only traverse the rows and columns of the
+ * volume that contain active pixels, instead of checking the masks for every
+ * ray and pixel. This makes masked projection cost roughly proportional to
+ * the size of the active region.
+ */
+class _AstraExport CMaskIndex {
+public:
+	/** Build the index. Either mask may be null, in which case all rays
+	 *  (or pixels) are active.
+	 *
+	 * @param _projGeom Projection geometry of the sinogram (mask)
+	 * @param _volGeom Volume geometry of the reconstruction (mask)
+	 * @param _pSinogramMask Sinogram mask, or nullptr
+	 * @param _pReconstructionMask Reconstruction mask, or nullptr
+	 */
+	CMaskIndex(const CProjectionGeometry2D &_projGeom, const CVolumeGeometry2D &_volGeom,
+	           const CFloat32ProjectionData2D *_pSinogramMask,
+	           const CFloat32VolumeData2D *_pReconstructionMask);
+
+	// m_subset points into the member vectors
+	CMaskIndex(const CMaskIndex&) = delete;
+	CMaskIndex &operator=(const CMaskIndex&) = delete;
+
+	/** Rays and pixels projectors have to visit. */
+	const SProjectionSubset &getSubset() const { return m_subset; }
+
+	/** Number of active rays. */
+	size_t getActiveRayCount() const { return m_iActiveRays; }
+
+	/** Number of active rays of a single projection. */
+	int getActiveRayCount(int _iAngle) const;
+
+	/** Number of active pixels. */
+	size_t getActivePixelCount() const { return m_iActivePixels; }
+
+private:
+	int m_iAngleCount;
+	int m_iDetectorCount;
+
+	std::vector<int> m_iNextRay;
+	std::vector<int> m_iRaysPerAngle;
+	std::vector<int> m_iRowSpans;
+	std::vector<int> m_iColSpans;
+
+	size_t m_iActiveRays;
+	size_t m_iActivePixels;
+
+	SProjectionSubset m_subset;
+};
+
+} // end namespace
+
+#endif
@@ -30,21 +30,28 @@ template <typename Policy>
 void CParallelBeamBlobKernelProjector2D::project(Policy& p)
 {
 	projectBlock_internal(0, m_pProjectionGeometry->getProjectionAngleCount(),
-						  0, m_pProjectionGeometry->getDetectorCount(), p);
+						  0, m_pProjectionGeometry->getDetectorCount(), SProjectionSubset(), p);
 }
 
 template <typename Policy>
 void CParallelBeamBlobKernelProjector2D::projectSingleProjection(int _iProjection, Policy& p)
 {
 	projectBlock_internal(_iProjection, _iProjection + 1,
-						  0, m_pProjectionGeometry->getDetectorCount(), p);
+						  0, m_pProjectionGeometry->getDetectorCount(), SProjectionSubset(), p);
 }
 
 template <typename Policy>
 void CParallelBeamBlobKernelProjector2D::projectSingleRay(int _iProjection, int _iDetector, Policy& p)
 {
 	projectBlock_internal(_iProjection, _iProjection + 1,
-						  _iDetector, _iDetector + 1, p);
+						  _iDetector, _iDetector + 1, SProjectionSubset(), p);
+}
+
+template <typename Policy>
+void CParallelBeamBlobKernelProjector2D::projectSubset(int _iProjFrom, int _iProjTo, const SProjectionSubset& _subset, Policy& p)
+{
+	projectBlock_internal(_iProjFrom, _iProjTo,
+						  0, m_pProjectionGeometry->getDetectorCount(), _subset, p);
 }
 
 //----------------------------------------------------------------------------------------
@@ -107,8 +114,17 @@ void CParallelBeamBlobKernelProjector2D::projectSingleRay(int _iProjection, int
 //    offset = r - row
 //
 template <typename Policy>
-void CParallelBeamBlobKernelProjector2D::projectBlock_internal(int _iProjFrom, int _iProjTo, int _iDetFrom, int _iDetTo, Policy& p)
+void CParallelBeamBlobKernelProjector2D::projectBlock_internal(int _iProjFrom, int _iProjTo, int _iDetFrom, int _iDetTo, const SProjectionSubset& _subset, Policy& p)
 {
+	// policies that accept the rays of an angle interleaved are splatted
+	// pixel by pixel instead
+	if constexpr (PolicyTraits<Policy>::bRayInterleavable) {
+		if (_iDetTo - _iDetFrom > 1) {
+			projectBlockFootprint_internal(_iProjFrom, _iProjTo, _iDetFrom, _iDetTo, _subset, p);
+			return;
+		}
+	}
+
 	// get vector geometry
 	const CParallelVecProjectionGeometry2D* pVecProjectionGeometry;
 	if (dynamic_cast<CParallelProjectionGeometry2D*>(m_pProjectionGeometry.get())) {
@@ -125,6 +141,12 @@ void CParallelBeamBlobKernelProjector2D::projectBlock_internal(int _iProjFrom, i
 	const int colCount = m_pVolumeGeometry->getGridColCount();
 	const int rowCount = m_pVolumeGeometry->getGridRowCount();
 
+	// window of the volume to traverse
+	const int rowFrom = _subset.iRowFrom;
+	const int rowTo = std::min(rowCount, _subset.iRowTo);
+	const int colFrom = _subset.iColFrom;
+	const int colTo = std::min(colCount, _subset.iColTo);
+
 	// loop angles
 	for (int iAngle = _iProjFrom; iAngle < _iProjTo; ++iAngle) {
 
@@ -150,7 +172,7 @@ void CParallelBeamBlobKernelProjector2D::projectBlock_internal(int _iProjFrom, i
 		Ey = m_pVolumeGeometry->getWindowMaxY() - pixelLengthY*0.5f;
 
 		// loop detectors
-		for (iDetector = _iDetFrom; iDetector < _iDetTo; ++iDetector) {
+		for (iDetector = _subset.firstRay(iAngle, _iDetFrom); iDetector < _iDetTo; iDetector = _subset.firstRay(iAngle, iDetector + 1)) {
 			
 			iRayIndex = iAngle * m_pProjectionGeometry->getDetectorCount() + iDetector;
 
@@ -164,16 +186,18 @@ void CParallelBeamBlobKernelProjector2D::projectBlock_internal(int _iProjFrom, i
 			if (vertical) {
 
 				// calculate c for row 0
-				c = (Dx + (Ey - Dy)*ratio - Ex) * inv_pixelLengthX;
+				const float32 c0 = (Dx + (Ey - Dy)*ratio - Ex) * inv_pixelLengthX;
 
-				// loop rows
-				for (row = 0; row < rowCount; ++row, c += delta) {
+				// loop rows of the window
+				for (row = rowFrom; row < rowTo; ++row) {
+					c = c0 + row * delta;
 
 					col_left = int(c - 0.5f - m_fBlobSize);
 					col_right = int(c + 0.5f + m_fBlobSize);
 
 					if (col_left < 0) col_left = 0; 
 					if (col_right > colCount-1) col_right = colCount-1; 
+					_subset.clipRow(row, col_left, col_right);
 
 					// loop columns
 					for (col = col_left; col <= col_right; ++col) {
@@ -194,16 +218,18 @@ void CParallelBeamBlobKernelProjector2D::projectBlock_internal(int _iProjFrom, i
 			else {
 
 				// calculate r for col 0
-				r = -(Dy + (Ex - Dx)*ratio - Ey) * inv_pixelLengthY;
+				const float32 r0 = -(Dy + (Ex - Dx)*ratio - Ey) * inv_pixelLengthY;
 
-				// loop columns
-				for (col = 0; col < colCount; ++col, r += delta) {
+				// loop columns of the window
+				for (col = colFrom; col < colTo; ++col) {
+					r = r0 + col * delta;
 
 					row_top = int(r - 0.5f - m_fBlobSize);
 					row_bottom = int(r + 0.5f + m_fBlobSize);
 
 					if (row_top < 0) row_top = 0; 
 					if (row_bottom > rowCount-1) row_bottom = rowCount-1; 
+					_subset.clipCol(col, row_top, row_bottom);
 
 					// loop rows
 					for (row = row_top; row <= row_bottom; ++row) {
@@ -229,3 +255,160 @@ void CParallelBeamBlobKernelProjector2D::projectBlock_internal(int _iProjFrom, i
 	if (dynamic_cast<CParallelProjectionGeometry2D*>(m_pProjectionGeometry.get()))
 		delete pVecProjectionGeometry;
 }
+
+//----------------------------------------------------------------------------------------
+// PROJECT BLOCK - pixel driven footprints
+//
+// Generates exactly the weights of projectBlock_internal, but visits every
+// pixel once per angle instead of every pixel within the blob radius of
+// every ray. As the policy is ray interleavable, its pixel prior and
+// posterior are evaluated once per pixel rather than once per weight.
+//
+// Per angle, the intersection c0(d) of the ray of detector d with row 0 is
+// tabulated (r0(d) with column 0 for mainly horizontal rays). It is linear
+// in d:
+//    c0(d) = c0(0) + d*step,   step = (Ux - Uy*Rx/Ry)/PixelLengthX.
+//
+// The ray driven traversal gives pixel (row,col) a weight for ray d if
+//    int(c - 0.5 - BlobSize) <= col <= int(c + 0.5 + BlobSize),   c = c0(d) + row*deltac.
+// Both bounds are monotone in c, and thus in d, so the rays hitting a pixel
+// form a range of detectors: its footprint. Along a row of pixels, the
+// footprint shifts by a constant number of detectors per pixel, so its ends
+// are tracked incrementally, starting each row from the ray through its
+// first pixel.
+//
+template <typename Policy>
+void CParallelBeamBlobKernelProjector2D::projectBlockFootprint_internal(int _iProjFrom, int _iProjTo, int _iDetFrom, int _iDetTo, const SProjectionSubset& _subset, Policy& p)
+{
+	// get vector geometry
+	const CParallelVecProjectionGeometry2D* pVecProjectionGeometry;
+	if (dynamic_cast<CParallelProjectionGeometry2D*>(m_pProjectionGeometry.get())) {
+		pVecProjectionGeometry = dynamic_cast<CParallelProjectionGeometry2D*>(m_pProjectionGeometry.get())->toVectorGeometry();
+	} else {
+		pVecProjectionGeometry = dynamic_cast<CParallelVecProjectionGeometry2D*>(m_pProjectionGeometry.get());
+	}
+
+	// precomputations
+	const float32 pixelLengthX = m_pVolumeGeometry->getPixelLengthX();
+	const float32 pixelLengthY = m_pVolumeGeometry->getPixelLengthY();
+	const float32 inv_pixelLengthX = 1.0f / m_pVolumeGeometry->getPixelLengthX();
+	const float32 inv_pixelLengthY = 1.0f / m_pVolumeGeometry->getPixelLengthY();
+	const int colCount = m_pVolumeGeometry->getGridColCount();
+	const int rowCount = m_pVolumeGeometry->getGridRowCount();
+	const int detCount = m_pProjectionGeometry->getDetectorCount();
+
+	// window of the volume to traverse
+	const int rowFrom = _subset.iRowFrom;
+	const int rowTo = std::min(rowCount, _subset.iRowTo);
+	const int colFrom = _subset.iColFrom;
+	const int colTo = std::min(colCount, _subset.iColTo);
+
+	// per angle: intersection of each ray with row (column) 0, and whether the
+	// policy accepted the ray
+	std::vector<float32> fRayPos(detCount);
+	std::vector<char> bRayActive(detCount);
+
+	// the weights are passed on as float32 anyway
+	const std::vector<float32> fBlobValues(m_pfBlobValues.begin(), m_pfBlobValues.end());
+
+	// loop angles
+	for (int iAngle = _iProjFrom; iAngle < _iProjTo; ++iAngle) {
+
+		// variables
+		float32 Dx, Dy, Ex, Ey, delta, invBlobExtent, ratio, step;
+		int iDetector;
+
+		const SParProjection * proj = &pVecProjectionGeometry->getProjectionVectors()[iAngle];
+
+		bool vertical = fabs(proj->fRayX) < fabs(proj->fRayY);
+		if (vertical) {
+			ratio = proj->fRayX/proj->fRayY;
+			delta = -m_pVolumeGeometry->getPixelLengthY() * (proj->fRayX/proj->fRayY) * inv_pixelLengthX;
+			invBlobExtent = m_pVolumeGeometry->getPixelLengthY() / abs(m_fBlobSize * sqrt(proj->fRayY*proj->fRayY + proj->fRayX*proj->fRayX) / proj->fRayY);
+			step = (proj->fDetUX - proj->fDetUY*ratio) * inv_pixelLengthX;
+		} else {
+			ratio = proj->fRayY/proj->fRayX;
+			delta = -m_pVolumeGeometry->getPixelLengthX() * (proj->fRayY/proj->fRayX) * inv_pixelLengthY;
+			invBlobExtent = m_pVolumeGeometry->getPixelLengthX() / abs(m_fBlobSize * sqrt(proj->fRayY*proj->fRayY + proj->fRayX*proj->fRayX) / proj->fRayX);
+			step = -(proj->fDetUY - proj->fDetUX*ratio) * inv_pixelLengthY;
+		}
+
+		Ex = m_pVolumeGeometry->getWindowMinX() + pixelLengthX*0.5f;
+		Ey = m_pVolumeGeometry->getWindowMaxY() - pixelLengthY*0.5f;
+
+		// tabulate the rays of this angle (same expressions as the ray driven traversal)
+		for (iDetector = _iDetFrom; iDetector < _iDetTo; ++iDetector) {
+			Dx = proj->fDetSX + (iDetector+0.5f) * proj->fDetUX;
+			Dy = proj->fDetSY + (iDetector+0.5f) * proj->fDetUY;
+			if (vertical)
+				fRayPos[iDetector] = (Dx + (Ey - Dy)*ratio - Ex) * inv_pixelLengthX;
+			else
+				fRayPos[iDetector] = -(Dy + (Ex - Dx)*ratio - Ey) * inv_pixelLengthY;
+		}
+		const int iRayOffset = iAngle * detCount;
+		std::fill(bRayActive.begin() + _iDetFrom, bRayActive.begin() + _iDetTo, 0);
+		for (iDetector = _subset.firstRay(iAngle, _iDetFrom); iDetector < _iDetTo; iDetector = _subset.firstRay(iAngle, iDetector + 1)) {
+			// POLICY: RAY PRIOR
+			bRayActive[iDetector] = p.rayPrior(iRayOffset + iDetector);
+		}
+		const bool allRaysActive = std::find(bRayActive.begin() + _iDetFrom, bRayActive.begin() + _iDetTo, 0) == bRayActive.begin() + _iDetTo;
+
+		const float32 pos0 = fRayPos[_iDetFrom] - _iDetFrom * step;
+		const float32 invStep = 1.0f / step;
+		const bool increasing = step >= 0.0f;
+
+		// loop pixels of the window
+		for (int row = rowFrom; row < rowTo; ++row) {
+			int colFirst = colFrom, colLast = colTo - 1;
+			_subset.clipRow(row, colFirst, colLast);
+
+			int rayFirst = _iDetFrom, rayLast = _iDetFrom;
+			for (int col = colFirst; col <= colLast; ++col) {
+
+				// offset of the rays at this pixel, and the pixel's own coordinate
+				const float32 shift = vertical ? row * delta : col * delta;
+				const int target = vertical ? col : row;
+
+				// ray d reaches the pixel from below / from above
+				auto above = [&](int d) { return int(fRayPos[d] + shift + 0.5f + m_fBlobSize) >= target; };
+				auto below = [&](int d) { return int(fRayPos[d] + shift - 0.5f - m_fBlobSize) <= target; };
+				auto afterFirst = [&](int d) { return increasing ? above(d) : below(d); };
+				auto beforeLast = [&](int d) { return increasing ? below(d) : above(d); };
+
+				// footprint: the rays hitting the pixel are [rayFirst, rayLast]. Start
+				// the first pixel of a row at the ray through its centre, and move the
+				// ends along from one pixel to the next.
+				if (col == colFirst && std::isfinite(invStep)) {
+					rayFirst = int(std::min(std::max((target - shift - pos0) * invStep, float32(_iDetFrom)), float32(_iDetTo - 1)));
+					rayLast = rayFirst;
+				}
+				while (rayFirst > _iDetFrom && afterFirst(rayFirst - 1)) --rayFirst;
+				while (rayFirst < _iDetTo && !afterFirst(rayFirst)) ++rayFirst;
+				while (rayLast < _iDetTo - 1 && beforeLast(rayLast + 1)) ++rayLast;
+				while (rayLast >= _iDetFrom && !beforeLast(rayLast)) --rayLast;
+
+				const int iVolumeIndex = row * colCount + col;
+				if (rayFirst > rayLast) continue;
+
+				// POLICY: PIXEL PRIOR + ADD + POSTERIOR
+				if (!p.pixelPrior(iVolumeIndex)) continue;
+				for (iDetector = rayFirst; iDetector <= rayLast; ++iDetector) {
+					if (!allRaysActive && !bRayActive[iDetector]) continue;
+					float32 offset = abs(fRayPos[iDetector] + shift - float32(target)) * invBlobExtent;
+					int index = (int)(offset*m_iBlobSampleCount+0.5f);
+					p.addWeight(iRayOffset + iDetector, iVolumeIndex, fBlobValues[min(index,m_iBlobSampleCount-1)]);
+				}
+				p.pixelPosterior(iVolumeIndex);
+			}
+		}
+
+		// POLICY: RAY POSTERIOR
+		for (iDetector = _iDetFrom; iDetector < _iDetTo; ++iDetector)
+			if (bRayActive[iDetector])
+				p.rayPosterior(iRayOffset + iDetector);
+
+	} // end loop angles
+
+	if (dynamic_cast<CParallelProjectionGeometry2D*>(m_pProjectionGeometry.get()))
+		delete pVecProjectionGeometry;
+}
@@ -31,21 +31,28 @@ template <typename Policy>
 void CParallelBeamDistanceDrivenProjector2D::project(Policy& p)
 {
 	projectBlock_internal(0, m_pProjectionGeometry->getProjectionAngleCount(),
-		                  0, m_pProjectionGeometry->getDetectorCount(), p);
+		                  0, m_pProjectionGeometry->getDetectorCount(), SProjectionSubset(), p);
 }
 
 template <typename Policy>
 void CParallelBeamDistanceDrivenProjector2D::projectSingleProjection(int _iProjection, Policy& p)
 {
 	projectBlock_internal(_iProjection, _iProjection + 1,
-	                      0, m_pProjectionGeometry->getDetectorCount(), p);
+	                      0, m_pProjectionGeometry->getDetectorCount(), SProjectionSubset(), p);
 }
 
 template <typename Policy>
 void CParallelBeamDistanceDrivenProjector2D::projectSingleRay(int _iProjection, int _iDetector, Policy& p)
 {
 	projectBlock_internal(_iProjection, _iProjection + 1,
-	                      _iDetector, _iDetector + 1, p);
+	                      _iDetector, _iDetector + 1, SProjectionSubset(), p);
+}
+
+template <typename Policy>
+void CParallelBeamDistanceDrivenProjector2D::projectSubset(int _iProjFrom, int _iProjTo, const SProjectionSubset& _subset, Policy& p)
+{
+	projectBlock_internal(_iProjFrom, _iProjTo,
+	                      0, m_pProjectionGeometry->getDetectorCount(), _subset, p);
 }
 
 
@@ -53,7 +60,7 @@ void CParallelBeamDistanceDrivenProjector2D::projectSingleRay(int _iProjection,
 
 
 template <typename Policy>
-void CParallelBeamDistanceDrivenProjector2D::projectBlock_internal(int _iProjFrom, int _iProjTo, int _iDetFrom, int _iDetTo, Policy& p)
+void CParallelBeamDistanceDrivenProjector2D::projectBlock_internal(int _iProjFrom, int _iProjTo, int _iDetFrom, int _iDetTo, const SProjectionSubset& _subset, Policy& p)
 {
 	// get vector geometry
 	const CParallelVecProjectionGeometry2D* pVecProjectionGeometry;
@@ -71,6 +78,12 @@ void CParallelBeamDistanceDrivenProjector2D::projectBlock_internal(int _iProjFro
 	const int colCount = m_pVolumeGeometry->getGridColCount();
 	const int rowCount = m_pVolumeGeometry->getGridRowCount();
 
+	// window of the volume to traverse
+	const int rowFrom = _subset.iRowFrom;
+	const int rowTo = std::min(rowCount, _subset.iRowTo);
+	const int colFrom = _subset.iColFrom;
+	const int colTo = std::min(colCount, _subset.iColTo);
+
 	// Performance note:
 	// This is not a very well optimized version of the distance driven
 	// projector. The CPU projector model in ASTRA requires ray-driven iteration,
@@ -90,7 +103,7 @@ void CParallelBeamDistanceDrivenProjector2D::projectBlock_internal(int _iProjFro
 		                         sqrt(proj->fRayX * proj->fRayX + proj->fRayY * proj->fRayY);
 
 		// loop detectors
-		for (int iDetector = _iDetFrom; iDetector < _iDetTo; ++iDetector) {
+		for (int iDetector = _subset.firstRay(iAngle, _iDetFrom); iDetector < _iDetTo; iDetector = _subset.firstRay(iAngle, iDetector + 1)) {
 
 			const int iRayIndex = iAngle * m_pProjectionGeometry->getDetectorCount() + iDetector;
 
@@ -108,10 +121,11 @@ void CParallelBeamDistanceDrivenProjector2D::projectBlock_internal(int _iProjFro
 				const float32 deltad = 0.5f * fabs((proj->fDetUX - proj->fDetUY * RxOverRy) * inv_pixelLengthX);
 
 				// calculate c for row 0
-				float32 c = (Dx + (Ey - Dy)*RxOverRy - Ex) * inv_pixelLengthX + 0.5f;
+				const float32 c0 = (Dx + (Ey - Dy)*RxOverRy - Ex) * inv_pixelLengthX + 0.5f;
 
-				// loop rows
-				for (int row = 0; row < rowCount; ++row, c+= deltac) {
+				// loop rows of the window
+				for (int row = rowFrom; row < rowTo; ++row) {
+					float32 c = c0 + row * deltac;
 
 					// horizontal extent of ray in center of this row:
 					// [ c - deltad , c + deltad ]
@@ -125,6 +139,8 @@ void CParallelBeamDistanceDrivenProjector2D::projectBlock_internal(int _iProjFro
 
 					if (colBegin >= colCount || colEnd <= 0)
 						continue;
+					if (!_subset.rowOverlaps(row, colBegin, colEnd - 1))
+						continue;
 
 					int iVolumeIndex = row * colCount + colBegin;
 					if (colBegin + 1 == colEnd) {
@@ -165,10 +181,11 @@ void CParallelBeamDistanceDrivenProjector2D::projectBlock_internal(int _iProjFro
 				const float32 deltad = 0.5f * fabs((proj->fDetUY - proj->fDetUX * RyOverRx) * inv_pixelLengthY);
 
 				// calculate r for col 0
-				float32 r = -(Dy + (Ex - Dx)*RyOverRx - Ey) * inv_pixelLengthY + 0.5f;
+				const float32 r0 = -(Dy + (Ex - Dx)*RyOverRx - Ey) * inv_pixelLengthY + 0.5f;
 
-				// loop columns
-				for (int col = 0; col < colCount; ++col, r+= deltar) {
+				// loop columns of the window
+				for (int col = colFrom; col < colTo; ++col) {
+					float32 r = r0 + col * deltar;
 
 					// vertical extent of ray in center of this column:
 					// [ r - deltad , r + deltad ]
@@ -178,6 +195,8 @@ void CParallelBeamDistanceDrivenProjector2D::projectBlock_internal(int _iProjFro
 
 					if (rowBegin >= rowCount || rowEnd <= 0)
 						continue;
+					if (!_subset.colOverlaps(col, rowBegin, rowEnd - 1))
+						continue;
 
 					int iVolumeIndex = rowBegin * colCount + col;
 					if (rowBegin + 1 == rowEnd) {
@@ -31,21 +31,28 @@ template <typename Policy>
 void CParallelBeamLinearKernelProjector2D::project(Policy& p)
 {
 	projectBlock_internal(0, m_pProjectionGeometry->getProjectionAngleCount(),
-		                  0, m_pProjectionGeometry->getDetectorCount(), p);
+		                  0, m_pProjectionGeometry->getDetectorCount(), SProjectionSubset(), p);
 }
 
 template <typename Policy>
 void CParallelBeamLinearKernelProjector2D::projectSingleProjection(int _iProjection, Policy& p)
 {
 	projectBlock_internal(_iProjection, _iProjection + 1,
-	                      0, m_pProjectionGeometry->getDetectorCount(), p);
+	                      0, m_pProjectionGeometry->getDetectorCount(), SProjectionSubset(), p);
 }
 
 template <typename Policy>
 void CParallelBeamLinearKernelProjector2D::projectSingleRay(int _iProjection, int _iDetector, Policy& p)
 {
 	projectBlock_internal(_iProjection, _iProjection + 1,
-	                      _iDetector, _iDetector + 1, p);
+	                      _iDetector, _iDetector + 1, SProjectionSubset(), p);
+}
+
+template <typename Policy>
+void CParallelBeamLinearKernelProjector2D::projectSubset(int _iProjFrom, int _iProjTo, const SProjectionSubset& _subset, Policy& p)
+{
+	projectBlock_internal(_iProjFrom, _iProjTo,
+	                      0, m_pProjectionGeometry->getDetectorCount(), _subset, p);
 }
 
 
@@ -126,7 +133,7 @@ void CParallelBeamLinearKernelProjector2D::projectSingleRay(int _iProjection, in
       W_(rayIndex,volIndex+colcount) = offset * lengthPerCol
 */
 template <typename Policy>
-void CParallelBeamLinearKernelProjector2D::projectBlock_internal(int _iProjFrom, int _iProjTo, int _iDetFrom, int _iDetTo, Policy& p)
+void CParallelBeamLinearKernelProjector2D::projectBlock_internal(int _iProjFrom, int _iProjTo, int _iDetFrom, int _iDetTo, const SProjectionSubset& _subset, Policy& p)
 {
 	// get vector geometry
 	const CParallelVecProjectionGeometry2D* pVecProjectionGeometry;
@@ -144,6 +151,12 @@ void CParallelBeamLinearKernelProjector2D::projectBlock_internal(int _iProjFrom,
 	const int colCount = m_pVolumeGeometry->getGridColCount();
 	const int rowCount = m_pVolumeGeometry->getGridRowCount();
 
+	// window of the volume to traverse
+	const int rowFrom = _subset.iRowFrom;
+	const int rowTo = std::min(rowCount, _subset.iRowTo);
+	const int colFrom = _subset.iColFrom;
+	const int colTo = std::min(colCount, _subset.iColTo);
+
 	// loop angles
 	for (int iAngle = _iProjFrom; iAngle < _iProjTo; ++iAngle) {
 
@@ -160,7 +173,7 @@ void CParallelBeamLinearKernelProjector2D::projectBlock_internal(int _iProjFrom,
 		Ey = m_pVolumeGeometry->getWindowMaxY() - pixelLengthY*0.5f;
 
 		// loop detectors
-		for (iDetector = _iDetFrom; iDetector < _iDetTo; ++iDetector) {
+		for (iDetector = _subset.firstRay(iAngle, _iDetFrom); iDetector < _iDetTo; iDetector = _subset.firstRay(iAngle, iDetector + 1)) {
 			
 			iRayIndex = iAngle * m_pProjectionGeometry->getDetectorCount() + iDetector;
 
@@ -180,13 +193,15 @@ void CParallelBeamLinearKernelProjector2D::projectBlock_internal(int _iProjFrom,
 				deltac = -pixelLengthY * RxOverRy * inv_pixelLengthX;
 
 				// calculate c for row 0
-				c = (Dx + (Ey - Dy)*RxOverRy - Ex) * inv_pixelLengthX;
+				const float32 c0 = (Dx + (Ey - Dy)*RxOverRy - Ex) * inv_pixelLengthX;
 
-				// loop rows
-				for (row = 0; row < rowCount; ++row, c += deltac) {
+				// loop rows of the window
+				for (row = rowFrom; row < rowTo; ++row) {
+					c = c0 + row * deltac;
 
 					col = int(floor(c));
 					if (col < -1 || col >= colCount) { if (!isin) continue; else break; }
+					if (!_subset.rowOverlaps(row, col, col + 1)) continue;
 					offset = c - float32(col);
 
 					iVolumeIndex = row * colCount + col;
@@ -207,13 +222,15 @@ void CParallelBeamLinearKernelProjector2D::projectBlock_internal(int _iProjFrom,
 				deltar = -pixelLengthX * RyOverRx * inv_pixelLengthY;
 
 				// calculate r for col 0
-				r = -(Dy + (Ex - Dx)*RyOverRx - Ey) * inv_pixelLengthY;
+				const float32 r0 = -(Dy + (Ex - Dx)*RyOverRx - Ey) * inv_pixelLengthY;
 
-				// loop columns
-				for (col = 0; col < colCount; ++col, r += deltar) {
+				// loop columns of the window
+				for (col = colFrom; col < colTo; ++col) {
+					r = r0 + col * deltar;
 
 					row = int(floor(r));
 					if (row < -1 || row >= rowCount) { if (!isin) continue; else break; }
+					if (!_subset.colOverlaps(col, row, row + 1)) continue;
 					offset = r - float32(row);
 
 					iVolumeIndex = row * colCount + col;
@@ -29,21 +29,28 @@ template <typename Policy>
 void CParallelBeamStripKernelProjector2D::project(Policy& p)
 {
 	projectBlock_internal(0, m_pProjectionGeometry->getProjectionAngleCount(),
-		                  0, m_pProjectionGeometry->getDetectorCount(), p);
+		                  0, m_pProjectionGeometry->getDetectorCount(), SProjectionSubset(), p);
 }
 
 template <typename Policy>
 void CParallelBeamStripKernelProjector2D::projectSingleProjection(int _iProjection, Policy& p)
 {
 	projectBlock_internal(_iProjection, _iProjection + 1,
-	                      0, m_pProjectionGeometry->getDetectorCount(), p);
+	                      0, m_pProjectionGeometry->getDetectorCount(), SProjectionSubset(), p);
 }
 
 template <typename Policy>
 void CParallelBeamStripKernelProjector2D::projectSingleRay(int _iProjection, int _iDetector, Policy& p)
 {
 	projectBlock_internal(_iProjection, _iProjection + 1,
-	                      _iDetector, _iDetector + 1, p);
+	                      _iDetector, _iDetector + 1, SProjectionSubset(), p);
+}
+
+template <typename Policy>
+void CParallelBeamStripKernelProjector2D::projectSubset(int _iProjFrom, int _iProjTo, const SProjectionSubset& _subset, Policy& p)
+{
+	projectBlock_internal(_iProjFrom, _iProjTo,
+	                      0, m_pProjectionGeometry->getDetectorCount(), _subset, p);
 }
 
 //----------------------------------------------------------------------------------------
@@ -111,7 +118,7 @@ void CParallelBeamStripKernelProjector2D::projectSingleRay(int _iProjection, int
        T <= offset:       Kernel = PixelArea
 */
 template <typename Policy>
-void CParallelBeamStripKernelProjector2D::projectBlock_internal(int _iProjFrom, int _iProjTo, int _iDetFrom, int _iDetTo, Policy& p)
+void CParallelBeamStripKernelProjector2D::projectBlock_internal(int _iProjFrom, int _iProjTo, int _iDetFrom, int _iDetTo, const SProjectionSubset& _subset, Policy& p)
 {
 	// get vector geometry
 	const CParallelVecProjectionGeometry2D* pVecProjectionGeometry;
@@ -131,6 +138,12 @@ void CParallelBeamStripKernelProjector2D::projectBlock_internal(int _iProjFrom,
 	const int rowCount = m_pVolumeGeometry->getGridRowCount();
 	const int detCount = pVecProjectionGeometry->getDetectorCount();
 
+	// window of the volume to traverse
+	const int rowFrom = _subset.iRowFrom;
+	const int rowTo = std::min(rowCount, _subset.iRowTo);
+	const int colFrom = _subset.iColFrom;
+	const int colTo = std::min(colCount, _subset.iColTo);
+
 	// loop angles
 	for (int iAngle = _iProjFrom; iAngle < _iProjTo; ++iAngle) {
 
@@ -152,7 +165,7 @@ void CParallelBeamStripKernelProjector2D::projectBlock_internal(int _iProjFrom,
 		Ey = m_pVolumeGeometry->getWindowMaxY() - pixelLengthY*0.5f;
 
 		// loop detectors
-		for (iDetector = _iDetFrom; iDetector < _iDetTo; ++iDetector) {
+		for (iDetector = _subset.firstRay(iAngle, _iDetFrom); iDetector < _iDetTo; iDetector = _subset.firstRay(iAngle, iDetector + 1)) {
 			
 			iRayIndex = iAngle * detCount + iDetector;
 
@@ -174,23 +187,26 @@ void CParallelBeamStripKernelProjector2D::projectBlock_internal(int _iProjFrom,
 				invTminS = 1.0f / (T-S);
 
 				// calculate cL and cR for row 0
-				cL = (DLx + (Ey - DLy)*RxOverRy - Ex) * inv_pixelLengthX;
-				cR = (DRx + (Ey - DRy)*RxOverRy - Ex) * inv_pixelLengthX;
+				float32 cL0 = (DLx + (Ey - DLy)*RxOverRy - Ex) * inv_pixelLengthX;
+				float32 cR0 = (DRx + (Ey - DRy)*RxOverRy - Ex) * inv_pixelLengthX;
 
-				if (cR < cL) {
-					float32 tmp = cL;
-					cL = cR;
-					cR = tmp;
+				if (cR0 < cL0) {
+					float32 tmp = cL0;
+					cL0 = cR0;
+					cR0 = tmp;
 				}
 
-				// loop rows
-				for (row = 0; row < rowCount; ++row, cL += deltac, cR += deltac) {
+				// loop rows of the window
+				for (row = rowFrom; row < rowTo; ++row) {
+					cL = cL0 + row * deltac;
+					cR = cR0 + row * deltac;
 
 					col_left = int(cL-0.5f+S);
 					col_right = int(cR+1.5-S);
 
 					if (col_left < 0) col_left = 0; 
 					if (col_right > colCount-1) col_right = colCount-1; 
+					_subset.clipRow(row, col_left, col_right);
 
 					float32 tmp = float32(col_left);
 					offsetL = cL - tmp;
@@ -232,24 +248,27 @@ void CParallelBeamStripKernelProjector2D::projectBlock_internal(int _iProjFrom,
 				T = 0.5f + 0.5f*fabs(RyOverRx);
 				invTminS = 1.0f / (T-S);
 
-				// calculate rL and rR for row 0
-				rL = -(DLy + (Ex - DLx)*RyOverRx - Ey) * inv_pixelLengthY;
-				rR = -(DRy + (Ex - DRx)*RyOverRx - Ey) * inv_pixelLengthY;
+				// calculate rL and rR for col 0
+				float32 rL0 = -(DLy + (Ex - DLx)*RyOverRx - Ey) * inv_pixelLengthY;
+				float32 rR0 = -(DRy + (Ex - DRx)*RyOverRx - Ey) * inv_pixelLengthY;
 
-				if (rR < rL) {
-					float32 tmp = rL;
-					rL = rR;
-					rR = tmp;
+				if (rR0 < rL0) {
+					float32 tmp = rL0;
+					rL0 = rR0;
+					rR0 = tmp;
 				}
 
-				// loop columns
-				for (col = 0; col < colCount; ++col, rL += deltar, rR += deltar) {
+				// loop columns of the window
+				for (col = colFrom; col < colTo; ++col) {
+					rL = rL0 + col * deltar;
+					rR = rR0 + col * deltar;
 
 					row_top = int(rL-0.5f+S);
 					row_bottom = int(rR+1.5-S);
 
 					if (row_top < 0) row_top = 0; 
 					if (row_bottom > rowCount-1) row_bottom = rowCount-1; 
+					_subset.clipCol(col, row_top, row_bottom);
 
 					float32 tmp = float32(row_top);
 					offsetL = rL - tmp;
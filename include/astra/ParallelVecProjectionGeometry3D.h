@@ -128,6 +128,13 @@ public:
 
 	const SPar3DProjection* getProjectionVectors() const { return &m_ProjectionAngles[0]; }
 
+	virtual void getProjectedBBoxSingleAngle(int iAngle,
+	                                         double fXMin, double fXMax,
+	                                         double fYMin, double fYMax,
+	                                         double fZMin, double fZMax,
+	                                         double &fUMin, double &fUMax,
+	                                         double &fVMin, double &fVMax) const override;
+
 	virtual void projectPoint(double fX, double fY, double fZ,
 	                          int iAngleIndex,
 	                          double &fU, double &fV) const override;
@@ -0,0 +1,166 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+#ifndef _INC_ASTRA_PROFILER
+#define _INC_ASTRA_PROFILER
+
+#include "Globals.h"
+#include "Singleton.h"
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace astra {
+
+/**
+ * Accumulated statistics of one profiled phase.
+ */
+struct SProfilePhaseStats {
+	std::string sName;
+	size_t iCalls = 0;      ///< number of times the phase was entered
+	double fSeconds = 0.0;  ///< total wall clock time spent in the phase
+	size_t iRays = 0;       ///< rays traced
+	size_t iNonZeros = 0;   ///< projection weights applied
+	size_t iBytes = 0;      ///< bytes processed or copied
+};
+
+/**
+ * Counters of one named phase, such as "project/line" or "algorithm/SIRT".
+ * Phases are created by the CProfiler and live as long as the library.
+ */
+class _AstraExport CProfilePhase {
+public:
+	CProfilePhase(const std::string &_sName) : m_sName(_sName) { reset(); }
+
+	const std::string &getName() const { return m_sName; }
+
+	void addCall(std::chrono::steady_clock::duration _time) {
+		m_iCalls.fetch_add(1, std::memory_order_relaxed);
+		m_iNanoseconds.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(_time).count(), std::memory_order_relaxed);
+	}
+	void addRays(size_t _iCount) { m_iRays.fetch_add(_iCount, std::memory_order_relaxed); }
+	void addNonZeros(size_t _iCount) { m_iNonZeros.fetch_add(_iCount, std::memory_order_relaxed); }
+	void addBytes(size_t _iCount) { m_iBytes.fetch_add(_iCount, std::memory_order_relaxed); }
+
+	SProfilePhaseStats getStats() const;
+	void reset();
+
+private:
+	std::string m_sName;
+	std::atomic<size_t> m_iCalls;
+	std::atomic<long long> m_iNanoseconds;
+	std::atomic<size_t> m_iRays;
+	std::atomic<size_t> m_iNonZeros;
+	std::atomic<size_t> m_iBytes;
+};
+
+/**
+ * Process-wide registry of profiled phases.
+ *
+ * Profiling is disabled by default. While disabled, the instrumentation in
+ * the algorithms, projectors, filters and data operations only costs a
+ * relaxed atomic load per instrumented call; no clocks are read and no
+ * counters are updated.
+ */
+class _AstraExport CProfiler : public Singleton<CProfiler> {
+public:
+	CProfiler();
+	~CProfiler();
+
+	/** Enable or disable collection of statistics. Disabling keeps the
+	 *  statistics collected so far.
+	 */
+	void setEnabled(bool _bEnabled) { s_bEnabled.store(_bEnabled, std::memory_order_relaxed); }
+	static bool isEnabled() { return s_bEnabled.load(std::memory_order_relaxed); }
+
+	/** Get the phase with the given name, creating it if necessary. The
+	 *  returned reference stays valid for the lifetime of the library.
+	 */
+	CProfilePhase &getPhase(const std::string &_sName);
+
+	/** Statistics of all phases that have been entered at least once,
+	 *  sorted by name.
+	 */
+	std::vector<SProfilePhaseStats> getStats() const;
+
+	/** Zero the statistics of all phases.
+	 */
+	void resetStats();
+
+private:
+	static std::atomic<bool> s_bEnabled;
+
+	mutable std::mutex m_mutex;
+	std::map<std::string, std::unique_ptr<CProfilePhase> > m_phases;
+};
+
+/**
+ * Times the enclosing scope as one call of a phase, if profiling is enabled
+ * when the scope is entered. Counters added through the scope are dropped
+ * when profiling is disabled.
+ */
+class CProfileScope {
+public:
+	CProfileScope(CProfilePhase &_phase)
+		: m_pPhase(CProfiler::isEnabled() ? &_phase : nullptr)
+	{
+		if (m_pPhase)
+			m_start = std::chrono::steady_clock::now();
+	}
+	~CProfileScope() {
+		if (m_pPhase)
+			m_pPhase->addCall(std::chrono::steady_clock::now() - m_start);
+	}
+
+	CProfileScope(const CProfileScope&) = delete;
+	CProfileScope &operator=(const CProfileScope&) = delete;
+
+	bool isActive() const { return m_pPhase != nullptr; }
+	void addRays(size_t _iCount) { if (m_pPhase) m_pPhase->addRays(_iCount); }
+	void addNonZeros(size_t _iCount) { if (m_pPhase) m_pPhase->addNonZeros(_iCount); }
+	void addBytes(size_t _iCount) { if (m_pPhase) m_pPhase->addBytes(_iCount); }
+
+private:
+	CProfilePhase *m_pPhase;
+	std::chrono::steady_clock::time_point m_start;
+};
+
+/** Declare a CProfileScope named _var for the phase with the given constant
+ *  name. The phase lookup is done only once per call site.
+ */
+#define ASTRA_PROFILE_SCOPE(_var, _name) \
+	static astra::CProfilePhase &_var##_phase = astra::CProfiler::getSingleton().getPhase(_name); \
+	astra::CProfileScope _var(_var##_phase)
+
+} // end namespace
+
+#endif
@@ -31,6 +31,7 @@ along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
 #include "Globals.h"
 #include "Config.h"
 #include "Vector3D.h"
+#include "GeometryCache.h"
 
 #include <string>
 #include <cmath>
@@ -221,6 +222,12 @@ public:
 	 */
 	virtual bool isOfType(const std::string& _sType) const = 0;
 
+	/** Get the cache of data derived from this geometry, such as converted
+	 *  projection vectors. It is cleared whenever the geometry is
+	 *  (re)initialized.
+	 */
+	CGeometryCache& getCache() const { return m_cache; }
+
 private:
 	//< For Config unused argument checking
 	ConfigCheckData* configCheckData;
@@ -228,6 +235,9 @@ private:
 
 protected:
 	virtual bool initializeAngles(const Config& _cfg);
+
+	//< Cache of derived data, see getCache()
+	mutable CGeometryCache m_cache;
 };
 
 
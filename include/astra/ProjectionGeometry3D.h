@@ -31,6 +31,7 @@ along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
 #include "Globals.h"
 #include "Config.h"
 #include "Vector3D.h"
+#include "GeometryCache.h"
 
 #include <string>
 #include <cmath>
@@ -333,12 +334,21 @@ public:
 	 */
 	virtual bool isOfType(const std::string& _sType) const = 0;
 
+	/** Get the cache of data derived from this geometry, such as converted
+	 *  projection vectors. It is cleared whenever the geometry is
+	 *  (re)initialized.
+	 */
+	CGeometryCache& getCache() const { return m_cache; }
+
 	//< For Config unused argument checking
 	ConfigCheckData* configCheckData;
 	friend class ConfigReader<CProjectionGeometry3D>;
 
 protected:
 	virtual bool initializeAngles(const Config& _cfg);
+
+	//< Cache of derived data, see getCache()
+	mutable CGeometryCache m_cache;
 };
 
 
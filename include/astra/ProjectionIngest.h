@@ -0,0 +1,83 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+#ifndef _INC_ASTRA_PROJECTIONINGEST
+#define _INC_ASTRA_PROJECTIONINGEST
+
+#include "Globals.h"
+#include "Data3D.h"
+
+#include <cstdint>
+
+namespace astra {
+
+/** Options for ingestRawProjections()
+ */
+struct _AstraExport SRawIngestOptions {
+	/** Convert the corrected transmission to line integrals with -log */
+	bool bLog;
+	/** The transmission is clamped to at least this value before the log,
+	 *  so that noise does not produce infinities. Dead pixels (flat <= dark)
+	 *  always have transmission 1, i.e. a line integral of 0. */
+	float32 fMinTransmission;
+
+	SRawIngestOptions() : bLog(true), fMinTransmission(1e-6f) { }
+};
+
+/**
+ * Convert raw detector counts to flat/dark corrected line integrals
+ * -log((raw - dark) / (flat - dark)), stored in a projection data object.
+ *
+ * The raw data is a stack of _iAngleCount projections of
+ * (detector rows x detector columns) pixels each, in the order in which
+ * detectors deliver them. The projections are written to the angles
+ * [_iFirstAngle, _iFirstAngle + _iAngleCount) of _pData, so a scan can be
+ * ingested a block of angles at a time.
+ *
+ * The conversion, flat/dark correction, log and reordering to the ASTRA
+ * (row, angle, column) layout happen in a single threaded pass, without
+ * temporary float copies of the raw data.
+ *
+ * @param _pRaw raw counts (uint16_t, uint32_t or float32)
+ * @param _iFirstAngle index of the first projection in _pData
+ * @param _iAngleCount number of projections in _pRaw
+ * @param _pfFlat flat field (rows x columns), or nullptr for none
+ * @param _pfDark dark field (rows x columns), or nullptr for none
+ * @param _pData float32 host memory projection data
+ * @param _options options
+ * @return false if the angle range does not fit in _pData, or _pData is
+ *         not float32 host memory
+ */
+template<typename T>
+_AstraExport bool ingestRawProjections(const T *_pRaw, int _iFirstAngle, int _iAngleCount,
+                                       const float32 *_pfFlat, const float32 *_pfDark,
+                                       CFloat32ProjectionData3D *_pData,
+                                       const SRawIngestOptions &_options = SRawIngestOptions());
+
+} // end namespace astra
+
+#endif
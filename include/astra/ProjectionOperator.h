@@ -0,0 +1,141 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+#ifndef _INC_ASTRA_PROJECTIONOPERATOR
+#define _INC_ASTRA_PROJECTIONOPERATOR
+
+#include "Globals.h"
+#include "Data.h"
+
+#include <memory>
+#include <mutex>
+
+namespace astra {
+
+class CAlgorithm;
+class CProjector2D;
+class CProjector3D;
+class CData2D;
+class CData3D;
+class CFloat32VolumeData2D;
+class CFloat32ProjectionData2D;
+class CFloat32VolumeData3D;
+class CFloat32ProjectionData3D;
+
+enum EProjectionOperation {
+	OPERATION_FP,
+	OPERATION_BP
+};
+
+/**
+ * Persistent forward or backprojection operator for a 2D projector.
+ *
+ * The data objects and algorithm are set up once, so that repeated
+ * applications (for example as the matrix-vector product of an iterative
+ * solver) avoid the cost of creating them from a configuration each time.
+ * The projector must outlive the operator.
+ */
+class _AstraExport CProjectionOperator2D {
+public:
+	CProjectionOperator2D(CProjector2D *_pProjector, EProjectionOperation _eOperation);
+	~CProjectionOperator2D();
+
+	bool isInitialized() const { return m_bIsInitialized; }
+
+	EProjectionOperation getOperation() const { return m_eOperation; }
+	CProjector2D *getProjector() const { return m_pProjector; }
+
+	/** Number of elements of the input and output buffers.
+	 */
+	size_t getInputSize() const;
+	size_t getOutputSize() const;
+
+	/** Apply the operator to float32 host buffers in the (row-major) shape
+	 *  of the volume and projection geometry of the projector. The output
+	 *  is overwritten.
+	 */
+	bool apply(const float32 *_pfIn, float32 *_pfOut);
+
+	/** Apply the operator to existing data objects, such as data linked to
+	 *  external (DLPack) buffers. Their shapes must match the geometries of
+	 *  the projector.
+	 */
+	bool apply(const CData2D *_pIn, CData2D *_pOut);
+
+private:
+	CAlgorithm *createAlgorithm(CFloat32VolumeData2D *_pVolume, CFloat32ProjectionData2D *_pProjection) const;
+
+	CProjector2D *m_pProjector;
+	EProjectionOperation m_eOperation;
+	bool m_bIsInitialized;
+
+	CDataMemoryView<float32> *m_pVolumeStorage;
+	CDataMemoryView<float32> *m_pProjectionStorage;
+	std::unique_ptr<CFloat32VolumeData2D> m_pVolume;
+	std::unique_ptr<CFloat32ProjectionData2D> m_pProjection;
+	std::unique_ptr<CAlgorithm> m_pAlgorithm;
+
+	// The persistent data objects are shared by all calls to apply()
+	std::mutex m_mutex;
+};
+
+/**
+ * Persistent forward or backprojection operator for a 3D projector.
+ * See CProjectionOperator2D. Requires CUDA.
+ */
+class _AstraExport CProjectionOperator3D {
+public:
+	CProjectionOperator3D(CProjector3D *_pProjector, EProjectionOperation _eOperation);
+	~CProjectionOperator3D();
+
+	bool isInitialized() const { return m_bIsInitialized; }
+
+	EProjectionOperation getOperation() const { return m_eOperation; }
+	CProjector3D *getProjector() const { return m_pProjector; }
+
+	size_t getInputSize() const;
+	size_t getOutputSize() const;
+
+	bool apply(const float32 *_pfIn, float32 *_pfOut);
+	bool apply(const CData3D *_pIn, CData3D *_pOut);
+
+private:
+	CProjector3D *m_pProjector;
+	EProjectionOperation m_eOperation;
+	bool m_bIsInitialized;
+
+	CDataMemoryView<float32> *m_pVolumeStorage;
+	CDataMemoryView<float32> *m_pProjectionStorage;
+	std::unique_ptr<CFloat32VolumeData3D> m_pVolume;
+	std::unique_ptr<CFloat32ProjectionData3D> m_pProjection;
+
+	std::mutex m_mutex;
+};
+
+} // end namespace
+
+#endif
@@ -0,0 +1,170 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+#ifndef _INC_ASTRA_PROJECTIONSTREAMLOADER
+#define _INC_ASTRA_PROJECTIONSTREAMLOADER
+
+#include "Globals.h"
+#include "Data3D.h"
+#include "ProjectionIngest.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace astra {
+
+/**
+ * Loads a stack of projection images from disk into a float32 projection
+ * data object, using background threads.
+ *
+ * The projections can be stored in raw binary files or in uncompressed
+ * (possibly multi-page) TIFF files with 16 or 32 bit unsigned integer or
+ * 32 bit float samples. The projections are divided evenly over the files
+ * in the given order, so this can be one file per projection, or a single
+ * file containing all of them.
+ *
+ * The projections are read in blocks of consecutive angles, in order, by
+ * several threads. As soon as a block has been stored in the data object,
+ * it is reported to the ready callback (from a loader thread), and then
+ * waitForAngles() for those angles returns. Processing can so start on the
+ * first angles while the rest is still being read.
+ *
+ * If setCorrection() is used, blocks are flat/dark corrected and converted
+ * to line integrals while they are stored (see ingestRawProjections).
+ * Otherwise the samples are converted to float32 unchanged.
+ *
+ * The data object must not be deleted or resized while loading.
+ */
+class _AstraExport CProjectionStreamLoader {
+public:
+	enum EFormat { FORMAT_RAW, FORMAT_TIFF };
+	enum ESampleType { SAMPLE_UINT16, SAMPLE_UINT32, SAMPLE_FLOAT32 };
+
+	/** Called from a loader thread when a block of angles is done */
+	typedef void (*ReadyCallback)(void *_pContext, int _iFirstAngle, int _iAngleCount, bool _bSuccess);
+
+	CProjectionStreamLoader();
+
+	/** Aborts and waits for the loader threads */
+	~CProjectionStreamLoader();
+
+	/** Set the files to read, in order. */
+	void setFiles(const std::vector<std::string> &_files, EFormat _eFormat);
+
+	/** Set the sample type of raw files, and the number of bytes to skip at
+	 *  the start of each file. Raw files are little endian.
+	 */
+	void setRawLayout(ESampleType _eType, size_t _iHeaderBytes = 0);
+
+	/** Enable flat/dark correction. The flat and dark fields are
+	 *  (detector rows x detector columns) images, or empty for none.
+	 */
+	void setCorrection(const std::vector<float32> &_flat, const std::vector<float32> &_dark, const SRawIngestOptions &_options);
+
+	/** Set the number of angles per block (default 16). Returns false
+	 *  (and changes nothing) once start() has been called.
+	 */
+	bool setBlockSize(int _iBlockSize);
+
+	/** Set the number of loader threads (default 2) */
+	void setThreadCount(int _iThreads) { m_iThreads = _iThreads; }
+
+	void setReadyCallback(ReadyCallback _pCallback, void *_pContext) { m_pCallback = _pCallback; m_pCallbackContext = _pContext; }
+
+	/** Check the files and start loading into _pData in the background.
+	 *  Returns false if the files can not be loaded into _pData.
+	 */
+	bool start(CFloat32ProjectionData3D *_pData);
+
+	/** Wait until the given angles have been loaded. Returns false if
+	 *  loading (some of) them failed or was aborted.
+	 */
+	bool waitForAngles(int _iFirstAngle, int _iAngleCount);
+
+	/** Check if an angle has been loaded */
+	bool isAngleReady(int _iAngle) const;
+
+	/** Wait until loading is done. Returns false if it failed. */
+	bool wait();
+
+	/** Stop loading as soon as possible. Blocks that were not loaded fail. */
+	void abort();
+
+	/** Get the first error that occurred */
+	std::string getError() const;
+
+private:
+	enum EBlockState { BLOCK_PENDING, BLOCK_READY, BLOCK_FAILED };
+
+	void workerMain();
+	bool loadBlock(int _iBlock, std::vector<char> &_buffer);
+	bool readProjection(int _iAngle, char *_pDst);
+	void setError(const std::string &_sError);
+	void finishBlock(int _iBlock, bool _bSuccess);
+	void joinThreads();
+
+	std::vector<std::string> m_files;
+	EFormat m_eFormat;
+	ESampleType m_eType;
+	size_t m_iHeaderBytes;
+
+	bool m_bCorrect;
+	std::vector<float32> m_flat;
+	std::vector<float32> m_dark;
+	SRawIngestOptions m_options;
+
+	int m_iBlockSize;
+	int m_iThreads;
+	ReadyCallback m_pCallback;
+	void *m_pCallbackContext;
+
+	CFloat32ProjectionData3D *m_pData;
+	int m_iAngles;
+	int m_iRows;
+	int m_iCols;
+	int m_iProjectionsPerFile;
+	std::vector<std::vector<uint32_t> > m_pageOffsets; // per TIFF file
+
+	std::vector<std::thread> m_threads;
+	std::atomic<int> m_iNextBlock;
+	std::atomic<bool> m_bAbort;
+	int m_iRunning;
+
+	mutable std::mutex m_mutex;
+	std::condition_variable m_blockDone;
+	std::vector<EBlockState> m_blockState;
+	std::string m_sError;
+};
+
+} // end namespace astra
+
+#endif
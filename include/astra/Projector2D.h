@@ -28,9 +28,11 @@ along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
 #ifndef INC_ASTRA_PROJECTOR2D
 #define INC_ASTRA_PROJECTOR2D
 
+#include <algorithm>
 #include <cmath>
 #include <vector>
 #include <memory>
+#include <limits>
 
 #include "Globals.h"
 #include "Config.h"
@@ -44,6 +46,65 @@ namespace astra
 
 class CSparseMatrix;
 
+/**
+ * Rays and pixels a policy-based projection has to visit, as precomputed
+ * from sinogram and reconstruction masks by CMaskIndex. A default constructed
+ * subset visits everything.
+ *
+ * Active rays are linked per angle: piNextRay[iAngle * iDetectorCount + d] is
+ * the first active detector >= d (or iDetectorCount). Active pixels are
+ * bounded by a window of rows and columns, and per row (and per column) by
+ * the span [from, to) of active columns (rows).
+ *
+ * Skipping pixels outside the spans is only valid if the policy ignores
+ * them anyway, i.e. if it includes the reconstruction mask the subset was
+ * built from. The same holds for rays and the sinogram mask.
+ */
+struct SProjectionSubset {
+	int iDetectorCount = 0;
+	const int *piNextRay = nullptr;
+
+	int iRowFrom = 0;
+	int iRowTo = std::numeric_limits<int>::max();
+	int iColFrom = 0;
+	int iColTo = std::numeric_limits<int>::max();
+	const int *piRowSpans = nullptr;
+	const int *piColSpans = nullptr;
+
+	/** First active detector of angle _iAngle at or after _iDetector. */
+	int firstRay(int _iAngle, int _iDetector) const {
+		if (!piNextRay || _iDetector >= iDetectorCount)
+			return _iDetector;
+		return piNextRay[_iAngle * iDetectorCount + _iDetector];
+	}
+
+	/** Does row _iRow contain active pixels in columns [_iColFrom, _iColTo]? */
+	bool rowOverlaps(int _iRow, int _iColFrom, int _iColTo) const {
+		return !piRowSpans || (piRowSpans[2*_iRow] <= _iColTo && _iColFrom < piRowSpans[2*_iRow+1]);
+	}
+
+	/** Does column _iCol contain active pixels in rows [_iRowFrom, _iRowTo]? */
+	bool colOverlaps(int _iCol, int _iRowFrom, int _iRowTo) const {
+		return !piColSpans || (piColSpans[2*_iCol] <= _iRowTo && _iRowFrom < piColSpans[2*_iCol+1]);
+	}
+
+	/** Narrow the columns [_iColFrom, _iColTo] to the active pixels of row _iRow. */
+	void clipRow(int _iRow, int& _iColFrom, int& _iColTo) const {
+		if (piRowSpans) {
+			_iColFrom = std::max(_iColFrom, piRowSpans[2*_iRow]);
+			_iColTo = std::min(_iColTo, piRowSpans[2*_iRow+1] - 1);
+		}
+	}
+
+	/** Narrow the rows [_iRowFrom, _iRowTo] to the active pixels of column _iCol. */
+	void clipCol(int _iCol, int& _iRowFrom, int& _iRowTo) const {
+		if (piColSpans) {
+			_iRowFrom = std::max(_iRowFrom, piColSpans[2*_iCol]);
+			_iRowTo = std::min(_iRowTo, piColSpans[2*_iCol+1] - 1);
+		}
+	}
+};
+
 
 /** This is a base interface class for a two-dimensional projector.  Each subclass should at least 
  * implement the core projection functions computeProjectionRayWeights and projectPoint.   For 
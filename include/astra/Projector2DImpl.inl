@@ -33,5 +33,6 @@ along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
 #include "ParallelBeamBlobKernelProjector2D.inl"
 #include "FanFlatBeamStripKernelProjector2D.inl"
 #include "FanFlatBeamLineKernelProjector2D.inl"
+#include "FanFlatBeamDistanceDrivenProjector2D.inl"
 #include "SparseMatrixProjector2D.inl"
 
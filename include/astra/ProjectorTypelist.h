@@ -39,6 +39,7 @@ along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
 #include "ParallelBeamBlobKernelProjector2D.h"
 #include "ParallelBeamStripKernelProjector2D.h"
 #include "SparseMatrixProjector2D.h"
+#include "FanFlatBeamDistanceDrivenProjector2D.h"
 #include "FanFlatBeamLineKernelProjector2D.h"
 #include "FanFlatBeamStripKernelProjector2D.h"
 #include "CudaProjector2D.h"
@@ -49,6 +50,7 @@ typedef TypeList<
 #ifdef ASTRA_CUDA
 				CCudaProjector2D,
 #endif
+				CFanFlatBeamDistanceDrivenProjector2D,
 				CFanFlatBeamLineKernelProjector2D,
 				CFanFlatBeamStripKernelProjector2D,
 				CParallelBeamDistanceDrivenProjector2D,
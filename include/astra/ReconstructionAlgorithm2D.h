@@ -35,6 +35,9 @@ along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
 
 #include "Projector2D.h"
 #include "Data2D.h"
+#include "MaskIndex.h"
+
+#include <memory>
 
 
 namespace astra {
@@ -48,6 +51,8 @@ namespace astra {
  * \astra_xml_item{ReconstructionDataId, integer, Identifier of a volume data object as it is stored in the DataManager.}
  * \astra_xml_item_option{ReconstructionMaskId, integer, not used, Identifier of a volume data object that acts as a reconstruction mask. 1 = reconstruct on this pixel. 0 = don't reconstruct on this pixel.}
  * \astra_xml_item_option{SinogramMaskId, integer, not used, Identifier of a projection data object that acts as a projection mask. 1 = reconstruct using this ray. 0 = don't use this ray while reconstructing.}
+ * \astra_xml_item_option{VolumeWindow, integer array, not used, Sub-window [RowFrom RowTo ColFrom ColTo) of the volume to reconstruct. Pixels outside it are kept fixed, and only enter through the forward projection of this exterior. Only supported by some algorithms.}
+ * \astra_xml_item_option{ExteriorProjectionDataId, integer, not used, Identifier of a projection data object containing the forward projection of the exterior of VolumeWindow. If not given it is computed from the reconstruction data on the first run (and again after reset()), so later changes to the exterior of the reconstruction data are not seen. Changes to the sinogram are used by the next run.}
  * \astra_xml_item_option{UseMinConstraint, bool, false, Use minimum value constraint.}
  * \astra_xml_item_option{MinConstraintValue, float, 0, Minimum constraint value.}
  * \astra_xml_item_option{UseMaxConstraint, bool, false, Use maximum value constraint.}
@@ -72,6 +77,18 @@ public:
 	 */
 	virtual bool initialize(const Config& _cfg);
 
+	/** Initialize the algorithm with a config object, using the given data
+	 * objects instead of ProjectionDataId and ReconstructionDataId.
+	 *
+	 * @param _cfg Configuration Object
+	 * @param _pSinogram		ProjectionData2D object containing the sinogram data.
+	 * @param _pReconstruction	VolumeData2D object for storing the reconstructed volume.
+	 * @return initialization successful?
+	 */
+	bool initialize(const Config& _cfg,
+	                CFloat32ProjectionData2D* _pSinogram,
+	                CFloat32VolumeData2D* _pReconstruction);
+
 	/** Initialize class.
 	 *
 	 * @param _pProjector		Projector Object.
@@ -107,6 +124,16 @@ public:
 	 */
 	void setSinogramMask(CFloat32ProjectionData2D* _pMask, bool _bEnable = true);
 
+	/** Only reconstruct a sub-window of the volume. The pixels outside the
+	 * window keep their values, and enter the reconstruction only through
+	 * their (fixed) forward projection.
+	 *
+	 * @param _window Volume window to reconstruct
+	 * @param _pExteriorProjection Forward projection of the exterior of the window,
+	 *                             or nullptr to compute it from the reconstruction on the first run
+	 */
+	void setVolumeWindow(const SVolumeWindow& _window, CFloat32ProjectionData2D* _pExteriorProjection = nullptr);
+
 	/** Get projector object
 	 *
 	 * @return projector
@@ -137,6 +164,13 @@ public:
 	 */
 	virtual bool run(int _iNrIterations = 0) = 0;
 
+	/** Forget the state kept between calls to run(), such as the search
+	 * direction of CGLS or the position in the projection order of ART and
+	 * SART. The next run() starts a new reconstruction from the current
+	 * contents of the sinogram and reconstruction data objects.
+	 */
+	virtual void reset();
+
 	/** Get the norm of the residual image.
 	 *  Only a few algorithms support this method.
 	 *
@@ -153,6 +187,48 @@ protected:
 	 */
 	bool _check();
 
+	/** Read ProjectionDataId and ReconstructionDataId from the configuration,
+	 *  unless the data objects were passed to initialize() directly.
+	 *
+	 * @return success
+	 */
+	bool readDataIds(ConfigReader<CAlgorithm>& CR);
+
+	/** Get an index of the active rays and pixels of the enabled masks,
+	 *  for use by the data projectors of run(). It is rebuilt on every call,
+	 *  except with a volume window, where it is kept with the window mask.
+	 *
+	 * @return mask index owned by the algorithm, or nullptr if no masks are enabled
+	 */
+	const CMaskIndex* getMaskIndex();
+
+	/** If a volume window is set, build the mask of its pixels and (optionally)
+	 *  subtract the forward projection of the exterior from the sinogram.
+	 *  The mask and the projection of the exterior are made on the first call
+	 *  only, but the subtraction is redone every time to pick up changes to
+	 *  the sinogram.
+	 *
+	 * @param _bSubtractExterior also compute getEffectiveSinogram()
+	 */
+	void prepareVolumeWindow(bool _bSubtractExterior = true);
+
+	/** Reconstruction mask for the data projector policies: the window mask
+	 *  if a volume window is set, else the fixed reconstruction mask if enabled.
+	 *
+	 * @return mask, or nullptr if none
+	 */
+	CFloat32VolumeData2D* getEffectiveReconstructionMask() const;
+
+	/** Sinogram to reconstruct from: the sinogram minus the projection of the
+	 *  exterior if a volume window is set, else the sinogram itself.
+	 */
+	CFloat32ProjectionData2D* getEffectiveSinogram() const;
+
+	/** Pixels of the reconstruction the algorithm updates: the volume window
+	 *  if set, else the whole volume.
+	 */
+	SVolumeWindow getUpdateWindow() const;
+
 	//< Projector object.
 	CProjector2D* m_pProjector;
 	//< ProjectionData2D object containing the sinogram.
@@ -179,9 +255,27 @@ protected:
 	//< Use the fixed reconstruction mask?
 	bool m_bUseSinogramMask;
 
+	//< Reconstruct only a sub-window of the volume?
+	bool m_bUseVolumeWindow;
+	//< Sub-window of the volume to reconstruct
+	SVolumeWindow m_volumeWindow;
+	//< Given forward projection of the exterior of the window (not owned)
+	CFloat32ProjectionData2D* m_pExteriorProjection;
+	//< Mask of the window pixels, intersected with the reconstruction mask
+	std::unique_ptr<CFloat32VolumeData2D> m_pWindowMask;
+	//< Computed forward projection of the exterior of the window
+	std::unique_ptr<CFloat32ProjectionData2D> m_pExteriorSinogram;
+	//< Sinogram minus the forward projection of the exterior
+	std::unique_ptr<CFloat32ProjectionData2D> m_pWindowSinogram;
+	//< Index of the masks, see getMaskIndex()
+	std::unique_ptr<CMaskIndex> m_pMaskIndex;
+
 
 	//< Specify if initialize/check should check for a valid Projector
 	virtual bool requiresProjector() const { return true; }
+
+	//< Specify if the algorithm can reconstruct a volume window
+	virtual bool supportsVolumeWindow() const { return false; }
 };
 
 } // end namespace
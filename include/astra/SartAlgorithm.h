@@ -178,6 +178,10 @@ public:
 	 */
 	virtual bool run(int _iNrIterations = 1);
 
+	/** Forget the state kept between calls to run().
+	 */
+	virtual void reset();
+
 	/** Get a description of the class.
 	 *
 	 * @return description string
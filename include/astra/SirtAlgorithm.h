@@ -56,6 +56,8 @@ namespace astra {
  * \astra_xml_item{ReconstructionDataId, integer, Identifier of a volume data object as it is stored in the DataManager.}
  * \astra_xml_item_option{ReconstructionMaskId, integer, not used, Identifier of a volume data object that acts as a reconstruction mask. 1 = reconstruct on this pixel. 0 = don't reconstruct on this pixel.}
  * \astra_xml_item_option{SinogramMaskId, integer, not used, Identifier of a projection data object that acts as a projection mask. 1 = reconstruct using this ray. 0 = don't use this ray while reconstructing.}
+ * \astra_xml_item_option{VolumeWindow, integer array, not used, Sub-window [RowFrom RowTo ColFrom ColTo) of the volume to reconstruct. Pixels outside it are kept fixed.}
+ * \astra_xml_item_option{ExteriorProjectionDataId, integer, not used, Identifier of a projection data object containing the forward projection of the exterior of VolumeWindow. Computed on the first run if not given.}
  * \astra_xml_item_option{UseMinConstraint, bool, false, Use minimum value constraint.}
  * \astra_xml_item_option{MinConstraintValue, float, 0, Minimum constraint value.}
  * \astra_xml_item_option{UseMaxConstraint, bool, false, Use maximum value constraint.}
@@ -112,6 +114,9 @@ protected:
 	 */
 	virtual bool _check();
 
+	//< Volume windows are supported
+	virtual bool supportsVolumeWindow() const { return true; }
+
 	/** Temporary data object for storing the total ray lengths
 	 */
 	CFloat32ProjectionData2D* m_pTotalRayLength;
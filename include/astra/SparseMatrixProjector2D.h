@@ -151,6 +151,18 @@ public:
 	template <typename Policy>
 	void projectSingleRay(int _iProjection, int _iDetector, Policy& _policy);
 
+	/** Policy-based projection of a range of projections, restricted to the
+	 * rays of a (mask) subset. The matrix rows only hold the pixels on
+	 * each ray, so the pixel window of the subset is not used.
+	 *
+	 * @param _iProjFrom First projection (inclusive)
+	 * @param _iProjTo Last projection (exclusive)
+	 * @param _subset Rays and pixels to visit
+	 * @param _policy Policy object.  Should contain prior, addWeight and posterior function.
+	 */
+	template <typename Policy>
+	void projectSubset(int _iProjFrom, int _iProjTo, const SProjectionSubset& _subset, Policy& _policy);
+
 	/** Policy-based voxel-projection of a single pixel.  This function will calculate 
 	 * each non-zero projection weight and use this value for a task provided by the policy object.
 	 *
@@ -51,6 +51,20 @@ void CSparseMatrixProjector2D::projectSingleProjection(int _iProjection, Policy&
 }
 
 
+//----------------------------------------------------------------------------------------
+// PROJECT SUBSET
+template <typename Policy>
+void CSparseMatrixProjector2D::projectSubset(int _iProjFrom, int _iProjTo, const SProjectionSubset& _subset, Policy& p)
+{
+	ASTRA_ASSERT(m_bIsInitialized);
+
+	const int iDetCount = m_pProjectionGeometry->getDetectorCount();
+	for (int i = _iProjFrom; i < _iProjTo; ++i)
+		for (int j = _subset.firstRay(i, 0); j < iDetCount; j = _subset.firstRay(i, j + 1))
+			projectSingleRay(i, j, p);
+}
+
+
 //----------------------------------------------------------------------------------------
 // PROJECT SINGLE RAY
 template <typename Policy>
@@ -0,0 +1,152 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+#ifndef _INC_ASTRA_THREADPOOL
+#define _INC_ASTRA_THREADPOOL
+
+#include "Globals.h"
+#include "Singleton.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace astra {
+
+/**
+ * Library-wide pool of CPU worker threads, used by the CPU projectors,
+ * data operations and filters.
+ *
+ * Work is submitted as a range that is split into chunks. The chunks are
+ * distributed over per-worker queues; idle workers steal chunks from the
+ * queues of other workers, and the submitting thread helps until the whole
+ * range is done.
+ *
+ * Nested use is serialized: a parallelFor() from inside a chunk that is
+ * already running on the pool (for example projections inside a batch of
+ * slice reconstructions) runs directly on the calling thread, so that
+ * batch-level and projector-level parallelism do not oversubscribe.
+ *
+ * The default number of threads is taken from the ASTRA_NUM_THREADS or
+ * OMP_NUM_THREADS environment variables, or else the number of hardware
+ * threads. Setting ASTRA_PROC_BIND or OMP_PROC_BIND to a value other than
+ * "false" pins worker threads to cores (Linux only).
+ */
+class _AstraExport CThreadPool : public Singleton<CThreadPool> {
+public:
+	CThreadPool();
+	~CThreadPool();
+
+	/** Set the total number of threads used by parallelFor(), including
+	 *  the calling thread. 0 restores the default. Waits for the work that
+	 *  is running on the pool. Ignored from inside a parallelFor().
+	 */
+	void setThreadCount(int _iThreads);
+	int getThreadCount() const;
+
+	/** Enable or disable pinning of worker thread i to core i. Like
+	 *  setThreadCount(), this restarts the worker threads.
+	 */
+	void setAffinity(bool _bPin);
+	bool getAffinity() const;
+
+	/** Call _func(from, to) for consecutive subranges covering
+	 *  [_iBegin, _iEnd), on the pool. Subranges have at least _iGrain
+	 *  elements (except possibly the last one). Returns when the whole
+	 *  range is done. The first exception thrown by _func is rethrown.
+	 */
+	void parallelFor(int _iBegin, int _iEnd, int _iGrain, const std::function<void(int, int)> &_func);
+
+	/** True if the calling thread is running a chunk of a parallelFor.
+	 */
+	static bool inParallelRegion();
+
+private:
+	struct SJob;
+	struct STask {
+		SJob *pJob;
+		int iFrom;
+		int iTo;
+	};
+	struct SQueue {
+		std::mutex mutex;
+		std::deque<STask> tasks;
+	};
+
+	void startWorkers();
+	void stopWorkers(std::unique_lock<std::mutex> &_lock);
+	void workerMain(int _iIndex);
+	bool popTask(int _iIndex, STask &_task);
+	void runTask(const STask &_task);
+
+	int m_iThreads;
+	bool m_bPin;
+
+	std::vector<std::thread> m_workers;
+	std::vector<std::unique_ptr<SQueue>> m_queues;
+	size_t m_iNextQueue;
+
+	// Protects starting/stopping workers and the wake-up condition
+	mutable std::mutex m_mutex;
+	std::condition_variable m_wakeup;
+	std::atomic<size_t> m_iPending;
+	bool m_bStop;
+
+	// Workers are only stopped when no parallelFor() is running on them,
+	// and new ones wait until the workers being stopped have been joined
+	std::condition_variable m_lifecycle;
+	int m_iActiveJobs;
+	bool m_bStopping;
+};
+
+/** Set/get the number of CPU threads used by ASTRA. See CThreadPool.
+ */
+_AstraExport void setNumThreads(int _iThreads);
+_AstraExport int getNumThreads();
+
+/** Convenience wrapper for CThreadPool::parallelFor() on the global pool.
+ */
+_AstraExport void parallelFor(int _iBegin, int _iEnd, int _iGrain, const std::function<void(int, int)> &_func);
+
+/** Minimum number of elements per thread for element-wise loops over data.
+ */
+static const size_t ELEMENTWISE_GRAIN = 1 << 16;
+
+/** Call _func(from, to) for consecutive subranges of [0, _iSize) of at
+ *  least _iGrain elements, on the global pool. For element-wise loops over
+ *  (possibly large) data.
+ */
+_AstraExport void parallelForBlocks(size_t _iSize, size_t _iGrain, const std::function<void(size_t, size_t)> &_func);
+
+} // end namespace
+
+#endif
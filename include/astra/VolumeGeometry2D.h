@@ -603,6 +603,24 @@ inline float CVolumeGeometry2D::coordYToRowF(float32 _fCoordY) const
 }
 
 
+/**
+ * Rectangular sub-window of a volume, in pixel indices: rows
+ * [iRowFrom, iRowTo) and columns [iColFrom, iColTo).
+ */
+struct SVolumeWindow {
+	int iRowFrom = 0;
+	int iRowTo = 0;
+	int iColFrom = 0;
+	int iColTo = 0;
+
+	/** Is the window non-empty and inside the volume? */
+	bool isValid(const CVolumeGeometry2D &_volGeom) const {
+		return iRowFrom >= 0 && iRowFrom < iRowTo && iRowTo <= _volGeom.getGridRowCount() &&
+		       iColFrom >= 0 && iColFrom < iColTo && iColTo <= _volGeom.getGridColCount();
+	}
+};
+
+
 
 } // end namespace astra
 
@@ -52,6 +52,7 @@ private:
 	virtual bool getInt(const std::string &name, int &iValue) const;
 	virtual bool getFloat(const std::string &name, float &fValue) const;
 	virtual bool getDoubleArray(const std::string &name, std::vector<double> &values) const;
+	virtual bool getDoubleArray(const std::string &name, ConfigNumericalArray &values) const;
 	virtual bool getIntArray(const std::string &name, std::vector<int> &values) const;
 	virtual bool getString(const std::string &name, std::string &sValue) const;
 
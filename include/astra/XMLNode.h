@@ -130,6 +130,25 @@ public:
 	std::vector<float32> getContentNumericalArray() const;
 	std::vector<double> getContentNumericalArrayDouble() const;
 
+	/** Does this node hold a binary numerical array? Numerical lists and
+	 *  matrices are stored in binary form, and are only converted to text
+	 *  when the node or its document is printed.
+	 *
+	 * @return true if the content is a binary array
+	 */
+	bool isContentBinaryArray() const;
+
+	/** Get direct access to the binary numerical array in this node.
+	 *  The data is owned by the document, and stays valid until the content
+	 *  of the node is changed or the document is printed or destroyed.
+	 *
+	 * @param _pfData pointer to the data, in C order
+	 * @param _iWidth number of columns (or elements, for a list)
+	 * @param _iHeight number of rows, or 0 for a list
+	 * @return false if the content of this node is not a binary array
+	 */
+	bool getContentBinaryArray(const double *&_pfData, int &_iWidth, int &_iHeight) const;
+
 
 
 	/** Does this node contain an attribute with a certain name?
@@ -258,21 +277,21 @@ public:
 	 */ 
 	void setContent(float32 _fValue);
 
-	/** Add a list of numerical data to the node
+	/** Add a list of numerical data to the node, as a binary array
 	 *
 	 * @param _pfList data
 	 * @param _iSize number of elements in the list
 	 */ 
 	void setContent(const float32* _pfList, int _iSize);
 
-	/** Add a list of numerical data to the node
+	/** Add a list of numerical data to the node, as a binary array
 	 *
 	 * @param _pfList data
 	 * @param _iSize number of elements in the list
 	 */
 	void setContent(const double* _pfList, int _iSize);
 
-	/** Add a (2D) matrix of numerical data to the node
+	/** Add a (2D) matrix of numerical data to the node, as a binary array
 	 *
 	 * @param _pfMatrix data
 	 * @param _iWidth width of the matrix
@@ -281,7 +300,7 @@ public:
 	 */
 	void setContent(const float32* _pfMatrix, int _iWidth, int _iHeight, bool transposed);
 
-	/** Add a (2D) matrix of numerical data to the node
+	/** Add a (2D) matrix of numerical data to the node, as a binary array
 	 *
 	 * @param _pfMatrix data
 	 * @param _iWidth width of the matrix
@@ -329,6 +348,11 @@ public:
 
 protected:
 
+	/** Convert all binary arrays in the subtree of n to text, in preparation
+	 *  for printing.
+	 */
+	static void convertBinaryArraysToText(rapidxml::xml_node<char>* n);
+
 	/** Private Constructor.
 	 * 
 	 * @param n rapidxml node
@@ -92,19 +92,27 @@ void astra_mex_set_gpu_index(int nlhs, mxArray* plhs[], int nrhs, const mxArray*
 {
 #ifdef ASTRA_CUDA
 	bool usage = false;
-	if (nrhs != 2 && nrhs != 4) {
+	if (nrhs < 2 || nrhs % 2 != 0) {
 		usage = true;
 	}
 
 	astra::SGPUParams params;
 	params.memory = 0;
 
-	if (!usage && nrhs >= 4) {
-		std::string s = mexToString(prhs[2]);
-		if (s != "memory") {
-			usage = true;
+	for (int i = 2; !usage && i + 1 < nrhs; i += 2) {
+		std::string s = mexToString(prhs[i]);
+		if (s == "memory") {
+			params.memory = (size_t)mxGetScalar(prhs[i+1]);
+		} else if (s == "split") {
+			std::string split = mexToString(prhs[i+1]);
+			if (split == "linear")
+				params.splitStrategy = astra::SPLIT_LINEAR;
+			else if (split == "cost")
+				params.splitStrategy = astra::SPLIT_COST;
+			else
+				usage = true;
 		} else {
-			params.memory = (size_t)mxGetScalar(prhs[3]);
+			usage = true;
 		}
 	}
 
@@ -128,7 +136,7 @@ void astra_mex_set_gpu_index(int nlhs, mxArray* plhs[], int nrhs, const mxArray*
 	}
 
 	if (usage) {
-		mexPrintf("Usage: astra_mex('set_gpu_index', index/indices [, 'memory', memory])");
+		mexPrintf("Usage: astra_mex('set_gpu_index', index/indices [, 'memory', memory] [, 'split', 'linear'/'cost'])");
 	}
 #endif
 }
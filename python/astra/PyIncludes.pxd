@@ -94,6 +94,12 @@ cdef extern from "astra/Data3D.h" namespace "astra::CData3D":
         THREEVOLUME "astra::CData3D::VOLUME"
 
 
+cdef extern from "astra/Float16.h" namespace "astra":
+    cdef cppclass float16:
+        pass
+    cdef cppclass bfloat16:
+        pass
+
 cdef extern from "astra/Data2D.h" namespace "astra":
     cdef cppclass CData2D:
         bool isInitialized()
@@ -102,6 +108,10 @@ cdef extern from "astra/Data2D.h" namespace "astra":
         int getHeight()
         bool isFloat32Memory()
         float32 *getFloat32Memory()
+        bool isFloat16Memory()
+        float16 *getFloat16Memory()
+        bool isBFloat16Memory()
+        bfloat16 *getBFloat16Memory()
         CDataStorage *getStorage()
         TWOEDataType getType()
 
@@ -187,6 +197,11 @@ cdef extern from "astra/Data3D.h" namespace "astra":
         int getDepth()
         bool isFloat32Memory()
         float32* getFloat32Memory()
+        bool isFloat16Memory()
+        float16 *getFloat16Memory()
+        bool isBFloat16Memory()
+        bfloat16 *getBFloat16Memory()
+        bool isReadOnly()
         CDataStorage *getStorage()
         THREEEDataType getType()
 
@@ -207,6 +222,7 @@ cdef extern from "astra/VolumeGeometry3D.h" namespace "astra":
         int getGridColCount()
         int getGridRowCount()
         int getGridSliceCount()
+        size_t getGridTotCount()
 
 cdef extern from "astra/ProjectionGeometry3D.h" namespace "astra":
     cdef cppclass CProjectionGeometry3D:
@@ -216,6 +232,7 @@ cdef extern from "astra/ProjectionGeometry3D.h" namespace "astra":
         int getProjectionCount()
         int getDetectorColCount()
         int getDetectorRowCount()
+        int getDetectorTotCount()
         void getProjectedBBox(double, double, double, double, double, double, double&, double&, double&, double&)
         void projectPoint(double, double, double, int, double&, double&)
 
@@ -228,6 +245,18 @@ cdef extern from "astra/Data3D.h" namespace "astra":
     cdef cppclass CDataMemory[T](CDataStorage):
         CDataMemory(size_t)
 
+cdef extern from "astra/DataMemoryMapped.h" namespace "astra":
+    cdef enum EMemoryMapMode "astra::EMemoryMapMode":
+        MEMMAP_READONLY "astra::MEMMAP_READONLY"
+        MEMMAP_READWRITE "astra::MEMMAP_READWRITE"
+        MEMMAP_COPYONWRITE "astra::MEMMAP_COPYONWRITE"
+        MEMMAP_CREATE "astra::MEMMAP_CREATE"
+    cdef cppclass CDataMemoryMapped[T](CDataMemory[T]):
+        CDataMemoryMapped(const string&, size_t, EMemoryMapMode, size_t)
+        bool isMapped()
+        bool isReadOnly()
+        bool flush()
+
 cdef extern from "astra/Data3D.h" namespace "astra":
     cdef cppclass CFloat32VolumeData3D(CData3D):
         CFloat32VolumeData3D(unique_ptr[CVolumeGeometry3D]&&, CDataStorage*)
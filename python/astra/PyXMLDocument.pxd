@@ -55,6 +55,7 @@ cdef extern from "astra/XMLNode.h" namespace "astra":
         void setContent(double*, int, int, bool)
         void setContent(double*, int)
         string getContent()
+        bool getContentBinaryArray(const double *&, int &, int &)
         bool hasAttribute(string)
 
 cdef extern from "astra/XMLDocument.h" namespace "astra":
@@ -48,8 +48,10 @@ from . import projector3d
 
 from .astra import (
     get_gpu_info,
+    get_num_threads,
     has_feature,
     set_gpu_index,
+    set_num_threads,
     use_cuda
 )
 from .creators import (
@@ -24,6 +24,8 @@
 # -----------------------------------------------------------------------
 
 from . import algorithm_c as a
+from . import projector
+import numpy as np
 
 def create(config):
     """Create algorithm object.
@@ -46,6 +48,46 @@ def run(i, iterations=1):
     """
     return a.run(i,iterations)
 
+def run_batch(config, sinograms, volumes=None, iterations=1, num_threads=0, progress=None):
+    """Reconstruct a stack of independent 2D slices with a single algorithm
+    configuration, on multiple threads.
+
+    The projector is shared by all slices. Every thread creates one
+    algorithm from ``config`` and reuses it for all of its slices. The data
+    ids in ``config`` are ignored.
+
+    :param config: Options of a 2D reconstruction algorithm, including a
+        ProjectorId.
+    :type config: :class:`dict`
+    :param sinograms: Stack of sinograms of shape (slices, angles, detectors),
+        such as 3D parallel beam projection data. Any array or DLPack tensor
+        that numpy can convert.
+    :param volumes: Output stack of shape (slices, rows, columns). Its
+        contents are the initial reconstruction. If None, a stack of zeros
+        is allocated.
+    :type volumes: :class:`numpy.ndarray`
+    :param iterations: Number of iterations to run for every slice.
+    :type iterations: :class:`int`
+    :param num_threads: Number of worker threads, or 0 for one per core.
+        With 0 and fewer slices than cores, the slices are reconstructed one
+        at a time, with multi-threaded projections.
+    :type num_threads: :class:`int`
+    :param progress: Called as ``progress(slice, success)`` after each slice,
+        from a worker thread. Raising an exception stops the batch.
+    :returns: :class:`numpy.ndarray` -- the reconstructed volumes.
+
+    """
+    if not isinstance(sinograms, np.ndarray) and hasattr(sinograms, '__dlpack__'):
+        sinograms = np.from_dlpack(sinograms)
+    if volumes is None:
+        vg = projector.volume_geometry(config['ProjectorId'])
+        volumes = np.zeros((np.shape(sinograms)[0], vg['GridRowCount'], vg['GridColCount']), dtype=np.float32)
+    out = volumes
+    if not isinstance(volumes, np.ndarray) and hasattr(volumes, '__dlpack__'):
+        out = np.from_dlpack(volumes)
+    a.run_batch(config, sinograms, out, iterations, num_threads, progress)
+    return volumes
+
 def get_res_norm(i):
     """Get residual norm of algorithm.
     
@@ -57,6 +99,17 @@ def get_res_norm(i):
     
     return a.get_res_norm(i)
     
+def get_data_operation_result(i):
+    """Get the result of a DataOperation algorithm computing a ``dot`` or
+    ``norm``.
+
+    :param i: ID of object.
+    :type i: :class:`int`
+    :returns: :class:`float` -- The result of the last run.
+
+    """
+    return a.get_data_operation_result(i)
+
 def delete(ids):
     """Delete an algorithm object.
     
@@ -27,6 +27,7 @@
 from __future__ import print_function
 
 from .PyIncludes cimport *
+from libcpp.vector cimport vector
 
 from . cimport PyAlgorithmManager
 from .PyAlgorithmManager cimport CAlgorithmManager
@@ -42,6 +43,10 @@ from .utils import wrap_from_bytes
 
 from .log import AstraError
 
+import numpy as np
+cimport numpy as cnp
+cnp.import_array()
+
 cdef CAlgorithmManager * manAlg = <CAlgorithmManager * >PyAlgorithmManager.getSingletonPtr()
 
 cdef extern from *:
@@ -52,9 +57,36 @@ cdef extern from "src/PythonPluginAlgorithm.h" namespace "astra":
     cdef cppclass CPluginAlgorithm:
         object getInstance()
 
+cdef extern from "astra/BatchReconstruction2D.h" namespace "astra":
+    cdef enum EState "astra::SBatchSliceStatus::EState":
+        SLICE_PENDING "astra::SBatchSliceStatus::SLICE_PENDING"
+        SLICE_DONE "astra::SBatchSliceStatus::SLICE_DONE"
+        SLICE_FAILED "astra::SBatchSliceStatus::SLICE_FAILED"
+    cdef cppclass SBatchSliceStatus:
+        EState eState
+        string sError
+    ctypedef void (*ProgressCallback "astra::CBatchReconstruction2D::ProgressCallback")(void *, int, bool) noexcept
+    cdef cppclass CBatchReconstruction2D:
+        CBatchReconstruction2D()
+        bool initialize(XMLConfig *) nogil
+        void setThreadCount(int)
+        void setProgressCallback(ProgressCallback, void *)
+        void abort() nogil
+        size_t getSinogramSize()
+        size_t getSliceSize()
+        bool run(const float32 *, float32 *, int, int) nogil
+        const vector[SBatchSliceStatus] &getSliceStatus()
+
 cdef extern from *:
     CPluginAlgorithm * dynamic_cast_PluginAlg "dynamic_cast<astra::CPluginAlgorithm*>" (CAlgorithm * )
 
+cdef extern from "astra/DataOperationAlgorithm.h" namespace "astra":
+    cdef cppclass CDataOperationAlgorithm:
+        double getResult()
+
+cdef extern from *:
+    CDataOperationAlgorithm * dynamic_cast_DataOpAlg "dynamic_cast<astra::CDataOperationAlgorithm*>" (CAlgorithm * )
+
 
 def create(config):
     cdef XMLConfig * cfg = utils.dictToConfig(b'Algorithm', config)
@@ -89,6 +121,77 @@ def run(i, iterations=0):
         raise AstraError("Algorithm failed", append_log=True)
 
 
+cdef class _BatchProgress:
+    cdef CBatchReconstruction2D *batch
+    cdef object callback
+    cdef object exception
+
+cdef void _batchProgressCallback(void *ctx, int iSlice, bool bSuccess) noexcept with gil:
+    cdef _BatchProgress state = <_BatchProgress>ctx
+    if state.exception is not None:
+        return
+    try:
+        state.callback(iSlice, bSuccess)
+    except BaseException as e:
+        # Stop starting new slices, and re-raise from run_batch
+        state.exception = e
+        state.batch.abort()
+
+
+def run_batch(config, sinograms, volumes, iterations, num_threads, progress):
+    cdef XMLConfig * cfg = utils.dictToConfig(b'Algorithm', config)
+    cdef CBatchReconstruction2D batch
+    cdef _BatchProgress state = _BatchProgress()
+    cdef cnp.ndarray sino
+    cdef cnp.ndarray vol
+    cdef const float32 *pfSino
+    cdef float32 *pfVol
+    cdef int its = iterations
+    cdef int nslices
+    cdef bool ret
+    cdef const vector[SBatchSliceStatus] *status
+    try:
+        if not batch.initialize(cfg):
+            raise AstraError("Unable to initialize batch reconstruction", append_log=True)
+
+        # The input may be any array or DLPack tensor; the output is
+        # written back if it is not a contiguous float32 array itself
+        sino = np.ascontiguousarray(sinograms, dtype=np.float32)
+        nslices = sino.shape[0] if sino.ndim == 3 else -1
+        if nslices < 0 or <size_t>sino.size != nslices * batch.getSinogramSize():
+            raise ValueError("The sinograms must have shape (slices, angles, detectors) matching the projector")
+        direct = isinstance(volumes, np.ndarray) and volumes.dtype == np.float32 and volumes.flags['C_CONTIGUOUS'] and volumes.flags['WRITEABLE']
+        vol = volumes if direct else np.ascontiguousarray(volumes, dtype=np.float32)
+        if vol.ndim != 3 or vol.shape[0] != nslices or <size_t>vol.size != nslices * batch.getSliceSize():
+            raise ValueError("The volumes must have shape (slices, rows, columns) matching the projector and sinograms")
+
+        batch.setThreadCount(num_threads)
+        if progress is not None:
+            state.batch = &batch
+            state.callback = progress
+            batch.setProgressCallback(_batchProgressCallback, <void*>state)
+
+        pfSino = <const float32*>cnp.PyArray_DATA(sino)
+        pfVol = <float32*>cnp.PyArray_DATA(vol)
+        with nogil:
+            ret = batch.run(pfSino, pfVol, nslices, its)
+    finally:
+        del cfg
+
+    if state.exception is not None:
+        raise state.exception
+
+    if not direct:
+        volumes[...] = vol
+
+    if not ret:
+        status = &batch.getSliceStatus()
+        failed = [ (i, wrap_from_bytes(status[0][i].sError)) for i in range(status.size()) if status[0][i].eState == SLICE_FAILED ]
+        if failed:
+            raise AstraError("Batch reconstruction failed for slices " + ", ".join(str(i) for i, _ in failed) + ": " + failed[0][1], append_log=True)
+        raise AstraError("Batch reconstruction aborted")
+
+
 def get_res_norm(i):
     cdef CReconstructionAlgorithm2D * pAlg2D
     cdef CReconstructionAlgorithm3D * pAlg3D
@@ -125,6 +228,16 @@ def get_plugin_object(algorithm_id):
     return pluginAlg.getInstance()
 
 
+def get_data_operation_result(algorithm_id):
+    cdef CAlgorithm *alg
+    cdef CDataOperationAlgorithm *dataOpAlg
+    alg = getAlg(algorithm_id)
+    dataOpAlg = dynamic_cast_DataOpAlg(alg)
+    if not dataOpAlg:
+        raise AstraError("Not a DataOperation algorithm")
+    return dataOpAlg.getResult()
+
+
 def clear():
     manAlg.clear()
 
@@ -37,13 +37,19 @@ def use_cuda():
     """
     return a.use_cuda()
 
-def set_gpu_index(idx, memory=0):
+def set_gpu_index(idx, memory=0, split='linear'):
     """Set default GPU index to use.
     
     :param idx: GPU index
     :type idx: :class:`int`
+    :param memory: GPU memory in bytes to use for 3D operations (0 for all)
+    :type memory: :class:`int`
+    :param split: how 3D data is split into parts that fit in GPU memory:
+                  ``'linear'`` for parts of equal size, or ``'cost'`` for
+                  parts of about equal estimated compute and transfer cost
+    :type split: :class:`str`
     """
-    a.set_gpu_index(idx, memory)
+    a.set_gpu_index(idx, memory, split)
 
 def get_gpu_info(idx=-1):
     """Get GPU info.
@@ -69,6 +75,127 @@ def has_feature(feature):
     """
     return a.has_feature(feature)
 
+def get_memory_pool_stats():
+    """Get statistics of the pool of temporary buffers used by the
+    CPU algorithms.
+
+    :returns: :class:`dict` -- with keys ``hits``, ``misses``,
+              ``evictions``, ``bytes_held`` (idle buffers kept in the pool),
+              ``bytes_in_use`` (buffers currently borrowed) and ``limit``
+    """
+    return a.get_memory_pool_stats()
+
+def reset_memory_pool_stats():
+    """Reset the hit, miss and eviction counters of the buffer pool."""
+    a.reset_memory_pool_stats()
+
+def set_memory_pool_limit(limit):
+    """Set the maximum total size of idle buffers kept in the buffer pool.
+
+    :param limit: Limit in bytes. 0 disables pooling.
+    :type limit: :class:`int`
+    """
+    a.set_memory_pool_limit(limit)
+
+def clear_memory_pool():
+    """Free all idle buffers held by the buffer pool."""
+    a.clear_memory_pool()
+
+def set_num_threads(n, pin=None):
+    """Set the number of CPU threads used by ASTRA.
+
+    The default is taken from the ``ASTRA_NUM_THREADS`` or
+    ``OMP_NUM_THREADS`` environment variables, or else the number of
+    cores. Parallel work started from inside other parallel work (such as
+    projections inside :func:`astra.algorithm.run_batch`) runs on a
+    single thread, so the levels do not oversubscribe the cores.
+
+    :param n: Number of threads, or 0 for the default.
+    :type n: :class:`int`
+    :param pin: If set, enable or disable pinning of worker threads to
+                cores (Linux only). The default is taken from the
+                ``ASTRA_PROC_BIND`` or ``OMP_PROC_BIND`` environment
+                variables.
+    :type pin: :class:`bool`
+    """
+    a.set_num_threads(n, pin)
+
+def get_num_threads():
+    """Get the number of CPU threads used by ASTRA.
+
+    :returns: :class:`int`
+    """
+    return a.get_num_threads()
+
+def set_profiling(enabled):
+    """Enable or disable collection of timing and counter statistics.
+
+    While enabled, ASTRA accumulates statistics per phase. Phases are named
+    ``algorithm/<type>`` for the CPU algorithms, ``project/<projector>``
+    for the CPU projectors (and ``project/getMatrix``), ``filter/fft`` for
+    FBP filtering, ``data/expression`` and ``data/operation`` for
+    element-wise updates of data objects, and ``cgm/job``,
+    ``cgm/transfer``, ``cgm/FP``, ``cgm/BP`` and ``cgm/FDK`` for the parts
+    of GPU 3D jobs. Phases can be nested, and the time of a phase that runs
+    on several threads at once is summed over the threads.
+
+    :param enabled: Enable or disable profiling. Disabling keeps the
+                    statistics collected so far.
+    :type enabled: :class:`bool`
+    """
+    a.set_profiling(enabled)
+
+def is_profiling():
+    """Check if profiling is enabled.
+
+    :returns: :class:`bool`
+    """
+    return a.is_profiling()
+
+def get_profile_stats():
+    """Get the statistics collected while profiling was enabled.
+
+    :returns: :class:`dict` -- mapping each phase name that has been
+              entered to a :class:`dict` with keys ``calls``, ``seconds``,
+              ``rays`` (rays traced), ``nonzeros`` (projection matrix
+              entries applied; only counted for explicit sparse matrices)
+              and ``bytes`` (bytes processed or transferred)
+    """
+    return a.get_profile_stats()
+
+def reset_profile_stats():
+    """Zero all profiling statistics."""
+    a.reset_profile_stats()
+
+def plan_gpu_job(job_type, vol_geom, proj_geom, memory=0, num_devices=1, max_block_dim=16384, split='linear'):
+    """Compute how a 3D GPU job would be split into parts, without running it.
+
+    This follows the splitting done when running a 3D FP, BP or FDK with
+    the GPU settings from :func:`set_gpu_index`, and does not need a GPU.
+
+    :param job_type: ``'FP'``, ``'BP'`` or ``'FDK'``
+    :type job_type: :class:`str`
+    :param vol_geom: 3D volume geometry
+    :type vol_geom: :class:`dict`
+    :param proj_geom: 3D projection geometry
+    :type proj_geom: :class:`dict`
+    :param memory: GPU memory in bytes (0 means 1GB)
+    :type memory: :class:`int`
+    :param num_devices: number of GPUs the parts are distributed over
+    :type num_devices: :class:`int`
+    :param max_block_dim: largest 3D texture dimension of the GPU
+    :type max_block_dim: :class:`int`
+    :param split: split strategy, as in :func:`set_gpu_index`
+    :type split: :class:`str`
+    :returns: :class:`dict` -- with keys ``outputs`` (list of output parts,
+              each a :class:`dict` with ``part``, ``upload_bytes``,
+              ``download_bytes`` and ``jobs``), ``transfer_bytes`` (total
+              host/GPU transfers) and ``cost`` (relative compute estimate).
+              Parts have a ``type``, and ``offset`` and ``shape`` in
+              (x, y, z) order for volumes and (u, angle, v) for projections.
+    """
+    return a.plan_gpu_job(job_type, vol_geom, proj_geom, memory, num_devices, max_block_dim, split)
+
 def delete(ids):
     """Delete an astra object.
     
@@ -88,3 +215,13 @@ def info(ids):
     return a.info(ids)
 
 
+
+def get_object_type(i):
+    """Get the type of an astra object.
+
+    :param i: ID of the object.
+    :type i: :class:`int`
+    :returns: :class:`str` -- such as ``'data2d'``, ``'data3d'`` or
+              ``'algorithm'``, or ``None`` if there is no such object
+    """
+    return a.get_object_type(i)
@@ -32,9 +32,12 @@ from .log import AstraError
 
 from libcpp.string cimport string
 from libcpp.vector cimport vector
+from libcpp.memory cimport unique_ptr
 from libcpp cimport bool
 from . cimport PyIndexManager
 from .PyIndexManager cimport CAstraObjectManagerBase
+from .PyIncludes cimport CVolumeGeometry3D, CProjectionGeometry3D
+from .utils cimport createVolumeGeometry3D, createProjectionGeometry3D
 
 cdef extern from "astra/Globals.h" namespace "astra":
     bool cudaEnabled()
@@ -54,11 +57,92 @@ ELSE:
     pass
 
 cdef extern from "astra/CompositeGeometryManager.h" namespace "astra":
+    cdef enum ESplitStrategy:
+        SPLIT_LINEAR
+        SPLIT_COST
     cdef cppclass SGPUParams:
         vector[int] GPUIndices
         size_t memory
+        ESplitStrategy splitStrategy
 cdef extern from "astra/CompositeGeometryManager.h" namespace "astra::CCompositeGeometryManager":
     void setGlobalGPUParams(SGPUParams&)
+    cdef enum EJobType:
+        JOB_FP
+        JOB_BP
+        JOB_FDK
+        JOB_NOP
+    cdef enum EJobMode:
+        MODE_ADD
+        MODE_SET
+    cdef cppclass SPlanPart:
+        bool bVolume
+        unsigned int offset[3]
+        size_t dims[3]
+    cdef cppclass SPlanJob:
+        EJobType eType
+        EJobMode eMode
+        SPlanPart input
+        size_t iInputBytes
+        double fCost
+    cdef cppclass SPlanOutput:
+        SPlanPart part
+        size_t iUploadBytes
+        size_t iDownloadBytes
+        vector[SPlanJob] jobs
+    cdef cppclass SJobPlan:
+        size_t iMaxSize
+        int iDeviceCount
+        vector[SPlanOutput] outputs
+        size_t iTransferBytes
+        double fCost
+    bool planJob(EJobType, const CVolumeGeometry3D&, const CProjectionGeometry3D&, size_t, int, int, SJobPlan&, ESplitStrategy)
+
+_split_strategies = { 'linear': SPLIT_LINEAR, 'cost': SPLIT_COST }
+
+cdef ESplitStrategy _split_strategy(split) except *:
+    if split not in _split_strategies:
+        raise AstraError('Unknown split strategy: {}'.format(split))
+    return _split_strategies[split]
+
+cdef extern from "astra/DataMemoryPool.h" namespace "astra":
+    cdef cppclass SDataMemoryPoolStats:
+        size_t iHits
+        size_t iMisses
+        size_t iEvictions
+        size_t iBytesHeld
+        size_t iBytesInUse
+    cdef cppclass CDataMemoryPool:
+        SDataMemoryPoolStats getStats()
+        void resetStats()
+        void setLimit(size_t)
+        size_t getLimit()
+        void clear()
+cdef extern from "astra/DataMemoryPool.h" namespace "astra::CDataMemoryPool":
+    CDataMemoryPool* getSingletonPtr()
+
+cdef extern from "astra/ThreadPool.h" namespace "astra":
+    cdef cppclass CThreadPool:
+        void setThreadCount(int) nogil
+        int getThreadCount()
+        void setAffinity(bool) nogil
+cdef extern from "astra/ThreadPool.h" namespace "astra::CThreadPool":
+    CThreadPool* getThreadPool "astra::CThreadPool::getSingletonPtr"()
+
+cdef extern from "astra/Profiler.h" namespace "astra":
+    cdef cppclass SProfilePhaseStats:
+        string sName
+        size_t iCalls
+        double fSeconds
+        size_t iRays
+        size_t iNonZeros
+        size_t iBytes
+    cdef cppclass CProfiler:
+        void setEnabled(bool)
+        bool isEnabled()
+        vector[SProfilePhaseStats] getStats()
+        void resetStats()
+cdef extern from "astra/Profiler.h" namespace "astra::CProfiler":
+    CProfiler* getProfiler "astra::CProfiler::getSingletonPtr"()
 
 
 def credits():
@@ -82,7 +166,7 @@ def use_cuda():
     return cudaAvailable()
 
 IF HAVE_CUDA==True:
-  def set_gpu_index(idx, memory=0):
+  def set_gpu_index(idx, memory=0, split='linear'):
     try:
       import collections.abc as abc
     except:
@@ -93,6 +177,7 @@ IF HAVE_CUDA==True:
     if memory != 0 and memory < 1024*1024:
         raise AstraError("Setting GPU memory lower than 1MB is not supported")
     params.memory = memory
+    params.splitStrategy = _split_strategy(split)
 
     # We let Cython convert idx into a std::vector<int>
     params.GPUIndices = idx
@@ -116,7 +201,7 @@ IF HAVE_CUDA==True:
   def get_gpu_info(idx=-1):
     return wrap_from_bytes(getCudaDeviceString(idx))
 ELSE:
-  def set_gpu_index(idx, memory=0):
+  def set_gpu_index(idx, memory=0, split='linear'):
     raise AstraError("CUDA support is not enabled in ASTRA")
   def get_gpu_info(idx=-1):
     raise AstraError("CUDA support is not enabled in ASTRA")
@@ -148,5 +233,101 @@ def info(ids):
             s = ptr.getType() + b"\t" + ptr.getInfo(i)
             print(wrap_from_bytes(s))
 
+def get_object_type(i):
+    cdef CAstraObjectManagerBase* ptr = PyIndexManager.getSingletonPtr().get(i)
+    if not ptr:
+        return None
+    return wrap_from_bytes(ptr.getType())
+
 def has_feature(feature):
     return hasFeature(wrap_to_bytes(feature))
+
+def get_memory_pool_stats():
+    cdef SDataMemoryPoolStats stats = getSingletonPtr().getStats()
+    return { 'hits': stats.iHits,
+             'misses': stats.iMisses,
+             'evictions': stats.iEvictions,
+             'bytes_held': stats.iBytesHeld,
+             'bytes_in_use': stats.iBytesInUse,
+             'limit': getSingletonPtr().getLimit() }
+
+def reset_memory_pool_stats():
+    getSingletonPtr().resetStats()
+
+def set_memory_pool_limit(size_t limit):
+    getSingletonPtr().setLimit(limit)
+
+def clear_memory_pool():
+    getSingletonPtr().clear()
+
+def set_num_threads(int n, pin=None):
+    cdef CThreadPool *pool = getThreadPool()
+    cdef bool bPin
+    # Restarting the workers waits for them, so release the GIL
+    with nogil:
+        pool.setThreadCount(n)
+    if pin is not None:
+        bPin = True if pin else False
+        with nogil:
+            pool.setAffinity(bPin)
+
+def get_num_threads():
+    return getThreadPool().getThreadCount()
+
+def set_profiling(enabled):
+    getProfiler().setEnabled(True if enabled else False)
+
+def is_profiling():
+    return getProfiler().isEnabled()
+
+def get_profile_stats():
+    cdef vector[SProfilePhaseStats] stats = getProfiler().getStats()
+    return { wrap_from_bytes(s.sName): { 'calls': s.iCalls,
+                                         'seconds': s.fSeconds,
+                                         'rays': s.iRays,
+                                         'nonzeros': s.iNonZeros,
+                                         'bytes': s.iBytes }
+             for s in stats }
+
+def reset_profile_stats():
+    getProfiler().resetStats()
+
+cdef _plan_part_dict(const SPlanPart &p):
+    return { 'type': 'volume' if p.bVolume else 'projection',
+             'offset': (p.offset[0], p.offset[1], p.offset[2]),
+             'shape': (p.dims[0], p.dims[1], p.dims[2]) }
+
+_plan_job_types = { 'FP': JOB_FP, 'BP': JOB_BP, 'FDK': JOB_FDK }
+_plan_job_names = { JOB_FP: 'FP', JOB_BP: 'BP', JOB_FDK: 'FDK', JOB_NOP: 'NOP' }
+
+def plan_gpu_job(job_type, vol_geom, proj_geom, size_t memory, int num_devices, int max_block_dim, split):
+    cdef EJobType eType
+    cdef ESplitStrategy eSplit = _split_strategy(split)
+    cdef unique_ptr[CVolumeGeometry3D] pVolGeom
+    cdef unique_ptr[CProjectionGeometry3D] pProjGeom
+    cdef SJobPlan plan
+    if job_type not in _plan_job_types:
+        raise AstraError('Unknown job type: {}'.format(job_type))
+    eType = _plan_job_types[job_type]
+    pVolGeom = createVolumeGeometry3D(vol_geom)
+    pProjGeom = createProjectionGeometry3D(proj_geom)
+    if not planJob(eType, pVolGeom.get()[0], pProjGeom.get()[0], memory, num_devices, max_block_dim, plan, eSplit):
+        raise AstraError('Failed to plan job', append_log=True)
+    outputs = []
+    for o in plan.outputs:
+        jobs = []
+        for j in o.jobs:
+            jobs.append({ 'type': _plan_job_names[j.eType],
+                          'mode': 'set' if j.eMode == MODE_SET else 'add',
+                          'input': _plan_part_dict(j.input) if j.eType != JOB_NOP else None,
+                          'input_bytes': j.iInputBytes,
+                          'cost': j.fCost })
+        outputs.append({ 'part': _plan_part_dict(o.part),
+                         'upload_bytes': o.iUploadBytes,
+                         'download_bytes': o.iDownloadBytes,
+                         'jobs': jobs })
+    return { 'max_size': plan.iMaxSize,
+             'num_devices': plan.iDeviceCount,
+             'outputs': outputs,
+             'transfer_bytes': plan.iTransferBytes,
+             'cost': plan.fCost }
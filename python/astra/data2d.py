@@ -46,6 +46,7 @@ def create(datatype, geometry, data=None):
     :param geometry: Volume or projection geometry.
     :type geometry: :class:`dict`
     :param data: Data to fill the constructed object with, either a scalar or array.
+                 A :class:`numpy.float16` array is stored as float16.
     :type data: :class:`float` or :class:`numpy.ndarray`
     :returns: :class:`int` -- the ID of the constructed object.
 
@@ -119,6 +120,21 @@ def get_shared(i):
     return d.get_shared(i)
 
 
+def get_shared_dlpack(i):
+    """Get an object sharing the memory of a 2D data object through DLPack.
+
+    The result can be passed to the ``from_dlpack`` function of for example
+    numpy or PyTorch, without copying the data. It is only valid as long as
+    the data object exists.
+
+    :param i: ID of object to get.
+    :type i: :class:`int`
+    :returns: An object implementing ``__dlpack__``.
+
+    """
+    return d.get_shared_dlpack(i)
+
+
 def get_single(i):
     """Get a 2D object in single precision.
 
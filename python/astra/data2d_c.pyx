@@ -53,7 +53,7 @@ from .utils import wrap_from_bytes
 from .utils cimport linkVolFromGeometry2D, linkProjFromGeometry2D, createProjectionGeometry2D, createVolumeGeometry2D
 from .log import AstraError
 
-from .pythonutils import geom_size
+from .pythonutils import geom_size, bfloat16_to_float32, float32_to_bfloat16
 
 import operator
 
@@ -80,6 +80,10 @@ def create(datatype, geometry, data=None, link=False):
     cdef unique_ptr[CVolumeGeometry2D] pGeometry
     cdef unique_ptr[CProjectionGeometry2D] ppGeometry
     cdef CData2D * pDataObject2D
+    cdef CDataStorage * pStorage
+
+    # float16 input data is stored as float16
+    half = isinstance(data, np.ndarray) and data.dtype == np.float16
 
     if link:
         geom_shape = geom_size(geometry)
@@ -90,13 +94,19 @@ def create(datatype, geometry, data=None, link=False):
     if datatype == '-vol':
         pGeometry = createVolumeGeometry2D(geometry)
         if link:
-            pDataObject2D = linkVolFromGeometry2D(cython.operator.dereference(pGeometry), data)
+            pDataObject2D = linkVolFromGeometry2D(cython.operator.dereference(pGeometry), data, False)
+        elif half:
+            pStorage = new CDataMemory[float16](pGeometry.get().getGridTotCount())
+            pDataObject2D = new CFloat32VolumeData2D(move(pGeometry), pStorage)
         else:
             pDataObject2D = createCFloat32VolumeData2DMemory(move(pGeometry))
     elif datatype == '-sino':
         ppGeometry = createProjectionGeometry2D(geometry)
         if link:
-            pDataObject2D = linkProjFromGeometry2D(cython.operator.dereference(ppGeometry), data)
+            pDataObject2D = linkProjFromGeometry2D(cython.operator.dereference(ppGeometry), data, False)
+        elif half:
+            pStorage = new CDataMemory[float16](<size_t>ppGeometry.get().getProjectionAngleCount() * ppGeometry.get().getDetectorCount())
+            pDataObject2D = new CFloat32ProjectionData2D(move(ppGeometry), pStorage)
         else:
             pDataObject2D = createCFloat32ProjectionData2DMemory(move(ppGeometry))
     else:
@@ -113,28 +123,32 @@ def create(datatype, geometry, data=None, link=False):
 
 cdef fillDataObject(CData2D * obj, data):
     if data is None:
-        fillDataObjectScalar(obj, 0)
+        data = 0
+    if isinstance(data, np.ndarray):
+        obj_shape = (obj.getHeight(), obj.getWidth())
+        if data.shape != obj_shape:
+            raise ValueError(
+              "The dimensions of the data {} do not match those specified "
+              "in the geometry {}".format(data.shape, obj_shape))
+    view = getDataView(obj)
+    if obj.isBFloat16Memory():
+        view[...] = float32_to_bfloat16(data)
     else:
-        if isinstance(data, np.ndarray):
-            obj_shape = (obj.getHeight(), obj.getWidth())
-            if data.shape != obj_shape:
-                raise ValueError(
-                  "The dimensions of the data {} do not match those specified "
-                  "in the geometry {}".format(data.shape, obj_shape))
-            fillDataObjectArray(obj, np.ascontiguousarray(data,dtype=np.float32))
-        else:
-            fillDataObjectScalar(obj, np.float32(data))
-
-cdef fillDataObjectScalar(CData2D * obj, float s):
-    cdef size_t i
-    for i in range(obj.getSize()):
-        obj.getFloat32Memory()[i] = s
+        view[...] = data
 
-@cython.boundscheck(False)
-@cython.wraparound(False)
-cdef fillDataObjectArray(CData2D * obj, const float [:,::1] data):
-    cdef float [:,::1] cView =  <float[:data.shape[0],:data.shape[1]]> obj.getFloat32Memory()
-    cView[:] = data
+cdef getDataView(CData2D * obj):
+    """Numpy array sharing the memory of obj. bfloat16 data is returned as
+    raw uint16 values."""
+    cdef np.npy_intp shape[2]
+    shape[0] = <np.npy_intp> obj.getHeight()
+    shape[1] = <np.npy_intp> obj.getWidth()
+    if obj.isFloat32Memory():
+        return np.PyArray_SimpleNewFromData(2,shape,np.NPY_FLOAT32,<void *>obj.getFloat32Memory())
+    if obj.isFloat16Memory():
+        return np.PyArray_SimpleNewFromData(2,shape,np.NPY_FLOAT16,<void *>obj.getFloat16Memory())
+    if obj.isBFloat16Memory():
+        return np.PyArray_SimpleNewFromData(2,shape,np.NPY_UINT16,<void *>obj.getBFloat16Memory())
+    raise ValueError("Data object is not float32/float16/bfloat16 memory")
 
 cdef CData2D * getObject(i) except NULL:
     cdef CData2D * pDataObject = man2d.get(i)
@@ -234,23 +248,46 @@ def change_geometry(i, geom):
     else:
         raise AstraError("Not a known data object")
 
-@cython.boundscheck(False)
-@cython.wraparound(False)
 def get(i):
     cdef CData2D * pDataObject = getObject(i)
-    outArr = np.empty((pDataObject.getHeight(), pDataObject.getWidth()),dtype=np.float32,order='C')
-    cdef float [:,::1] mView = outArr
-    cdef float [:,::1] cView =  <float[:outArr.shape[0],:outArr.shape[1]]> pDataObject.getFloat32Memory()
-    mView[:] = cView
-    return outArr
+    view = getDataView(pDataObject)
+    if pDataObject.isBFloat16Memory():
+        return bfloat16_to_float32(view)
+    return view.copy()
 
 def get_shared(i):
     cdef CData2D * pDataObject = getObject(i)
-    cdef np.npy_intp shape[2]
-    shape[0] = <np.npy_intp> pDataObject.getHeight()
-    shape[1] = <np.npy_intp> pDataObject.getWidth()
-    return np.PyArray_SimpleNewFromData(2,shape,np.NPY_FLOAT32,<void *>pDataObject.getFloat32Memory())
+    if pDataObject.isBFloat16Memory():
+        raise ValueError("bfloat16 data objects can not be shared with numpy")
+    return getDataView(pDataObject)
+
+
+cdef class DLPackData2D:
+    """DLPack export of the memory of a 2D data object, without copying.
+
+    It is only valid as long as the data object exists."""
+    cdef object i
+    cdef CData2D * pDataObject
+
+    def __cinit__(self, i):
+        self.i = i
+        self.pDataObject = getObject(i)
+
+    def __dlpack__(self, stream=None, max_version=None, dl_device=None, copy=None):
+        if man2d.get(self.i) != self.pDataObject:
+            raise BufferError("Data object has been deleted")
+        if copy:
+            raise BufferError("Copying is not supported")
+        if dl_device is not None and tuple(dl_device) != self.__dlpack_device__():
+            raise BufferError("Only CPU export is supported")
+        versioned = max_version is not None and max_version[0] >= 1
+        return utils.createDLPackCapsule2D(self.pDataObject, self, versioned)
+
+    def __dlpack_device__(self):
+        return (1, 0) # kDLCPU
 
+def get_shared_dlpack(i):
+    return DLPackData2D(i)
 
 def get_single(i):
     raise NotImplementedError("Not yet implemented")
@@ -24,10 +24,10 @@
 # -----------------------------------------------------------------------
 
 from . import data3d_c as d
-from .pythonutils import GPULink
+from .pythonutils import GPULink, FileLink
 
 
-def create(datatype,geometry,data=None):
+def create(datatype,geometry,data=None,filename=None):
     """Create a 3D object.
 
     :param datatype: Data object type, '-vol' or '-sino'.
@@ -35,11 +35,17 @@ def create(datatype,geometry,data=None):
     :param geometry: Volume or projection geometry.
     :type geometry: :class:`dict`
     :param data: Data to fill the constructed object with, either a scalar or array.
+                 A :class:`numpy.float16` array is stored as float16.
     :type data: :class:`float` or :class:`numpy.ndarray`
+    :param filename: If specified, store the object in this file instead of
+                     in memory. The file is created or overwritten, and
+                     memory-mapped. This allows objects larger than the
+                     available memory.
+    :type filename: :class:`string`
     :returns: :class:`int` -- the ID of the constructed object.
 
     """
-    return d.create(datatype,geometry,data)
+    return d.create(datatype,geometry,data,filename=filename)
 
 def link(datatype, geometry, data):
     """Link a 3D array with ASTRA from another library supporting dlpack,
@@ -50,6 +56,8 @@ def link(datatype, geometry, data):
     :param geometry: Volume or projection geometry.
     :type geometry: :class:`dict`
     :param data: Array to link. Needs to implement the dlpack protocol.
+                 Alternatively, a :class:`FileLink` to memory-map a file, or
+                 a :class:`GPULink` to link GPU memory.
     :type data: :class:`object`
     :returns: :class:`int` -- the ID assigned to the linked object.
 
@@ -80,6 +88,21 @@ def get_shared(i):
     """
     return d.get_shared(i)
 
+def get_shared_dlpack(i):
+    """Get an object sharing the memory of a 3D data object through DLPack.
+
+    The result can be passed to the ``from_dlpack`` function of for example
+    numpy or PyTorch, without copying the data. It is only valid as long as
+    the data object exists.
+
+    :param i: ID of object to get.
+    :type i: :class:`int`
+    :returns: An object implementing ``__dlpack__``.
+
+    """
+    return d.get_shared_dlpack(i)
+
+
 def get_single(i):
     """Get a 3D object in single precision.
 
@@ -101,6 +124,83 @@ def store(i,data):
     """
     return d.store(i,data)
 
+def ingest_raw(i, raw, flat=None, dark=None, first_angle=0, log=True, min_transmission=1e-6):
+    """Fill (part of) a 3D projection data object from raw detector counts.
+
+    The counts are converted, flat/dark corrected to
+    ``-log((raw - dark) / (flat - dark))`` and reordered in a single
+    threaded pass, without making float copies of the raw data. Large scans
+    can be ingested a block of projections at a time using ``first_angle``.
+    Dead pixels, where flat <= dark, get a transmission of 1 (a line
+    integral of 0).
+
+    :param i: ID of a float32 projection data object.
+    :type i: :class:`int`
+    :param raw: Projections with shape (angles, detector rows, detector
+                columns), or a single projection.
+    :type raw: :class:`numpy.ndarray` of uint16 or uint32
+    :param flat: Flat field with shape (detector rows, detector columns).
+    :type flat: :class:`numpy.ndarray`
+    :param dark: Dark field with shape (detector rows, detector columns).
+    :type dark: :class:`numpy.ndarray`
+    :param first_angle: Index of the first projection of ``raw``.
+    :type first_angle: :class:`int`
+    :param log: If False, store the corrected transmission instead of the
+                line integrals.
+    :type log: :class:`bool`
+    :param min_transmission: Lower bound of the transmission before the log.
+    :type min_transmission: :class:`float`
+
+    """
+    return d.ingest_raw(i, raw, flat, dark, first_angle, log, min_transmission)
+
+def load_projections(i, files, format='tiff', dtype='uint16', header_bytes=0,
+                     flat=None, dark=None, log=True, min_transmission=1e-6,
+                     block_size=16, num_threads=2, callback=None):
+    """Load projection files into a 3D projection data object in the
+    background.
+
+    The projections are divided evenly over the files, in order, so this can
+    be one file per projection or a single stack. Blocks of ``block_size``
+    projections are read in order by ``num_threads`` threads, and become
+    available as soon as they have been stored. If ``flat`` or ``dark`` is
+    given, each block is corrected as in :func:`ingest_raw`; otherwise the
+    samples are stored unchanged.
+
+    Deleting the data object stops loading first. Projections that were not
+    loaded by then fail.
+
+    :param i: ID of a float32 projection data object.
+    :type i: :class:`int`
+    :param files: File names.
+    :type files: :class:`list`
+    :param format: ``'tiff'`` for uncompressed (multi-page) TIFF files with
+                   uint16, uint32 or float32 samples, or ``'raw'`` for raw
+                   little endian binary files.
+    :type format: :class:`str`
+    :param dtype: Sample type of raw files.
+    :param header_bytes: Number of bytes to skip at the start of raw files.
+    :type header_bytes: :class:`int`
+    :param flat: Flat field with shape (detector rows, detector columns).
+    :type flat: :class:`numpy.ndarray`
+    :param dark: Dark field with shape (detector rows, detector columns).
+    :type dark: :class:`numpy.ndarray`
+    :param log: See :func:`ingest_raw`.
+    :param min_transmission: See :func:`ingest_raw`.
+    :param block_size: Number of projections per block.
+    :type block_size: :class:`int`
+    :param num_threads: Number of loader threads.
+    :type num_threads: :class:`int`
+    :param callback: Function called as ``callback(first, count, success)``
+                     from a loader thread when a block is done.
+    :returns: A ``ProjectionStream`` with methods ``wait(first=0,
+              count=None)``, ``is_ready(angle)`` and ``abort()``.
+
+    """
+    return d.load_projections(i, files, format, dtype, header_bytes, flat, dark,
+                              log, min_transmission, block_size, num_threads,
+                              callback)
+
 def get_geometry(i):
     """Get the geometry of a 3D object.
 
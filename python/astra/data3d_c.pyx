@@ -30,6 +30,8 @@ from __future__ import print_function
 cimport cython
 
 from libcpp.utility cimport move
+from libcpp.vector cimport vector
+from libc.stdint cimport uint16_t, uint32_t
 
 from . cimport PyData3DManager
 from .PyData3DManager cimport CData3DManager
@@ -45,38 +47,88 @@ from .PyXMLDocument cimport XMLDocument
 
 from . cimport utils
 from .utils import wrap_from_bytes
-from .utils cimport linkVolFromGeometry3D, linkProjFromGeometry3D, createProjectionGeometry3D, createVolumeGeometry3D
+from .utils cimport linkVolFromGeometry3D, linkProjFromGeometry3D, createProjectionGeometry3D, createVolumeGeometry3D, mapFile
 from .log import AstraError
 
-from .pythonutils import geom_size, GPULink
+from .pythonutils import geom_size, GPULink, bfloat16_to_float32, float32_to_bfloat16
 
 import operator
+import weakref
 
 include "config.pxi"
 
 cdef extern from "astra/SheppLogan.h" namespace "astra":
     cdef void generateSheppLogan3D(CFloat32VolumeData3D*, bool)
 
+cdef extern from "astra/ProjectionIngest.h" namespace "astra":
+    cdef cppclass SRawIngestOptions:
+        bool bLog
+        float32 fMinTransmission
+    cdef bool ingestRawProjections[T](const T*, int, int, const float32*, const float32*, CFloat32ProjectionData3D*, const SRawIngestOptions&) nogil
+
+cdef extern from "astra/ProjectionStreamLoader.h" namespace "astra":
+    cdef enum EFormat "astra::CProjectionStreamLoader::EFormat":
+        FORMAT_RAW "astra::CProjectionStreamLoader::FORMAT_RAW"
+        FORMAT_TIFF "astra::CProjectionStreamLoader::FORMAT_TIFF"
+    cdef enum ESampleType "astra::CProjectionStreamLoader::ESampleType":
+        SAMPLE_UINT16 "astra::CProjectionStreamLoader::SAMPLE_UINT16"
+        SAMPLE_UINT32 "astra::CProjectionStreamLoader::SAMPLE_UINT32"
+        SAMPLE_FLOAT32 "astra::CProjectionStreamLoader::SAMPLE_FLOAT32"
+    ctypedef void (*ReadyCallback "astra::CProjectionStreamLoader::ReadyCallback")(void *, int, int, bool) noexcept
+    cdef cppclass CProjectionStreamLoader:
+        CProjectionStreamLoader()
+        void setFiles(const vector[string] &, EFormat)
+        void setRawLayout(ESampleType, size_t)
+        void setCorrection(const vector[float32] &, const vector[float32] &, const SRawIngestOptions &)
+        bool setBlockSize(int)
+        void setThreadCount(int)
+        void setReadyCallback(ReadyCallback, void *)
+        bool start(CFloat32ProjectionData3D *)
+        bool waitForAngles(int, int) nogil
+        bool isAngleReady(int)
+        bool wait() nogil
+        void abort()
+        string getError()
+
+cdef extern from *:
+    CFloat32ProjectionData3D* dynamic_cast_CFloat32ProjectionData3D "dynamic_cast<astra::CFloat32ProjectionData3D*>" (CData3D*)
+
 cdef CData3DManager * man3d = <CData3DManager * >PyData3DManager.getSingletonPtr()
 
 
 
 
-def create(datatype,geometry,data=None, link=False):
+def create(datatype,geometry,data=None, link=False, filename=None):
     cdef unique_ptr[CVolumeGeometry3D] pGeometry
     cdef unique_ptr[CProjectionGeometry3D] ppGeometry
     cdef CData3D * pDataObject3D
+    cdef CDataStorage * pStorage
+
+    # float16 input data is stored as float16
+    half = isinstance(data, np.ndarray) and data.dtype == np.float16 and filename is None
 
     if datatype == '-vol':
         pGeometry = createVolumeGeometry3D(geometry)
         if link:
-            pDataObject3D = linkVolFromGeometry3D(cython.operator.dereference(pGeometry), data)
+            pDataObject3D = linkVolFromGeometry3D(cython.operator.dereference(pGeometry), data, False)
+        elif filename is not None:
+            pStorage = mapFile(filename, 'w+', 0, pGeometry.get().getGridTotCount())
+            pDataObject3D = new CFloat32VolumeData3D(move(pGeometry), pStorage)
+        elif half:
+            pStorage = new CDataMemory[float16](pGeometry.get().getGridTotCount())
+            pDataObject3D = new CFloat32VolumeData3D(move(pGeometry), pStorage)
         else:
             pDataObject3D = createCFloat32VolumeData3DMemory(move(pGeometry))
     elif datatype == '-sino' or datatype == '-proj3d' or datatype == '-sinocone':
         ppGeometry = createProjectionGeometry3D(geometry)
         if link:
-            pDataObject3D = linkProjFromGeometry3D(cython.operator.dereference(ppGeometry), data)
+            pDataObject3D = linkProjFromGeometry3D(cython.operator.dereference(ppGeometry), data, False)
+        elif filename is not None:
+            pStorage = mapFile(filename, 'w+', 0, <size_t>ppGeometry.get().getProjectionCount() * ppGeometry.get().getDetectorTotCount())
+            pDataObject3D = new CFloat32ProjectionData3D(move(ppGeometry), pStorage)
+        elif half:
+            pStorage = new CDataMemory[float16](<size_t>ppGeometry.get().getProjectionCount() * ppGeometry.get().getDetectorTotCount())
+            pDataObject3D = new CFloat32ProjectionData3D(move(ppGeometry), pStorage)
         else:
             pDataObject3D = createCFloat32ProjectionData3DMemory(move(ppGeometry))
     else:
@@ -86,7 +138,8 @@ def create(datatype,geometry,data=None, link=False):
         del pDataObject3D
         raise AstraError("Couldn't initialize data object", append_log=True)
 
-    if not link:
+    # A newly created file mapping is already zero-filled
+    if not link and not (filename is not None and data is None):
         fillDataObject(pDataObject3D, data)
 
     return man3d.store(pDataObject3D)
@@ -136,30 +189,35 @@ def change_geometry(i, geom):
 
 
 cdef fillDataObject(CData3D * obj, data):
-    if not obj.isFloat32Memory():
-        raise ValueError("Data object is not float32/memory")
+    view = getDataView(obj)
+    if obj.isReadOnly():
+        raise ValueError("Data object is mapped read-only")
     if data is None:
-        fillDataObjectScalar(obj, 0)
+        data = 0
+    if isinstance(data, np.ndarray):
+        obj_shape = (obj.getDepth(), obj.getHeight(), obj.getWidth())
+        if data.shape != obj_shape:
+            raise ValueError("The dimensions of the data {} do not match those "
+                             "specified in the geometry {}".format(data.shape, obj_shape))
+    if obj.isBFloat16Memory():
+        view[...] = float32_to_bfloat16(data)
     else:
-        if isinstance(data, np.ndarray):
-            obj_shape = (obj.getDepth(), obj.getHeight(), obj.getWidth())
-            if data.shape != obj_shape:
-                raise ValueError("The dimensions of the data {} do not match those "
-                                 "specified in the geometry {}".format(data.shape, obj_shape))
-            fillDataObjectArray(obj, np.ascontiguousarray(data,dtype=np.float32))
-        else:
-            fillDataObjectScalar(obj, np.float32(data))
+        view[...] = data
 
-cdef fillDataObjectScalar(CData3D * obj, float s):
-    cdef size_t i
-    for i in range(obj.getSize()):
-        obj.getFloat32Memory()[i] = s
-
-@cython.boundscheck(False)
-@cython.wraparound(False)
-cdef fillDataObjectArray(CData3D* obj, const float [:,:,::1] data):
-    cdef float [:,:,::1] cView = <float[:data.shape[0],:data.shape[1],:data.shape[2]]> obj.getFloat32Memory()
-    cView[:] = data
+cdef getDataView(CData3D * obj):
+    """Numpy array sharing the memory of obj. bfloat16 data is returned as
+    raw uint16 values."""
+    cdef np.npy_intp shape[3]
+    shape[0] = <np.npy_intp> obj.getDepth()
+    shape[1] = <np.npy_intp> obj.getHeight()
+    shape[2] = <np.npy_intp> obj.getWidth()
+    if obj.isFloat32Memory():
+        return np.PyArray_SimpleNewFromData(3,shape,np.NPY_FLOAT32,<void *>obj.getFloat32Memory())
+    if obj.isFloat16Memory():
+        return np.PyArray_SimpleNewFromData(3,shape,np.NPY_FLOAT16,<void *>obj.getFloat16Memory())
+    if obj.isBFloat16Memory():
+        return np.PyArray_SimpleNewFromData(3,shape,np.NPY_UINT16,<void *>obj.getBFloat16Memory())
+    raise ValueError("Data object is not float32/float16/bfloat16 memory")
 
 cdef CData3D * getObject(i) except NULL:
     cdef CData3D * pDataObject = man3d.get(i)
@@ -169,27 +227,49 @@ cdef CData3D * getObject(i) except NULL:
         raise AstraError("Data object not initialized properly")
     return pDataObject
 
-@cython.boundscheck(False)
-@cython.wraparound(False)
 def get(i):
     cdef CData3D * pDataObject = getObject(i)
-    if not pDataObject.isFloat32Memory():
-        raise ValueError("Data object is not float32/memory")
-    outArr = np.empty((pDataObject.getDepth(),pDataObject.getHeight(), pDataObject.getWidth()),dtype=np.float32,order='C')
-    cdef float [:,:,::1] mView = outArr
-    cdef float [:,:,::1] cView = <float[:outArr.shape[0],:outArr.shape[1],:outArr.shape[2]]> pDataObject.getFloat32Memory()
-    mView[:] = cView
-    return outArr
+    view = getDataView(pDataObject)
+    if pDataObject.isBFloat16Memory():
+        return bfloat16_to_float32(view)
+    return view.copy()
 
 def get_shared(i):
     cdef CData3D * pDataObject = getObject(i)
-    if not pDataObject.isFloat32Memory():
-        raise ValueError("Data object is not float32/memory")
-    cdef np.npy_intp shape[3]
-    shape[0] = <np.npy_intp> pDataObject.getDepth()
-    shape[1] = <np.npy_intp> pDataObject.getHeight()
-    shape[2] = <np.npy_intp> pDataObject.getWidth()
-    return np.PyArray_SimpleNewFromData(3,shape,np.NPY_FLOAT32,<void *>pDataObject.getFloat32Memory())
+    if pDataObject.isBFloat16Memory():
+        raise ValueError("bfloat16 data objects can not be shared with numpy")
+    view = getDataView(pDataObject)
+    if pDataObject.isReadOnly():
+        # Writing to a read-only mapping would crash
+        view.setflags(write=False)
+    return view
+
+cdef class DLPackData3D:
+    """DLPack export of the memory of a 3D data object, without copying.
+
+    It is only valid as long as the data object exists."""
+    cdef object i
+    cdef CData3D * pDataObject
+
+    def __cinit__(self, i):
+        self.i = i
+        self.pDataObject = getObject(i)
+
+    def __dlpack__(self, stream=None, max_version=None, dl_device=None, copy=None):
+        if man3d.get(self.i) != self.pDataObject:
+            raise BufferError("Data object has been deleted")
+        if copy:
+            raise BufferError("Copying is not supported")
+        if dl_device is not None and tuple(dl_device) != self.__dlpack_device__():
+            raise BufferError("Only CPU export is supported")
+        versioned = max_version is not None and max_version[0] >= 1
+        return utils.createDLPackCapsule3D(self.pDataObject, self, versioned)
+
+    def __dlpack_device__(self):
+        return (1, 0) # kDLCPU
+
+def get_shared_dlpack(i):
+    return DLPackData3D(i)
 
 def get_single(i):
     raise NotImplementedError("Not yet implemented")
@@ -198,6 +278,179 @@ def store(i,data):
     cdef CData3D * pDataObject = getObject(i)
     fillDataObject(pDataObject, data)
 
+def ingest_raw(i, raw, flat, dark, first_angle, log, min_transmission):
+    cdef CFloat32ProjectionData3D * pProj = dynamic_cast_CFloat32ProjectionData3D(getObject(i))
+    cdef SRawIngestOptions options
+    cdef np.ndarray flat_arr
+    cdef np.ndarray dark_arr
+    cdef np.ndarray raw_arr
+    cdef const float32 *pfFlat = NULL
+    cdef const float32 *pfDark = NULL
+    cdef const void *pRaw
+    cdef int iFirst = first_angle
+    cdef int iCount
+    cdef bool ret
+    if not pProj:
+        raise AstraError("Data object is not projection data")
+    if not pProj.isFloat32Memory():
+        raise ValueError("Data object is not float32/memory")
+    if not isinstance(raw, np.ndarray) or raw.dtype not in (np.uint16, np.uint32):
+        raise TypeError("Raw data must be a uint16 or uint32 numpy array")
+    det_shape = (pProj.getDepth(), pProj.getWidth())
+    if raw.ndim == 2:
+        raw = raw[np.newaxis]
+    if raw.ndim != 3 or raw.shape[1:] != det_shape:
+        raise ValueError("The dimensions of the raw data {} do not match the "
+                         "detector size {}".format(raw.shape, det_shape))
+    if first_angle < 0 or first_angle + raw.shape[0] > pProj.getHeight():
+        raise ValueError("Projections {} to {} out of range".format(first_angle, first_angle + raw.shape[0]))
+    raw_arr = np.ascontiguousarray(raw)
+    pRaw = np.PyArray_DATA(raw_arr)
+    iCount = raw_arr.shape[0]
+    if flat is not None:
+        flat_arr = np.ascontiguousarray(flat, dtype=np.float32)
+        if (<object>flat_arr).shape != det_shape:
+            raise ValueError("The dimensions of the flat field do not match the detector size")
+        pfFlat = <const float32*>np.PyArray_DATA(flat_arr)
+    if dark is not None:
+        dark_arr = np.ascontiguousarray(dark, dtype=np.float32)
+        if (<object>dark_arr).shape != det_shape:
+            raise ValueError("The dimensions of the dark field do not match the detector size")
+        pfDark = <const float32*>np.PyArray_DATA(dark_arr)
+    options.bLog = True if log else False
+    options.fMinTransmission = min_transmission
+    if raw_arr.dtype == np.uint16:
+        with nogil:
+            ret = ingestRawProjections[uint16_t](<const uint16_t*>pRaw, iFirst, iCount, pfFlat, pfDark, pProj, options)
+    else:
+        with nogil:
+            ret = ingestRawProjections[uint32_t](<const uint32_t*>pRaw, iFirst, iCount, pfFlat, pfDark, pProj, options)
+    if not ret:
+        raise AstraError("Failed to ingest raw projections", append_log=True)
+
+cdef class _StreamCallback:
+    cdef CProjectionStreamLoader *loader
+    cdef object callback
+    cdef object exception
+
+cdef void _streamReadyCallback(void *ctx, int iFirst, int iCount, bool bSuccess) noexcept with gil:
+    cdef _StreamCallback state = <_StreamCallback>ctx
+    if state.exception is not None:
+        return
+    try:
+        state.callback(iFirst, iCount, bSuccess)
+    except BaseException as e:
+        # Stop loading, and re-raise from wait()
+        state.exception = e
+        state.loader.abort()
+
+cdef class ProjectionStream:
+    """Projections being loaded into a 3D data object in the background."""
+    cdef CProjectionStreamLoader *loader
+    cdef _StreamCallback state
+    cdef readonly int angles
+    cdef int data_id
+    cdef object __weakref__
+
+    def __cinit__(self):
+        self.loader = new CProjectionStreamLoader()
+        self.state = _StreamCallback()
+        self.state.loader = self.loader
+
+    def __dealloc__(self):
+        # Stops the loader threads, which may be waiting for the GIL to
+        # report a block
+        with nogil:
+            del self.loader
+
+    def wait(self, first=0, count=None):
+        """Wait until the given projections have been loaded.
+
+        :param first: First projection to wait for.
+        :param count: Number of projections, or None for all from ``first``.
+        :raises: :class:`AstraError` if loading them failed.
+        """
+        cdef int iFirst = first
+        cdef int iCount = self.angles - first if count is None else count
+        cdef bool ret
+        with nogil:
+            ret = self.loader.waitForAngles(iFirst, iCount)
+        if self.state.exception is not None:
+            raise self.state.exception
+        if not ret:
+            raise AstraError("Loading projections failed: " + wrap_from_bytes(self.loader.getError()), append_log=True)
+
+    def is_ready(self, angle):
+        """Check if a projection has been loaded."""
+        return self.loader.isAngleReady(angle)
+
+    def abort(self):
+        """Stop loading. Projections that were not loaded yet fail."""
+        self.loader.abort()
+
+# Streams that may still write to their data object. Deleting the object
+# stops them first.
+_streams = weakref.WeakSet()
+
+def _stop_streams(ids):
+    cdef ProjectionStream stream
+    for stream in list(_streams):
+        if ids is None or stream.data_id in ids:
+            stream.loader.abort()
+            with nogil:
+                stream.loader.wait()
+            _streams.discard(stream)
+
+def load_projections(i, files, fmt, dtype, header_bytes, flat, dark, log, min_transmission, block_size, num_threads, callback):
+    cdef CFloat32ProjectionData3D * pProj = dynamic_cast_CFloat32ProjectionData3D(getObject(i))
+    cdef ProjectionStream stream = ProjectionStream()
+    cdef vector[string] vFiles
+    cdef vector[float32] vFlat
+    cdef vector[float32] vDark
+    cdef SRawIngestOptions options
+    if not pProj:
+        raise AstraError("Data object is not projection data")
+    if not pProj.isFloat32Memory():
+        raise ValueError("Data object is not float32/memory")
+    if isinstance(files, (str, bytes)):
+        files = [ files ]
+    for f in files:
+        vFiles.push_back(f.encode() if isinstance(f, str) else f)
+    if fmt == 'tiff':
+        stream.loader.setFiles(vFiles, FORMAT_TIFF)
+    elif fmt == 'raw':
+        stream.loader.setFiles(vFiles, FORMAT_RAW)
+        dtype = np.dtype(dtype)
+        if dtype == np.uint16:
+            stream.loader.setRawLayout(SAMPLE_UINT16, header_bytes)
+        elif dtype == np.uint32:
+            stream.loader.setRawLayout(SAMPLE_UINT32, header_bytes)
+        elif dtype == np.float32:
+            stream.loader.setRawLayout(SAMPLE_FLOAT32, header_bytes)
+        else:
+            raise TypeError("Raw data must be uint16, uint32 or float32")
+    else:
+        raise ValueError("Unknown format " + str(fmt))
+    if flat is not None or dark is not None:
+        if flat is not None:
+            vFlat = np.ascontiguousarray(flat, dtype=np.float32).ravel()
+        if dark is not None:
+            vDark = np.ascontiguousarray(dark, dtype=np.float32).ravel()
+        options.bLog = True if log else False
+        options.fMinTransmission = min_transmission
+        stream.loader.setCorrection(vFlat, vDark, options)
+    stream.loader.setBlockSize(block_size)
+    stream.loader.setThreadCount(num_threads)
+    if callback is not None:
+        stream.state.callback = callback
+        stream.loader.setReadyCallback(_streamReadyCallback, <void*>stream.state)
+    stream.angles = pProj.getHeight()
+    if not stream.loader.start(pProj):
+        raise AstraError("Unable to load projections", append_log=True)
+    stream.data_id = i
+    _streams.add(stream)
+    return stream
+
 def dimensions(i):
     cdef CData3D * pDataObject = getObject(i)
     return (pDataObject.getDepth(),pDataObject.getHeight(),pDataObject.getWidth())
@@ -211,12 +464,15 @@ def shepp_logan(i, modified=True):
 
 def delete(ids):
     try:
-        for i in ids:
-            man3d.remove(i)
+        ids = list(ids)
     except TypeError:
-        man3d.remove(ids)
+        ids = [ ids ]
+    _stop_streams(ids)
+    for i in ids:
+        man3d.remove(i)
 
 def clear():
+    _stop_streams(None)
     man3d.clear()
 
 def info():
@@ -36,6 +36,13 @@ from .log import AstraError
 
 from . cimport PyProjector2DManager
 from .PyProjector2DManager cimport CProjector2DManager
+from . cimport PyProjector3DManager
+from .PyProjector3DManager cimport CProjector3DManager
+from .utils cimport linkVolFromGeometry3D, linkProjFromGeometry3D
+
+import numpy as np
+cimport numpy as cnp
+cnp.import_array()
 
 cdef extern from "astra/ForwardProjectionAlgorithm.h" namespace "astra":
     cdef cppclass CForwardProjectionAlgorithm(CAlgorithm):
@@ -43,6 +50,26 @@ cdef extern from "astra/ForwardProjectionAlgorithm.h" namespace "astra":
 cdef extern from "astra/BackProjectionAlgorithm.h" namespace "astra":
     cdef cppclass CBackProjectionAlgorithm(CReconstructionAlgorithm2D):
         CBackProjectionAlgorithm(CProjector2D*, CFloat32ProjectionData2D*, CFloat32VolumeData2D*)
+cdef extern from "astra/ProjectionOperator.h" namespace "astra":
+    cdef enum EProjectionOperation:
+        OPERATION_FP
+        OPERATION_BP
+    cdef cppclass CProjectionOperator2D:
+        CProjectionOperator2D(CProjector2D*, EProjectionOperation)
+        bool isInitialized()
+        CProjector2D *getProjector()
+        size_t getInputSize()
+        size_t getOutputSize()
+        bool apply(const float32*, float32*) nogil
+        bool apply(const CData2D*, CData2D*) nogil
+    cdef cppclass CProjectionOperator3D:
+        CProjectionOperator3D(CProjector3D*, EProjectionOperation)
+        bool isInitialized()
+        CProjector3D *getProjector()
+        size_t getInputSize()
+        size_t getOutputSize()
+        bool apply(const float32*, float32*) nogil
+        bool apply(const CData3D*, CData3D*) nogil
 
 
 
@@ -341,3 +368,161 @@ def direct_BP2D(projector_id, vol, proj):
     direct_FPBP2D(projector_id, vol, proj, "BP")
 
 
+cdef EProjectionOperation _parseOperation(operation) except *:
+    if operation == 'FP':
+        return OPERATION_FP
+    elif operation == 'BP':
+        return OPERATION_BP
+    raise ValueError("Operation should be 'FP' or 'BP'")
+
+cdef bool _isDirectArray(arr, size_t size, bool writeable):
+    # Arrays that can be passed to the operators as raw buffers
+    return (isinstance(arr, np.ndarray) and arr.dtype == np.float32 and
+            arr.flags['C_CONTIGUOUS'] and <size_t>arr.size == size and
+            (not writeable or arr.flags['WRITEABLE']))
+
+
+cdef class ProjectionOperator2D:
+    """Persistent forward or backprojection operator for a 2D projector.
+
+    Setting up the operator once avoids the overhead of creating data objects
+    and algorithms for every projection, for example when using it as a
+    matrix-vector product in an iterative solver.
+
+    :param projector_id: A 2D projector object handle
+    :type projector_id: :class:`int`
+    :param operation: 'FP' or 'BP'
+    :type operation: :class:`string`
+    """
+    cdef CProjectionOperator2D *thisptr
+    cdef int projector_id
+    cdef EProjectionOperation eOperation
+
+    def __cinit__(self, projector_id, operation):
+        cdef CProjector2DManager * manProj2D = <CProjector2DManager * >PyProjector2DManager.getSingletonPtr()
+        cdef CProjector2D * projector = manProj2D.get(projector_id)
+        if projector == NULL:
+            raise AstraError("Projector not found")
+        self.eOperation = _parseOperation(operation)
+        self.projector_id = projector_id
+        self.thisptr = new CProjectionOperator2D(projector, self.eOperation)
+        if not self.thisptr.isInitialized():
+            raise AstraError("Failed to initialize projection operator", append_log=True)
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    def apply(self, inp, out):
+        """Apply the operator, overwriting the contents of out.
+
+        Contiguous float32 numpy arrays of the right size are used directly;
+        other arrays are linked through DLPack, and must have the shape of the
+        projector geometries.
+
+        :param inp: The input data
+        :param out: The pre-allocated output data
+        """
+        cdef CProjector2DManager * manProj2D = <CProjector2DManager * >PyProjector2DManager.getSingletonPtr()
+        if manProj2D.get(self.projector_id) != self.thisptr.getProjector():
+            raise AstraError("Projector has been deleted")
+
+        cdef bool ret = True
+        cdef const float32 *pfIn
+        cdef float32 *pfOut
+        if _isDirectArray(inp, self.thisptr.getInputSize(), False) and _isDirectArray(out, self.thisptr.getOutputSize(), True):
+            pfIn = <const float32*>cnp.PyArray_DATA(inp)
+            pfOut = <float32*>cnp.PyArray_DATA(out)
+            with nogil:
+                ret = self.thisptr.apply(pfIn, pfOut)
+            if not ret:
+                raise AstraError("Failed to apply projection operator", append_log=True)
+            return
+
+        cdef CProjector2D * projector = self.thisptr.getProjector()
+        cdef CData2D * pIn = NULL
+        cdef CData2D * pOut = NULL
+        try:
+            if self.eOperation == OPERATION_FP:
+                pIn = linkVolFromGeometry2D(projector.getVolumeGeometry(), inp)
+                pOut = linkProjFromGeometry2D(projector.getProjectionGeometry(), out)
+            else:
+                pIn = linkProjFromGeometry2D(projector.getProjectionGeometry(), inp)
+                pOut = linkVolFromGeometry2D(projector.getVolumeGeometry(), out)
+            with nogil:
+                ret = self.thisptr.apply(pIn, pOut)
+            if not ret:
+                raise AstraError("Failed to apply projection operator", append_log=True)
+        finally:
+            del pIn
+            del pOut
+
+
+cdef class ProjectionOperator3D:
+    """Persistent forward or backprojection operator for a 3D projector.
+
+    See :class:`ProjectionOperator2D`.
+
+    :param projector_id: A 3D projector object handle
+    :type projector_id: :class:`int`
+    :param operation: 'FP' or 'BP'
+    :type operation: :class:`string`
+    """
+    cdef CProjectionOperator3D *thisptr
+    cdef int projector_id
+    cdef EProjectionOperation eOperation
+
+    def __cinit__(self, projector_id, operation):
+        cdef CProjector3DManager * manProj3D = <CProjector3DManager * >PyProjector3DManager.getSingletonPtr()
+        cdef CProjector3D * projector = manProj3D.get(projector_id)
+        if projector == NULL:
+            raise AstraError("Projector not found")
+        self.eOperation = _parseOperation(operation)
+        self.projector_id = projector_id
+        self.thisptr = new CProjectionOperator3D(projector, self.eOperation)
+        if not self.thisptr.isInitialized():
+            raise AstraError("Failed to initialize projection operator", append_log=True)
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    def apply(self, inp, out):
+        """Apply the operator, overwriting the contents of out.
+
+        See :meth:`ProjectionOperator2D.apply`.
+
+        :param inp: The input data
+        :param out: The pre-allocated output data
+        """
+        cdef CProjector3DManager * manProj3D = <CProjector3DManager * >PyProjector3DManager.getSingletonPtr()
+        if manProj3D.get(self.projector_id) != self.thisptr.getProjector():
+            raise AstraError("Projector has been deleted")
+
+        cdef bool ret = True
+        cdef const float32 *pfIn
+        cdef float32 *pfOut
+        if _isDirectArray(inp, self.thisptr.getInputSize(), False) and _isDirectArray(out, self.thisptr.getOutputSize(), True):
+            pfIn = <const float32*>cnp.PyArray_DATA(inp)
+            pfOut = <float32*>cnp.PyArray_DATA(out)
+            with nogil:
+                ret = self.thisptr.apply(pfIn, pfOut)
+            if not ret:
+                raise AstraError("Failed to apply projection operator", append_log=True)
+            return
+
+        cdef CProjector3D * projector = self.thisptr.getProjector()
+        cdef CData3D * pIn = NULL
+        cdef CData3D * pOut = NULL
+        try:
+            if self.eOperation == OPERATION_FP:
+                pIn = linkVolFromGeometry3D(projector.getVolumeGeometry(), inp)
+                pOut = linkProjFromGeometry3D(projector.getProjectionGeometry(), out)
+            else:
+                pIn = linkProjFromGeometry3D(projector.getProjectionGeometry(), inp)
+                pOut = linkVolFromGeometry3D(projector.getVolumeGeometry(), out)
+            with nogil:
+                ret = self.thisptr.apply(pIn, pOut)
+            if not ret:
+                raise AstraError("Failed to apply projection operator", append_log=True)
+        finally:
+            del pIn
+            del pOut
@@ -40,6 +40,7 @@ from . import data3d
 from . import projector
 from . import algorithm
 from . import pythonutils
+from . import astra
 
 from .log import AstraError
 
@@ -57,27 +58,50 @@ def clear():
     algorithm.clear()
 
 
-def data_op(op, data, scalar, gpu_core, mask=None):
+def data_op(op, data, scalar=None, gpu_core=None, mask=None):
     """Perform data operation on data.
 
+    The operation runs on the GPU if ``gpu_core`` is given, CUDA is
+    available and the data are 2D. Otherwise it runs on the CPU, which also
+    supports 3D data and the operations ``'$1-$2'``, ``'$1./$2'``,
+    ``'axpby'``, ``'clamp'``, ``'dot'`` and ``'norm'``. See
+    ``include/astra/DataOperationAlgorithm.h`` for details.
+
     :param op: Operation to perform.
     :param data: Data to perform operation on.
     :param scalar: Scalar argument to data operation.
-    :param gpu_core: GPU core to perform operation on.
+    :param gpu_core: GPU core to perform operation on, or None for the CPU.
     :param mask: Optional mask.
+    :returns: :class:`float` -- for ``'dot'`` and ``'norm'``, the result
 
     """
 
-    cfg = ac.astra_dict('DataOperation_CUDA')
+    if not isinstance(data, (list, tuple)):
+        data = [data]
+    cuda_ops = ('$1*s1', '$1.*s1', '$1/s1', '$1./s1', '$1+s1', '$1-s1',
+                '$1.*$2', '$1+$2')
+    use_gpu = (gpu_core is not None and astra.use_cuda() and
+               op.replace(' ', '') in cuda_ops and
+               all(astra.get_object_type(i) == 'data2d' for i in data))
+
+    cfg = ac.astra_dict('DataOperation_CUDA' if use_gpu else 'DataOperation')
     cfg['Operation'] = op
-    cfg['Scalar'] = scalar
+    if scalar is not None:
+        cfg['Scalar'] = scalar
+    elif use_gpu:
+        cfg['Scalar'] = 0
     cfg['DataId'] = data
     if not mask == None:
         cfg['MaskId'] = mask
-    cfg['option']['GPUindex'] = gpu_core
+    if use_gpu:
+        cfg['option']['GPUindex'] = gpu_core
     alg_id = algorithm.create(cfg)
-    algorithm.run(alg_id)
-    algorithm.delete(alg_id)
+    try:
+        algorithm.run(alg_id)
+        if not use_gpu and op.replace(' ', '') in ('dot', 'norm'):
+            return algorithm.get_data_operation_result(alg_id)
+    finally:
+        algorithm.delete(alg_id)
 
 
 def add_noise_to_sino(sinogram_in, I0, seed=None):
@@ -80,6 +80,16 @@ class OpTomo(scipy.sparse.linalg.LinearOperator):
 
         self.proj_id = proj_id
 
+        # Persistent operators, to avoid setting up data objects and
+        # algorithms on every projection
+        from .experimental import ProjectionOperator2D, ProjectionOperator3D
+        if self.data_mod is data2d:
+            self.fp_op = ProjectionOperator2D(proj_id, 'FP')
+            self.bp_op = ProjectionOperator2D(proj_id, 'BP')
+        else:
+            self.fp_op = ProjectionOperator3D(proj_id, 'FP')
+            self.bp_op = ProjectionOperator3D(proj_id, 'BP')
+
         self.transposeOpTomo = OpTomoTranspose(self)
         try:
             self.T = self.transposeOpTomo
@@ -173,20 +183,9 @@ class OpTomo(scipy.sparse.linalg.LinearOperator):
         """
 
         v = self.__checkArray(v, self.vshape)
-        vid = self.data_mod.link('-vol',self.vg,v)
         if out is None:
-            out = np.zeros(self.sshape,dtype=np.float32)
-        sid = self.data_mod.link('-sino',self.pg,out)
-
-        cfg = creators.astra_dict('FP'+self.appendString)
-        cfg['ProjectionDataId'] = sid
-        cfg['VolumeDataId'] = vid
-        cfg['ProjectorId'] = self.proj_id
-        fp_id = algorithm.create(cfg)
-        algorithm.run(fp_id)
-
-        algorithm.delete(fp_id)
-        self.data_mod.delete([vid,sid])
+            out = np.empty(self.sshape,dtype=np.float32)
+        self.fp_op.apply(v, out)
         return out
 
     def BP(self,s,out=None):
@@ -203,20 +202,9 @@ class OpTomo(scipy.sparse.linalg.LinearOperator):
         :type out: :class:`numpy.ndarray`
         """
         s = self.__checkArray(s, self.sshape)
-        sid = self.data_mod.link('-sino',self.pg,s)
         if out is None:
-            out = np.zeros(self.vshape,dtype=np.float32)
-        vid = self.data_mod.link('-vol',self.vg,out)
-
-        cfg = creators.astra_dict('BP'+self.appendString)
-        cfg['ProjectionDataId'] = sid
-        cfg['ReconstructionDataId'] = vid
-        cfg['ProjectorId'] = self.proj_id
-        bp_id = algorithm.create(cfg)
-        algorithm.run(bp_id)
-
-        algorithm.delete(bp_id)
-        self.data_mod.delete([vid,sid])
+            out = np.empty(self.vshape,dtype=np.float32)
+        self.bp_op.apply(s, out)
         return out
 
 
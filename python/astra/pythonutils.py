@@ -81,3 +81,42 @@ class GPULink(object):
         self.y = y
         self.z = z
         self.pitch = pitch
+
+
+class FileLink(object):
+    """Utility class for astra.data3d.link with a memory-mapped file
+
+    The file must contain float32 values in native byte order, in the same
+    layout as the arrays returned by astra.data3d.get, starting at byte
+    position offset.
+
+    mode is one of:
+
+    * 'r': map the file read-only. The data object can not be modified.
+    * 'r+': map the file read-write. Changes are written to the file.
+    * 'c': copy-on-write. Changes are kept in memory and not written to the file.
+    * 'w+': create or overwrite the file, and map it read-write.
+
+    The modes have the same meaning as for numpy.memmap.
+    """
+    def __init__(self, filename, mode='r+', offset=0):
+        if mode not in ('r', 'r+', 'c', 'w+'):
+            raise ValueError("mode must be one of 'r', 'r+', 'c', 'w+'")
+        self.filename = filename
+        self.mode = mode
+        self.offset = offset
+
+
+def bfloat16_to_float32(bits):
+    """Convert an array of raw bfloat16 values (as uint16) to float32."""
+    return (np.asarray(bits, dtype=np.uint16).astype(np.uint32) << 16).view(np.float32)
+
+def float32_to_bfloat16(data):
+    """Convert float32 values to raw bfloat16 values (as uint16), rounding
+    to nearest even."""
+    x = np.ascontiguousarray(data, dtype=np.float32).view(np.uint32)
+    r = ((x + 0x7fff + ((x >> 16) & 1)) >> 16).astype(np.uint16)
+    nan = np.isnan(x.view(np.float32))
+    if np.any(nan):
+        r[nan] = (x[nan] >> 16).astype(np.uint16) | 0x40
+    return r
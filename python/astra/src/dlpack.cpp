@@ -30,6 +30,7 @@ along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
 
 #include "astra/Data2D.h"
 #include "astra/Data3D.h"
+#include "astra/DLPack.h"
 
 #ifdef ASTRA_CUDA
 #include "astra/cuda/dlpack_support.h"
@@ -38,156 +39,30 @@ along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
 #include <Python.h>
 #include <cstdio>
 
-template<class DLT>
-class CDataStorageDLPackCPU : public astra::CDataMemory<float> {
-public:
-	CDataStorageDLPackCPU(DLT *tensor);
-	virtual ~CDataStorageDLPackCPU();
-
-protected:
-	DLT *m_pTensor;
-
-};
-
-template<class DLT>
-CDataStorageDLPackCPU<DLT>::CDataStorageDLPackCPU(DLT *tensor_m)
-	: m_pTensor(tensor_m)
-{
-	// We assume all sanity checks have already been done
-
-	uint8_t* data = static_cast<uint8_t*>(m_pTensor->dl_tensor.data);
-	data += m_pTensor->dl_tensor.byte_offset;
-
-	this->m_pfData = reinterpret_cast<float*>(data);
-}
-
-template<class DLT>
-CDataStorageDLPackCPU<DLT>::~CDataStorageDLPackCPU()
-{
-	if (m_pTensor) {
-		assert(m_pTensor->deleter);
-		m_pTensor->deleter(m_pTensor);
-	}
-	m_pTensor = nullptr;
-
-	// Prevent the parent destructor from deleting this memory
-	m_pfData = nullptr;
-}
-
-static void getNonSingletonDims(DLTensor *tensor,
-                                std::vector<int64_t> &nonsingular_dims,
-                                std::vector<int64_t> &nonsingular_strides)
-{
-	for (int i = 0; i < tensor->ndim; ++i) {
-		if (tensor->shape[i] > 1) {
-			nonsingular_dims.push_back(tensor->shape[i]);
-			nonsingular_strides.push_back(tensor->strides[i]);
-		}
-	}
-}
-
-static bool isContiguous(DLTensor *tensor)
-{
-	if (!tensor->strides)
-		return true;
-
-	// Ignore singleton dimensions as they don't affect contiguity and tensor producers
-	// may optionally set their strides to 1
-	std::vector<int64_t> non_singleton_dims, non_singleton_strides;
-	getNonSingletonDims(tensor, non_singleton_dims, non_singleton_strides);
-
-	if (non_singleton_dims.size() < 2)
-		return true;
-
-	int64_t accumulator = 1;
-	for (int i = non_singleton_dims.size() - 1; i >= 0; --i) {
-		if (non_singleton_strides[i] != accumulator)
-			return false;
-		accumulator *= non_singleton_dims[i];
-	}
-	return true;
-}
-
-
-template<size_t D>
-bool checkDLTensor(DLTensor *tensor, std::array<int, D> dims, std::string &error)
-{
-	// data type
-	if (tensor->dtype.code != kDLFloat || tensor->dtype.bits != 32)
-	{
-		error = "Data must be float32";
-		return false;
-	}
-	if (tensor->dtype.lanes != 1) {
-		error = "Data must be single-channel";
-		return false;
-	}
-
-	// shape
-	if constexpr (D == 2) {
-		if (tensor->ndim != 2) {
-			error = "Data must be two-dimensional";
-			return false;
-		}
-
-		if (tensor->shape[0] != dims[1] || tensor->shape[1] != dims[0])
-		{
-			error = astra::StringUtil::format("Data shape (%zd x %zd) does not match geometry (%d x %d)", tensor->shape[0], tensor->shape[1], dims[1], dims[0]);
-			return false;
-		}
-	}
-	if constexpr (D == 3) {
-		if (tensor->ndim != 3) {
-			error = "Data must be three-dimensional";
-			return false;
-		}
-
-		if (tensor->shape[0] != dims[2] || tensor->shape[1] != dims[1] ||
-		    tensor->shape[2] != dims[0])
-		{
-			error = astra::StringUtil::format("Data shape (%zd x %zd x %zd) does not match geometry (%d x %d x %d)", tensor->shape[0], tensor->shape[1], tensor->shape[2], dims[2], dims[1], dims[0]);
-			return false;
-		}
-	}
-
-	if (!isContiguous(tensor)) {
-		error = "Data must be contiguous";
-		return false;
-	}
-
-	error = "";
-	return true;
-}
-
-
 template<class DLT, size_t D>
-astra::CDataStorage *getDLTensorStorage(DLT *tensor_m, std::array<int, D> dims, std::string &error)
+astra::CDataStorage *getDLTensorStorage(DLT *tensor_m, std::array<int, D> dims, std::string &error, bool allowCopy)
 {
 	DLTensor *tensor = &tensor_m->dl_tensor;
 
 #ifdef ASTRA_CUDA
 	if (astraCUDA::isSupportedDLPackGPUType(tensor->device.device_type)) {
-		if (!checkDLTensor(tensor, dims, error))
+		if (!astra::checkDLTensor(tensor, dims, error))
 			return nullptr;
+		if (!astra::isContiguousDLTensor(tensor)) {
+			error = "Data must be contiguous";
+			return nullptr;
+		}
 		return astraCUDA::wrapDLTensor(tensor_m);
 	}
 #endif
 
-	switch (tensor->device.device_type) {
-	case kDLCPU:
-	case kDLCUDAHost:
-	case kDLROCMHost:
-		if (!checkDLTensor(tensor, dims, error))
-			return nullptr;
-		return new CDataStorageDLPackCPU(tensor_m);
-	default:
-		error = "Unsupported dlpack device type";
-		return nullptr;
-	}
+	// Host memory is linked without copying if possible, and copied
+	// (and copied back when the data object is deleted) otherwise
+	return astra::wrapDLTensorCPU(tensor_m, dims, error, allowCopy);
 }
 
 template<size_t D>
-astra::CDataStorage *getDLTensorStorage(PyObject *obj, std::array<int, D> dims, std::string &error)
+astra::CDataStorage *getDLTensorStorage(PyObject *obj, std::array<int, D> dims, std::string &error, bool allowCopy)
 {
 	if (!PyCapsule_CheckExact(obj)) {
 		error = "Invalid capsule";
@@ -204,7 +79,7 @@ astra::CDataStorage *getDLTensorStorage(PyObject *obj, std::array<int, D> dims,
 			return nullptr;
 		}
 		DLManagedTensor *tensor_m = static_cast<DLManagedTensor*>(ptr);
-		storage = getDLTensorStorage(tensor_m, dims, error);
+		storage = getDLTensorStorage(tensor_m, dims, error, allowCopy);
 
 		if (storage) {
 			// All checks passed, so we can officially consume this dltensor
@@ -235,7 +110,7 @@ astra::CDataStorage *getDLTensorStorage(PyObject *obj, std::array<int, D> dims,
 		// input and output objects, we may want to return an error
 		// when using a copied tensor for output.
 
-		storage = getDLTensorStorage(tensor_m, dims, error);
+		storage = getDLTensorStorage(tensor_m, dims, error, allowCopy);
 		if (storage) {
 			// All checks passed, so we can officially consume this dltensor
 			PyCapsule_SetName(obj, "used_dltensor_versioned");
@@ -245,7 +120,7 @@ astra::CDataStorage *getDLTensorStorage(PyObject *obj, std::array<int, D> dims,
 	return storage;
 }
 
-astra::CFloat32VolumeData2D* getDLTensor(PyObject *obj, const astra::CVolumeGeometry2D &pGeom, std::string &error)
+astra::CFloat32VolumeData2D* getDLTensor(PyObject *obj, const astra::CVolumeGeometry2D &pGeom, std::string &error, bool allowCopy)
 {
 	if (!PyCapsule_CheckExact(obj))
 		return nullptr;
@@ -253,13 +128,13 @@ astra::CFloat32VolumeData2D* getDLTensor(PyObject *obj, const astra::CVolumeGeom
 	// x,y,z
 	std::array<int, 2> dims{pGeom.getGridColCount(), pGeom.getGridRowCount()};
 
-	astra::CDataStorage *storage = getDLTensorStorage(obj, dims, error);
+	astra::CDataStorage *storage = getDLTensorStorage(obj, dims, error, allowCopy);
 	if (!storage)
 		return nullptr;
 
 	return new astra::CFloat32VolumeData2D(pGeom, storage);
 }
-astra::CFloat32ProjectionData2D* getDLTensor(PyObject *obj, const astra::CProjectionGeometry2D &pGeom, std::string &error)
+astra::CFloat32ProjectionData2D* getDLTensor(PyObject *obj, const astra::CProjectionGeometry2D &pGeom, std::string &error, bool allowCopy)
 {
 	if (!PyCapsule_CheckExact(obj))
 		return nullptr;
@@ -267,14 +142,14 @@ astra::CFloat32ProjectionData2D* getDLTensor(PyObject *obj, const astra::CProjec
 	// x,y,z
 	std::array<int, 2> dims{pGeom.getDetectorCount(), pGeom.getProjectionAngleCount()};
 
-	astra::CDataStorage *storage = getDLTensorStorage(obj, dims, error);
+	astra::CDataStorage *storage = getDLTensorStorage(obj, dims, error, allowCopy);
 	if (!storage)
 		return nullptr;
 
 	return new astra::CFloat32ProjectionData2D(pGeom, storage);
 }
 
-astra::CFloat32VolumeData3D* getDLTensor(PyObject *obj, const astra::CVolumeGeometry3D &pGeom, std::string &error)
+astra::CFloat32VolumeData3D* getDLTensor(PyObject *obj, const astra::CVolumeGeometry3D &pGeom, std::string &error, bool allowCopy)
 {
 	if (!PyCapsule_CheckExact(obj))
 		return nullptr;
@@ -282,13 +157,13 @@ astra::CFloat32VolumeData3D* getDLTensor(PyObject *obj, const astra::CVolumeGeom
 	// x,y,z
 	std::array<int, 3> dims{pGeom.getGridColCount(), pGeom.getGridRowCount(), pGeom.getGridSliceCount()};
 
-	astra::CDataStorage *storage = getDLTensorStorage(obj, dims, error);
+	astra::CDataStorage *storage = getDLTensorStorage(obj, dims, error, allowCopy);
 	if (!storage)
 		return nullptr;
 
 	return new astra::CFloat32VolumeData3D(pGeom, storage);
 }
-astra::CFloat32ProjectionData3D* getDLTensor(PyObject *obj, const astra::CProjectionGeometry3D &pGeom, std::string &error)
+astra::CFloat32ProjectionData3D* getDLTensor(PyObject *obj, const astra::CProjectionGeometry3D &pGeom, std::string &error, bool allowCopy)
 {
 	if (!PyCapsule_CheckExact(obj))
 		return nullptr;
@@ -296,9 +171,77 @@ astra::CFloat32ProjectionData3D* getDLTensor(PyObject *obj, const astra::CProjec
 	// x,y,z
 	std::array<int, 3> dims{pGeom.getDetectorColCount(), pGeom.getProjectionCount(), pGeom.getDetectorRowCount()};
 
-	astra::CDataStorage *storage = getDLTensorStorage(obj, dims, error);
+	astra::CDataStorage *storage = getDLTensorStorage(obj, dims, error, allowCopy);
 	if (!storage)
 		return nullptr;
 
 	return new astra::CFloat32ProjectionData3D(pGeom, storage);
 }
+
+
+// Capsule destructor, as recommended by the DLPack Python specification:
+// delete the tensor only if the capsule was never consumed
+template<class DLT>
+static void dlpackCapsuleDestructor(PyObject *capsule)
+{
+	const char *name = std::is_same_v<DLT, DLManagedTensorVersioned> ? "dltensor_versioned" : "dltensor";
+	if (!PyCapsule_IsValid(capsule, name))
+		return;
+
+	PyObject *type, *value, *traceback;
+	PyErr_Fetch(&type, &value, &traceback);
+
+	DLT *tensor_m = static_cast<DLT*>(PyCapsule_GetPointer(capsule, name));
+	if (tensor_m) {
+		if (tensor_m->deleter)
+			tensor_m->deleter(tensor_m);
+	} else {
+		PyErr_WriteUnraisable(capsule);
+	}
+
+	PyErr_Restore(type, value, traceback);
+}
+
+template<class DLT, size_t D>
+static PyObject *createDLPackCapsule(astra::CData<D> *data, PyObject *owner)
+{
+	// Keep the owner alive for as long as the tensor exists. The deleter
+	// may be called by the consumer from any thread.
+	Py_XINCREF(owner);
+	auto onDelete = [owner]() {
+		PyGILState_STATE state = PyGILState_Ensure();
+		Py_XDECREF(owner);
+		PyGILState_Release(state);
+	};
+
+	std::string error;
+	DLT *tensor_m = astra::exportDLTensor<DLT>(data, onDelete, error);
+	if (!tensor_m) {
+		Py_XDECREF(owner);
+		PyErr_SetString(PyExc_BufferError, error.c_str());
+		return nullptr;
+	}
+
+	const char *name = std::is_same_v<DLT, DLManagedTensorVersioned> ? "dltensor_versioned" : "dltensor";
+	PyObject *capsule = PyCapsule_New(tensor_m, name, dlpackCapsuleDestructor<DLT>);
+	if (!capsule)
+		tensor_m->deleter(tensor_m);
+
+	return capsule;
+}
+
+PyObject *createDLPackCapsule(astra::CData2D *data, PyObject *owner, bool versioned)
+{
+	if (versioned)
+		return createDLPackCapsule<DLManagedTensorVersioned>(data, owner);
+	else
+		return createDLPackCapsule<DLManagedTensor>(data, owner);
+}
+
+PyObject *createDLPackCapsule(astra::CData3D *data, PyObject *owner, bool versioned)
+{
+	if (versioned)
+		return createDLPackCapsule<DLManagedTensorVersioned>(data, owner);
+	else
+		return createDLPackCapsule<DLManagedTensor>(data, owner);
+}
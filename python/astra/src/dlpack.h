@@ -29,16 +29,25 @@ along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
 #define ASTRA_PYTHON_SRC_DLPACK_H
 
 namespace astra {
+	class CData2D;
+	class CData3D;
 	class CFloat32VolumeData3D;
 	class CVolumeGeometry3D;
 	class CFloat32ProjectionData3D;
 	class CProjectionGeometry3D;
 }
 
-astra::CFloat32ProjectionData2D* getDLTensor(PyObject *obj, const astra::CProjectionGeometry2D &pGeom, std::string &error);
-astra::CFloat32VolumeData2D* getDLTensor(PyObject *obj, const astra::CVolumeGeometry2D &pGeom, std::string &error);
-astra::CFloat32ProjectionData3D* getDLTensor(PyObject *obj, const astra::CProjectionGeometry3D &pGeom, std::string &error);
-astra::CFloat32VolumeData3D* getDLTensor(PyObject *obj, const astra::CVolumeGeometry3D &pGeom, std::string &error);
+// Link a DLPack capsule as a data object. Host memory with an unsupported
+// layout is copied if allowCopy is set (see astra::wrapDLTensorCPU).
+astra::CFloat32ProjectionData2D* getDLTensor(PyObject *obj, const astra::CProjectionGeometry2D &pGeom, std::string &error, bool allowCopy);
+astra::CFloat32VolumeData2D* getDLTensor(PyObject *obj, const astra::CVolumeGeometry2D &pGeom, std::string &error, bool allowCopy);
+astra::CFloat32ProjectionData3D* getDLTensor(PyObject *obj, const astra::CProjectionGeometry3D &pGeom, std::string &error, bool allowCopy);
+astra::CFloat32VolumeData3D* getDLTensor(PyObject *obj, const astra::CVolumeGeometry3D &pGeom, std::string &error, bool allowCopy);
+
+// Export the memory of a data object as a DLPack capsule, keeping owner
+// alive until the tensor is deleted. Sets a Python exception on failure.
+PyObject *createDLPackCapsule(astra::CData2D *data, PyObject *owner, bool versioned);
+PyObject *createDLPackCapsule(astra::CData3D *data, PyObject *owner, bool versioned);
 void dump_dltensor_info(PyObject *obj);
 
 #endif
@@ -28,7 +28,9 @@
 import sys
 cimport numpy as np
 import numpy as np
+np.import_array()
 import builtins
+import os
 from libcpp.string cimport string
 from libcpp.vector cimport vector
 from libcpp.list cimport list
@@ -41,7 +43,7 @@ from .PyXMLDocument cimport XMLDocument
 from .PyXMLDocument cimport XMLNode
 from .PyIncludes cimport *
 
-from .pythonutils import GPULink
+from .pythonutils import GPULink, FileLink
 from .log import AstraError
 
 cdef extern from "Python.h":
@@ -51,10 +53,12 @@ cdef extern from *:
     XMLConfig* dynamic_cast_XMLConfig "dynamic_cast<astra::XMLConfig*>" (Config*)
 
 cdef extern from "src/dlpack.h":
-    CFloat32VolumeData2D* getDLTensor(obj, const CVolumeGeometry2D &pGeom, string &error)
-    CFloat32ProjectionData2D* getDLTensor(obj, const CProjectionGeometry2D &pGeom, string &error)
-    CFloat32VolumeData3D* getDLTensor(obj, const CVolumeGeometry3D &pGeom, string &error)
-    CFloat32ProjectionData3D* getDLTensor(obj, const CProjectionGeometry3D &pGeom, string &error)
+    CFloat32VolumeData2D* getDLTensor(obj, const CVolumeGeometry2D &pGeom, string &error, bool allowCopy)
+    CFloat32ProjectionData2D* getDLTensor(obj, const CProjectionGeometry2D &pGeom, string &error, bool allowCopy)
+    CFloat32VolumeData3D* getDLTensor(obj, const CVolumeGeometry3D &pGeom, string &error, bool allowCopy)
+    CFloat32ProjectionData3D* getDLTensor(obj, const CProjectionGeometry3D &pGeom, string &error, bool allowCopy)
+    object createDLPackCapsule(CData2D *data, object owner, bool versioned)
+    object createDLPackCapsule(CData3D *data, object owner, bool versioned)
 
 
 
@@ -211,6 +215,21 @@ def stringToPythonValue(inputIn):
             return str(input)
 
 
+cdef XMLNodeContent2python(XMLNode node):
+    cdef const double *data
+    cdef int width
+    cdef int height
+    cdef np.npy_intp shape[2]
+    if node.getContentBinaryArray(data, width, height):
+        # binary numerical arrays are copied directly, without going via text
+        if height == 0:
+            shape[0] = width
+            return np.PyArray_SimpleNewFromData(1,shape,np.NPY_FLOAT64,<void *>data).copy()
+        shape[0] = height
+        shape[1] = width
+        return np.PyArray_SimpleNewFromData(2,shape,np.NPY_FLOAT64,<void *>data).copy()
+    return stringToPythonValue(node.getContent())
+
 cdef XMLNode2dict(XMLNode node):
     cdef XMLNode subnode
     cdef list[XMLNode] nodes
@@ -227,9 +246,9 @@ cdef XMLNode2dict(XMLNode node):
             if subnode.hasAttribute(b'value'):
                 opts[castString(subnode.getAttribute(b'key'))] = stringToPythonValue(subnode.getAttribute(b'value'))
             else:
-                opts[castString(subnode.getAttribute(b'key'))] = stringToPythonValue(subnode.getContent())
+                opts[castString(subnode.getAttribute(b'key'))] = XMLNodeContent2python(subnode)
         else:
-            dct[castString(subnode.getName())] = stringToPythonValue(subnode.getContent())
+            dct[castString(subnode.getName())] = XMLNodeContent2python(subnode)
         inc(it)
     if len(opts)>0: dct['options'] = opts
     return dct
@@ -258,7 +277,13 @@ def getDLPackCapsule(data):
         return None
     return capsule
 
-cdef CFloat32VolumeData2D* linkVolFromGeometry2D(const CVolumeGeometry2D &pGeometry, data) except NULL:
+cdef createDLPackCapsule2D(CData2D *data, owner, bool versioned):
+    return createDLPackCapsule(data, owner, versioned)
+
+cdef createDLPackCapsule3D(CData3D *data, owner, bool versioned):
+    return createDLPackCapsule(data, owner, versioned)
+
+cdef CFloat32VolumeData2D* linkVolFromGeometry2D(const CVolumeGeometry2D &pGeometry, data, bool allowCopy=True) except NULL:
     cdef CFloat32VolumeData2D * pDataObject2D = NULL
     cdef CDataStorage * pStorage
     cdef string dlerror = b""
@@ -266,7 +291,7 @@ cdef CFloat32VolumeData2D* linkVolFromGeometry2D(const CVolumeGeometry2D &pGeome
     # TODO: investigate the stream argument to __dlpack__().
     capsule = getDLPackCapsule(data)
     if capsule is not None:
-        pDataObject2D = getDLTensor(capsule, pGeometry, dlerror)
+        pDataObject2D = getDLTensor(capsule, pGeometry, dlerror, allowCopy)
         if not pDataObject2D:
             raise ValueError("Failed to link dlpack array: " + wrap_from_bytes(dlerror))
         return pDataObject2D
@@ -274,7 +299,7 @@ cdef CFloat32VolumeData2D* linkVolFromGeometry2D(const CVolumeGeometry2D &pGeome
     raise TypeError("Data should be an array with DLPack support")
 
 
-cdef CFloat32ProjectionData2D* linkProjFromGeometry2D(const CProjectionGeometry2D &pGeometry, data) except NULL:
+cdef CFloat32ProjectionData2D* linkProjFromGeometry2D(const CProjectionGeometry2D &pGeometry, data, bool allowCopy=True) except NULL:
     cdef CFloat32ProjectionData2D * pDataObject2D = NULL
     cdef CDataStorage * pStorage
     cdef string dlerror = b""
@@ -282,14 +307,36 @@ cdef CFloat32ProjectionData2D* linkProjFromGeometry2D(const CProjectionGeometry2
     # TODO: investigate the stream argument to __dlpack__().
     capsule = getDLPackCapsule(data)
     if capsule is not None:
-        pDataObject2D = getDLTensor(capsule, pGeometry, dlerror)
+        pDataObject2D = getDLTensor(capsule, pGeometry, dlerror, allowCopy)
         if not pDataObject2D:
             raise ValueError("Failed to link dlpack array: " + wrap_from_bytes(dlerror))
         return pDataObject2D
 
     raise TypeError("Data should be an array with DLPack support")
 
-cdef CFloat32VolumeData3D* linkVolFromGeometry3D(const CVolumeGeometry3D &pGeometry, data) except NULL:
+cdef CDataStorage* mapFile(filename, mode, size_t offset, size_t size) except NULL:
+    cdef EMemoryMapMode eMode
+    cdef CDataMemoryMapped[float32] *pStorage
+    cdef string sFilename = os.fsencode(filename)
+
+    if mode == 'r':
+        eMode = MEMMAP_READONLY
+    elif mode == 'r+':
+        eMode = MEMMAP_READWRITE
+    elif mode == 'c':
+        eMode = MEMMAP_COPYONWRITE
+    elif mode == 'w+':
+        eMode = MEMMAP_CREATE
+    else:
+        raise ValueError("Invalid file mapping mode '{}'".format(mode))
+
+    pStorage = new CDataMemoryMapped[float32](sFilename, size, eMode, offset)
+    if not pStorage.isMapped():
+        del pStorage
+        raise AstraError("Could not map file {}".format(filename), append_log=True)
+    return pStorage
+
+cdef CFloat32VolumeData3D* linkVolFromGeometry3D(const CVolumeGeometry3D &pGeometry, data, bool allowCopy=True) except NULL:
     cdef CFloat32VolumeData3D * pDataObject3D = NULL
     cdef CDataStorage * pStorage
     cdef string dlerror = b""
@@ -297,7 +344,7 @@ cdef CFloat32VolumeData3D* linkVolFromGeometry3D(const CVolumeGeometry3D &pGeome
     # TODO: investigate the stream argument to __dlpack__().
     capsule = getDLPackCapsule(data)
     if capsule is not None:
-        pDataObject3D = getDLTensor(capsule, pGeometry, dlerror)
+        pDataObject3D = getDLTensor(capsule, pGeometry, dlerror, allowCopy)
         if not pDataObject3D:
             raise ValueError("Failed to link dlpack array: " + wrap_from_bytes(dlerror))
         return pDataObject3D
@@ -316,10 +363,15 @@ cdef CFloat32VolumeData3D* linkVolFromGeometry3D(const CVolumeGeometry3D &pGeome
         pDataObject3D = new CFloat32VolumeData3D(pGeometry, pStorage)
         return pDataObject3D
 
-    raise TypeError("Data should be an array with DLPack support, or a GPULink object")
+    if isinstance(data, FileLink):
+        pStorage = mapFile(data.filename, data.mode, data.offset, pGeometry.getGridTotCount())
+        pDataObject3D = new CFloat32VolumeData3D(pGeometry, pStorage)
+        return pDataObject3D
 
+    raise TypeError("Data should be an array with DLPack support, or a GPULink or FileLink object")
 
-cdef CFloat32ProjectionData3D* linkProjFromGeometry3D(const CProjectionGeometry3D &pGeometry, data) except NULL:
+
+cdef CFloat32ProjectionData3D* linkProjFromGeometry3D(const CProjectionGeometry3D &pGeometry, data, bool allowCopy=True) except NULL:
     cdef CFloat32ProjectionData3D * pDataObject3D = NULL
     cdef CDataStorage * pStorage
     cdef string dlerror = b""
@@ -327,7 +379,7 @@ cdef CFloat32ProjectionData3D* linkProjFromGeometry3D(const CProjectionGeometry3
     # TODO: investigate the stream argument to __dlpack__().
     capsule = getDLPackCapsule(data)
     if capsule is not None:
-        pDataObject3D = getDLTensor(capsule, pGeometry, dlerror)
+        pDataObject3D = getDLTensor(capsule, pGeometry, dlerror, allowCopy)
         if not pDataObject3D:
             raise ValueError("Failed to link dlpack array: " + wrap_from_bytes(dlerror))
         return pDataObject3D
@@ -346,7 +398,12 @@ cdef CFloat32ProjectionData3D* linkProjFromGeometry3D(const CProjectionGeometry3
         pDataObject3D = new CFloat32ProjectionData3D(pGeometry, pStorage)
         return pDataObject3D
 
-    raise TypeError("Data should be an array with DLPack support, or a GPULink object")
+    if isinstance(data, FileLink):
+        pStorage = mapFile(data.filename, data.mode, data.offset, <size_t>pGeometry.getProjectionCount() * pGeometry.getDetectorTotCount())
+        pDataObject3D = new CFloat32ProjectionData3D(pGeometry, pStorage)
+        return pDataObject3D
+
+    raise TypeError("Data should be an array with DLPack support, or a GPULink or FileLink object")
 
 cdef unique_ptr[CProjectionGeometry2D] createProjectionGeometry2D(geometry) except *:
     cdef XMLConfig *cfg
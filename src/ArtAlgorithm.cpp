@@ -30,6 +30,7 @@ along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
 #include "astra/AstraObjectManager.h"
 
 #include "astra/Logging.h"
+#include "astra/Profiler.h"
 
 using namespace std;
 
@@ -191,10 +192,20 @@ void CArtAlgorithm::setRayOrder(int* _piProjectionOrder, int* _piDetectorOrder,
 	}
 }
 
+//----------------------------------------------------------------------------------------
+// Reset
+void CArtAlgorithm::reset()
+{
+	CReconstructionAlgorithm2D::reset();
+	m_iCurrentRay = 0;
+}
+
 //----------------------------------------------------------------------------------------
 // Iterate
 bool CArtAlgorithm::run(int _iNrIterations)
 {
+	ASTRA_PROFILE_SCOPE(profile, "algorithm/ART");
+
 	// check initialized
 	assert(m_bIsInitialized);
 	
@@ -31,6 +31,7 @@ along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
 #include "astra/DataProjectorPolicies.h"
 
 #include "astra/Logging.h"
+#include "astra/Profiler.h"
 
 using namespace std;
 
@@ -69,8 +70,8 @@ bool CBackProjectionAlgorithm::_check()
 	// check base class
 	ASTRA_CONFIG_CHECK(CReconstructionAlgorithm2D::_check(), "BP", "Error in ReconstructionAlgorithm2D initialization");
 
-	ASTRA_CONFIG_CHECK(m_pSinogram->isFloat32Memory(), "BP", "Projection data object not a float32 host memory object");
-	ASTRA_CONFIG_CHECK(m_pReconstruction->isFloat32Memory(), "BP", "Reconstruction data object not a float32 host memory object");
+	ASTRA_CONFIG_CHECK(m_pSinogram->isFloatMemory(), "BP", "Projection data object not a float32/float16/bfloat16 host memory object");
+	ASTRA_CONFIG_CHECK(m_pReconstruction->isFloatMemory(), "BP", "Reconstruction data object not a float32/float16/bfloat16 host memory object");
 
 	ASTRA_CONFIG_CHECK(!m_bUseSinogramMask || m_pSinogramMask->isFloat32Memory(), "BP", "Projection mask object not a float32 host memory object");
 	ASTRA_CONFIG_CHECK(!m_bUseReconstructionMask || m_pReconstructionMask->isFloat32Memory(), "BP", "Reconstruction mask object not a float32 host memory object");
@@ -114,28 +115,84 @@ bool CBackProjectionAlgorithm::initialize(CProjector2D* _pProjector,
 	return m_bIsInitialized;
 }
 
+//----------------------------------------------------------------------------------------
+// Back projection data projector converting the projection data on load
+template<typename TProj>
+static CDataProjectorInterface *dispatchConvertingBP(CProjector2D *_pProjector,
+                                                     CFloat32VolumeData2D *_pVolume, CFloat32ProjectionData2D *_pSinogram,
+                                                     CFloat32VolumeData2D *_pVolumeMask, CFloat32ProjectionData2D *_pSinogramMask,
+                                                     bool _bUseVolumeMask, bool _bUseSinogramMask)
+{
+	return dispatchDataProjector(
+			_pProjector,
+			SinogramMaskPolicy(_pSinogramMask),
+			ReconstructionMaskPolicy(_pVolumeMask),
+			ConvertingBPPolicy<TProj>(_pVolume->getFloat32Memory(), _pSinogram->getMemory<TProj>()),
+			_bUseSinogramMask, _bUseVolumeMask, true
+		);
+}
+
 //----------------------------------------------------------------------------------------
 // Iterate
 bool CBackProjectionAlgorithm::run(int _iNrIterations)
 {
+	ASTRA_PROFILE_SCOPE(profile, "algorithm/BP");
+
 	// check initialized
 	ASTRA_ASSERT(m_bIsInitialized);
 
 	CDataProjectorInterface* pBackProjector;
 
-	pBackProjector = dispatchDataProjector(
-			m_pProjector, 
-			SinogramMaskPolicy(m_pSinogramMask),														// sinogram mask
-			ReconstructionMaskPolicy(m_pReconstructionMask),											// reconstruction mask
-			DefaultBPPolicy(m_pReconstruction, m_pSinogram), // backprojection
-			m_bUseSinogramMask, m_bUseReconstructionMask, true // options on/off
-		); 
+	// with a volume window, only its pixels are masked in
+	prepareVolumeWindow(false);
+	CFloat32VolumeData2D *pReconstructionMask = getEffectiveReconstructionMask();
+	const bool bUseReconstructionMask = (pReconstructionMask != nullptr);
+
+	// only visit the active rays and pixels of the masks
+	const CMaskIndex *pMaskIndex = getMaskIndex();
+
+	if (m_pReconstruction->isFloat32Memory() && m_pSinogram->isFloat32Memory()) {
+		pBackProjector = dispatchDataProjector(
+				m_pProjector, 
+				SinogramMaskPolicy(m_pSinogramMask),														// sinogram mask
+				ReconstructionMaskPolicy(pReconstructionMask),											// reconstruction mask
+				DefaultBPPolicy(m_pReconstruction, m_pSinogram), // backprojection
+				m_bUseSinogramMask, bUseReconstructionMask, true // options on/off
+			); 
+		pBackProjector->setMaskIndex(pMaskIndex);
+
+		m_pReconstruction->setData(0.0f);
+		pBackProjector->project();
 
-	m_pReconstruction->setData(0.0f);
+		ASTRA_DELETE(pBackProjector);
+
+		return true;
+	}
+
+	// 16-bit data: accumulate in a float32 volume, and convert at the end
+	CFloat32VolumeData2D *pVolume = m_pReconstruction;
+	if (!m_pReconstruction->isFloat32Memory())
+		pVolume = createCFloat32VolumeData2DPooled(m_pReconstruction->getGeometry());
+
+	if (m_pSinogram->isFloat16Memory())
+		pBackProjector = dispatchConvertingBP<float16>(m_pProjector, pVolume, m_pSinogram, pReconstructionMask, m_pSinogramMask, bUseReconstructionMask, m_bUseSinogramMask);
+	else if (m_pSinogram->isBFloat16Memory())
+		pBackProjector = dispatchConvertingBP<bfloat16>(m_pProjector, pVolume, m_pSinogram, pReconstructionMask, m_pSinogramMask, bUseReconstructionMask, m_bUseSinogramMask);
+	else
+		pBackProjector = dispatchConvertingBP<float32>(m_pProjector, pVolume, m_pSinogram, pReconstructionMask, m_pSinogramMask, bUseReconstructionMask, m_bUseSinogramMask);
+
+	pBackProjector->setMaskIndex(pMaskIndex);
+
+	pVolume->setData(0.0f);
 	pBackProjector->project();
 
 	ASTRA_DELETE(pBackProjector);
 
+	if (pVolume != m_pReconstruction) {
+		m_pReconstruction->copyData(*pVolume);
+		delete pVolume;
+	}
+
 	return true;
 }
 //----------------------------------------------------------------------------------------
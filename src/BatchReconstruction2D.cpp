@@ -0,0 +1,271 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+#include "astra/BatchReconstruction2D.h"
+
+#include "astra/ReconstructionAlgorithm2D.h"
+#include "astra/AstraObjectFactory.h"
+#include "astra/AstraObjectManager.h"
+#include "astra/Data2D.h"
+#include "astra/Data3D.h"
+#include "astra/Projector2D.h"
+#include "astra/XMLConfig.h"
+#include "astra/Logging.h"
+#include "astra/ThreadPool.h"
+
+#include <algorithm>
+#include <exception>
+#include <memory>
+
+namespace astra {
+
+static CReconstructionAlgorithm2D *createAlgorithm(const std::string &_sType)
+{
+	CAlgorithm *pAlg = CAlgorithmFactory::getSingleton().create(_sType);
+	CReconstructionAlgorithm2D *pAlg2D = dynamic_cast<CReconstructionAlgorithm2D*>(pAlg);
+	if (!pAlg2D)
+		delete pAlg;
+	return pAlg2D;
+}
+
+CBatchReconstruction2D::CBatchReconstruction2D()
+	: m_bIsInitialized(false), m_pConfig(nullptr), m_pProjector(nullptr),
+	  m_iThreads(0), m_pProgress(nullptr), m_pProgressCtx(nullptr),
+	  m_bAbort(false), m_iNextSlice(0)
+{
+
+}
+
+CBatchReconstruction2D::~CBatchReconstruction2D()
+{
+
+}
+
+bool CBatchReconstruction2D::initialize(XMLConfig *_pAlgorithmConfig)
+{
+	m_bIsInitialized = false;
+
+	if (!_pAlgorithmConfig) {
+		ASTRA_ERROR("CBatchReconstruction2D: no algorithm configuration");
+		return false;
+	}
+
+	XMLNode node = _pAlgorithmConfig->self.getSingleNode("ProjectorId");
+	if (!node) {
+		ASTRA_ERROR("CBatchReconstruction2D: algorithm configuration has no ProjectorId");
+		return false;
+	}
+	int id;
+	try {
+		id = node.getContentInt();
+	} catch (const StringUtil::bad_cast &) {
+		ASTRA_ERROR("CBatchReconstruction2D: invalid ProjectorId");
+		return false;
+	}
+	m_pProjector = CProjector2DManager::getSingleton().get(id);
+	if (!m_pProjector || !m_pProjector->isInitialized()) {
+		ASTRA_ERROR("CBatchReconstruction2D: invalid projector");
+		return false;
+	}
+
+	m_sAlgorithmType = _pAlgorithmConfig->self.getAttribute("type");
+	std::unique_ptr<CReconstructionAlgorithm2D> pAlg(createAlgorithm(m_sAlgorithmType));
+	if (!pAlg) {
+		ASTRA_ERROR("CBatchReconstruction2D: %s is not a 2D reconstruction algorithm", m_sAlgorithmType.c_str());
+		return false;
+	}
+
+	m_pConfig = _pAlgorithmConfig;
+	m_bIsInitialized = true;
+	return true;
+}
+
+size_t CBatchReconstruction2D::getSinogramSize() const
+{
+	ASTRA_ASSERT(m_bIsInitialized);
+	const CProjectionGeometry2D &projGeom = m_pProjector->getProjectionGeometry();
+	return (size_t)projGeom.getProjectionAngleCount() * projGeom.getDetectorCount();
+}
+
+size_t CBatchReconstruction2D::getSliceSize() const
+{
+	ASTRA_ASSERT(m_bIsInitialized);
+	return m_pProjector->getVolumeGeometry().getGridTotCount();
+}
+
+bool CBatchReconstruction2D::run(const CFloat32ProjectionData3D *_pSinograms, CFloat32VolumeData3D *_pVolumes, int _iIterations)
+{
+	ASTRA_ASSERT(m_bIsInitialized);
+
+	if (!_pSinograms->isFloat32Memory() || !_pVolumes->isFloat32Memory()) {
+		ASTRA_ERROR("CBatchReconstruction2D: data objects must be float32 host memory");
+		return false;
+	}
+
+	const CProjectionGeometry2D &projGeom = m_pProjector->getProjectionGeometry();
+	const CVolumeGeometry2D &volGeom = m_pProjector->getVolumeGeometry();
+
+	if (_pSinograms->getDetectorColCount() != projGeom.getDetectorCount() ||
+	    _pSinograms->getAngleCount() != projGeom.getProjectionAngleCount()) {
+		ASTRA_ERROR("CBatchReconstruction2D: projection data does not match the projection geometry of the projector");
+		return false;
+	}
+	if (_pVolumes->getColCount() != volGeom.getGridColCount() ||
+	    _pVolumes->getRowCount() != volGeom.getGridRowCount()) {
+		ASTRA_ERROR("CBatchReconstruction2D: volume data does not match the volume geometry of the projector");
+		return false;
+	}
+	if (_pSinograms->getDetectorRowCount() != _pVolumes->getSliceCount()) {
+		ASTRA_ERROR("CBatchReconstruction2D: number of detector rows and volume slices differ");
+		return false;
+	}
+
+	return run(_pSinograms->getFloat32Memory(), _pVolumes->getFloat32Memory(),
+	           _pVolumes->getSliceCount(), _iIterations);
+}
+
+bool CBatchReconstruction2D::run(const float32 *_pfSinograms, float32 *_pfVolumes, int _iSlices, int _iIterations)
+{
+	ASTRA_ASSERT(m_bIsInitialized);
+
+	m_status.assign(std::max(_iSlices, 0), SBatchSliceStatus());
+	if (_iSlices <= 0)
+		return true;
+
+	m_bAbort = false;
+	m_iNextSlice = 0;
+
+	int iPoolThreads = getNumThreads();
+	int iThreads = m_iThreads;
+	if (iThreads <= 0)
+		iThreads = iPoolThreads;
+	iThreads = std::min(iThreads, _iSlices);
+
+	// With fewer slices than threads, one worker per slice would leave the
+	// other threads idle. Reconstruct the slices one at a time instead, so
+	// that their projections use the whole pool.
+	if (m_iThreads <= 0 && iThreads < iPoolThreads)
+		iThreads = 1;
+
+	ASTRA_DEBUG("CBatchReconstruction2D: reconstructing %d slices on %d threads", _iSlices, iThreads);
+
+	// With a single worker, the algorithms can use the thread pool
+	// themselves. Otherwise the workers run on the pool, and projections
+	// inside them are single-threaded.
+	if (iThreads == 1) {
+		worker(_pfSinograms, _pfVolumes, _iSlices, _iIterations);
+	} else {
+		parallelFor(0, iThreads, 1, [&](int iFrom, int iTo) {
+			for (int i = iFrom; i < iTo; ++i)
+				worker(_pfSinograms, _pfVolumes, _iSlices, _iIterations);
+		});
+	}
+
+	for (const SBatchSliceStatus &s : m_status)
+		if (s.eState != SBatchSliceStatus::SLICE_DONE)
+			return false;
+
+	return true;
+}
+
+void CBatchReconstruction2D::worker(const float32 *_pfSinograms, float32 *_pfVolumes, int _iSlices, int _iIterations)
+{
+	// Data objects of this thread, re-linked to each of its slices
+	CDataMemoryView<float32> *pProjectionStorage = new CDataMemoryView<float32>();
+	CDataMemoryView<float32> *pVolumeStorage = new CDataMemoryView<float32>();
+	CFloat32ProjectionData2D sinogram(m_pProjector->getProjectionGeometry(), pProjectionStorage);
+	CFloat32VolumeData2D volume(m_pProjector->getVolumeGeometry(), pVolumeStorage);
+
+	// Algorithm of this thread, bound to the data objects above
+	std::unique_ptr<CReconstructionAlgorithm2D> pAlg;
+
+	size_t iSinogramSize = getSinogramSize();
+	size_t iSliceSize = getSliceSize();
+
+	while (!m_bAbort && !shouldAbort()) {
+		int iSlice = m_iNextSlice++;
+		if (iSlice >= _iSlices)
+			break;
+
+		// The sinogram is only read by the algorithm
+		pProjectionStorage->setData(const_cast<float32*>(_pfSinograms) + iSlice * iSinogramSize);
+		pVolumeStorage->setData(_pfVolumes + iSlice * iSliceSize);
+
+		std::string sError;
+		bool ok;
+		try {
+			ok = reconstructSlice(pAlg, &sinogram, &volume, _iIterations, sError);
+		} catch (const std::exception &e) {
+			ok = false;
+			sError = e.what();
+		}
+
+		SBatchSliceStatus &status = m_status[iSlice];
+		status.eState = ok ? SBatchSliceStatus::SLICE_DONE : SBatchSliceStatus::SLICE_FAILED;
+		status.sError = sError;
+		if (!ok)
+			ASTRA_WARN("CBatchReconstruction2D: slice %d failed: %s", iSlice, sError.c_str());
+
+		if (m_pProgress)
+			m_pProgress(m_pProgressCtx, iSlice, ok);
+	}
+
+	// The storage does not own the slices
+	pAlg.reset();
+	pProjectionStorage->setData(nullptr);
+	pVolumeStorage->setData(nullptr);
+}
+
+bool CBatchReconstruction2D::reconstructSlice(std::unique_ptr<CReconstructionAlgorithm2D> &_pAlg,
+                                              CFloat32ProjectionData2D *_pSinogram, CFloat32VolumeData2D *_pVolume,
+                                              int _iIterations, std::string &_sError)
+{
+	if (_pAlg) {
+		// algorithms such as CGLS keep state between calls to run()
+		_pAlg->reset();
+	} else {
+		_pAlg.reset(createAlgorithm(m_sAlgorithmType));
+		if (!_pAlg) {
+			_sError = "unable to create algorithm";
+			return false;
+		}
+		if (!_pAlg->initialize(*m_pConfig, _pSinogram, _pVolume)) {
+			_pAlg.reset();
+			_sError = "unable to initialize algorithm";
+			return false;
+		}
+	}
+
+	if (!_pAlg->run(_iIterations)) {
+		_sError = "algorithm failed";
+		return false;
+	}
+
+	return true;
+}
+
+} // end namespace
@@ -28,8 +28,12 @@ along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
 #include "astra/CglsAlgorithm.h"
 
 #include "astra/AstraObjectManager.h"
+#include "astra/DataExpression.h"
 
 #include "astra/Logging.h"
+#include "astra/Profiler.h"
+
+#include <limits>
 
 using namespace std;
 
@@ -102,10 +106,10 @@ bool CCglsAlgorithm::initialize(const Config& _cfg)
 	}
 
 	// member variables
-	r = createCFloat32ProjectionData2DMemory(m_pSinogram->getGeometry());
-	w = createCFloat32ProjectionData2DMemory(m_pSinogram->getGeometry());
-	z = createCFloat32VolumeData2DMemory(m_pReconstruction->getGeometry());
-	p = createCFloat32VolumeData2DMemory(m_pReconstruction->getGeometry());
+	r = createCFloat32ProjectionData2DPooled(m_pSinogram->getGeometry());
+	w = createCFloat32ProjectionData2DPooled(m_pSinogram->getGeometry());
+	z = createCFloat32VolumeData2DPooled(m_pReconstruction->getGeometry());
+	p = createCFloat32VolumeData2DPooled(m_pReconstruction->getGeometry());
 
 	alpha = 0.0f;
 	beta = 0.0f;
@@ -130,20 +134,32 @@ bool CCglsAlgorithm::initialize(CProjector2D* _pProjector,
 	m_pReconstruction = _pReconstruction;
 
 	// member variables
-	r = createCFloat32ProjectionData2DMemory(m_pSinogram->getGeometry());
-	w = createCFloat32ProjectionData2DMemory(m_pSinogram->getGeometry());
-	z = createCFloat32VolumeData2DMemory(m_pReconstruction->getGeometry());
-	p = createCFloat32VolumeData2DMemory(m_pReconstruction->getGeometry());
+	r = createCFloat32ProjectionData2DPooled(m_pSinogram->getGeometry());
+	w = createCFloat32ProjectionData2DPooled(m_pSinogram->getGeometry());
+	z = createCFloat32VolumeData2DPooled(m_pReconstruction->getGeometry());
+	p = createCFloat32VolumeData2DPooled(m_pReconstruction->getGeometry());
 
 	// success
 	m_bIsInitialized = _check();
 	return m_bIsInitialized;
 }
 
+//----------------------------------------------------------------------------------------
+// Reset
+void CCglsAlgorithm::reset()
+{
+	CReconstructionAlgorithm2D::reset();
+	m_iIteration = 0;
+}
+
 //----------------------------------------------------------------------------------------
 // Iterate
 bool CCglsAlgorithm::run(int _iNrIterations)
 {
+	ASTRA_PROFILE_SCOPE(profile, "algorithm/CGLS");
+
+	using namespace expr;
+
 	// check initialized
 	ASTRA_ASSERT(m_bIsInitialized);
 
@@ -151,48 +167,57 @@ bool CCglsAlgorithm::run(int _iNrIterations)
 	CDataProjectorInterface* pForwardProjector;
 	CDataProjectorInterface* pBackProjector;
 
+	// with a volume window, only its pixels are masked in and updated
+	prepareVolumeWindow();
+	CFloat32VolumeData2D *pReconstructionMask = getEffectiveReconstructionMask();
+	const bool bUseReconstructionMask = (pReconstructionMask != nullptr);
+	const SVolumeWindow window = getUpdateWindow();
+
 	// forward projection data projector
 	pForwardProjector = dispatchDataProjector(
 		m_pProjector, 
 			SinogramMaskPolicy(m_pSinogramMask),					// sinogram mask
-			ReconstructionMaskPolicy(m_pReconstructionMask),		// reconstruction mask
+			ReconstructionMaskPolicy(pReconstructionMask),		// reconstruction mask
 			DefaultFPPolicy(p, w),									// forward projection
-			m_bUseSinogramMask, m_bUseReconstructionMask, true		// options on/off
+			m_bUseSinogramMask, bUseReconstructionMask, true		// options on/off
 		); 
 
 	// backprojection data projector
 	pBackProjector = dispatchDataProjector(
 			m_pProjector, 
 			SinogramMaskPolicy(m_pSinogramMask),														// sinogram mask
-			ReconstructionMaskPolicy(m_pReconstructionMask),											// reconstruction mask
+			ReconstructionMaskPolicy(pReconstructionMask),											// reconstruction mask
 			DefaultBPPolicy(z, r),																		//  backprojection
-			m_bUseSinogramMask, m_bUseReconstructionMask, true // options on/off
+			m_bUseSinogramMask, bUseReconstructionMask, true // options on/off
 		); 
 
+	// only visit the active rays and pixels of the masks
+	const CMaskIndex *pMaskIndex = getMaskIndex();
+	pForwardProjector->setMaskIndex(pMaskIndex);
+	pBackProjector->setMaskIndex(pMaskIndex);
+
 
 
-	size_t i;
+	// bounds for the constraints, or infinite if not used
+	const float32 fMin = m_bUseMinConstraint ? m_fMinValue : -std::numeric_limits<float32>::infinity();
+	const float32 fMax = m_bUseMaxConstraint ? m_fMaxValue : std::numeric_limits<float32>::infinity();
+	const bool bConstrained = m_bUseMinConstraint || m_bUseMaxConstraint;
 
 	if (m_iIteration == 0) {
 		// r = b;
-		r->copyData(*m_pSinogram);
+		r->copyData(*getEffectiveSinogram());
 
 		// z = A'*b;
 		z->setData(0.0f);
 		pBackProjector->project();
-		if (m_bUseMinConstraint)
-			z->clampMin(m_fMinValue);
-		if (m_bUseMaxConstraint)
-			z->clampMax(m_fMaxValue);
+		if (bConstrained)
+			assign(*z, clamp(lazy(*z), fMin, fMax), window);
 
 		// p = z;
 		p->copyData(*z);
 
 		// gamma = dot(z,z);
-		gamma = 0.0f;
-		for (i = 0; i < z->getSize(); ++i) {
-			gamma += z->getFloat32Memory()[i] * z->getFloat32Memory()[i];
-		}
+		gamma = sum(sqr(lazy(*z)));
 		m_iIteration++;
 	}
 
@@ -205,48 +230,34 @@ bool CCglsAlgorithm::run(int _iNrIterations)
 		pForwardProjector->project();
 	
 		// alpha = gamma/dot(w,w);
-		float32 tmp = 0;
-		for (i = 0; i < w->getSize(); ++i) {
-			tmp += w->getFloat32Memory()[i] * w->getFloat32Memory()[i];
-		}
+		float32 tmp = sum(sqr(lazy(*w)));
 		alpha = gamma / tmp;
 
 		// x = x + alpha*p;
-		for (i = 0; i < m_pReconstruction->getSize(); ++i) {
-			m_pReconstruction->getFloat32Memory()[i] += alpha * p->getFloat32Memory()[i];
-		}
+		assign(*m_pReconstruction, lazy(*m_pReconstruction) + alpha * lazy(*p), window);
 
 		// r = r - alpha*w;
-		for (i = 0; i < r->getSize(); ++i) {
-			r->getFloat32Memory()[i] -= alpha * w->getFloat32Memory()[i];
-		}
+		assign(*r, lazy(*r) - alpha * lazy(*w));
 
 		// z = A'*r;
 		z->setData(0.0f);
 		pBackProjector->project();
 
 		// CHECKME: should these be here?
-		if (m_bUseMinConstraint)
-			z->clampMin(m_fMinValue);
-		if (m_bUseMaxConstraint)
-			z->clampMax(m_fMaxValue);
+		if (bConstrained)
+			assign(*z, clamp(lazy(*z), fMin, fMax), window);
 
 		// beta = 1/gamma;
 		beta = 1.0f / gamma;
 
 		// gamma = dot(z,z);
-		gamma = 0;
-		for (i = 0; i < z->getSize(); ++i) {
-			gamma += z->getFloat32Memory()[i] * z->getFloat32Memory()[i];
-		}
+		gamma = sum(sqr(lazy(*z)));
 
 		// beta = gamma*beta;
 		beta *= gamma; 
 
 		// p = z + beta*p;
-		for (i = 0; i < z->getSize(); ++i) {
-			p->getFloat32Memory()[i] = z->getFloat32Memory()[i] + beta * p->getFloat32Memory()[i];
-		}
+		assign(*p, lazy(*z) + beta * lazy(*p));
 		
 		m_iIteration++;
 	}
@@ -27,8 +27,6 @@ along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
 
 #include "astra/CompositeGeometryManager.h"
 
-#ifdef ASTRA_CUDA
-
 #include "astra/GeometryUtil3D.h"
 #include "astra/VolumeGeometry3D.h"
 #include "astra/ConeProjectionGeometry3D.h"
@@ -39,17 +37,25 @@ along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
 #include "astra/Projector3D.h"
 #include "astra/CudaProjector3D.h"
 #include "astra/Data3D.h"
+#include "astra/DataBricked.h"
 #include "astra/Logging.h"
+#include "astra/Profiler.h"
 
+#ifdef ASTRA_CUDA
 #include "astra/cuda/2d/astra.h"
 #include "astra/cuda/3d/mem3d.h"
+#endif
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <cstring>
 #include <sstream>
 #include <climits>
 #include <mutex>
 #include <thread>
 #include <atomic>
+#include <tuple>
 
 
 namespace astra {
@@ -61,15 +67,38 @@ CCompositeGeometryManager::CCompositeGeometryManager()
 {
 	std::unique_lock lock{g_GPUParams_mutex};
 	m_iMaxSize = 0;
+	m_eSplitStrategy = SPLIT_LINEAR;
 
 	if (s_params) {
 		m_iMaxSize = s_params->memory;
 		m_GPUIndices = s_params->GPUIndices;
+		m_eSplitStrategy = s_params->splitStrategy;
 	}
 }
 
 
 
+static bool isBrickedStorage(const CDataStorage *storage)
+{
+	return dynamic_cast<const CDataBricked<float32>*>(storage) != nullptr;
+}
+
+// Host-side storage that is transferred to the GPU part by part
+static bool isHostStorage(const CDataStorage *storage)
+{
+	return storage->isMemory() || isBrickedStorage(storage);
+}
+
+// Parts without data only occur in plans (see planJob), where they stand
+// for host data
+static bool isHostPart(const CCompositeGeometryManager::CPart &part)
+{
+	return !part.pData || isHostStorage(part.pData->getStorage());
+}
+
+
+#ifdef ASTRA_CUDA
+
 class _AstraExport CGPUMemoryHandler {
 protected:
 	CData3D *_dataSource;
@@ -82,27 +111,32 @@ public:
 	CData3D* getData() { return _data; }
 };
 
+static CData3D *allocateGPUPart(const CCompositeGeometryManager::CPart &part, astraCUDA3d::Mem3DZeroMode zero)
+{
+	size_t x, y, z;
+	part.getDims(x, y, z);
+	CDataStorage *storage = astraCUDA3d::allocateGPUMemory(x, y, z, zero);
+	if (!storage)
+		return nullptr;
+
+	if (part.eType == CCompositeGeometryManager::CPart::PART_VOL) {
+		return new CFloat32VolumeData3D(*dynamic_cast<const CCompositeGeometryManager::CVolumePart&>(part).pGeom, storage);
+	} else if (part.eType == CCompositeGeometryManager::CPart::PART_PROJ) {
+		return new CFloat32ProjectionData3D(*dynamic_cast<const CCompositeGeometryManager::CProjectionPart&>(part).pGeom, storage);
+	}
+
+	assert(false);
+	delete storage;
+	return nullptr;
+}
+
 class CDataMemoryHandler : public CGPUMemoryHandler {
 public:
 	CDataMemoryHandler(const CCompositeGeometryManager::CPart &part, astraCUDA3d::Mem3DZeroMode zero) {
 		CData3D *d = part.pData;
 		assert(d->isFloat32Memory());
 		_dataSource = d;
-
-		size_t x, y, z;
-		part.getDims(x, y, z);
-		CDataStorage *storage = astraCUDA3d::allocateGPUMemory(x, y, z, zero);
-		if (!storage)
-			_data = nullptr;
-
-		if (part.eType == CCompositeGeometryManager::CPart::PART_VOL) {
-			_data = new CFloat32VolumeData3D(*dynamic_cast<const CCompositeGeometryManager::CVolumePart&>(part).pGeom, storage);
-		} else if (part.eType == CCompositeGeometryManager::CPart::PART_PROJ) {
-			_data = new CFloat32ProjectionData3D(*dynamic_cast<const CCompositeGeometryManager::CProjectionPart&>(part).pGeom, storage);
-		} else {
-			assert(false);
-		}
-
+		_data = allocateGPUPart(part, zero);
 	}
 	virtual ~CDataMemoryHandler() {
 		if (_data)
@@ -117,6 +151,83 @@ public:
 	}
 };
 
+// Host data that can not be copied to the GPU directly is staged through a
+// linear float32 buffer holding only the sub-block of the part.
+class CDataStagedHandler : public CGPUMemoryHandler {
+protected:
+	virtual void stageIn(const astraCUDA3d::SSubDimensions3D &pos, CData3D &staging) =0;
+	virtual void stageOut(const astraCUDA3d::SSubDimensions3D &pos, const CData3D &staging) =0;
+public:
+	CDataStagedHandler(const CCompositeGeometryManager::CPart &part, astraCUDA3d::Mem3DZeroMode zero) {
+		_dataSource = part.pData;
+		_data = allocateGPUPart(part, zero);
+	}
+	virtual ~CDataStagedHandler() {
+		if (_data)
+			astraCUDA3d::freeGPUMemory(_data);
+		delete _data;
+	}
+	virtual bool copyToGPUMemory(const astraCUDA3d::SSubDimensions3D &pos) {
+		CData3D staging(pos.subnx, pos.subny, pos.subnz, new CDataMemory<float32>(pos.subnx * pos.subny * pos.subnz));
+		stageIn(pos, staging);
+		return astraCUDA3d::copyToGPUMemory(&staging, _data);
+	}
+	virtual bool copyFromGPUMemory(const astraCUDA3d::SSubDimensions3D &pos) {
+		CData3D staging(pos.subnx, pos.subny, pos.subnz, new CDataMemory<float32>(pos.subnx * pos.subny * pos.subnz));
+		if (!astraCUDA3d::copyFromGPUMemory(&staging, _data))
+			return false;
+		stageOut(pos, staging);
+		return true;
+	}
+};
+
+// Bricked data: only the bricks intersecting the part are touched, so no
+// relayout of the full data is needed.
+class CDataBrickedHandler : public CDataStagedHandler {
+protected:
+	CDataBricked<float32> *_bricked;
+
+	virtual void stageIn(const astraCUDA3d::SSubDimensions3D &pos, CData3D &staging) {
+		_bricked->copySubToLinear(pos.subx, pos.suby, pos.subz, pos.subnx, pos.subny, pos.subnz, staging.getFloat32Memory());
+	}
+	virtual void stageOut(const astraCUDA3d::SSubDimensions3D &pos, const CData3D &staging) {
+		_bricked->copySubFromLinear(pos.subx, pos.suby, pos.subz, pos.subnx, pos.subny, pos.subnz, staging.getFloat32Memory());
+	}
+public:
+	CDataBrickedHandler(const CCompositeGeometryManager::CPart &part, astraCUDA3d::Mem3DZeroMode zero)
+		: CDataStagedHandler(part, zero)
+	{
+		_bricked = dynamic_cast<CDataBricked<float32>*>(_dataSource->getStorage());
+		assert(_bricked);
+	}
+};
+
+// float16/bfloat16 host memory: converted to and from float32 row by row
+class CDataConvertingHandler : public CDataStagedHandler {
+protected:
+	static size_t rowOffset(const astraCUDA3d::SSubDimensions3D &pos, size_t y, size_t z) {
+		return ((pos.subz + z) * pos.ny + pos.suby + y) * pos.pitch + pos.subx;
+	}
+	virtual void stageIn(const astraCUDA3d::SSubDimensions3D &pos, CData3D &staging) {
+		for (size_t z = 0; z < pos.subnz; ++z)
+			for (size_t y = 0; y < pos.subny; ++y)
+				copyConvertMemory(_dataSource->getStorage(), rowOffset(pos, y, z),
+				                  staging.getStorage(), (z * pos.subny + y) * pos.subnx, pos.subnx);
+	}
+	virtual void stageOut(const astraCUDA3d::SSubDimensions3D &pos, const CData3D &staging) {
+		for (size_t z = 0; z < pos.subnz; ++z)
+			for (size_t y = 0; y < pos.subny; ++y)
+				copyConvertMemory(staging.getStorage(), (z * pos.subny + y) * pos.subnx,
+				                  _dataSource->getStorage(), rowOffset(pos, y, z), pos.subnx);
+	}
+public:
+	CDataConvertingHandler(const CCompositeGeometryManager::CPart &part, astraCUDA3d::Mem3DZeroMode zero)
+		: CDataStagedHandler(part, zero)
+	{
+		assert(_dataSource->isFloat16Memory() || _dataSource->isBFloat16Memory());
+	}
+};
+
 class CDataGPUHandler : public CGPUMemoryHandler {
 public:
 	CDataGPUHandler(const CCompositeGeometryManager::CPart& part, astraCUDA3d::Mem3DZeroMode zero);
@@ -163,8 +274,12 @@ bool CDataGPUHandler::copyFromGPUMemory(const astraCUDA3d::SSubDimensions3D &pos
 
 
 std::unique_ptr<CGPUMemoryHandler> createGPUMemoryHandler(const CCompositeGeometryManager::CPart &part, astraCUDA3d::Mem3DZeroMode zero) {
-	if (part.pData->getStorage()->isMemory())
+	if (part.pData->isFloat32Memory())
 		return std::unique_ptr<CGPUMemoryHandler>(new CDataMemoryHandler(part, zero));
+	else if (part.pData->getStorage()->isMemory())
+		return std::unique_ptr<CGPUMemoryHandler>(new CDataConvertingHandler(part, zero));
+	else if (isBrickedStorage(part.pData->getStorage()))
+		return std::unique_ptr<CGPUMemoryHandler>(new CDataBrickedHandler(part, zero));
 	else
 		return std::unique_ptr<CGPUMemoryHandler>(new CDataGPUHandler(part, zero));
 }
@@ -191,6 +306,8 @@ static astraCUDA3d::SSubDimensions3D getPartSubDims(const CCompositeGeometryMana
 	return d;
 }
 
+#endif
+
 static void splitPart(int n,
                       std::unique_ptr<CCompositeGeometryManager::CPart> && base,
                       CCompositeGeometryManager::TPartList& out,
@@ -200,10 +317,16 @@ static std::unique_ptr<CCompositeGeometryManager::CPart>
 reducePart(const CCompositeGeometryManager::CPart *base,
            const CCompositeGeometryManager::CPart *other);
 
+static void splitPartByCost(int n,
+                            std::unique_ptr<CCompositeGeometryManager::CPart> && base,
+                            const CCompositeGeometryManager::TJobListInternal &jobs,
+                            CCompositeGeometryManager::TPartList& out,
+                            size_t maxSize, int div);
+
 
 static bool requiresInputGPUAllocation(const CCompositeGeometryManager::SJobInternal &job)
 {
-	if (job.pInput->pData->getStorage()->isMemory())
+	if (isHostPart(*job.pInput))
 		return true;
 	if (job.eType == CCompositeGeometryManager::JOB_FDK)
 		return true;
@@ -212,14 +335,29 @@ static bool requiresInputGPUAllocation(const CCompositeGeometryManager::SJobInte
 
 static bool requiresOutputGPUAllocation(const CCompositeGeometryManager::CPart &part)
 {
-	return part.pData->getStorage()->isMemory();
+	return isHostPart(part);
 }
 
-bool CCompositeGeometryManager::splitJobs(TJobSetInternal &jobs, size_t maxSize, int div, TJobSetInternal &split)
+// Relative cost of running a job with the given input dimensions into an
+// output part of the given size
+static double estimateJobCost(CCompositeGeometryManager::EJobType eType,
+                              size_t outputSize,
+                              size_t tx, size_t ty, size_t tz)
 {
-	int maxBlockDim = astraCUDA3d::maxBlockDimension();
-	ASTRA_DEBUG("Found max block dim %d", maxBlockDim);
+	switch (eType) {
+		case CCompositeGeometryManager::JOB_FP:
+			return outputSize * cbrt(tx * ty * tz);
+		case CCompositeGeometryManager::JOB_BP:
+		case CCompositeGeometryManager::JOB_FDK:
+			return (double)outputSize * ty;
+		case CCompositeGeometryManager::JOB_NOP:
+			break;
+	}
+	return 0.0;
+}
 
+bool CCompositeGeometryManager::splitJobs(TJobSetInternal &jobs, size_t maxSize, int maxBlockDim, int div, TJobSetInternal &split)
+{
 	split.clear();
 
 	size_t costHeuristic = 0;
@@ -265,7 +403,10 @@ bool CCompositeGeometryManager::splitJobs(TJobSetInternal &jobs, size_t maxSize,
 		if (pOutput->eType == CPart::PART_PROJ)
 			axisOutput = 1;
 
-		splitPart(axisOutput, std::move(pOutput), splitOutput, outputMemSize, UINT_MAX, div);
+		if (m_eSplitStrategy == SPLIT_COST)
+			splitPartByCost(axisOutput, std::move(pOutput), L, splitOutput, outputMemSize, div);
+		else
+			splitPart(axisOutput, std::move(pOutput), splitOutput, outputMemSize, UINT_MAX, div);
 #if 0
 		// There are currently no reasons to split the output over other axes
 
@@ -293,10 +434,9 @@ bool CCompositeGeometryManager::splitJobs(TJobSetInternal &jobs, size_t maxSize,
 
 				if (input->getSize() == 0) {
 					ASTRA_DEBUG("Empty input");
-					SJobInternal newjob{nullptr};
+					SJobInternal newjob{nullptr, job.FDKSettings};
 					newjob.eMode = job.eMode;
 					newjob.pProjector = job.pProjector;
-					newjob.FDKSettings = job.FDKSettings;
 					newjob.eType = JOB_NOP;
 					newjobs.push_back(std::move(newjob));
 					continue;
@@ -341,25 +481,15 @@ bool CCompositeGeometryManager::splitJobs(TJobSetInternal &jobs, size_t maxSize,
 				EJobMode eMode = job.eMode;
 
 				for (std::unique_ptr<CPart> &i_in : splitInput) {
-					SJobInternal newjob{std::move(i_in)};
+					SJobInternal newjob{std::move(i_in), job.FDKSettings};
 					newjob.eMode = eMode;
 					newjob.pProjector = job.pProjector;
-					newjob.FDKSettings = job.FDKSettings;
 					newjob.eType = job.eType;
 
 					size_t tx, ty, tz;
 					newjob.pInput->getDims(tx, ty, tz);
 
-					switch (newjob.eType) {
-						case JOB_FP:
-							costHeuristic += outputPart.get()->getSize() * cbrt(tx * ty * tz);
-							break;
-						case JOB_BP: case JOB_FDK:
-							costHeuristic += outputPart.get()->getSize() * ty;
-							break;
-						case JOB_NOP:
-							break;
-					}
+					costHeuristic += estimateJobCost(newjob.eType, outputPart->getSize(), tx, ty, tz);
 
 					newjobs.push_back(std::move(newjob));
 
@@ -468,7 +598,32 @@ bool CCompositeGeometryManager::CPart::isFull() const
 
 bool CCompositeGeometryManager::CPart::canSplitAndReduce() const
 {
-	return pData->getStorage()->isMemory();
+	return isHostPart(*this);
+}
+
+CCompositeGeometryManager::SPartKey CCompositeGeometryManager::CPart::getKey() const
+{
+	SPartKey key;
+	key.pData = pData;
+	key.eType = eType;
+	key.sub[0] = subX;
+	key.sub[1] = subY;
+	key.sub[2] = subZ;
+	getDims(key.dims[0], key.dims[1], key.dims[2]);
+	return key;
+}
+
+bool CCompositeGeometryManager::SPartKey::operator==(const SPartKey &other) const
+{
+	return pData == other.pData && eType == other.eType &&
+	       std::equal(sub, sub + 3, other.sub) &&
+	       std::equal(dims, dims + 3, other.dims);
+}
+
+bool CCompositeGeometryManager::SPartKey::operator<(const SPartKey &other) const
+{
+	return std::tie(pData, eType, sub[0], sub[1], sub[2], dims[0], dims[1], dims[2]) <
+	       std::tie(other.pData, other.eType, other.sub[0], other.sub[1], other.sub[2], other.dims[0], other.dims[1], other.dims[2]);
 }
 
 
@@ -671,6 +826,42 @@ static size_t computeLinearSplit(size_t maxBlock, int div, size_t sliceCount)
 // - number of sub-parts is divisible by div
 // - maybe all approximately the same size?
 
+// Create the sub-part of a volume part consisting of the given range of
+// slices along axis n
+static CCompositeGeometryManager::CVolumePart* createVolumeSlab(const CCompositeGeometryManager::CVolumePart *pPart,
+                                                                int n, int offset, int size)
+{
+	const CVolumeGeometry3D *pGeom = pPart->pGeom;
+
+	size_t dims[3];
+	pPart->getDims(dims[0], dims[1], dims[2]);
+
+	int offsets[3] = { 0, 0, 0 };
+	offsets[n] = offset;
+	size_t sizes[3] = { dims[0], dims[1], dims[2] };
+	sizes[n] = size;
+
+	double shifts[3] = { 0., 0., 0. };
+	if (n == 0)
+		shifts[0] = pGeom->getPixelLengthX() * offset;
+	else if (n == 1)
+		shifts[1] = pGeom->getPixelLengthY() * offset;
+	else if (n == 2)
+		shifts[2] = pGeom->getPixelLengthZ() * offset;
+
+	CVolumeGeometry3D *pSubGeom = new CVolumeGeometry3D(sizes[0],
+	                                                    sizes[1],
+	                                                    sizes[2],
+	                                                    pGeom->getWindowMinX() + shifts[0],
+	                                                    pGeom->getWindowMinY() + shifts[1],
+	                                                    pGeom->getWindowMinZ() + shifts[2],
+	                                                    pGeom->getWindowMinX() + shifts[0] + sizes[0] * pGeom->getPixelLengthX(),
+	                                                    pGeom->getWindowMinY() + shifts[1] + sizes[1] * pGeom->getPixelLengthY(),
+	                                                    pGeom->getWindowMinZ() + shifts[2] + sizes[2] * pGeom->getPixelLengthZ()
+	                                                   );
+	return createSubVolumePart(pPart, offsets[0], offsets[1], offsets[2], pSubGeom);
+}
+
 static void splitVolumePart(int n,
                             const CCompositeGeometryManager::CPart *base,
                             CCompositeGeometryManager::TPartList& out,
@@ -683,8 +874,6 @@ static void splitVolumePart(int n,
 	pPart = dynamic_cast<const CCompositeGeometryManager::CVolumePart*>(base);
 	assert(pPart);
 
-	const CVolumeGeometry3D *pGeom = pPart->pGeom;
-
 	size_t dims[3];
 	pPart->getDims(dims[0], dims[1], dims[2]);
 	size_t sliceSize = 1;
@@ -709,30 +898,7 @@ static void splitVolumePart(int n,
 		if (endX > sliceCount) endX = sliceCount;
 		int size = endX - newsubX;
 
-		int offsets[3] = { 0, 0, 0 };
-		offsets[n] = newsubX;
-		size_t sizes[3] = { dims[0], dims[1], dims[2] };
-		sizes[n] = size;
-
-		double shifts[3] = { 0., 0., 0. };
-		if (n == 0)
-			shifts[0] = pGeom->getPixelLengthX() * newsubX;
-		else if (n == 1)
-			shifts[1] = pGeom->getPixelLengthY() * newsubX;
-		else if (n == 2)
-			shifts[2] = pGeom->getPixelLengthZ() * newsubX;
-
-		CVolumeGeometry3D *pSubGeom = new CVolumeGeometry3D(sizes[0],
-		                                                    sizes[1],
-		                                                    sizes[2],
-		                                                    pGeom->getWindowMinX() + shifts[0],
-		                                                    pGeom->getWindowMinY() + shifts[1],
-		                                                    pGeom->getWindowMinZ() + shifts[2],
-		                                                    pGeom->getWindowMinX() + shifts[0] + sizes[0] * pGeom->getPixelLengthX(),
-		                                                    pGeom->getWindowMinY() + shifts[1] + sizes[1] * pGeom->getPixelLengthY(),
-		                                                    pGeom->getWindowMinZ() + shifts[2] + sizes[2] * pGeom->getPixelLengthZ()
-		                                                   );
-		CCompositeGeometryManager::CVolumePart *sub = createSubVolumePart(pPart, offsets[0], offsets[1], offsets[2], pSubGeom);
+		CCompositeGeometryManager::CVolumePart *sub = createVolumeSlab(pPart, n, newsubX, size);
 		ASTRA_DEBUG("VolumePart split %d %d %d -> %p", sub->subX, sub->subY, sub->subZ, (void*)sub);
 
 		out.push_back(std::unique_ptr<CCompositeGeometryManager::CPart>(sub));
@@ -877,6 +1043,27 @@ reduceProjectionPart(const CCompositeGeometryManager::CProjectionPart *base,
 	return std::unique_ptr<CCompositeGeometryManager::CPart>(sub);
 }
 
+// Create the sub-part of a projection part consisting of the given range of
+// slices along axis n
+static CCompositeGeometryManager::CProjectionPart* createProjectionSlab(const CCompositeGeometryManager::CProjectionPart *pPart,
+                                                                        int n, int offset, int size)
+{
+	const CProjectionGeometry3D *pGeom = pPart->pGeom;
+
+	int offsets[3] = { 0, 0, 0 };
+	offsets[n] = offset;
+
+	CProjectionGeometry3D *pSubGeom = 0;
+	if (n == 0)
+		pSubGeom = getSubProjectionGeometry_U(pGeom, offset, size);
+	else if (n == 1)
+		pSubGeom = getSubProjectionGeometry_Angle(pGeom, offset, size);
+	else if (n == 2)
+		pSubGeom = getSubProjectionGeometry_V(pGeom, offset, size);
+
+	return createSubProjectionPart(pPart, offsets[0], offsets[1], offsets[2], pSubGeom);
+}
+
 static void splitProjectionPart(int n,
                                 const CCompositeGeometryManager::CPart *base,
                                 CCompositeGeometryManager::TPartList &out,
@@ -889,8 +1076,6 @@ static void splitProjectionPart(int n,
 	pPart = dynamic_cast<const CCompositeGeometryManager::CProjectionPart*>(base);
 	assert(pPart);
 
-	const CProjectionGeometry3D *pGeom = pPart->pGeom;
-
 	size_t dims[3];
 	pPart->getDims(dims[0], dims[1], dims[2]);
 	size_t sliceSize = 1;
@@ -919,19 +1104,7 @@ static void splitProjectionPart(int n,
 		if (endX > sliceCount) endX = sliceCount;
 		int size = endX - newsubX;
 
-		int offsets[3] = { 0, 0, 0 };
-		offsets[n] = newsubX;
-
-		CProjectionGeometry3D *pSubGeom = 0;
-		if (n == 0)
-			pSubGeom = getSubProjectionGeometry_U(pGeom, newsubX, size);
-		else if (n == 1)
-			pSubGeom = getSubProjectionGeometry_Angle(pGeom, newsubX, size);
-		else if (n == 2)
-			pSubGeom = getSubProjectionGeometry_V(pGeom, newsubX, size);
-
-		CCompositeGeometryManager::CProjectionPart *sub;
-		sub = createSubProjectionPart(pPart, offsets[0], offsets[1], offsets[2], pSubGeom);
+		CCompositeGeometryManager::CProjectionPart *sub = createProjectionSlab(pPart, n, newsubX, size);
 		ASTRA_DEBUG("ProjectionPart split %d %d %d -> %p", sub->subX, sub->subY, sub->subZ, (void*)sub);
 		out.push_back(std::unique_ptr<CCompositeGeometryManager::CPart>(sub));
 	}
@@ -972,6 +1145,187 @@ reducePart(const CCompositeGeometryManager::CPart *base,
 		assert(false);
 }
 
+static std::unique_ptr<CCompositeGeometryManager::CPart>
+createSlab(const CCompositeGeometryManager::CPart *base, int n, int offset, int size)
+{
+	if (base->eType == CCompositeGeometryManager::CPart::PART_PROJ)
+		return std::unique_ptr<CCompositeGeometryManager::CPart>(createProjectionSlab(dynamic_cast<const CCompositeGeometryManager::CProjectionPart*>(base), n, offset, size));
+	else if (base->eType == CCompositeGeometryManager::CPart::PART_VOL)
+		return std::unique_ptr<CCompositeGeometryManager::CPart>(createVolumeSlab(dynamic_cast<const CCompositeGeometryManager::CVolumePart*>(base), n, offset, size));
+	else
+		assert(false);
+	return nullptr;
+}
+
+// Estimated cost of running jobs for the given output part: the compute
+// estimate, and the number of elements transferred for the inputs reduced
+// to the part and for the part itself
+static void estimatePartCost(const CCompositeGeometryManager::CPart *output,
+                             const CCompositeGeometryManager::TJobListInternal &jobs,
+                             double &compute, double &transfer)
+{
+	size_t outputSize = output->getSize();
+	compute = 0.0;
+	transfer = outputSize;
+	if (!jobs.empty() && jobs.front().eMode != CCompositeGeometryManager::MODE_SET)
+		transfer += outputSize;
+	for (const CCompositeGeometryManager::SJobInternal &job : jobs) {
+		if (job.eType == CCompositeGeometryManager::JOB_NOP || !job.pInput)
+			continue;
+		std::unique_ptr<CCompositeGeometryManager::CPart> input = reducePart(job.pInput.get(), output);
+		size_t tx, ty, tz;
+		input->getDims(tx, ty, tz);
+		compute += estimateJobCost(job.eType, outputSize, tx, ty, tz);
+		transfer += input->getSize();
+	}
+}
+
+// Split along axis n into as many blocks as splitPart would, but with
+// block boundaries chosen to minimize the largest estimated cost of a
+// block instead of making blocks of equal size. For cone beam geometries
+// with a strong magnification, the input footprints of equal blocks can
+// differ a lot.
+//
+// The cost of a block is its compute estimate and transferred elements
+// (see estimatePartCost), each relative to that of the full part. As
+// footprints of neighbouring blocks overlap, this is not additive, so
+// every candidate block is reduced and estimated separately.
+static void splitPartByCost(int n,
+                            std::unique_ptr<CCompositeGeometryManager::CPart> && base,
+                            const CCompositeGeometryManager::TJobListInternal &jobs,
+                            CCompositeGeometryManager::TPartList& out,
+                            size_t maxSize, int div)
+{
+	if (!base->canSplitAndReduce()) {
+		out.push_back(std::move(base));
+		return;
+	}
+
+	size_t dims[3];
+	base->getDims(dims[0], dims[1], dims[2]);
+	size_t sliceSize = 1;
+	for (int i = 0; i < 3; ++i)
+		if (i != n)
+			sliceSize *= dims[i];
+	size_t sliceCount = dims[n];
+
+	size_t m = std::min(maxSize / sliceSize, (size_t)UINT_MAX);
+	if (m == 0)
+		m = 1;
+	size_t blockCount = ceildiv(sliceCount, computeLinearSplit(m, div, sliceCount));
+	if (blockCount <= 1) {
+		out.push_back(std::move(base));
+		return;
+	}
+
+	// Block boundaries are restricted to multiples of a step, to limit
+	// the number of blocks to estimate
+	const size_t maxSteps = 256;
+	size_t step = std::min(ceildiv(sliceCount, maxSteps), m);
+	size_t stepCount = ceildiv(sliceCount, step);
+	size_t maxBlockSteps = m / step;
+	auto pos = [&](size_t i) { return std::min(i * step, sliceCount); };
+
+	double compute0, transfer0;
+	estimatePartCost(base.get(), jobs, compute0, transfer0);
+
+	std::map<std::pair<size_t, size_t>, double> cache;
+	auto cost = [&](size_t a, size_t b) {
+		std::pair<size_t, size_t> key(a, b);
+		auto it = cache.find(key);
+		if (it != cache.end())
+			return it->second;
+		std::unique_ptr<CCompositeGeometryManager::CPart> slab = createSlab(base.get(), n, pos(a), pos(b) - pos(a));
+		double compute, transfer;
+		estimatePartCost(slab.get(), jobs, compute, transfer);
+		double c = 0.0;
+		if (compute0 > 0.0)
+			c += compute / compute0;
+		if (transfer0 > 0.0)
+			c += transfer / transfer0;
+		cache[key] = c;
+		return c;
+	};
+
+	// Greedily make blocks as large as possible with cost at most maxCost.
+	// Returns the block boundaries, in steps.
+	auto partition = [&](double maxCost) {
+		std::vector<size_t> bounds{0};
+		while (bounds.back() < stepCount) {
+			size_t a = bounds.back();
+			size_t lo = a + 1;
+			size_t hi = std::min(a + maxBlockSteps, stepCount);
+			// largest b in [lo, hi] with cost(a, b) <= maxCost, or lo
+			while (lo < hi) {
+				size_t mid = (lo + hi + 1) / 2;
+				if (cost(a, mid) <= maxCost)
+					lo = mid;
+				else
+					hi = mid - 1;
+			}
+			bounds.push_back(lo);
+		}
+		return bounds;
+	};
+
+	// Bisect on the largest block cost
+	double lo = 0.0, hi = cost(0, stepCount);
+	std::vector<size_t> bounds = partition(hi);
+	if (maxBlockSteps == 0 || bounds.size() - 1 > blockCount) {
+		// The step is too coarse for the memory limit
+		splitPart(n, std::move(base), out, maxSize, UINT_MAX, div);
+		return;
+	}
+	for (int iter = 0; iter < 20; ++iter) {
+		double mid = 0.5 * (lo + hi);
+		std::vector<size_t> b = partition(mid);
+		if (b.size() - 1 <= blockCount) {
+			hi = mid;
+			bounds = b;
+		} else {
+			lo = mid;
+		}
+	}
+
+	// Split the most expensive blocks until there are as many blocks as
+	// splitPart would make, to keep the count divisible over devices
+	while (bounds.size() - 1 < blockCount) {
+		size_t worst = 0;
+		double worstCost = -1.0;
+		for (size_t i = 0; i + 1 < bounds.size(); ++i) {
+			if (bounds[i + 1] - bounds[i] < 2)
+				continue;
+			double c = cost(bounds[i], bounds[i + 1]);
+			if (c > worstCost) {
+				worst = i;
+				worstCost = c;
+			}
+		}
+		if (worstCost < 0.0)
+			break;
+		size_t a = bounds[worst], b = bounds[worst + 1];
+		size_t l = a + 1, h = b - 1;
+		while (l < h) {
+			size_t mid = (l + h) / 2;
+			if (cost(a, mid) < cost(mid, b))
+				l = mid + 1;
+			else
+				h = mid;
+		}
+		bounds.insert(bounds.begin() + worst + 1, l);
+	}
+
+	ASTRA_DEBUG("Split by cost into %zu blocks, evaluated %zu candidates", bounds.size() - 1, cache.size());
+
+	for (size_t i = 0; i + 1 < bounds.size(); ++i) {
+		std::unique_ptr<CCompositeGeometryManager::CPart> sub = createSlab(base.get(), n, pos(bounds[i]), pos(bounds[i + 1]) - pos(bounds[i]));
+		ASTRA_DEBUG("Part split by cost %d %d %d (cost %f) -> %p", sub->subX, sub->subY, sub->subZ, cost(bounds[i], bounds[i + 1]), (void*)sub.get());
+		out.push_back(std::move(sub));
+	}
+}
+
+
+#ifdef ASTRA_CUDA
 
 CCompositeGeometryManager::SJob CCompositeGeometryManager::createJobFP(CProjector3D *pProjector,
                                             CFloat32VolumeData3D *pVolData,
@@ -1112,13 +1466,26 @@ bool CCompositeGeometryManager::doBP(CProjector3D *pProjector, const std::vector
 
 
 
-static bool doJob(const CCompositeGeometryManager::TJobSetInternal::const_iterator& iter)
+// Input part kept in GPU memory between the entries run on a device
+struct SResidentInput {
+	CCompositeGeometryManager::SPartKey key;
+	std::unique_ptr<CGPUMemoryHandler> mem;
+};
+
+static bool doJob(const CCompositeGeometryManager::TJobSetInternal::value_type &entry, SResidentInput &resident)
 {
-	CCompositeGeometryManager::CPart* output = iter->first.get();
-	const CCompositeGeometryManager::TJobListInternal& L = iter->second;
+	ASTRA_PROFILE_SCOPE(profile, "cgm/job");
+
+	CCompositeGeometryManager::CPart* output = entry.first.get();
+	const CCompositeGeometryManager::TJobListInternal& L = entry.second;
 
 	assert(!L.empty());
 
+	// Only keep the resident input if this entry starts with it. Jobs are
+	// split to fit their output with their own input, not with another one.
+	if (resident.mem && !(L.begin()->pInput && resident.key == L.begin()->pInput->getKey()))
+		resident.mem.reset();
+
 	ASTRA_DEBUG("first mode: %d", L.begin()->eMode);
 	bool zero = L.begin()->eMode == CCompositeGeometryManager::MODE_SET;
 
@@ -1133,8 +1500,7 @@ static bool doJob(const CCompositeGeometryManager::TJobSetInternal::const_iterat
 		if (zero) {
 			// TODO: This function shouldn't have to know about this difference
 			// between Memory/GPU
-			if (output->pData->getStorage()->isMemory()) {
-				assert(output->pData->isFloat32Memory());
+			if (output->pData->isFloat32Memory()) {
 				for (size_t z = 0; z < outz; ++z) {
 					for (size_t y = 0; y < outy; ++y) {
 						float* ptr = output->pData->getFloat32Memory();
@@ -1144,6 +1510,21 @@ static bool doJob(const CCompositeGeometryManager::TJobSetInternal::const_iterat
 						memset(ptr, 0, sizeof(float) * outx);
 					}
 				}
+			} else if (output->pData->getStorage()->isMemory()) {
+				assert(output->pData->isFloatMemory());
+				for (size_t z = 0; z < outz; ++z) {
+					for (size_t y = 0; y < outy; ++y) {
+						size_t offset = (z + output->subZ) * (size_t)output->pData->getHeight() * (size_t)output->pData->getWidth();
+						offset += (y + output->subY) * (size_t)output->pData->getWidth();
+						offset += output->subX;
+						fillMemory(output->pData->getStorage(), offset, outx, 0.0f);
+					}
+				}
+			} else if (isBrickedStorage(output->pData->getStorage())) {
+				CDataBricked<float32> *bricked = dynamic_cast<CDataBricked<float32>*>(output->pData->getStorage());
+				std::vector<float> zeroes(outx * outy, 0.0f);
+				for (size_t z = 0; z < outz; ++z)
+					bricked->copySubFromLinear(output->subX, output->subY, output->subZ + z, outx, outy, 1, &zeroes[0]);
 			} else {
 				assert(output->pData->getStorage()->isGPU());
 				assert(output->isFull()); // TODO: zero subset?
@@ -1163,6 +1544,8 @@ static bool doJob(const CCompositeGeometryManager::TJobSetInternal::const_iterat
 
 	if (!zero) {
 		// instead of zeroing output memory, copy from host
+		ASTRA_PROFILE_SCOPE(transfer, "cgm/transfer");
+		transfer.addBytes(outx * outy * outz * sizeof(float32));
 		ok = dstMem->copyToGPUMemory(dstdims);
 		if (!ok) {
 			ASTRA_ERROR("Error copying output data to GPU");
@@ -1188,19 +1571,35 @@ static bool doJob(const CCompositeGeometryManager::TJobSetInternal::const_iterat
 		size_t inx, iny, inz;
 		j.pInput->getDims(inx, iny, inz);
 
-		std::unique_ptr<CGPUMemoryHandler> srcMem = createGPUMemoryHandler(*j.pInput.get(), astraCUDA3d::INIT_NO);
-		ok = srcMem->getData() != nullptr;
-		if (!ok) {
-			ASTRA_ERROR("Error allocating GPU memory");
-			return false;
-		}
-
 		astraCUDA3d::SSubDimensions3D srcdims = getPartSubDims(j.pInput.get());
 
-		ok = srcMem->copyToGPUMemory(srcdims);
-		if (!ok) {
-			ASTRA_ERROR("Error copying input data to GPU");
-			return false;
+		// FDK filters its input in place, so that can't be kept
+		bool keepInput = j.eType != CCompositeGeometryManager::JOB_FDK;
+		CCompositeGeometryManager::SPartKey inputKey = j.pInput->getKey();
+
+		std::unique_ptr<CGPUMemoryHandler> srcMem;
+		if (keepInput && resident.mem && resident.key == inputKey) {
+			ASTRA_DEBUG("CCompositeGeometryManager::doJobs: reusing resident input");
+			srcMem = std::move(resident.mem);
+		} else {
+			resident.mem.reset();
+
+			srcMem = createGPUMemoryHandler(*j.pInput.get(), astraCUDA3d::INIT_NO);
+			ok = srcMem->getData() != nullptr;
+			if (!ok) {
+				ASTRA_ERROR("Error allocating GPU memory");
+				return false;
+			}
+
+			{
+				ASTRA_PROFILE_SCOPE(transfer, "cgm/transfer");
+				transfer.addBytes(inx * iny * inz * sizeof(float32));
+				ok = srcMem->copyToGPUMemory(srcdims);
+			}
+			if (!ok) {
+				ASTRA_ERROR("Error copying input data to GPU");
+				return false;
+			}
 		}
 
 		switch (j.eType) {
@@ -1211,6 +1610,8 @@ static bool doJob(const CCompositeGeometryManager::TJobSetInternal::const_iterat
 
 			ASTRA_DEBUG("CCompositeGeometryManager::doJobs: doing FP");
 
+			ASTRA_PROFILE_SCOPE(kernel, "cgm/FP");
+			kernel.addRays(outx * outy * outz);
 			ok = astraCUDA3d::FP(dynamic_cast<CFloat32ProjectionData3D*>(dstMem->getData()), dynamic_cast<CFloat32VolumeData3D*>(srcMem->getData()), detectorSuperSampling, projKernel);
 			if (!ok) {
 				ASTRA_ERROR("Error performing sub-FP");
@@ -1226,6 +1627,8 @@ static bool doJob(const CCompositeGeometryManager::TJobSetInternal::const_iterat
 
 			ASTRA_DEBUG("CCompositeGeometryManager::doJobs: doing BP");
 
+			ASTRA_PROFILE_SCOPE(kernel, "cgm/BP");
+			kernel.addRays(inx * iny * inz);
 			ok = astraCUDA3d::BP(dynamic_cast<CFloat32ProjectionData3D*>(srcMem->getData()), dynamic_cast<CFloat32VolumeData3D*>(dstMem->getData()), voxelSuperSampling, projKernel);
 			if (!ok) {
 				ASTRA_ERROR("Error performing sub-BP");
@@ -1251,6 +1654,8 @@ static bool doJob(const CCompositeGeometryManager::TJobSetInternal::const_iterat
 			} else {
 				ASTRA_DEBUG("CCompositeGeometryManager::doJobs: doing FDK");
 
+				ASTRA_PROFILE_SCOPE(kernel, "cgm/FDK");
+				kernel.addRays(inx * iny * inz);
 				ok = astraCUDA3d::FDK(dynamic_cast<CFloat32ProjectionData3D*>(srcMem->getData()), dynamic_cast<CFloat32VolumeData3D*>(dstMem->getData()), j.FDKSettings.bShortScan, j.FDKSettings.filterConfig, fOutputScale );
 				if (!ok) {
 					ASTRA_ERROR("Error performing sub-FDK");
@@ -1265,10 +1670,19 @@ static bool doJob(const CCompositeGeometryManager::TJobSetInternal::const_iterat
 			return false;
 		}
 
-		// srcMem goes out of scope here, freeing any allocated memory
+		if (keepInput) {
+			resident.key = inputKey;
+			resident.mem = std::move(srcMem);
+		}
+
+		// otherwise srcMem goes out of scope here, freeing any allocated memory
 	}
 
-	ok = dstMem->copyFromGPUMemory(dstdims);
+	{
+		ASTRA_PROFILE_SCOPE(transfer, "cgm/transfer");
+		transfer.addBytes(outx * outy * outz * sizeof(float32));
+		ok = dstMem->copyFromGPUMemory(dstdims);
+	}
 	if (!ok) {
 	       ASTRA_ERROR("Error copying output data from GPU");
 	       return false;
@@ -1280,110 +1694,212 @@ static bool doJob(const CCompositeGeometryManager::TJobSetInternal::const_iterat
 }
 
 
-class WorkQueue {
+// Runs entries on a GPU, keeping the last input on the GPU in case the
+// next entry uses it too
+class CGPUJobDevice : public CCompositeGeometryManager::CJobDevice {
 public:
-	WorkQueue(CCompositeGeometryManager::TJobSetInternal &_jobs) : m_jobs(_jobs), failed(false) {
-		m_iter = m_jobs.begin();
-	}
-	void flag_failure(const std::string &err) {
-		failed = true;
-		lock();
-		// We overwrite any existing error. Might have to change that
-		// if we ever change the Python error capture mechanism.
-		m_error = err;
-		unlock();
+	// iGPU is the GPU to use, or -1 for the current device
+	CGPUJobDevice(int iGPU) : m_iGPU(iGPU) { }
+
+	virtual bool start() override {
+		ASTRA_DEBUG("Launching thread on GPU %d", m_iGPU);
+		if (m_iGPU >= 0)
+			return astraCUDA3d::setGPUIndex(m_iGPU);
+		return true;
 	}
-	bool has_failed() const {
-		return failed;
+	virtual void finish() override {
+		ASTRA_DEBUG("Finishing thread on GPU %d", m_iGPU);
+		m_resident.mem.reset();
 	}
-	std::string get_error() const {
-		// (Not thread safe on purpose)
-		return m_error;
+	virtual bool runEntry(const CCompositeGeometryManager::TJobSetInternal::value_type &entry) override {
+		ASTRA_DEBUG("Running block on GPU %d", m_iGPU);
+		return doJob(entry, m_resident);
 	}
-	bool receive(CCompositeGeometryManager::TJobSetInternal::const_iterator &i) {
-		if (failed)
-			return false;
 
-		lock();
+private:
+	int m_iGPU;
+	SResidentInput m_resident;
+};
 
-		if (m_iter == m_jobs.end()) {
-			unlock();
-			return false;
-		}
+#endif
+
+void CCompositeGeometryManager::setGPUIndices(const std::vector<int>& GPUIndices)
+{
+	m_GPUIndices = GPUIndices;
+}
 
-		i = m_iter++;
 
-		unlock();
+CCompositeGeometryManager::CJobScheduler::CJobScheduler(const TJobSetInternal &jobs, int iWorkerCount)
+	: m_queues(iWorkerCount), m_lastGroup(iWorkerCount, SIZE_MAX), m_iSteals(0), m_bFailed(false)
+{
+	assert(iWorkerCount > 0);
+
+	// Group entries by their inputs, keeping the order of the entries
+	std::map<std::vector<SPartKey>, size_t> groupIndex;
+	std::vector<std::vector<const TJobSetInternal::value_type*>> groupEntries;
+	std::vector<size_t> groupSize;
+	for (const TJobSetInternal::value_type &entry : jobs) {
+		std::vector<SPartKey> inputs;
+		size_t size = entry.first->getSize();
+		for (const SJobInternal &job : entry.second) {
+			if (job.pInput) {
+				inputs.push_back(job.pInput->getKey());
+				size += job.pInput->getSize();
+			}
+		}
 
-		return true;
+		auto it = groupIndex.find(inputs);
+		if (it == groupIndex.end()) {
+			it = groupIndex.insert(std::make_pair(inputs, m_groups.size())).first;
+			m_groups.push_back(inputs);
+			groupEntries.emplace_back();
+			groupSize.push_back(0);
+		}
+		groupEntries[it->second].push_back(&entry);
+		groupSize[it->second] += size;
 	}
-	void lock() {
-		m_mutex.lock();
+
+	// Assign the largest groups first, each to the worker with the least
+	// data so far
+	std::vector<size_t> order(m_groups.size());
+	for (size_t i = 0; i < order.size(); ++i)
+		order[i] = i;
+	std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+		return groupSize[a] > groupSize[b];
+	});
+
+	std::vector<size_t> load(iWorkerCount, 0);
+	for (size_t g : order) {
+		size_t w = std::min_element(load.begin(), load.end()) - load.begin();
+		load[w] += groupSize[g];
+		for (const TJobSetInternal::value_type *entry : groupEntries[g])
+			m_queues[w].push_back(SEntry{entry, g});
 	}
-	void unlock() {
-		m_mutex.unlock();
+
+	ASTRA_DEBUG("CJobScheduler: %zu entries in %zu groups over %d workers", jobs.size(), m_groups.size(), iWorkerCount);
+}
+
+bool CCompositeGeometryManager::CJobScheduler::receive(int iWorker, const TJobSetInternal::value_type *&entry)
+{
+	if (m_bFailed)
+		return false;
+
+	std::unique_lock lock{m_mutex};
+
+	std::deque<SEntry> *queue = &m_queues[iWorker];
+	if (queue->empty()) {
+		// Steal from the back of another queue. Prefer one that ends with
+		// the inputs this worker used last, and otherwise the longest.
+		std::deque<SEntry> *victim = nullptr;
+		for (std::deque<SEntry> &q : m_queues) {
+			if (q.empty())
+				continue;
+			if (m_lastGroup[iWorker] != SIZE_MAX && q.back().iGroup == m_lastGroup[iWorker]) {
+				victim = &q;
+				break;
+			}
+			if (!victim || q.size() > victim->size())
+				victim = &q;
+		}
+		if (!victim)
+			return false;
+
+		ASTRA_DEBUG("CJobScheduler: worker %d steals an entry", iWorker);
+		m_iSteals++;
+		entry = victim->back().pEntry;
+		m_lastGroup[iWorker] = victim->back().iGroup;
+		victim->pop_back();
+		return true;
 	}
 
-private:
-	CCompositeGeometryManager::TJobSetInternal &m_jobs;
-	CCompositeGeometryManager::TJobSetInternal::const_iterator m_iter;
-	std::atomic<bool> failed;
-	std::mutex m_mutex;
-	std::string m_error;
-};
+	entry = queue->front().pEntry;
+	m_lastGroup[iWorker] = queue->front().iGroup;
+	queue->pop_front();
+	return true;
+}
 
-struct WorkThreadInfo {
-	WorkQueue* m_queue;
-	unsigned int m_iGPU;
-};
+void CCompositeGeometryManager::CJobScheduler::flagFailure(const std::string &err)
+{
+	m_bFailed = true;
+	std::unique_lock lock{m_mutex};
+	// We overwrite any existing error. Might have to change that
+	// if we ever change the Python error capture mechanism.
+	m_error = err;
+}
+
+std::string CCompositeGeometryManager::CJobScheduler::getError() const
+{
+	std::unique_lock lock{m_mutex};
+	return m_error;
+}
 
-void runEntries(WorkThreadInfo* info)
+size_t CCompositeGeometryManager::CJobScheduler::getStealCount() const
 {
-	ASTRA_DEBUG("Launching thread on GPU %d", info->m_iGPU);
-	CCompositeGeometryManager::TJobSetInternal::const_iterator i;
-	while (info->m_queue->receive(i)) {
-		ASTRA_DEBUG("Running block on GPU %d", info->m_iGPU);
-		astraCUDA3d::setGPUIndex(info->m_iGPU);
-		if (!doJob(i)) {
-			ASTRA_DEBUG("Thread on GPU %d reporting failure", info->m_iGPU);
+	std::unique_lock lock{m_mutex};
+	return m_iSteals;
+}
+
+static void runDevice(CCompositeGeometryManager::CJobScheduler &scheduler,
+                      CCompositeGeometryManager::CJobDevice *device, int iWorker)
+{
+	if (!device->start()) {
+		scheduler.flagFailure(CLogger::getLastErrMsg());
+		return;
+	}
+
+	const CCompositeGeometryManager::TJobSetInternal::value_type *entry;
+	while (scheduler.receive(iWorker, entry)) {
+		if (!device->runEntry(*entry)) {
+			ASTRA_DEBUG("Worker %d reporting failure", iWorker);
 			// Capture last error message from this thread to
 			// report it back to the main thread.
-			std::string err = CLogger::getLastErrMsg();
-			info->m_queue->flag_failure(err);
+			scheduler.flagFailure(CLogger::getLastErrMsg());
 		}
 	}
-	ASTRA_DEBUG("Finishing thread on GPU %d", info->m_iGPU);
+
+	device->finish();
 }
 
-void runWorkQueue(WorkQueue &queue, const std::vector<int> & iGPUIndices) {
-	int iThreadCount = iGPUIndices.size();
+//static
+bool CCompositeGeometryManager::runJobs(const TJobSetInternal &jobs, const std::vector<CJobDevice*> &devices)
+{
+	int iThreadCount = devices.size();
+	if (iThreadCount == 0)
+		return false;
 
-	std::vector<WorkThreadInfo> infos;
-	std::vector<std::thread*> threads;
-	infos.resize(iThreadCount);
-	threads.resize(iThreadCount);
-	ASTRA_DEBUG("Thread count %d", iThreadCount);
+	CJobScheduler scheduler(jobs, iThreadCount);
 
-	for (int i = 0; i < iThreadCount; ++i) {
-		infos[i].m_queue = &queue;
-		infos[i].m_iGPU = iGPUIndices[i];
-		threads[i] = new std::thread(runEntries, &infos[i]);
+	if (iThreadCount == 1) {
+		ASTRA_DEBUG("Running single-threaded");
+		runDevice(scheduler, devices[0], 0);
+		// Errors have been reported in this thread already
+		return !scheduler.hasFailed();
 	}
 
+	ASTRA_DEBUG("Running multi-threaded, thread count %d", iThreadCount);
+
+	std::vector<std::thread> threads;
+	for (int i = 0; i < iThreadCount; ++i)
+		threads.emplace_back(runDevice, std::ref(scheduler), devices[i], i);
+
 	// Wait for them to finish
-	for (int i = 0; i < iThreadCount; ++i) {
-		threads[i]->join();
-		delete threads[i];
-		threads[i] = 0;
-	}
-}
+	for (std::thread &t : threads)
+		t.join();
 
+	ASTRA_DEBUG("CJobScheduler: %zu entries stolen", scheduler.getStealCount());
 
-void CCompositeGeometryManager::setGPUIndices(const std::vector<int>& GPUIndices)
-{
-	m_GPUIndices = GPUIndices;
+	if (scheduler.hasFailed()) {
+		std::string err = scheduler.getError();
+		if (!err.empty())
+			ASTRA_ERROR("%s", err.c_str());
+		return false;
+	}
+
+	return true;
 }
 
+#ifdef ASTRA_CUDA
+
 bool CCompositeGeometryManager::doJobs(TJobList &jobs)
 {
 	// Convert job list into (internal) job set.
@@ -1394,10 +1910,9 @@ bool CCompositeGeometryManager::doJobs(TJobList &jobs)
 
 	for (SJob &job : jobs) {
 		TJobListInternal newjobs;
-		SJobInternal newjob{std::move(job.pInput)};
+		SJobInternal newjob{std::move(job.pInput), job.FDKSettings};
 		newjob.eMode = job.eMode;
 		newjob.pProjector = job.pProjector;
-		newjob.FDKSettings = job.FDKSettings;
 		newjob.eType = job.eType;
 		newjobs.push_back(std::move(newjob));
 
@@ -1412,6 +1927,13 @@ bool CCompositeGeometryManager::doJobs(TJobSetInternal &jobset)
 
 	ASTRA_DEBUG("CCompositeGeometryManager::doJobs starting");
 
+	for (const TJobSetInternal::value_type &entry : jobset) {
+		if (entry.first->pData->isReadOnly()) {
+			ASTRA_ERROR("CCompositeGeometryManager::doJobs: output data object is read-only");
+			return false;
+		}
+	}
+
 	size_t maxSize = m_iMaxSize;
 	if (maxSize == 0) {
 		// Get memory from first GPU. Not optimal...
@@ -1427,52 +1949,140 @@ bool CCompositeGeometryManager::doJobs(TJobSetInternal &jobset)
 	} else {
 		ASTRA_DEBUG("Set to %lu bytes of GPU memory", maxSize);
 	}
-	maxSize = (maxSize * 9) / 10;
+	maxSize = getSplitSize(maxSize);
 
-	maxSize /= sizeof(float);
 	int div = 1;
 	if (!m_GPUIndices.empty())
 		div = m_GPUIndices.size();
 
+	int maxBlockDim = astraCUDA3d::maxBlockDimension();
+	ASTRA_DEBUG("Found max block dim %d", maxBlockDim);
+
 	// Split jobs to fit
 	TJobSetInternal split;
-	splitJobs(jobset, maxSize, div, split);
+	splitJobs(jobset, maxSize, maxBlockDim, div, split);
 	jobset.clear();
 
-	if (m_GPUIndices.size() <= 1) {
+	std::vector<std::unique_ptr<CGPUJobDevice>> gpus;
+	if (m_GPUIndices.empty())
+		gpus.emplace_back(new CGPUJobDevice(-1));
+	for (int iGPU : m_GPUIndices)
+		gpus.emplace_back(new CGPUJobDevice(iGPU));
 
-		// Run jobs
-		ASTRA_DEBUG("Running single-threaded");
+	std::vector<CJobDevice*> devices;
+	for (std::unique_ptr<CGPUJobDevice> &gpu : gpus)
+		devices.push_back(gpu.get());
 
-		if (!m_GPUIndices.empty())
-			astraCUDA3d::setGPUIndex(m_GPUIndices[0]);
+	if (!runJobs(split, devices))
+		return false;
 
-		for (TJobSetInternal::const_iterator iter = split.begin(); iter != split.end(); ++iter) {
-			if (!doJob(iter)) {
-				ASTRA_DEBUG("doJob failed, aborting");
-				return false;
-			}
-		}
+	ASTRA_DEBUG("CCompositeGeometryManager::doJobs done");
+
+	return true;
+}
+
+#endif
+
+//static
+size_t CCompositeGeometryManager::getSplitSize(size_t iMemory)
+{
+	if (iMemory == 0)
+		iMemory = 1024 * 1024 * 1024;
+	return ((iMemory * 9) / 10) / sizeof(float);
+}
+
+static CCompositeGeometryManager::SPlanPart planPart(const CCompositeGeometryManager::CPart &part)
+{
+	CCompositeGeometryManager::SPlanPart p;
+	p.bVolume = part.eType == CCompositeGeometryManager::CPart::PART_VOL;
+	p.offset[0] = part.subX;
+	p.offset[1] = part.subY;
+	p.offset[2] = part.subZ;
+	part.getDims(p.dims[0], p.dims[1], p.dims[2]);
+	return p;
+}
+
+//static
+bool CCompositeGeometryManager::planJob(EJobType eType,
+                                        const CVolumeGeometry3D &volGeom,
+                                        const CProjectionGeometry3D &projGeom,
+                                        size_t iMemory, int iDeviceCount,
+                                        int iMaxBlockDim, SJobPlan &plan,
+                                        ESplitStrategy eStrategy)
+{
+	if (eType == JOB_NOP || iDeviceCount < 1 || iMaxBlockDim < 1)
+		return false;
 
+	// Parts without data, standing for host data of the full geometries
+	CVolumePart *vol = new CVolumePart();
+	vol->pGeom = volGeom.clone();
+	CProjectionPart *proj = new CProjectionPart();
+	proj->pGeom = projGeom.clone();
+
+	std::unique_ptr<CPart> input, output;
+	if (eType == JOB_FP) {
+		input.reset(vol);
+		output.reset(proj);
 	} else {
+		input.reset(proj);
+		output.reset(vol);
+	}
 
-		ASTRA_DEBUG("Running multi-threaded");
+	TJobSetInternal jobset;
+	TJobListInternal L;
+	SJobInternal job{std::move(input)};
+	job.eType = eType;
+	job.eMode = MODE_SET;
+	L.push_back(std::move(job));
+	jobset.push_back(std::make_pair(std::move(output), std::move(L)));
 
-		WorkQueue wq(split);
+	plan.iMaxSize = getSplitSize(iMemory);
+	plan.iDeviceCount = iDeviceCount;
+	plan.outputs.clear();
+	plan.iTransferBytes = 0;
+	plan.fCost = 0.0;
 
-		runWorkQueue(wq, m_GPUIndices);
+	CCompositeGeometryManager cgm;
+	cgm.m_eSplitStrategy = eStrategy;
+	TJobSetInternal split;
+	if (!cgm.splitJobs(jobset, plan.iMaxSize, iMaxBlockDim, iDeviceCount, split))
+		return false;
 
-		if (wq.has_failed()) {
-			std::string err = wq.get_error();
-			if (!err.empty())
-				ASTRA_ERROR("%s", err.c_str());
-			return false;
+	// Transfers as done by doJob: the output is uploaded unless the first
+	// job overwrites it, and always downloaded; every input is uploaded.
+	for (const auto &p : split) {
+		SPlanOutput out;
+		out.part = planPart(*p.first);
+		size_t outputBytes = p.first->getSize() * sizeof(float);
+		out.iUploadBytes = 0;
+		if (!p.second.empty() && p.second.front().eMode != MODE_SET)
+			out.iUploadBytes = outputBytes;
+		out.iDownloadBytes = outputBytes;
+		plan.iTransferBytes += out.iUploadBytes + out.iDownloadBytes;
+
+		for (const SJobInternal &j : p.second) {
+			SPlanJob pj;
+			pj.eType = j.eType;
+			pj.eMode = j.eMode;
+			pj.iInputBytes = 0;
+			pj.fCost = 0.0;
+			if (j.pInput) {
+				pj.input = planPart(*j.pInput);
+				pj.iInputBytes = j.pInput->getSize() * sizeof(float);
+				pj.fCost = estimateJobCost(j.eType, p.first->getSize(),
+				                           pj.input.dims[0], pj.input.dims[1], pj.input.dims[2]);
+			} else {
+				pj.input = SPlanPart{};
+				pj.input.bVolume = eType != JOB_FP;
+			}
+			plan.iTransferBytes += pj.iInputBytes;
+			plan.fCost += pj.fCost;
+			out.jobs.push_back(pj);
 		}
 
+		plan.outputs.push_back(std::move(out));
 	}
 
-	ASTRA_DEBUG("CCompositeGeometryManager::doJobs done");
-
 	return true;
 }
 
@@ -1496,9 +2106,8 @@ void CCompositeGeometryManager::setGlobalGPUParams(const SGPUParams& params)
 	std::string ss = s.str();
 	ASTRA_DEBUG("%s", ss.c_str());
 	ASTRA_DEBUG("Memory: %zu", params.memory);
+	ASTRA_DEBUG("Split strategy: %s", params.splitStrategy == SPLIT_COST ? "cost" : "linear");
 }
 
 
 }
-
-#endif
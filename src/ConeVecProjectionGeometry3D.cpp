@@ -31,6 +31,7 @@ along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
 #include "astra/Utilities.h"
 #include "astra/Logging.h"
 
+#include <algorithm>
 #include <cstring>
 
 using namespace std;
@@ -80,7 +81,7 @@ bool CConeVecProjectionGeometry3D::initializeAngles(const Config& _cfg)
 	ConfigReader<CProjectionGeometry3D> CR("ConeVecProjectionGeometry3D", this, _cfg);
 
 	// Required: Vectors
-	vector<double> data;
+	ConfigNumericalArray data;
 	if (!CR.getRequiredNumericalArray("Vectors", data))
 		return false;
 	ASTRA_CONFIG_CHECK(data.size() % 12 == 0, "ConeVecProjectionGeometry3D", "Vectors doesn't consist of 12-tuples.");
@@ -116,6 +117,8 @@ bool CConeVecProjectionGeometry3D::initialize(int _iProjectionAngleCount,
                                                   int _iDetectorColCount, 
                                                   std::vector<SConeProjection> &&_pProjectionAngles)
 {
+	m_cache.invalidate();
+
 	m_iProjectionAngleCount = _iProjectionAngleCount;
 	m_iDetectorRowCount = _iDetectorRowCount;
 	m_iDetectorColCount = _iDetectorColCount;
@@ -217,6 +220,49 @@ void CConeVecProjectionGeometry3D::projectPoint(double fX, double fY, double fZ,
 }
 
 
+//----------------------------------------------------------------------------------------
+
+void CConeVecProjectionGeometry3D::getProjectedBBoxSingleAngle(int iAngle,
+                                             double fXMin, double fXMax,
+                                             double fYMin, double fYMax,
+                                             double fZMin, double fZMax,
+                                             double &fUMin, double &fUMax,
+                                             double &fVMin, double &fVMax) const
+{
+	ASTRA_ASSERT(iAngle >= 0);
+	ASTRA_ASSERT(iAngle < m_iProjectionAngleCount);
+
+	// Use the cached per-angle coefficients instead of recomputing them
+	// for every corner
+	auto coeffs = getConeBP_UV_Coeffs(this);
+	assert(coeffs);
+
+	const SConeBPCoeffs &c = (*coeffs)[iAngle];
+
+	double vol_u[8];
+	double vol_v[8];
+
+	for (int j = 0; j < 8; ++j) {
+		double fX = (j & 4) ? fXMax : fXMin;
+		double fY = (j & 2) ? fYMax : fYMin;
+		double fZ = (j & 1) ? fZMax : fZMin;
+
+		// The -0.5f shifts from corner to center of detector pixels
+		double fD = c.fDX*fX + c.fDY*fY + c.fDZ*fZ + c.fDC;
+		vol_u[j] = (c.fUX*fX + c.fUY*fY + c.fUZ*fZ + c.fUC) / fD - 0.5;
+		vol_v[j] = (c.fVX*fX + c.fVY*fY + c.fVZ*fZ + c.fVC) / fD - 0.5;
+	}
+
+	fUMin = fUMax = vol_u[0];
+	fVMin = fVMax = vol_v[0];
+	for (int j = 1; j < 8; ++j) {
+		fUMin = std::min(fUMin, vol_u[j]);
+		fUMax = std::max(fUMax, vol_u[j]);
+		fVMin = std::min(fVMin, vol_v[j]);
+		fVMax = std::max(fVMax, vol_v[j]);
+	}
+}
+
 //----------------------------------------------------------------------------------------
 
 bool CConeVecProjectionGeometry3D::_check()
@@ -199,6 +199,23 @@ bool ConfigReader<T>::getRequiredNumericalArray(const std::string &name, std::ve
 	return true;
 }
 
+template<class T>
+bool ConfigReader<T>::getRequiredNumericalArray(const std::string &name, ConfigNumericalArray &values)
+{
+	values.clear();
+	if (!cfg->has(name)) {
+		astra::CLogger::error(__FILE__, __LINE__, "Configuration error in %s: No %s tag specified.", objName, name.c_str());
+		return false;
+	}
+	markNodeParsed(name);
+
+	if (!cfg->getDoubleArray(name, values)) {
+		astra::CLogger::error(__FILE__, __LINE__, "Configuration error in %s: %s must be a numerical matrix.", objName, name.c_str());
+		return false;
+	}
+	return true;
+}
+
 template<class T>
 bool ConfigReader<T>::getRequiredIntArray(const std::string &name, std::vector<int> &values)
 {
@@ -121,6 +121,7 @@ bool CCudaDartMaskAlgorithm3D::run(int _iNrIterations)
 bool CCudaDartMaskAlgorithm3D::_check() 
 {
 	ASTRA_CONFIG_CHECK(m_pMask->isFloat32Memory(), "CudaDartMask3D", "Mask data object must be float32/memory");
+	ASTRA_CONFIG_CHECK(!m_pMask->isReadOnly(), "CudaDartMask3D", "Mask data object is read-only");
 	ASTRA_CONFIG_CHECK(m_pSegmentation->isFloat32Memory(), "CudaDartMask3D", "Segmentation data object must be float32/memory");
 
 	// connectivity: 6 or 26
@@ -121,6 +121,7 @@ bool CCudaDartSmoothingAlgorithm3D::_check()
 {
 	ASTRA_CONFIG_CHECK(m_pIn->isFloat32Memory(), "CudaDartSmoothing3D", "Input data object must be float32/memory");
 	ASTRA_CONFIG_CHECK(m_pOut->isFloat32Memory(), "CudaDartSmoothing3D", "Output data object must be float32/memory");
+	ASTRA_CONFIG_CHECK(!m_pOut->isReadOnly(), "CudaDartSmoothing3D", "Output data object is read-only");
 
 	// geometry of inData must match that of outData
 
@@ -187,6 +187,7 @@ bool CCudaForwardProjectionAlgorithm3D::check()
 	//ASTRA_CONFIG_CHECK(m_pProjector->isInitialized(), "Reconstruction2D", "Projector Object Not Initialized.");
 	ASTRA_CONFIG_CHECK(m_pProjections->isInitialized(), "FP3D_CUDA", "Projection Data Object Not Initialized.");
 	ASTRA_CONFIG_CHECK(m_pVolume->isInitialized(), "FP3D_CUDA", "Volume Data Object Not Initialized.");
+	ASTRA_CONFIG_CHECK(!m_pProjections->isReadOnly(), "FP3D_CUDA", "Projection Data Object is read-only.");
 
 	ASTRA_CONFIG_CHECK(m_iDetectorSuperSampling >= 1, "FP3D_CUDA", "DetectorSuperSampling must be a positive integer.");
 
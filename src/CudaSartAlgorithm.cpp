@@ -215,6 +215,14 @@ bool CCudaSartAlgorithm::precomputeWeights()
 }
 
 
+//----------------------------------------------------------------------------------------
+// Reset
+void CCudaSartAlgorithm::reset()
+{
+	CCudaReconstructionAlgorithm2D::reset();
+	m_iIteration = 0;
+}
+
 //----------------------------------------------------------------------------------------
 
 bool CCudaSartAlgorithm::run(int _iNrIterations)
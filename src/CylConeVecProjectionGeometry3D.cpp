@@ -80,7 +80,7 @@ bool CCylConeVecProjectionGeometry3D::initializeAngles(const Config& _cfg)
 	ConfigReader<CProjectionGeometry3D> CR("CylConeVecProjectionGeometry3D", this, _cfg);	
 
 	// Required: Vectors
-	vector<double> data;
+	ConfigNumericalArray data;
 	if (!CR.getRequiredNumericalArray("Vectors", data))
 		return false;
 	ASTRA_CONFIG_CHECK(data.size() % 13 == 0, "CylConeVecProjectionGeometry3D", "Vectors doesn't consist of 13-tuples.");
@@ -118,6 +118,8 @@ bool CCylConeVecProjectionGeometry3D::initialize(int _iProjectionAngleCount,
                                                   int _iDetectorColCount, 
                                                   std::vector<SCylConeProjection> &&_pProjectionAngles)
 {
+	m_cache.invalidate();
+
 	m_iProjectionAngleCount = _iProjectionAngleCount;
 	m_iDetectorRowCount = _iDetectorRowCount;
 	m_iDetectorColCount = _iDetectorColCount;
@@ -0,0 +1,397 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+#include "astra/DLPack.h"
+
+#include "astra/Data2D.h"
+#include "astra/Data3D.h"
+#include "astra/Utilities.h"
+
+#include <cstring>
+#include <vector>
+
+namespace astra {
+
+namespace {
+
+template<class DLT>
+void deleteDLTensor(DLT *tensor_m)
+{
+	if (tensor_m) {
+		assert(tensor_m->deleter);
+		tensor_m->deleter(tensor_m);
+	}
+}
+
+bool isReadOnly(const DLManagedTensor *) { return false; }
+bool isReadOnly(const DLManagedTensorVersioned *tensor_m)
+{
+	return tensor_m->flags & DLPACK_FLAG_BITMASK_READ_ONLY;
+}
+
+uint8_t *getDLTensorData(const DLTensor *tensor)
+{
+	return static_cast<uint8_t*>(tensor->data) + tensor->byte_offset;
+}
+
+// Storage linking the memory of a contiguous DLPack tensor
+template<class DLT, typename T>
+class CDataStorageDLPackCPU : public CDataMemory<T> {
+public:
+	CDataStorageDLPackCPU(DLT *tensor_m) : m_pTensor(tensor_m) {
+		this->m_pfData = reinterpret_cast<T*>(getDLTensorData(&m_pTensor->dl_tensor));
+	}
+	virtual ~CDataStorageDLPackCPU() {
+		deleteDLTensor(m_pTensor);
+		m_pTensor = nullptr;
+
+		// Prevent the parent destructor from deleting this memory
+		this->m_pfData = nullptr;
+	}
+
+	virtual bool isReadOnly() const { return astra::isReadOnly(m_pTensor); }
+
+protected:
+	DLT *m_pTensor;
+};
+
+// Storage holding a contiguous copy of a strided or misaligned DLPack
+// tensor, which is copied back into the tensor on destruction
+template<class DLT, typename T>
+class CDataStorageDLPackCopy : public CDataMemory<T> {
+public:
+	CDataStorageDLPackCopy(DLT *tensor_m, size_t size) : CDataMemory<T>(size), m_pTensor(tensor_m), m_iSize(size) {
+		if (this->m_pfData)
+			copy(true);
+	}
+	virtual ~CDataStorageDLPackCopy() {
+		if (this->m_pfData && !isReadOnly())
+			copy(false);
+		deleteDLTensor(m_pTensor);
+		m_pTensor = nullptr;
+	}
+
+	virtual bool isReadOnly() const { return astra::isReadOnly(m_pTensor); }
+
+protected:
+	void copy(bool toBuffer);
+
+	DLT *m_pTensor;
+	size_t m_iSize;
+};
+
+template<class DLT, typename T>
+void CDataStorageDLPackCopy<DLT, T>::copy(bool toBuffer)
+{
+	const DLTensor *tensor = &m_pTensor->dl_tensor;
+	const int ndim = tensor->ndim;
+	assert(ndim >= 1);
+
+	std::vector<int64_t> strides(ndim);
+	int64_t acc = 1;
+	for (int d = ndim - 1; d >= 0; --d) {
+		strides[d] = tensor->strides ? tensor->strides[d] : acc;
+		acc *= tensor->shape[d];
+	}
+
+	// Copy row by row, using byte copies since the tensor may be misaligned
+	uint8_t *base = getDLTensorData(tensor);
+	const size_t rowLength = tensor->shape[ndim - 1];
+	const int64_t innerStride = strides[ndim - 1];
+	std::vector<int64_t> idx(ndim, 0);
+	T *row = this->m_pfData;
+	for (size_t n = 0; n < m_iSize; n += rowLength, row += rowLength) {
+		int64_t offset = 0;
+		for (int d = 0; d < ndim - 1; ++d)
+			offset += idx[d] * strides[d];
+		uint8_t *src = base + offset * (int64_t)sizeof(T);
+
+		if (innerStride == 1) {
+			if (toBuffer)
+				std::memcpy(row, src, rowLength * sizeof(T));
+			else
+				std::memcpy(src, row, rowLength * sizeof(T));
+		} else {
+			for (size_t i = 0; i < rowLength; ++i) {
+				uint8_t *e = src + (int64_t)i * innerStride * (int64_t)sizeof(T);
+				if (toBuffer)
+					std::memcpy(row + i, e, sizeof(T));
+				else
+					std::memcpy(e, row + i, sizeof(T));
+			}
+		}
+
+		for (int d = ndim - 2; d >= 0; --d) {
+			if (++idx[d] < tensor->shape[d])
+				break;
+			idx[d] = 0;
+		}
+	}
+}
+
+template<class DLT, typename T>
+CDataStorage *createDLPackStorage(DLT *tensor_m, bool direct, size_t size)
+{
+	if (direct)
+		return new CDataStorageDLPackCPU<DLT, T>(tensor_m);
+
+	CDataStorageDLPackCopy<DLT, T> *storage = new CDataStorageDLPackCopy<DLT, T>(tensor_m, size);
+	if (!storage->getData()) {
+		// Allocation failed; don't consume the tensor
+		delete storage;
+		return nullptr;
+	}
+	return storage;
+}
+
+}
+
+bool isDLPackHostDevice(DLDeviceType type)
+{
+	return type == kDLCPU || type == kDLCUDAHost || type == kDLROCMHost;
+}
+
+template<size_t D>
+bool checkDLTensor(const DLTensor *tensor, std::array<int, D> dims, std::string &error, bool allowHalf)
+{
+	// data type
+	bool half = (tensor->dtype.code == kDLFloat || tensor->dtype.code == kDLBfloat)
+	            && tensor->dtype.bits == 16;
+	if (allowHalf && half) {
+		// float16/bfloat16 are stored as-is in host memory
+	} else if (tensor->dtype.code != kDLFloat || tensor->dtype.bits != 32)
+	{
+		error = allowHalf ? "Data must be float32, float16 or bfloat16"
+		                  : "Data must be float32";
+		return false;
+	}
+	if (tensor->dtype.lanes != 1) {
+		error = "Data must be single-channel";
+		return false;
+	}
+
+	// shape
+	if constexpr (D == 2) {
+		if (tensor->ndim != 2) {
+			error = "Data must be two-dimensional";
+			return false;
+		}
+
+		if (tensor->shape[0] != dims[1] || tensor->shape[1] != dims[0])
+		{
+			error = StringUtil::format("Data shape (%zd x %zd) does not match geometry (%d x %d)", tensor->shape[0], tensor->shape[1], dims[1], dims[0]);
+			return false;
+		}
+	}
+	if constexpr (D == 3) {
+		if (tensor->ndim != 3) {
+			error = "Data must be three-dimensional";
+			return false;
+		}
+
+		if (tensor->shape[0] != dims[2] || tensor->shape[1] != dims[1] ||
+		    tensor->shape[2] != dims[0])
+		{
+			error = StringUtil::format("Data shape (%zd x %zd x %zd) does not match geometry (%d x %d x %d)", tensor->shape[0], tensor->shape[1], tensor->shape[2], dims[2], dims[1], dims[0]);
+			return false;
+		}
+	}
+
+	error = "";
+	return true;
+}
+
+bool isContiguousDLTensor(const DLTensor *tensor)
+{
+	if (!tensor->strides)
+		return true;
+
+	// Ignore singleton dimensions as they don't affect contiguity and tensor producers
+	// may optionally set their strides to 1
+	int64_t accumulator = 1;
+	for (int i = tensor->ndim - 1; i >= 0; --i) {
+		if (tensor->shape[i] <= 1)
+			continue;
+		if (tensor->strides[i] != accumulator)
+			return false;
+		accumulator *= tensor->shape[i];
+	}
+	return true;
+}
+
+bool isAlignedDLTensor(const DLTensor *tensor)
+{
+	size_t elementSize = (tensor->dtype.bits * tensor->dtype.lanes + 7) / 8;
+	if (elementSize == 0)
+		return true;
+	return ((size_t)getDLTensorData(tensor) % elementSize) == 0;
+}
+
+template<class DLT, size_t D>
+CDataStorage *wrapDLTensorCPU(DLT *tensor_m, std::array<int, D> dims, std::string &error, bool allowCopy)
+{
+	const DLTensor *tensor = &tensor_m->dl_tensor;
+
+	if (!isDLPackHostDevice(tensor->device.device_type)) {
+		error = "Unsupported dlpack device type";
+		return nullptr;
+	}
+
+	if (!checkDLTensor(tensor, dims, error, true))
+		return nullptr;
+
+	bool contiguous = isContiguousDLTensor(tensor);
+	bool aligned = isAlignedDLTensor(tensor);
+	bool direct = contiguous && aligned;
+	if (!direct && !allowCopy) {
+		error = contiguous ? "Data must be aligned" : "Data must be contiguous";
+		return nullptr;
+	}
+
+	size_t size = 1;
+	for (int d : dims)
+		size *= d;
+
+	CDataStorage *storage;
+	if (tensor->dtype.code == kDLBfloat)
+		storage = createDLPackStorage<DLT, bfloat16>(tensor_m, direct, size);
+	else if (tensor->dtype.bits == 16)
+		storage = createDLPackStorage<DLT, float16>(tensor_m, direct, size);
+	else
+		storage = createDLPackStorage<DLT, float32>(tensor_m, direct, size);
+
+	if (!storage)
+		error = "Failed to allocate memory for a copy of the data";
+
+	return storage;
+}
+
+
+namespace {
+
+template<size_t D>
+struct SDLPackExportContext {
+	int64_t shape[D];
+	int64_t strides[D];
+	std::function<void()> onDelete;
+};
+
+template<class DLT, size_t D>
+void exportDeleter(DLT *self)
+{
+	SDLPackExportContext<D> *ctx = static_cast<SDLPackExportContext<D>*>(self->manager_ctx);
+	if (ctx->onDelete)
+		ctx->onDelete();
+	delete ctx;
+	delete self;
+}
+
+// Unversioned tensors can not be marked read-only
+bool setVersion(DLManagedTensor *, bool readOnly) { return !readOnly; }
+bool setVersion(DLManagedTensorVersioned *tensor_m, bool readOnly)
+{
+	tensor_m->version.major = DLPACK_MAJOR_VERSION;
+	tensor_m->version.minor = DLPACK_MINOR_VERSION;
+	tensor_m->flags = readOnly ? DLPACK_FLAG_BITMASK_READ_ONLY : 0;
+	return true;
+}
+
+}
+
+template<class DLT, size_t D>
+DLT *exportDLTensor(CData<D> *data, std::function<void()> onDelete, std::string &error)
+{
+	void *ptr;
+	DLDataType dtype;
+	dtype.lanes = 1;
+	if (data->isFloat32Memory()) {
+		ptr = data->getFloat32Memory();
+		dtype.code = kDLFloat;
+		dtype.bits = 32;
+	} else if (data->isFloat16Memory()) {
+		ptr = data->getFloat16Memory();
+		dtype.code = kDLFloat;
+		dtype.bits = 16;
+	} else if (data->isBFloat16Memory()) {
+		ptr = data->getBFloat16Memory();
+		dtype.code = kDLBfloat;
+		dtype.bits = 16;
+	} else {
+		error = "Data must be float32, float16 or bfloat16 host memory";
+		return nullptr;
+	}
+
+	DLT *tensor_m = new DLT{};
+	if (!setVersion(tensor_m, data->isReadOnly())) {
+		delete tensor_m;
+		error = "Read-only data can only be exported as a versioned dlpack tensor";
+		return nullptr;
+	}
+
+	SDLPackExportContext<D> *ctx = new SDLPackExportContext<D>;
+	ctx->onDelete = std::move(onDelete);
+
+	// DLPack shapes are in the reverse order of the ASTRA dimensions
+	std::array<int, D> dims = data->getShape();
+	int64_t acc = 1;
+	for (size_t i = 0; i < D; ++i) {
+		ctx->shape[D - 1 - i] = dims[i];
+		ctx->strides[D - 1 - i] = acc;
+		acc *= dims[i];
+	}
+
+	DLTensor *tensor = &tensor_m->dl_tensor;
+	tensor->data = ptr;
+	tensor->device.device_type = kDLCPU;
+	tensor->device.device_id = 0;
+	tensor->ndim = D;
+	tensor->dtype = dtype;
+	tensor->shape = ctx->shape;
+	tensor->strides = ctx->strides;
+	tensor->byte_offset = 0;
+	tensor_m->manager_ctx = ctx;
+	tensor_m->deleter = &exportDeleter<DLT, D>;
+
+	error = "";
+	return tensor_m;
+}
+
+
+template _AstraExport bool checkDLTensor<2>(const DLTensor *, std::array<int, 2>, std::string &, bool);
+template _AstraExport bool checkDLTensor<3>(const DLTensor *, std::array<int, 3>, std::string &, bool);
+
+template _AstraExport CDataStorage *wrapDLTensorCPU<DLManagedTensor, 2>(DLManagedTensor *, std::array<int, 2>, std::string &, bool);
+template _AstraExport CDataStorage *wrapDLTensorCPU<DLManagedTensor, 3>(DLManagedTensor *, std::array<int, 3>, std::string &, bool);
+template _AstraExport CDataStorage *wrapDLTensorCPU<DLManagedTensorVersioned, 2>(DLManagedTensorVersioned *, std::array<int, 2>, std::string &, bool);
+template _AstraExport CDataStorage *wrapDLTensorCPU<DLManagedTensorVersioned, 3>(DLManagedTensorVersioned *, std::array<int, 3>, std::string &, bool);
+
+template _AstraExport DLManagedTensor *exportDLTensor<DLManagedTensor, 2>(CData<2> *, std::function<void()>, std::string &);
+template _AstraExport DLManagedTensor *exportDLTensor<DLManagedTensor, 3>(CData<3> *, std::function<void()>, std::string &);
+template _AstraExport DLManagedTensorVersioned *exportDLTensor<DLManagedTensorVersioned, 2>(CData<2> *, std::function<void()>, std::string &);
+template _AstraExport DLManagedTensorVersioned *exportDLTensor<DLManagedTensorVersioned, 3>(CData<3> *, std::function<void()>, std::string &);
+
+}
@@ -28,6 +28,8 @@ along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
 #include <sstream>
 
 #include "astra/Data2D.h"
+#include "astra/DataMemoryPool.h"
+#include "astra/ThreadPool.h"
 
 namespace astra {
 
@@ -40,38 +42,6 @@ std::string CData2D::description() const
 	return res.str();
 }
 
-template<typename T>
-void CDataMemory<T>::_allocateData(size_t size)
-{
-	ASTRA_ASSERT(m_pfData == NULL);
-	ASTRA_ASSERT(m_bOwnData);
-
-	// allocate contiguous block
-#ifdef _MSC_VER
-	m_pfData = (T*)_aligned_malloc(size * sizeof(T), 16);
-#else
-	int ret = posix_memalign((void**)&m_pfData, 16, size * sizeof(T));
-	ASTRA_ASSERT(ret == 0);
-#endif
-	ASTRA_ASSERT(((size_t)m_pfData & 15) == 0);
-}
-
-template<typename T>
-void CDataMemory<T>::_freeData()
-{
-	if (!m_bOwnData)
-		return;
-
-	// free memory for data block
-#ifdef _MSC_VER
-	_aligned_free(m_pfData);
-#else
-	free(m_pfData);
-#endif
-
-	m_pfData = nullptr;
-}
-
 CData2D& CData2D::operator+=(const CData2D &_other)
 {
 	ASTRA_ASSERT(isFloat32Memory());
@@ -79,8 +49,10 @@ CData2D& CData2D::operator+=(const CData2D &_other)
 	ASTRA_ASSERT(getSize() == _other.getSize());
 	float32 *out = getFloat32Memory();
 	const float32 *in = _other.getFloat32Memory();
-	for (size_t i = 0; i < m_iSize; i++)
-		out[i] += in[i];
+	parallelForBlocks(m_iSize, ELEMENTWISE_GRAIN, [&](size_t iFrom, size_t iTo) {
+		for (size_t i = iFrom; i < iTo; i++)
+			out[i] += in[i];
+	});
 	return (*this);
 }
 
@@ -91,20 +63,19 @@ CData2D& CData2D::operator*=(const CData2D &_other)
 	ASTRA_ASSERT(getSize() == _other.getSize());
 	float32 *out = getFloat32Memory();
 	const float32 *in = _other.getFloat32Memory();
-	for (size_t i = 0; i < m_iSize; i++)
-		out[i] *= in[i];
+	parallelForBlocks(m_iSize, ELEMENTWISE_GRAIN, [&](size_t iFrom, size_t iTo) {
+		for (size_t i = iFrom; i < iTo; i++)
+			out[i] *= in[i];
+	});
 	return (*this);
 }
 
 void CData2D::copyData(const CData2D &_other)
 {
-	ASTRA_ASSERT(isFloat32Memory());
-	ASTRA_ASSERT(_other.isFloat32Memory());
+	ASTRA_ASSERT(isFloatMemory());
+	ASTRA_ASSERT(_other.isFloatMemory());
 	ASTRA_ASSERT(getSize() == _other.getSize());
-	float32 *out = getFloat32Memory();
-	const float32 *in = _other.getFloat32Memory();
-	for (size_t i = 0; i < m_iSize; i++)
-		out[i] = in[i];
+	copyConvertMemory(_other.getStorage(), 0, getStorage(), 0, m_iSize);
 }
 
 
@@ -112,35 +83,39 @@ CData2D& CData2D::operator*=(float32 _value)
 {
 	ASTRA_ASSERT(isFloat32Memory());
 	float32 *out = getFloat32Memory();
-	for (size_t i = 0; i < m_iSize; i++)
-		out[i] *= _value;
+	parallelForBlocks(m_iSize, ELEMENTWISE_GRAIN, [&](size_t iFrom, size_t iTo) {
+		for (size_t i = iFrom; i < iTo; i++)
+			out[i] *= _value;
+	});
 	return (*this);
 }
 
 void CData2D::setData(float32 _value)
 {
-	ASTRA_ASSERT(isFloat32Memory());
-	float32 *out = getFloat32Memory();
-	for (size_t i = 0; i < m_iSize; i++)
-		out[i] = _value;
+	ASTRA_ASSERT(isFloatMemory());
+	fillMemory(getStorage(), 0, m_iSize, _value);
 }
 
 void CData2D::clampMin(float32 _fMin)
 {
 	ASTRA_ASSERT(isFloat32Memory());
 	float32 *out = getFloat32Memory();
-	for (size_t i = 0; i < m_iSize; i++)
-		if (out[i] < _fMin)
-			out[i] = _fMin;
+	parallelForBlocks(m_iSize, ELEMENTWISE_GRAIN, [&](size_t iFrom, size_t iTo) {
+		for (size_t i = iFrom; i < iTo; i++)
+			if (out[i] < _fMin)
+				out[i] = _fMin;
+	});
 }
 
 void CData2D::clampMax(float32 _fMax)
 {
 	ASTRA_ASSERT(isFloat32Memory());
 	float32 *out = getFloat32Memory();
-	for (size_t i = 0; i < m_iSize; i++)
-		if (out[i] > _fMax)
-			out[i] = _fMax;
+	parallelForBlocks(m_iSize, ELEMENTWISE_GRAIN, [&](size_t iFrom, size_t iTo) {
+		for (size_t i = iFrom; i < iTo; i++)
+			if (out[i] > _fMax)
+				out[i] = _fMax;
+	});
 }
 
 CFloat32ProjectionData2D *createCFloat32ProjectionData2DMemory(const CProjectionGeometry2D &geom)
@@ -182,7 +157,21 @@ CFloat32VolumeData2D *createCFloat32VolumeData2DMemory(std::unique_ptr<CVolumeGe
 	return new CFloat32VolumeData2D(std::move(geom), storage);
 }
 
-template class CDataMemory<float32>;
+CFloat32ProjectionData2D *createCFloat32ProjectionData2DPooled(const CProjectionGeometry2D &geom)
+{
+	size_t size = geom.getProjectionAngleCount();
+	size *= geom.getDetectorCount();
+
+	CDataStorage *storage = new CDataMemoryPooled<float32>(size);
+	return new CFloat32ProjectionData2D(geom, storage);
+}
+
+CFloat32VolumeData2D *createCFloat32VolumeData2DPooled(const CVolumeGeometry2D &geom)
+{
+	CDataStorage *storage = new CDataMemoryPooled<float32>(geom.getGridTotCount());
+	return new CFloat32VolumeData2D(geom, storage);
+}
+
 template class CData2DObject<CProjectionGeometry2D>;
 template class CData2DObject<CVolumeGeometry2D>;
 
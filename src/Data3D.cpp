@@ -28,6 +28,8 @@ along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
 #include <sstream>
 
 #include "astra/Data3D.h"
+#include "astra/DataBricked.h"
+#include "astra/DataMemoryPool.h"
 
 namespace astra {
 
@@ -40,46 +42,12 @@ std::string CData3D::description() const
 	return res.str();
 }
 
-template<typename T>
-void CDataMemory<T>::_allocateData(size_t size)
-{
-	ASTRA_ASSERT(m_pfData == NULL);
-	ASTRA_ASSERT(m_bOwnData);
-
-	// allocate contiguous block
-#ifdef _MSC_VER
-	m_pfData = (T*)_aligned_malloc(size * sizeof(T), 16);
-#else
-	int ret = posix_memalign((void**)&m_pfData, 16, size * sizeof(T));
-	ASTRA_ASSERT(ret == 0);
-#endif
-	ASTRA_ASSERT(((size_t)m_pfData & 15) == 0);
-}
-
-template<typename T>
-void CDataMemory<T>::_freeData()
-{
-	if (!m_bOwnData)
-		return;
-
-	// free memory for data block
-#ifdef _MSC_VER
-	_aligned_free(m_pfData);
-#else
-	free(m_pfData);
-#endif
-
-	m_pfData = nullptr;
-}
-
 CFloat32ProjectionData3D *createCFloat32ProjectionData3DMemory(const CProjectionGeometry3D &geom)
 {
 	size_t size = geom.getProjectionCount();
 	size *= geom.getDetectorTotCount();
 
 	CDataStorage *storage = new CDataMemory<float32>(size);
-	if (!storage)
-		return 0;
 	return new CFloat32ProjectionData3D(geom, storage);
 }
 
@@ -89,8 +57,6 @@ CFloat32ProjectionData3D *createCFloat32ProjectionData3DMemory(std::unique_ptr<C
 	size *= geom->getDetectorTotCount();
 
 	CDataStorage *storage = new CDataMemory<float32>(size);
-	if (!storage)
-		return 0;
 	return new CFloat32ProjectionData3D(std::move(geom), storage);
 }
 
@@ -98,19 +64,36 @@ CFloat32ProjectionData3D *createCFloat32ProjectionData3DMemory(std::unique_ptr<C
 CFloat32VolumeData3D *createCFloat32VolumeData3DMemory(const CVolumeGeometry3D &geom)
 {
 	CDataStorage *storage = new CDataMemory<float32>(geom.getGridTotCount());
-	if (!storage)
-		return 0;
 	return new CFloat32VolumeData3D(geom, storage);
 }
 
 CFloat32VolumeData3D *createCFloat32VolumeData3DMemory(std::unique_ptr<CVolumeGeometry3D> &&geom)
 {
 	CDataStorage *storage = new CDataMemory<float32>(geom->getGridTotCount());
-	if (!storage)
-		return 0;
 	return new CFloat32VolumeData3D(std::move(geom), storage);
 }
 
+CFloat32ProjectionData3D *createCFloat32ProjectionData3DPooled(const CProjectionGeometry3D &geom)
+{
+	size_t size = geom.getProjectionCount();
+	size *= geom.getDetectorTotCount();
+
+	CDataStorage *storage = new CDataMemoryPooled<float32>(size);
+	return new CFloat32ProjectionData3D(geom, storage);
+}
+
+CFloat32VolumeData3D *createCFloat32VolumeData3DPooled(const CVolumeGeometry3D &geom)
+{
+	CDataStorage *storage = new CDataMemoryPooled<float32>(geom.getGridTotCount());
+	return new CFloat32VolumeData3D(geom, storage);
+}
+
+CFloat32VolumeData3D *createCFloat32VolumeData3DBricked(const CVolumeGeometry3D &geom, int brickSize)
+{
+	CDataStorage *storage = new CDataBricked<float32>(geom.getGridColCount(), geom.getGridRowCount(), geom.getGridSliceCount(), brickSize);
+	return new CFloat32VolumeData3D(geom, storage);
+}
+
 template class CData3DObject<CProjectionGeometry3D>;
 template class CData3DObject<CVolumeGeometry3D>;
 
@@ -0,0 +1,142 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+#include "astra/DataBricked.h"
+#include "astra/Logging.h"
+
+#include <algorithm>
+
+namespace astra {
+
+template<typename T>
+CDataBricked<T>::CDataBricked(int x, int y, int z, int brickSize)
+	: m_iDims{x, y, z}, m_pfData(nullptr)
+{
+	ASTRA_ASSERT(x > 0 && y > 0 && z > 0);
+	ASTRA_ASSERT(brickSize > 0 && (brickSize & (brickSize - 1)) == 0);
+
+	m_iBrickShift = 0;
+	while ((1 << m_iBrickShift) < brickSize)
+		m_iBrickShift++;
+	m_iBrickVolume = (size_t)brickSize * brickSize * brickSize;
+
+	for (int i = 0; i < 3; ++i)
+		m_iBrickCounts[i] = (m_iDims[i] + brickSize - 1) >> m_iBrickShift;
+
+	size_t size = getBrickCount() * m_iBrickVolume;
+
+	bool hugePages;
+	m_pfData = (T*)allocateDataMemory(size * sizeof(T), hugePages);
+	ASTRA_ASSERT(m_pfData);
+
+	std::fill(m_pfData, m_pfData + size, T(0));
+}
+
+template<typename T>
+CDataBricked<T>::~CDataBricked()
+{
+	freeDataMemory(m_pfData);
+	m_pfData = nullptr;
+}
+
+template<typename T>
+void CDataBricked<T>::setData(T value)
+{
+	const int B = getBrickSize();
+	for (int bz = 0; bz < m_iBrickCounts[2]; ++bz) {
+		int nz = std::min(B, m_iDims[2] - bz * B);
+		for (int by = 0; by < m_iBrickCounts[1]; ++by) {
+			int ny = std::min(B, m_iDims[1] - by * B);
+			for (int bx = 0; bx < m_iBrickCounts[0]; ++bx) {
+				int nx = std::min(B, m_iDims[0] - bx * B);
+				T *brick = getBrick(bx, by, bz);
+				for (int k = 0; k < nz; ++k)
+					for (int j = 0; j < ny; ++j)
+						std::fill_n(brick + ((size_t)k * B + j) * B, nx, value);
+			}
+		}
+	}
+}
+
+template<typename T>
+void CDataBricked<T>::copyFromLinear(const T *src)
+{
+	copySubFromLinear(0, 0, 0, m_iDims[0], m_iDims[1], m_iDims[2], src);
+}
+
+template<typename T>
+void CDataBricked<T>::copyToLinear(T *dst) const
+{
+	copySubToLinear(0, 0, 0, m_iDims[0], m_iDims[1], m_iDims[2], dst);
+}
+
+// Both directions walk the linear array in order, and copy each row in
+// runs that end at brick boundaries.
+
+template<typename T>
+void CDataBricked<T>::copySubFromLinear(int x0, int y0, int z0, int nx, int ny, int nz, const T *src)
+{
+	ASTRA_ASSERT(x0 >= 0 && y0 >= 0 && z0 >= 0);
+	ASTRA_ASSERT(x0 + nx <= m_iDims[0] && y0 + ny <= m_iDims[1] && z0 + nz <= m_iDims[2]);
+
+	const int mask = getBrickSize() - 1;
+	for (int z = z0; z < z0 + nz; ++z) {
+		for (int y = y0; y < y0 + ny; ++y) {
+			int x = x0;
+			while (x < x0 + nx) {
+				int run = std::min(mask + 1 - (x & mask), x0 + nx - x);
+				std::copy_n(src, run, m_pfData + index(x, y, z));
+				src += run;
+				x += run;
+			}
+		}
+	}
+}
+
+template<typename T>
+void CDataBricked<T>::copySubToLinear(int x0, int y0, int z0, int nx, int ny, int nz, T *dst) const
+{
+	ASTRA_ASSERT(x0 >= 0 && y0 >= 0 && z0 >= 0);
+	ASTRA_ASSERT(x0 + nx <= m_iDims[0] && y0 + ny <= m_iDims[1] && z0 + nz <= m_iDims[2]);
+
+	const int mask = getBrickSize() - 1;
+	for (int z = z0; z < z0 + nz; ++z) {
+		for (int y = y0; y < y0 + ny; ++y) {
+			int x = x0;
+			while (x < x0 + nx) {
+				int run = std::min(mask + 1 - (x & mask), x0 + nx - x);
+				std::copy_n(m_pfData + index(x, y, z), run, dst);
+				dst += run;
+				x += run;
+			}
+		}
+	}
+}
+
+template class CDataBricked<float32>;
+
+}
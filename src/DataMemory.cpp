@@ -0,0 +1,235 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+#include "astra/Data.h"
+
+#include "astra/Logging.h"
+#include "astra/ThreadPool.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace astra {
+
+static std::mutex g_DataMemoryOptions_mutex;
+static SDataMemoryOptions g_DataMemoryOptions;
+
+// Transparent huge pages are 2MB on the common architectures
+static const size_t HUGE_PAGE_SIZE = (size_t)2 << 20;
+
+void setDataMemoryOptions(const SDataMemoryOptions &options)
+{
+	std::unique_lock lock{g_DataMemoryOptions_mutex};
+	g_DataMemoryOptions = options;
+}
+
+SDataMemoryOptions getDataMemoryOptions()
+{
+	std::unique_lock lock{g_DataMemoryOptions_mutex};
+	return g_DataMemoryOptions;
+}
+
+static size_t getPageSize()
+{
+#ifdef __linux__
+	return sysconf(_SC_PAGESIZE);
+#else
+	return 4096;
+#endif
+}
+
+// Zero the buffer from multiple threads, each taking one contiguous block of
+// whole pages. Block i of n starts at (i*bytes/n), rounded to a page, which
+// is the same static block partitioning used for splitting work over threads.
+static void parallelFirstTouch(char *ptr, size_t bytes, size_t pageSize, int threads)
+{
+	size_t pages = (bytes + pageSize - 1) / pageSize;
+	if ((size_t)threads > pages)
+		threads = (int)pages;
+
+	auto touch = [=](int i) {
+		size_t from = (pages * i / threads) * pageSize;
+		size_t to = std::min((pages * (i + 1) / threads) * pageSize, bytes);
+		memset(ptr + from, 0, to - from);
+	};
+
+	parallelFor(0, threads, 1, [&](int iFrom, int iTo) {
+		for (int i = iFrom; i < iTo; ++i)
+			touch(i);
+	});
+}
+
+void *allocateDataMemory(size_t bytes, bool &hugePages)
+{
+	SDataMemoryOptions options = getDataMemoryOptions();
+
+	hugePages = false;
+	size_t alignment = DATA_MEMORY_ALIGNMENT;
+	size_t pageSize = getPageSize();
+#ifdef __linux__
+	if (options.bHugePages && bytes >= options.iHugePageThreshold) {
+		hugePages = true;
+		alignment = HUGE_PAGE_SIZE;
+		pageSize = HUGE_PAGE_SIZE;
+	}
+#endif
+
+	void *ptr = nullptr;
+#ifdef _MSC_VER
+	ptr = _aligned_malloc(bytes, alignment);
+#else
+	int ret = posix_memalign(&ptr, alignment, bytes);
+	if (ret != 0)
+		ptr = nullptr;
+#endif
+	if (!ptr) {
+		ASTRA_ERROR("Failed to allocate %zu bytes of memory", bytes);
+		hugePages = false;
+		return nullptr;
+	}
+	ASTRA_ASSERT(((size_t)ptr % DATA_MEMORY_ALIGNMENT) == 0);
+
+#ifdef __linux__
+	if (hugePages && madvise(ptr, bytes - bytes % HUGE_PAGE_SIZE, MADV_HUGEPAGE) != 0) {
+		ASTRA_DEBUG("Huge pages not available for allocation of %zu bytes", bytes);
+		hugePages = false;
+	}
+#endif
+
+	if (options.bParallelFirstTouch && bytes >= options.iFirstTouchThreshold) {
+		int threads = options.iFirstTouchThreads;
+		if (threads <= 0)
+			threads = getNumThreads();
+		if (threads > 1)
+			parallelFirstTouch((char*)ptr, bytes, pageSize, threads);
+	}
+
+	return ptr;
+}
+
+void freeDataMemory(void *ptr)
+{
+#ifdef _MSC_VER
+	_aligned_free(ptr);
+#else
+	free(ptr);
+#endif
+}
+
+template<typename T>
+static T *getTypedMemory(CDataStorage *s)
+{
+	CDataMemory<T> *m = dynamic_cast<CDataMemory<T>*>(s);
+	return m ? m->getData() : nullptr;
+}
+
+template<typename TSrc, typename TDst>
+static void copyConvert(const TSrc *src, TDst *dst, size_t n)
+{
+	if constexpr (std::is_same_v<TSrc, TDst>) {
+		memcpy(dst, src, n * sizeof(TSrc));
+	} else {
+		for (size_t i = 0; i < n; ++i)
+			dst[i] = TDst((float32)src[i]);
+	}
+}
+
+template<typename TSrc>
+static bool copyConvertTo(const TSrc *src, CDataStorage *dst, size_t dstOffset, size_t n)
+{
+	if (float32 *d32 = getTypedMemory<float32>(dst))
+		copyConvert(src, d32 + dstOffset, n);
+	else if (float16 *d16 = getTypedMemory<float16>(dst))
+		copyConvert(src, d16 + dstOffset, n);
+	else if (bfloat16 *db16 = getTypedMemory<bfloat16>(dst))
+		copyConvert(src, db16 + dstOffset, n);
+	else
+		return false;
+	return true;
+}
+
+bool copyConvertMemory(const CDataStorage *src, size_t srcOffset, CDataStorage *dst, size_t dstOffset, size_t n)
+{
+	CDataStorage *s = const_cast<CDataStorage*>(src);
+	if (const float32 *s32 = getTypedMemory<float32>(s))
+		return copyConvertTo(s32 + srcOffset, dst, dstOffset, n);
+	if (const float16 *s16 = getTypedMemory<float16>(s))
+		return copyConvertTo(s16 + srcOffset, dst, dstOffset, n);
+	if (const bfloat16 *sb16 = getTypedMemory<bfloat16>(s))
+		return copyConvertTo(sb16 + srcOffset, dst, dstOffset, n);
+	return false;
+}
+
+bool fillMemory(CDataStorage *dst, size_t dstOffset, size_t n, float32 value)
+{
+	if (float32 *d32 = getTypedMemory<float32>(dst))
+		std::fill_n(d32 + dstOffset, n, value);
+	else if (float16 *d16 = getTypedMemory<float16>(dst))
+		std::fill_n(d16 + dstOffset, n, float16(value));
+	else if (bfloat16 *db16 = getTypedMemory<bfloat16>(dst))
+		std::fill_n(db16 + dstOffset, n, bfloat16(value));
+	else
+		return false;
+	return true;
+}
+
+template<typename T>
+void CDataMemory<T>::_allocateData(size_t size)
+{
+	ASTRA_ASSERT(m_pfData == NULL);
+	ASTRA_ASSERT(m_bOwnData);
+
+	// allocate contiguous block
+	m_pfData = (T*)allocateDataMemory(size * sizeof(T), m_bHugePages);
+	ASTRA_ASSERT(m_pfData);
+}
+
+template<typename T>
+void CDataMemory<T>::_freeData()
+{
+	if (!m_bOwnData)
+		return;
+
+	// free memory for data block
+	freeDataMemory(m_pfData);
+
+	m_pfData = nullptr;
+}
+
+template class CDataMemory<float32>;
+template class CDataMemory<float16>;
+template class CDataMemory<bfloat16>;
+
+}
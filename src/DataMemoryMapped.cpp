@@ -0,0 +1,355 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+#include "astra/DataMemoryMapped.h"
+
+#include "astra/Logging.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace astra {
+
+static size_t getPageSize()
+{
+#ifdef _WIN32
+	// MapViewOfFile offsets have to be a multiple of the allocation granularity
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return info.dwAllocationGranularity;
+#else
+	return sysconf(_SC_PAGESIZE);
+#endif
+}
+
+template<typename T>
+CDataMemoryMapped<T>::CDataMemoryMapped(const std::string &filename, size_t size, EMemoryMapMode mode, size_t offset)
+	: m_sFilename(filename), m_eMode(mode), m_pMapping(nullptr), m_iMappingSize(0)
+#ifdef _WIN32
+	, m_hFile(INVALID_HANDLE_VALUE), m_hMapping(NULL)
+#else
+	, m_iFd(-1)
+#endif
+{
+	if (!_map(size, offset))
+		_unmap();
+}
+
+template<typename T>
+CDataMemoryMapped<T>::~CDataMemoryMapped()
+{
+	_unmap();
+}
+
+#ifndef _WIN32
+
+template<typename T>
+bool CDataMemoryMapped<T>::_map(size_t size, size_t offset)
+{
+	int flags = (m_eMode == MEMMAP_READWRITE || m_eMode == MEMMAP_CREATE) ? O_RDWR : O_RDONLY;
+	if (m_eMode == MEMMAP_CREATE)
+		flags |= O_CREAT | O_TRUNC;
+
+	m_iFd = open(m_sFilename.c_str(), flags, 0666);
+	if (m_iFd < 0) {
+		ASTRA_ERROR("Could not open %s: %s", m_sFilename.c_str(), strerror(errno));
+		return false;
+	}
+
+	size_t dataSize = size * sizeof(T);
+
+	struct stat st;
+	if (fstat(m_iFd, &st) != 0) {
+		ASTRA_ERROR("Could not stat %s: %s", m_sFilename.c_str(), strerror(errno));
+		return false;
+	}
+	if ((size_t)st.st_size < offset + dataSize) {
+		if (m_eMode != MEMMAP_CREATE) {
+			ASTRA_ERROR("File %s is too small: %zu bytes, expected at least %zu", m_sFilename.c_str(), (size_t)st.st_size, offset + dataSize);
+			return false;
+		}
+		// This creates a zero-filled sparse file where supported
+		if (ftruncate(m_iFd, offset + dataSize) != 0) {
+			ASTRA_ERROR("Could not resize %s: %s", m_sFilename.c_str(), strerror(errno));
+			return false;
+		}
+	}
+
+	size_t pageSize = getPageSize();
+	size_t mapOffset = offset - (offset % pageSize);
+	m_iMappingSize = dataSize + (offset - mapOffset);
+
+	if (m_iMappingSize == 0) {
+		ASTRA_ERROR("Can not map empty data");
+		return false;
+	}
+
+	int prot = PROT_READ;
+	int mapFlags = MAP_SHARED;
+	if (m_eMode != MEMMAP_READONLY)
+		prot |= PROT_WRITE;
+	if (m_eMode == MEMMAP_COPYONWRITE)
+		mapFlags = MAP_PRIVATE;
+
+	void *p = mmap(nullptr, m_iMappingSize, prot, mapFlags, m_iFd, mapOffset);
+	if (p == MAP_FAILED) {
+		ASTRA_ERROR("Could not map %s: %s", m_sFilename.c_str(), strerror(errno));
+		m_iMappingSize = 0;
+		return false;
+	}
+
+	m_pMapping = (char*)p;
+	this->m_pfData = (T*)(m_pMapping + (offset - mapOffset));
+
+	// Projection data is mostly processed in blocks of consecutive angles,
+	// so ask for aggressive read-ahead.
+	madvise(m_pMapping, m_iMappingSize, MADV_SEQUENTIAL);
+
+	return true;
+}
+
+template<typename T>
+void CDataMemoryMapped<T>::_unmap()
+{
+	if (m_pMapping)
+		munmap(m_pMapping, m_iMappingSize);
+	if (m_iFd >= 0)
+		close(m_iFd);
+
+	m_pMapping = nullptr;
+	m_iMappingSize = 0;
+	m_iFd = -1;
+	this->m_pfData = nullptr;
+}
+
+template<typename T>
+void CDataMemoryMapped<T>::prefetch(size_t first, size_t count)
+{
+	char *start;
+	size_t length;
+	if (_rangeToPages(first, count, start, length))
+		madvise(start, length, MADV_WILLNEED);
+}
+
+template<typename T>
+void CDataMemoryMapped<T>::release(size_t first, size_t count)
+{
+	char *start;
+	size_t length;
+	// Pages of a copy-on-write mapping are dropped together with their
+	// private changes, so never touch pages that extend beyond the range.
+	if (!_rangeToPages(first, count, start, length, m_eMode == MEMMAP_COPYONWRITE))
+		return;
+
+	// Write back changes first, since MADV_DONTNEED drops them for
+	// shared mappings on some systems.
+	if (m_eMode == MEMMAP_READWRITE || m_eMode == MEMMAP_CREATE)
+		msync(start, length, MS_SYNC);
+	madvise(start, length, MADV_DONTNEED);
+}
+
+template<typename T>
+bool CDataMemoryMapped<T>::flush()
+{
+	if (!m_pMapping)
+		return false;
+	if (m_eMode != MEMMAP_READWRITE && m_eMode != MEMMAP_CREATE)
+		return true;
+	return msync(m_pMapping, m_iMappingSize, MS_SYNC) == 0;
+}
+
+#else
+
+template<typename T>
+bool CDataMemoryMapped<T>::_map(size_t size, size_t offset)
+{
+	DWORD access = GENERIC_READ;
+	if (m_eMode == MEMMAP_READWRITE || m_eMode == MEMMAP_CREATE)
+		access |= GENERIC_WRITE;
+	DWORD creation = (m_eMode == MEMMAP_CREATE) ? CREATE_ALWAYS : OPEN_EXISTING;
+
+	m_hFile = CreateFileA(m_sFilename.c_str(), access, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, creation, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (m_hFile == INVALID_HANDLE_VALUE) {
+		ASTRA_ERROR("Could not open %s", m_sFilename.c_str());
+		return false;
+	}
+
+	size_t dataSize = size * sizeof(T);
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(m_hFile, &fileSize)) {
+		ASTRA_ERROR("Could not get size of %s", m_sFilename.c_str());
+		return false;
+	}
+	if ((size_t)fileSize.QuadPart < offset + dataSize && m_eMode != MEMMAP_CREATE) {
+		ASTRA_ERROR("File %s is too small: %zu bytes, expected at least %zu", m_sFilename.c_str(), (size_t)fileSize.QuadPart, offset + dataSize);
+		return false;
+	}
+
+	size_t pageSize = getPageSize();
+	size_t mapOffset = offset - (offset % pageSize);
+	m_iMappingSize = dataSize + (offset - mapOffset);
+
+	if (m_iMappingSize == 0) {
+		ASTRA_ERROR("Can not map empty data");
+		return false;
+	}
+
+	DWORD protect = PAGE_READONLY;
+	DWORD viewAccess = FILE_MAP_READ;
+	if (m_eMode == MEMMAP_READWRITE || m_eMode == MEMMAP_CREATE) {
+		protect = PAGE_READWRITE;
+		viewAccess = FILE_MAP_WRITE;
+	} else if (m_eMode == MEMMAP_COPYONWRITE) {
+		protect = PAGE_WRITECOPY;
+		viewAccess = FILE_MAP_COPY;
+	}
+
+	// With MEMMAP_CREATE, this also extends the file to the required size
+	unsigned long long mapEnd = offset + dataSize;
+	m_hMapping = CreateFileMappingA(m_hFile, NULL, protect, (DWORD)(mapEnd >> 32), (DWORD)(mapEnd & 0xFFFFFFFFULL), NULL);
+	if (m_hMapping == NULL) {
+		ASTRA_ERROR("Could not create file mapping for %s", m_sFilename.c_str());
+		return false;
+	}
+
+	unsigned long long off = mapOffset;
+	void *p = MapViewOfFile(m_hMapping, viewAccess, (DWORD)(off >> 32), (DWORD)(off & 0xFFFFFFFFULL), m_iMappingSize);
+	if (!p) {
+		ASTRA_ERROR("Could not map %s", m_sFilename.c_str());
+		m_iMappingSize = 0;
+		return false;
+	}
+
+	m_pMapping = (char*)p;
+	this->m_pfData = (T*)(m_pMapping + (offset - mapOffset));
+
+	return true;
+}
+
+template<typename T>
+void CDataMemoryMapped<T>::_unmap()
+{
+	if (m_pMapping)
+		UnmapViewOfFile(m_pMapping);
+	if (m_hMapping != NULL)
+		CloseHandle(m_hMapping);
+	if (m_hFile != INVALID_HANDLE_VALUE)
+		CloseHandle(m_hFile);
+
+	m_pMapping = nullptr;
+	m_iMappingSize = 0;
+	m_hMapping = NULL;
+	m_hFile = INVALID_HANDLE_VALUE;
+	this->m_pfData = nullptr;
+}
+
+template<typename T>
+void CDataMemoryMapped<T>::prefetch(size_t first, size_t count)
+{
+	char *start;
+	size_t length;
+	if (!_rangeToPages(first, count, start, length))
+		return;
+
+	WIN32_MEMORY_RANGE_ENTRY range;
+	range.VirtualAddress = start;
+	range.NumberOfBytes = length;
+	PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+}
+
+template<typename T>
+void CDataMemoryMapped<T>::release(size_t first, size_t count)
+{
+	char *start;
+	size_t length;
+	if (!_rangeToPages(first, count, start, length))
+		return;
+
+	if (m_eMode == MEMMAP_READWRITE || m_eMode == MEMMAP_CREATE)
+		FlushViewOfFile(start, length);
+	// Removes the pages from the working set, but unlike MADV_DONTNEED
+	// this keeps changes in copy-on-write mappings.
+	VirtualUnlock(start, length);
+}
+
+template<typename T>
+bool CDataMemoryMapped<T>::flush()
+{
+	if (!m_pMapping)
+		return false;
+	if (m_eMode != MEMMAP_READWRITE && m_eMode != MEMMAP_CREATE)
+		return true;
+	return FlushViewOfFile(m_pMapping, m_iMappingSize) && FlushFileBuffers(m_hFile);
+}
+
+#endif
+
+template<typename T>
+bool CDataMemoryMapped<T>::_rangeToPages(size_t first, size_t count, char *&start, size_t &length, bool inside) const
+{
+	if (!m_pMapping || count == 0)
+		return false;
+
+	char *end = (char*)(this->m_pfData + first + count);
+	if (end > m_pMapping + m_iMappingSize)
+		end = m_pMapping + m_iMappingSize;
+
+	size_t pageSize = getPageSize();
+	size_t startOffset = (char*)(this->m_pfData + first) - m_pMapping;
+	size_t endOffset = end - m_pMapping;
+	if (!inside) {
+		startOffset -= startOffset % pageSize;
+	} else {
+		// only pages that lie entirely within the range. The last page of
+		// the mapping counts as whole, since it ends with the data.
+		if (startOffset % pageSize != 0)
+			startOffset += pageSize - startOffset % pageSize;
+		if (endOffset != m_iMappingSize)
+			endOffset -= endOffset % pageSize;
+	}
+	if (startOffset >= endOffset)
+		return false;
+	start = m_pMapping + startOffset;
+	length = endOffset - startOffset;
+	return true;
+}
+
+template class CDataMemoryMapped<float32>;
+
+}
@@ -0,0 +1,182 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+#include "astra/DataMemoryPool.h"
+
+#include "astra/Logging.h"
+
+namespace astra {
+
+// The pool is deliberately never destroyed: pooled data objects may be
+// deleted during static destruction (for example by the object managers),
+// after a function-local static pool would already be gone.
+template<> CDataMemoryPool& Singleton<CDataMemoryPool>::getSingleton() {
+	static CDataMemoryPool *instance = new CDataMemoryPool();
+	return *instance;
+}
+
+CDataMemoryPool::CDataMemoryPool()
+	: m_iLimit((size_t)256 << 20)
+{
+
+}
+
+CDataMemoryPool::~CDataMemoryPool()
+{
+	clear();
+}
+
+size_t CDataMemoryPool::getBucketSize(size_t bytes)
+{
+	// keep the three bits below the highest set bit, and round up the rest
+	if (bytes <= DATA_MEMORY_ALIGNMENT)
+		return DATA_MEMORY_ALIGNMENT;
+
+	int shift = 0;
+	while ((bytes >> shift) >= 16)
+		shift++;
+	size_t step = (size_t)1 << shift;
+	return (bytes + step - 1) & ~(step - 1);
+}
+
+void *CDataMemoryPool::acquire(size_t bytes, size_t &capacity)
+{
+	capacity = getBucketSize(bytes);
+
+	{
+		std::unique_lock lock{m_mutex};
+		auto it = m_buckets.find(capacity);
+		if (it != m_buckets.end() && !it->second.empty()) {
+			void *ptr = it->second.back();
+			it->second.pop_back();
+			m_stats.iHits++;
+			m_stats.iBytesHeld -= capacity;
+			m_stats.iBytesInUse += capacity;
+			return ptr;
+		}
+		m_stats.iMisses++;
+	}
+
+	bool hugePages;
+	void *ptr = allocateDataMemory(capacity, hugePages);
+	if (ptr) {
+		std::unique_lock lock{m_mutex};
+		m_stats.iBytesInUse += capacity;
+	}
+	return ptr;
+}
+
+void CDataMemoryPool::release(void *ptr, size_t capacity)
+{
+	if (!ptr)
+		return;
+
+	std::unique_lock lock{m_mutex};
+	m_stats.iBytesInUse -= capacity;
+
+	if (capacity > m_iLimit) {
+		m_stats.iEvictions++;
+		freeDataMemory(ptr);
+		return;
+	}
+
+	_evict(m_iLimit - capacity);
+	m_buckets[capacity].push_back(ptr);
+	m_stats.iBytesHeld += capacity;
+}
+
+// Free idle buffers, largest first, until at most 'bytes' are held.
+// Must be called with m_mutex held.
+void CDataMemoryPool::_evict(size_t bytes)
+{
+	auto it = m_buckets.end();
+	while (m_stats.iBytesHeld > bytes && it != m_buckets.begin()) {
+		--it;
+		std::vector<void*> &bucket = it->second;
+		while (m_stats.iBytesHeld > bytes && !bucket.empty()) {
+			freeDataMemory(bucket.back());
+			bucket.pop_back();
+			m_stats.iBytesHeld -= it->first;
+			m_stats.iEvictions++;
+		}
+	}
+}
+
+void CDataMemoryPool::setLimit(size_t bytes)
+{
+	std::unique_lock lock{m_mutex};
+	m_iLimit = bytes;
+	_evict(m_iLimit);
+}
+
+size_t CDataMemoryPool::getLimit() const
+{
+	std::unique_lock lock{m_mutex};
+	return m_iLimit;
+}
+
+void CDataMemoryPool::clear()
+{
+	std::unique_lock lock{m_mutex};
+	for (auto &b : m_buckets)
+		for (void *ptr : b.second)
+			freeDataMemory(ptr);
+	m_buckets.clear();
+	m_stats.iBytesHeld = 0;
+}
+
+SDataMemoryPoolStats CDataMemoryPool::getStats() const
+{
+	std::unique_lock lock{m_mutex};
+	return m_stats;
+}
+
+void CDataMemoryPool::resetStats()
+{
+	std::unique_lock lock{m_mutex};
+	m_stats.iHits = 0;
+	m_stats.iMisses = 0;
+	m_stats.iEvictions = 0;
+}
+
+template<typename T>
+CDataMemoryPooled<T>::CDataMemoryPooled(size_t size)
+{
+	this->m_pfData = (T*)CDataMemoryPool::getSingleton().acquire(size * sizeof(T), m_iCapacity);
+	ASTRA_ASSERT(this->m_pfData);
+}
+
+template<typename T>
+CDataMemoryPooled<T>::~CDataMemoryPooled()
+{
+	CDataMemoryPool::getSingleton().release(this->m_pfData, m_iCapacity);
+	this->m_pfData = nullptr;
+}
+
+template class CDataMemoryPooled<float32>;
+
+}
@@ -0,0 +1,222 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+#include "astra/DataOperationAlgorithm.h"
+
+#include "astra/DataOperations.h"
+#include "astra/AstraObjectManager.h"
+
+#include "astra/Logging.h"
+#include "astra/Profiler.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace astra {
+
+namespace {
+
+struct SOperationInfo {
+	const char *sName;
+	unsigned int iData;
+	unsigned int iScalars;
+};
+
+// Number of data objects and scalars required by each operation
+const SOperationInfo g_operations[] = {
+	{ "$1*s1", 1, 1 },
+	{ "$1.*s1", 1, 1 },
+	{ "$1/s1", 1, 1 },
+	{ "$1./s1", 1, 1 },
+	{ "$1+s1", 1, 1 },
+	{ "$1-s1", 1, 1 },
+	{ "$1.*$2", 2, 0 },
+	{ "$1+$2", 2, 0 },
+	{ "$1-$2", 2, 0 },
+	{ "$1./$2", 2, 0 },
+	{ "axpby", 2, 2 },
+	{ "clamp", 1, 2 },
+	{ "dot", 2, 0 },
+	{ "norm", 1, 0 },
+};
+
+}
+
+//----------------------------------------------------------------------------------------
+// Constructor
+CDataOperationAlgorithm::CDataOperationAlgorithm()
+{
+	m_pMask2D = NULL;
+	m_pMask3D = NULL;
+	m_fResult = 0.0;
+	m_bIsInitialized = false;
+}
+
+//----------------------------------------------------------------------------------------
+// Destructor
+CDataOperationAlgorithm::~CDataOperationAlgorithm()
+{
+
+}
+
+//---------------------------------------------------------------------------------------
+// Initialize - Config
+bool CDataOperationAlgorithm::initialize(const Config& _cfg)
+{
+	ConfigReader<CAlgorithm> CR("CDataOperationAlgorithm", this, _cfg);
+
+	// operation
+	if (!CR.getRequiredString("Operation", m_sOperation))
+		return false;
+	m_sOperation.erase(std::remove(m_sOperation.begin(), m_sOperation.end(), ' '), m_sOperation.end());
+
+	// data: either all 2D or all 3D objects
+	vector<int> data;
+	if (!CR.getRequiredIntArray("DataId", data))
+		return false;
+	for (int id : data) {
+		CData2D *pData2D = CData2DManager::getSingleton().get(id);
+		CData3D *pData3D = CData3DManager::getSingleton().get(id);
+		if (pData2D)
+			m_pData2D.push_back(pData2D);
+		else if (pData3D)
+			m_pData3D.push_back(pData3D);
+		else
+			ASTRA_CONFIG_CHECK(false, "DataOperation", "Invalid DataId %d.", id);
+	}
+
+	bool ok = true;
+
+	if (CR.has("Scalar"))
+		ok &= CR.getRequiredNumericalArray("Scalar", m_fScalar);
+
+	// MaskId is accepted both as a regular value (as set by astra.data_op)
+	// and as an option
+	int id = -1;
+	if (CR.has("MaskId") ? CR.getID("MaskId", id) : CR.getOptionID("MaskId", id)) {
+		m_pMask2D = CData2DManager::getSingleton().get(id);
+		m_pMask3D = CData3DManager::getSingleton().get(id);
+		ASTRA_CONFIG_CHECK(m_pMask2D || m_pMask3D, "DataOperation", "Invalid MaskId.");
+	}
+
+	if (!ok)
+		return false;
+
+	m_bIsInitialized = _check();
+	return m_bIsInitialized;
+}
+
+//----------------------------------------------------------------------------------------
+// Check
+template<size_t D>
+bool CDataOperationAlgorithm::checkData(const vector<CData<D>*> &_data, const CData<D> *_pMask)
+{
+	for (const CData<D> *pData : _data) {
+		ASTRA_CONFIG_CHECK(pData->isInitialized(), "DataOperation", "Data object not initialized.");
+		ASTRA_CONFIG_CHECK(pData->isFloat32Memory(), "DataOperation", "Data object not a float32 host memory object.");
+		ASTRA_CONFIG_CHECK(pData->getShape() == _data[0]->getShape(), "DataOperation", "Data objects do not have the same shape.");
+	}
+	if (_pMask) {
+		ASTRA_CONFIG_CHECK(_pMask->isFloat32Memory(), "DataOperation", "Mask not a float32 host memory object.");
+		ASTRA_CONFIG_CHECK(_pMask->getShape() == _data[0]->getShape(), "DataOperation", "Mask does not have the same shape as the data.");
+	}
+	return true;
+}
+
+bool CDataOperationAlgorithm::_check()
+{
+	const SOperationInfo *pInfo = NULL;
+	for (const SOperationInfo &info : g_operations)
+		if (m_sOperation == info.sName)
+			pInfo = &info;
+	ASTRA_CONFIG_CHECK(pInfo, "DataOperation", "Unknown operation '%s'.", m_sOperation.c_str());
+
+	ASTRA_CONFIG_CHECK(m_pData2D.empty() || m_pData3D.empty(), "DataOperation", "Cannot mix 2D and 3D data objects.");
+	size_t iData = m_pData2D.size() + m_pData3D.size();
+	ASTRA_CONFIG_CHECK(iData >= pInfo->iData, "DataOperation", "Operation '%s' requires %u data objects.", pInfo->sName, pInfo->iData);
+	ASTRA_CONFIG_CHECK(m_fScalar.size() >= pInfo->iScalars, "DataOperation", "Operation '%s' requires %u scalars.", pInfo->sName, pInfo->iScalars);
+
+	if (!m_pData2D.empty()) {
+		ASTRA_CONFIG_CHECK(!m_pMask3D || m_pMask2D, "DataOperation", "Mask must be a 2D data object.");
+		return checkData<2>(vector<CData<2>*>(m_pData2D.begin(), m_pData2D.end()), m_pMask2D);
+	} else {
+		ASTRA_CONFIG_CHECK(!m_pMask2D || m_pMask3D, "DataOperation", "Mask must be a 3D data object.");
+		return checkData<3>(vector<CData<3>*>(m_pData3D.begin(), m_pData3D.end()), m_pMask3D);
+	}
+}
+
+//----------------------------------------------------------------------------------------
+// Iterate
+template<size_t D>
+bool CDataOperationAlgorithm::runOperation(const vector<CData<D>*> &_data, const CData<D> *_pMask)
+{
+	const string &op = m_sOperation;
+	CData<D> &y = *_data[0];
+
+	if (op == "$1*s1" || op == "$1.*s1")
+		return scale<D>(m_fScalar[0], y, _pMask);
+	if (op == "$1/s1" || op == "$1./s1")
+		return scale<D>(1.0f / m_fScalar[0], y, _pMask);
+	if (op == "$1+s1")
+		return addScalar<D>(m_fScalar[0], y, _pMask);
+	if (op == "$1-s1")
+		return addScalar<D>(-m_fScalar[0], y, _pMask);
+	if (op == "$1.*$2")
+		return multiply<D>(*_data[1], y, _pMask);
+	if (op == "$1+$2")
+		return axpby<D>(1.0f, *_data[1], 1.0f, y, _pMask);
+	if (op == "$1-$2")
+		return axpby<D>(-1.0f, *_data[1], 1.0f, y, _pMask);
+	if (op == "$1./$2")
+		return divideSafe<D>(*_data[1], y, m_fScalar.empty() ? 0.0f : m_fScalar[0], _pMask);
+	if (op == "axpby")
+		return axpby<D>(m_fScalar[0], *_data[1], m_fScalar[1], y, _pMask);
+	if (op == "clamp")
+		return clamp<D>(y, m_fScalar[0], m_fScalar[1], _pMask);
+	if (op == "dot")
+		return dot<D>(y, *_data[1], m_fResult, _pMask);
+	if (op == "norm")
+		return norm<D>(y, m_fResult, _pMask);
+
+	return false;
+}
+
+bool CDataOperationAlgorithm::run(int _iNrIterations)
+{
+	ASTRA_PROFILE_SCOPE(profile, "algorithm/DataOperation");
+
+	// check initialized
+	ASTRA_ASSERT(m_bIsInitialized);
+
+	if (!m_pData2D.empty())
+		return runOperation<2>(vector<CData<2>*>(m_pData2D.begin(), m_pData2D.end()), m_pMask2D);
+	else
+		return runOperation<3>(vector<CData<3>*>(m_pData3D.begin(), m_pData3D.end()), m_pMask3D);
+}
+
+} // namespace astra
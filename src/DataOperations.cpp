@@ -0,0 +1,233 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+#include "astra/DataOperations.h"
+
+#include "astra/ThreadPool.h"
+#include "astra/Logging.h"
+#include "astra/Profiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace astra {
+
+// Fixed block size for partial sums of reductions
+static const size_t REDUCTION_BLOCK = 1 << 14;
+
+template<size_t D>
+static bool checkData(const char *_sOp, const CData<D> &_data, size_t _iSize)
+{
+	if (!_data.isFloat32Memory()) {
+		ASTRA_ERROR("%s: data is not float32 host memory", _sOp);
+		return false;
+	}
+	if (_data.getSize() != _iSize) {
+		ASTRA_ERROR("%s: data sizes do not match", _sOp);
+		return false;
+	}
+	return true;
+}
+
+template<size_t D>
+static bool checkMask(const char *_sOp, const CData<D> *_pMask, size_t _iSize)
+{
+	return !_pMask || checkData(_sOp, *_pMask, _iSize);
+}
+
+// Apply _op(i) to all elements i, or to those with a non-zero mask.
+// _iAccesses is the number of float32 reads and writes per element done by
+// _op, for profiling.
+template<typename F>
+static void forEachElement(size_t _iSize, const float32 *_pfMask, int _iAccesses, F _op)
+{
+	ASTRA_PROFILE_SCOPE(profile, "data/operation");
+	profile.addBytes(_iSize * sizeof(float32) * (_iAccesses + (_pfMask ? 1 : 0)));
+
+	parallelForBlocks(_iSize, ELEMENTWISE_GRAIN, [&](size_t iFrom, size_t iTo) {
+		if (_pfMask) {
+			for (size_t i = iFrom; i < iTo; ++i)
+				if (_pfMask[i] != 0.0f)
+					_op(i);
+		} else {
+			for (size_t i = iFrom; i < iTo; ++i)
+				_op(i);
+		}
+	});
+}
+
+// Sum _term(i) over all elements i, or over those with a non-zero mask
+template<typename F>
+static double sumElements(size_t _iSize, const float32 *_pfMask, int _iAccesses, F _term)
+{
+	ASTRA_PROFILE_SCOPE(profile, "data/operation");
+	profile.addBytes(_iSize * sizeof(float32) * (_iAccesses + (_pfMask ? 1 : 0)));
+
+	size_t iBlocks = (_iSize + REDUCTION_BLOCK - 1) / REDUCTION_BLOCK;
+	std::vector<double> partial(iBlocks, 0.0);
+	parallelForBlocks(iBlocks, std::max<size_t>(ELEMENTWISE_GRAIN / REDUCTION_BLOCK, 1), [&](size_t iBlockFrom, size_t iBlockTo) {
+		for (size_t b = iBlockFrom; b < iBlockTo; ++b) {
+			size_t iFrom = b * REDUCTION_BLOCK;
+			size_t iTo = std::min(iFrom + REDUCTION_BLOCK, _iSize);
+			double sum = 0.0;
+			if (_pfMask) {
+				for (size_t i = iFrom; i < iTo; ++i)
+					if (_pfMask[i] != 0.0f)
+						sum += _term(i);
+			} else {
+				for (size_t i = iFrom; i < iTo; ++i)
+					sum += _term(i);
+			}
+			partial[b] = sum;
+		}
+	});
+
+	double total = 0.0;
+	for (double p : partial)
+		total += p;
+	return total;
+}
+
+template<size_t D>
+static const float32 *maskMemory(const CData<D> *_pMask)
+{
+	return _pMask ? _pMask->getFloat32Memory() : nullptr;
+}
+
+//----------------------------------------------------------------------------------------
+
+template<size_t D>
+bool axpby(float32 _fA, const CData<D> &_x, float32 _fB, CData<D> &_y, const CData<D> *_pMask)
+{
+	size_t n = _y.getSize();
+	if (!checkData("axpby", _x, n) || !checkData("axpby", _y, n) || !checkMask("axpby", _pMask, n))
+		return false;
+	const float32 *x = _x.getFloat32Memory();
+	float32 *y = _y.getFloat32Memory();
+	forEachElement(n, maskMemory(_pMask), 3, [=](size_t i) { y[i] = _fA * x[i] + _fB * y[i]; });
+	return true;
+}
+
+template<size_t D>
+bool multiply(const CData<D> &_x, CData<D> &_y, const CData<D> *_pMask)
+{
+	size_t n = _y.getSize();
+	if (!checkData("multiply", _x, n) || !checkData("multiply", _y, n) || !checkMask("multiply", _pMask, n))
+		return false;
+	const float32 *x = _x.getFloat32Memory();
+	float32 *y = _y.getFloat32Memory();
+	forEachElement(n, maskMemory(_pMask), 3, [=](size_t i) { y[i] *= x[i]; });
+	return true;
+}
+
+template<size_t D>
+bool scale(float32 _fScalar, CData<D> &_y, const CData<D> *_pMask)
+{
+	size_t n = _y.getSize();
+	if (!checkData("scale", _y, n) || !checkMask("scale", _pMask, n))
+		return false;
+	float32 *y = _y.getFloat32Memory();
+	forEachElement(n, maskMemory(_pMask), 2, [=](size_t i) { y[i] *= _fScalar; });
+	return true;
+}
+
+template<size_t D>
+bool addScalar(float32 _fScalar, CData<D> &_y, const CData<D> *_pMask)
+{
+	size_t n = _y.getSize();
+	if (!checkData("addScalar", _y, n) || !checkMask("addScalar", _pMask, n))
+		return false;
+	float32 *y = _y.getFloat32Memory();
+	forEachElement(n, maskMemory(_pMask), 2, [=](size_t i) { y[i] += _fScalar; });
+	return true;
+}
+
+template<size_t D>
+bool divideSafe(const CData<D> &_x, CData<D> &_y, float32 _fEpsilon, const CData<D> *_pMask)
+{
+	size_t n = _y.getSize();
+	if (!checkData("divideSafe", _x, n) || !checkData("divideSafe", _y, n) || !checkMask("divideSafe", _pMask, n))
+		return false;
+	const float32 *x = _x.getFloat32Memory();
+	float32 *y = _y.getFloat32Memory();
+	forEachElement(n, maskMemory(_pMask), 3, [=](size_t i) {
+		y[i] = (std::fabs(x[i]) > _fEpsilon) ? y[i] / x[i] : 0.0f;
+	});
+	return true;
+}
+
+template<size_t D>
+bool clamp(CData<D> &_y, float32 _fMin, float32 _fMax, const CData<D> *_pMask)
+{
+	size_t n = _y.getSize();
+	if (!checkData("clamp", _y, n) || !checkMask("clamp", _pMask, n))
+		return false;
+	float32 *y = _y.getFloat32Memory();
+	forEachElement(n, maskMemory(_pMask), 2, [=](size_t i) { y[i] = std::min(std::max(y[i], _fMin), _fMax); });
+	return true;
+}
+
+template<size_t D>
+bool dot(const CData<D> &_x, const CData<D> &_y, double &_fResult, const CData<D> *_pMask)
+{
+	size_t n = _x.getSize();
+	if (!checkData("dot", _x, n) || !checkData("dot", _y, n) || !checkMask("dot", _pMask, n))
+		return false;
+	const float32 *x = _x.getFloat32Memory();
+	const float32 *y = _y.getFloat32Memory();
+	_fResult = sumElements(n, maskMemory(_pMask), 2, [=](size_t i) { return (double)x[i] * y[i]; });
+	return true;
+}
+
+template<size_t D>
+bool norm(const CData<D> &_x, double &_fResult, const CData<D> *_pMask)
+{
+	size_t n = _x.getSize();
+	if (!checkData("norm", _x, n) || !checkMask("norm", _pMask, n))
+		return false;
+	const float32 *x = _x.getFloat32Memory();
+	_fResult = std::sqrt(sumElements(n, maskMemory(_pMask), 1, [=](size_t i) { return (double)x[i] * x[i]; }));
+	return true;
+}
+
+//----------------------------------------------------------------------------------------
+
+#define INSTANTIATE_DATA_OPERATIONS(D) \
+template _AstraExport bool axpby<D>(float32, const CData<D> &, float32, CData<D> &, const CData<D> *); \
+template _AstraExport bool multiply<D>(const CData<D> &, CData<D> &, const CData<D> *); \
+template _AstraExport bool scale<D>(float32, CData<D> &, const CData<D> *); \
+template _AstraExport bool addScalar<D>(float32, CData<D> &, const CData<D> *); \
+template _AstraExport bool divideSafe<D>(const CData<D> &, CData<D> &, float32, const CData<D> *); \
+template _AstraExport bool clamp<D>(CData<D> &, float32, float32, const CData<D> *); \
+template _AstraExport bool dot<D>(const CData<D> &, const CData<D> &, double &, const CData<D> *); \
+template _AstraExport bool norm<D>(const CData<D> &, double &, const CData<D> *);
+
+INSTANTIATE_DATA_OPERATIONS(2)
+INSTANTIATE_DATA_OPERATIONS(3)
+
+} // end namespace
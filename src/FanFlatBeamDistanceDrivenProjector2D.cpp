@@ -0,0 +1,227 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+
+#include "astra/FanFlatBeamDistanceDrivenProjector2D.h"
+
+#include <cmath>
+#include <algorithm>
+#include <vector>
+
+#include "astra/DataProjectorPolicies.h"
+
+#include "astra/Logging.h"
+
+using namespace std;
+using namespace astra;
+
+#include "astra/FanFlatBeamDistanceDrivenProjector2D.inl"
+
+//----------------------------------------------------------------------------------------
+// default constructor
+CFanFlatBeamDistanceDrivenProjector2D::CFanFlatBeamDistanceDrivenProjector2D()
+{
+	m_iMaxWeightsCount = 0;
+}
+
+//----------------------------------------------------------------------------------------
+// constructor
+CFanFlatBeamDistanceDrivenProjector2D::CFanFlatBeamDistanceDrivenProjector2D(const CFanFlatProjectionGeometry2D &_pProjectionGeometry,
+                                                                             const CVolumeGeometry2D &_pReconstructionGeometry)
+	: CFanFlatBeamDistanceDrivenProjector2D()
+{
+	initialize(_pProjectionGeometry, _pReconstructionGeometry);
+}
+
+//----------------------------------------------------------------------------------------
+// destructor
+CFanFlatBeamDistanceDrivenProjector2D::~CFanFlatBeamDistanceDrivenProjector2D()
+{
+
+}
+
+//---------------------------------------------------------------------------------------
+// Check
+bool CFanFlatBeamDistanceDrivenProjector2D::_check()
+{
+	// check base class
+	ASTRA_CONFIG_CHECK(CProjector2D::_check(), "FanFlatBeamDistanceDrivenProjector2D", "Error in Projector2D initialization");
+
+	ASTRA_CONFIG_CHECK(dynamic_cast<CFanFlatProjectionGeometry2D*>(m_pProjectionGeometry.get()) || dynamic_cast<CFanFlatVecProjectionGeometry2D*>(m_pProjectionGeometry.get()), "FanFlatBeamDistanceDrivenProjector2D", "Unsupported projection geometry");
+
+	ASTRA_CONFIG_CHECK(abs(m_pVolumeGeometry->getPixelLengthX() / m_pVolumeGeometry->getPixelLengthY()) - 1 < eps, "FanFlatBeamDistanceDrivenProjector2D", "Pixel height must equal pixel width.");
+
+	// success
+	return true;
+}
+
+//---------------------------------------------------------------------------------------
+// Initialize, use a Config object
+bool CFanFlatBeamDistanceDrivenProjector2D::initialize(const Config& _cfg)
+{
+	assert(!m_bIsInitialized);
+
+	// initialization of parent class
+	if (!CProjector2D::initialize(_cfg)) {
+		return false;
+	}
+
+	// success
+	m_bIsInitialized = _check();
+	if (m_bIsInitialized)
+		m_iMaxWeightsCount = computeMaxWeightsCount();
+	return m_bIsInitialized;
+}
+
+//---------------------------------------------------------------------------------------
+// Initialize
+bool CFanFlatBeamDistanceDrivenProjector2D::initialize(const CFanFlatProjectionGeometry2D &_pProjectionGeometry,
+                                                       const CVolumeGeometry2D &_pVolumeGeometry)
+{
+	assert(!m_bIsInitialized);
+
+	// hardcopy geometries
+	m_pProjectionGeometry.reset(_pProjectionGeometry.clone());
+	m_pVolumeGeometry.reset(_pVolumeGeometry.clone());
+
+	// success
+	m_bIsInitialized = _check();
+	if (m_bIsInitialized)
+		m_iMaxWeightsCount = computeMaxWeightsCount();
+	return m_bIsInitialized;
+}
+
+//----------------------------------------------------------------------------------------
+// Get maximum amount of weights on a single ray
+int CFanFlatBeamDistanceDrivenProjector2D::getProjectionWeightsCount(int _iProjectionIndex)
+{
+	return m_iMaxWeightsCount;
+}
+
+//----------------------------------------------------------------------------------------
+// Single Ray Weights
+void CFanFlatBeamDistanceDrivenProjector2D::computeSingleRayWeights(int _iProjectionIndex, 
+																	 int _iDetectorIndex, 
+																	 SPixelWeight* _pWeightedPixels,
+																	 int _iMaxPixelCount, 
+																	 int& _iStoredPixelCount)
+{
+	ASTRA_ASSERT(m_bIsInitialized);
+	StorePixelWeightsPolicy p(_pWeightedPixels, _iMaxPixelCount);
+	projectSingleRay(_iProjectionIndex, _iDetectorIndex, p);
+	_iStoredPixelCount = p.getStoredPixelCount();
+}
+
+//----------------------------------------------------------------------------------------
+// Detector edges on the common axis
+bool CFanFlatBeamDistanceDrivenProjector2D::computeProjectionTables(const SFanProjection& _proj, int _iDetFrom, int _iDetTo,
+                                                                    float32* _pfEdgePos, float32* _pfEdgeDelta,
+                                                                    float32* _pfLengthPerLine) const
+{
+	const float32 pixelLengthX = m_pVolumeGeometry->getPixelLengthX();
+	const float32 pixelLengthY = m_pVolumeGeometry->getPixelLengthY();
+	const float32 inv_pixelLengthX = 1.0f / pixelLengthX;
+	const float32 inv_pixelLengthY = 1.0f / pixelLengthY;
+	const int detCount = m_pProjectionGeometry->getDetectorCount();
+	const float32 Ex = m_pVolumeGeometry->getWindowMinX() + pixelLengthX*0.5f;
+	const float32 Ey = m_pVolumeGeometry->getWindowMaxY() - pixelLengthY*0.5f;
+
+	// all rays of a projection are mapped to the same axis, chosen by the
+	// direction of the central ray of the fan
+	const float32 Cx = _proj.fSrcX - (_proj.fDetSX + 0.5f * detCount * _proj.fDetUX);
+	const float32 Cy = _proj.fSrcY - (_proj.fDetSY + 0.5f * detCount * _proj.fDetUY);
+	const bool vertical = fabs(Cx) < fabs(Cy);
+
+	// line through the source and the start of detector pixel e
+	for (int e = _iDetFrom; e <= _iDetTo; ++e) {
+		const float32 Rx = _proj.fDetSX + e * _proj.fDetUX - _proj.fSrcX;
+		const float32 Ry = _proj.fDetSY + e * _proj.fDetUY - _proj.fSrcY;
+		if (vertical) {
+			const float32 RxOverRy = Rx/Ry;
+			_pfEdgePos[e] = (_proj.fSrcX + (Ey - _proj.fSrcY)*RxOverRy - Ex) * inv_pixelLengthX + 0.5f;
+			_pfEdgeDelta[e] = -pixelLengthY * RxOverRy * inv_pixelLengthX;
+		} else {
+			const float32 RyOverRx = Ry/Rx;
+			_pfEdgePos[e] = -(_proj.fSrcY + (Ex - _proj.fSrcX)*RyOverRx - Ey) * inv_pixelLengthY + 0.5f;
+			_pfEdgeDelta[e] = -pixelLengthX * RyOverRx * inv_pixelLengthY;
+		}
+	}
+
+	// length of the central ray of each detector pixel through a line
+	for (int d = _iDetFrom; d < _iDetTo; ++d) {
+		const float32 Rx = _proj.fSrcX - (_proj.fDetSX + (d+0.5f) * _proj.fDetUX);
+		const float32 Ry = _proj.fSrcY - (_proj.fDetSY + (d+0.5f) * _proj.fDetUY);
+		if (vertical)
+			_pfLengthPerLine[d] = pixelLengthY * sqrt(Rx*Rx + Ry*Ry) / fabs(Ry);
+		else
+			_pfLengthPerLine[d] = pixelLengthX * sqrt(Rx*Rx + Ry*Ry) / fabs(Rx);
+	}
+
+	return vertical;
+}
+
+//----------------------------------------------------------------------------------------
+// Bound on the number of weights of any ray
+int CFanFlatBeamDistanceDrivenProjector2D::computeMaxWeightsCount() const
+{
+	const CFanFlatVecProjectionGeometry2D* pVecProjectionGeometry;
+	if (dynamic_cast<CFanFlatProjectionGeometry2D*>(m_pProjectionGeometry.get())) {
+		pVecProjectionGeometry = dynamic_cast<CFanFlatProjectionGeometry2D*>(m_pProjectionGeometry.get())->toVectorGeometry();
+	} else {
+		pVecProjectionGeometry = dynamic_cast<CFanFlatVecProjectionGeometry2D*>(m_pProjectionGeometry.get());
+	}
+
+	const int colCount = m_pVolumeGeometry->getGridColCount();
+	const int rowCount = m_pVolumeGeometry->getGridRowCount();
+	const int detCount = pVecProjectionGeometry->getDetectorCount();
+
+	std::vector<float32> edgePos(detCount + 1), edgeDelta(detCount + 1), lengthPerLine(detCount);
+
+	// The footprint of a ray on a line is linear in the line index, so it is
+	// widest on the first or the last line of the volume
+	int iMaxCount = 0;
+	for (int iAngle = 0; iAngle < pVecProjectionGeometry->getProjectionAngleCount(); ++iAngle) {
+		const bool vertical = computeProjectionTables(pVecProjectionGeometry->getProjectionVectors()[iAngle], 0, detCount,
+		                                              &edgePos[0], &edgeDelta[0], &lengthPerLine[0]);
+		const int lineCount = vertical ? rowCount : colCount;
+		const int pixelCount = vertical ? colCount : rowCount;
+		int iMaxPixels = 0;
+		for (int d = 0; d < detCount; ++d) {
+			const float32 width0 = edgePos[d+1] - edgePos[d];
+			const float32 width1 = width0 + (lineCount - 1) * (edgeDelta[d+1] - edgeDelta[d]);
+			const float32 width = std::max(fabs(width0), fabs(width1));
+			const int iPixels = (width < pixelCount) ? std::min((int)ceil(width) + 1, pixelCount) : pixelCount;
+			iMaxPixels = std::max(iMaxPixels, iPixels);
+		}
+		iMaxCount = std::max(iMaxCount, lineCount * iMaxPixels);
+	}
+
+	if (dynamic_cast<CFanFlatProjectionGeometry2D*>(m_pProjectionGeometry.get()))
+		delete pVecProjectionGeometry;
+
+	return iMaxCount + 1;
+}
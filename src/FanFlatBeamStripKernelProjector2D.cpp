@@ -90,6 +90,8 @@ bool CFanFlatBeamStripKernelProjector2D::initialize(const Config& _cfg)
 
 	// success
 	m_bIsInitialized = _check();
+	if (m_bIsInitialized)
+		precomputeDetectorTables();
 	return m_bIsInitialized;
 }
 
@@ -106,9 +108,28 @@ bool CFanFlatBeamStripKernelProjector2D::initialize(const CFanFlatProjectionGeom
 
 	// success
 	m_bIsInitialized = _check();
+	if (m_bIsInitialized)
+		precomputeDetectorTables();
 	return m_bIsInitialized;
 }
 
+//----------------------------------------------------------------------------------------
+// Precompute the detector tables
+void CFanFlatBeamStripKernelProjector2D::precomputeDetectorTables()
+{
+	const CFanFlatProjectionGeometry2D* projgeom = dynamic_cast<CFanFlatProjectionGeometry2D*>(m_pProjectionGeometry.get());
+	const int detCount = projgeom->getDetectorCount();
+	const float32 DW = projgeom->getDetectorWidth();
+	const float32 SDD = projgeom->getSourceDetectorDistance();
+
+	m_fSinAlpha.resize(detCount + 1);
+	m_fCosAlpha.resize(detCount + 1);
+	for (int i = 0; i < detCount + 1; ++i) {
+		float32 alpha = -atan((i - detCount*0.5f) * DW / SDD);
+		m_fCosAlpha[i] = cos(alpha);
+		m_fSinAlpha[i] = sin(alpha);
+	}
+}
 
 //----------------------------------------------------------------------------------------
 // Get maximum amount of weights on a single ray
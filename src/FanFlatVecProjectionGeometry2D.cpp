@@ -64,6 +64,7 @@ bool CFanFlatVecProjectionGeometry2D::initialize(int _iProjectionAngleCount,
                                                  std::vector<SFanProjection>&& _pProjectionAngles)
 {
 	assert(!m_bInitialized);
+	m_cache.invalidate();
 
 	m_iProjectionAngleCount = _iProjectionAngleCount;
 	m_iDetectorCount = _iDetectorCount;
@@ -101,7 +102,7 @@ bool CFanFlatVecProjectionGeometry2D::initializeAngles(const Config& _cfg)
 	ConfigReader<CProjectionGeometry2D> CR("FanFlatVecProjectionGeometry2D", this, _cfg);
 
 	// Required: Vectors
-	vector<double> data;
+	ConfigNumericalArray data;
 	if (!CR.getRequiredNumericalArray("Vectors", data))
 		return false;
 	ASTRA_CONFIG_CHECK(data.size() % 6 == 0, "FanFlatVecProjectionGeometry2D", "Vectors doesn't consist of 6-tuples.");
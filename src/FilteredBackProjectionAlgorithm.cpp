@@ -37,6 +37,8 @@ along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
 #include "astra/DataProjector.h"
 
 #include "astra/Logging.h"
+#include "astra/Profiler.h"
+#include "astra/ThreadPool.h"
 
 using namespace std;
 
@@ -73,11 +75,7 @@ bool CFilteredBackProjectionAlgorithm::initialize(const Config& _cfg)
 	ok &= CR.getRequiredID("ProjectorId", id);
 	m_pProjector = CProjector2DManager::getSingleton().get(id);
 
-	ok &= CR.getRequiredID("ProjectionDataId", id);
-	m_pSinogram = dynamic_cast<CFloat32ProjectionData2D*>(CData2DManager::getSingleton().get(id));
-
-	ok &= CR.getRequiredID("ReconstructionDataId", id);
-	m_pReconstruction = dynamic_cast<CFloat32VolumeData2D*>(CData2DManager::getSingleton().get(id));
+	ok &= readDataIds(CR);
 
 	if (CR.has("ProjectionIndex")) {
 		ASTRA_ERROR("ProjectionIndex is no longer available. Manually adjust the sinogram instead.");
@@ -152,10 +150,12 @@ bool CFilteredBackProjectionAlgorithm::_check()
 // Iterate
 bool CFilteredBackProjectionAlgorithm::run(int _iNrIterations)
 {
+	ASTRA_PROFILE_SCOPE(profile, "algorithm/FBP");
+
 	ASTRA_ASSERT(m_bIsInitialized);
 
 	// Filter sinogram
-	CFloat32ProjectionData2D *filteredSinogram = createCFloat32ProjectionData2DMemory(m_pSinogram->getGeometry());
+	CFloat32ProjectionData2D *filteredSinogram = createCFloat32ProjectionData2DPooled(m_pSinogram->getGeometry());
 	filteredSinogram->copyData(*m_pSinogram);
 	performFiltering(filteredSinogram);
 
@@ -190,6 +190,8 @@ void CFilteredBackProjectionAlgorithm::performFiltering(CFloat32ProjectionData2D
 	if (m_filterConfig.m_eType == FILTER_NONE)
 		return;
 
+	ASTRA_PROFILE_SCOPE(profile, "filter/fft");
+
 	int iAngleCount = m_pProjector->getProjectionGeometry().getProjectionAngleCount();
 	int iDetectorCount = m_pProjector->getProjectionGeometry().getDetectorCount();
 
@@ -197,6 +199,9 @@ void CFilteredBackProjectionAlgorithm::performFiltering(CFloat32ProjectionData2D
 	int zpDetector = calcNextPowerOfTwo(2 * m_pSinogram->getDetectorCount());
 	int iHalfFFTSize = astra::calcFFTFourierSize(zpDetector);
 
+	// one zero-padded complex row per angle
+	profile.addBytes((size_t)iAngleCount * 2 * zpDetector * sizeof(float32));
+
 	// cdft setup
 	int *ip = new int[int(2+sqrt((float)zpDetector)+1)];
 	ip[0] = 0;
@@ -264,11 +269,13 @@ void CFilteredBackProjectionAlgorithm::performFiltering(CFloat32ProjectionData2D
 	}
 
 	float32* pf = new float32[2 * iAngleCount * zpDetector];
+	float32* pfData = _pFilteredSinogram->getFloat32Memory();
 
-	// Copy and zero-pad data
-	for (int iAngle = 0; iAngle < iAngleCount; ++iAngle) {
+	// Filter the rows independently: copy and zero-pad, in-place FFT,
+	// filter, in-place inverse FFT, and copy back
+	auto filterRow = [&](int iAngle) {
 		float32* pfRow = pf + iAngle * 2 * zpDetector;
-		float32* pfDataRow = _pFilteredSinogram->getFloat32Memory() + iAngle * iDetectorCount;
+		float32* pfDataRow = pfData + iAngle * iDetectorCount;
 		for (int iDetector = 0; iDetector < iDetectorCount; ++iDetector) {
 			pfRow[2*iDetector] = pfDataRow[iDetector];
 			pfRow[2*iDetector+1] = 0.0f;
@@ -277,18 +284,10 @@ void CFilteredBackProjectionAlgorithm::performFiltering(CFloat32ProjectionData2D
 			pfRow[2*iDetector] = 0.0f;
 			pfRow[2*iDetector+1] = 0.0f;
 		}
-	}
 
-	// in-place FFT
-	for (int iAngle = 0; iAngle < iAngleCount; ++iAngle) {
-		float32* pfRow = pf + iAngle * 2 * zpDetector;
 		cdft(2*zpDetector, -1, pfRow, ip, w);
-	}
 
-	// Filter
-	if (bFilterComplex) {
-		for (int iAngle = 0; iAngle < iAngleCount; ++iAngle) {
-			float32* pfRow = pf + iAngle * 2 * zpDetector;
+		if (bFilterComplex) {
 			float *pfFilterRow = pfFilter;
 			if (bFilterMultiAngle)
 				pfFilterRow += iAngle * 2 * zpDetector;
@@ -299,10 +298,7 @@ void CFilteredBackProjectionAlgorithm::performFiltering(CFloat32ProjectionData2D
 				pfRow[2*i] = re;
 				pfRow[2*i+1] = im;
 			}
-		}
-	} else {
-		for (int iAngle = 0; iAngle < iAngleCount; ++iAngle) {
-			float32* pfRow = pf + iAngle * 2 * zpDetector;
+		} else {
 			float *pfFilterRow = pfFilter;
 			if (bFilterMultiAngle)
 				pfFilterRow += iAngle * iHalfFFTSize;
@@ -315,21 +311,21 @@ void CFilteredBackProjectionAlgorithm::performFiltering(CFloat32ProjectionData2D
 				pfRow[2*iDetector+1] *= pfFilterRow[zpDetector - iDetector];
 			}
 		}
-	}
 
-	// in-place inverse FFT
-	for (int iAngle = 0; iAngle < iAngleCount; ++iAngle) {
-		float32* pfRow = pf + iAngle * 2 * zpDetector;
 		cdft(2*zpDetector, 1, pfRow, ip, w);
-	}
 
-	// Copy data back
-	for (int iAngle = 0; iAngle < iAngleCount; ++iAngle) {
-		float32* pfRow = pf + iAngle * 2 * zpDetector;
-		float32* pfDataRow = _pFilteredSinogram->getFloat32Memory() + iAngle * iDetectorCount;
 		for (int iDetector = 0; iDetector < iDetectorCount; ++iDetector)
 			pfDataRow[iDetector] = pfRow[2*iDetector] / zpDetector;
-	}
+	};
+
+	// The first row initializes the shared FFT tables ip and w, which are
+	// only read afterwards
+	if (iAngleCount > 0)
+		filterRow(0);
+	parallelFor(1, iAngleCount, 8, [&](int iFrom, int iTo) {
+		for (int iAngle = iFrom; iAngle < iTo; ++iAngle)
+			filterRow(iAngle);
+	});
 
 	delete[] pf;
 	delete[] w;
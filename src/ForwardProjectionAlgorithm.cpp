@@ -32,6 +32,7 @@ along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
 #include "astra/DataProjectorPolicies.h"
 
 #include "astra/Logging.h"
+#include "astra/Profiler.h"
 
 using namespace std;
 
@@ -48,7 +49,8 @@ CForwardProjectionAlgorithm::CForwardProjectionAlgorithm()
 	  m_pVolumeMask(nullptr),
 	  m_bUseVolumeMask(false),
 	  m_pSinogramMask(nullptr),
-	  m_bUseSinogramMask(false)
+	  m_bUseSinogramMask(false),
+	  m_bUseVolumeWindow(false)
 {
 
 }
@@ -86,11 +88,12 @@ bool CForwardProjectionAlgorithm::_check()
 	ASTRA_CONFIG_CHECK(m_pSinogram->getGeometry().isEqual(m_pProjector->getProjectionGeometry()), "ForwardProjection", "Projection Data not compatible with the specified Projector.");
 	ASTRA_CONFIG_CHECK(m_pVolume->getGeometry().isEqual(m_pProjector->getVolumeGeometry()), "ForwardProjection", "Volume Data not compatible with the specified Projector.");
 
-	ASTRA_CONFIG_CHECK(m_pSinogram->isFloat32Memory(), "ForwardProjection", "Projection data object not a float32 host memory object");
-	ASTRA_CONFIG_CHECK(m_pVolume->isFloat32Memory(), "ForwardProjection", "Volume data object not a float32 host memory object");
+	ASTRA_CONFIG_CHECK(m_pSinogram->isFloatMemory(), "ForwardProjection", "Projection data object not a float32/float16/bfloat16 host memory object");
+	ASTRA_CONFIG_CHECK(m_pVolume->isFloatMemory(), "ForwardProjection", "Volume data object not a float32/float16/bfloat16 host memory object");
 
 	ASTRA_CONFIG_CHECK(!m_bUseSinogramMask || m_pSinogramMask->isFloat32Memory(), "ForwardProjection", "Projection mask object not a float32 host memory object");
 	ASTRA_CONFIG_CHECK(!m_bUseVolumeMask || m_pVolumeMask->isFloat32Memory(), "ForwardProjection", "Volume mask object not a float32 host memory object");
+	ASTRA_CONFIG_CHECK(!m_bUseVolumeWindow || m_volumeWindow.isValid(m_pVolume->getGeometry()), "ForwardProjection", "VolumeWindow is empty or not inside the volume.");
 
 	// success
 	return true;
@@ -134,6 +137,21 @@ bool CForwardProjectionAlgorithm::initialize(const Config& _cfg)
 		m_pSinogramMask = dynamic_cast<CFloat32ProjectionData2D*>(CData2DManager::getSingleton().get(id));
 	}
 
+	if (CR.hasOption("VolumeWindow")) {
+		vector<int> window;
+		if (!CR.getOptionIntArray("VolumeWindow", window))
+			return false;
+		if (window.size() != 4) {
+			ASTRA_ERROR("VolumeWindow must be of the form [RowFrom, RowTo, ColFrom, ColTo]");
+			return false;
+		}
+		m_bUseVolumeWindow = true;
+		m_volumeWindow.iRowFrom = window[0];
+		m_volumeWindow.iRowTo = window[1];
+		m_volumeWindow.iColFrom = window[2];
+		m_volumeWindow.iColTo = window[3];
+	}
+
 	// return success
 	m_bIsInitialized = _check();
 	return m_bIsInitialized;
@@ -169,6 +187,14 @@ void CForwardProjectionAlgorithm::setVolumeMask(CFloat32VolumeData2D* _pMask, bo
 	}
 }
 
+//----------------------------------------------------------------------------------------
+// Set Volume Window
+void CForwardProjectionAlgorithm::setVolumeWindow(const SVolumeWindow& _window)
+{
+	m_bUseVolumeWindow = true;
+	m_volumeWindow = _window;
+}
+
 //----------------------------------------------------------------------------------------
 // Set Fixed Sinogram Mask
 void CForwardProjectionAlgorithm::setSinogramMask(CFloat32ProjectionData2D* _pMask, bool _bEnable)
@@ -181,21 +207,79 @@ void CForwardProjectionAlgorithm::setSinogramMask(CFloat32ProjectionData2D* _pMa
 	}
 }
 
+//----------------------------------------------------------------------------------------
+// Forward projection data projector for volume and projection data that are
+// not both float32. Converts on load and accumulates in float32.
+template<typename TVol, typename TProj>
+static CDataProjectorInterface *dispatchConvertingFP(CProjector2D *_pProjector,
+                                                     CFloat32VolumeData2D *_pVolume, CFloat32ProjectionData2D *_pSinogram,
+                                                     CFloat32VolumeData2D *_pVolumeMask, CFloat32ProjectionData2D *_pSinogramMask,
+                                                     bool _bUseVolumeMask, bool _bUseSinogramMask)
+{
+	return dispatchDataProjector(
+		_pProjector,
+		SinogramMaskPolicy(_pSinogramMask),
+		ReconstructionMaskPolicy(_pVolumeMask),
+		ConvertingFPPolicy<TVol, TProj>(_pVolume->getMemory<TVol>(), _pSinogram->getMemory<TProj>()),
+		_bUseSinogramMask, _bUseVolumeMask, true
+	);
+}
+
+template<typename TVol>
+static CDataProjectorInterface *dispatchConvertingFP(CProjector2D *_pProjector,
+                                                     CFloat32VolumeData2D *_pVolume, CFloat32ProjectionData2D *_pSinogram,
+                                                     CFloat32VolumeData2D *_pVolumeMask, CFloat32ProjectionData2D *_pSinogramMask,
+                                                     bool _bUseVolumeMask, bool _bUseSinogramMask)
+{
+	if (_pSinogram->isFloat16Memory())
+		return dispatchConvertingFP<TVol, float16>(_pProjector, _pVolume, _pSinogram, _pVolumeMask, _pSinogramMask, _bUseVolumeMask, _bUseSinogramMask);
+	if (_pSinogram->isBFloat16Memory())
+		return dispatchConvertingFP<TVol, bfloat16>(_pProjector, _pVolume, _pSinogram, _pVolumeMask, _pSinogramMask, _bUseVolumeMask, _bUseSinogramMask);
+	return dispatchConvertingFP<TVol, float32>(_pProjector, _pVolume, _pSinogram, _pVolumeMask, _pSinogramMask, _bUseVolumeMask, _bUseSinogramMask);
+}
+
 //----------------------------------------------------------------------------------------
 // Iterate
 bool CForwardProjectionAlgorithm::run(int _iNrIterations)
 {
+	ASTRA_PROFILE_SCOPE(profile, "algorithm/FP");
+
 	// check initialized
 	ASTRA_ASSERT(m_bIsInitialized);
 
+	// with a volume window, only its pixels are masked in
+	std::unique_ptr<CFloat32VolumeData2D> pWindowMask;
+	CFloat32VolumeData2D *pVolumeMask = m_bUseVolumeMask ? m_pVolumeMask : nullptr;
+	if (m_bUseVolumeWindow) {
+		pWindowMask.reset(createWindowMask(m_pVolume->getGeometry(), m_volumeWindow, pVolumeMask));
+		pVolumeMask = pWindowMask.get();
+	}
+	const bool bUseVolumeMask = (pVolumeMask != nullptr);
+
 	// forward projection data projector
-	CDataProjectorInterface	*pForwardProjector = dispatchDataProjector(
-		m_pProjector, 
-		SinogramMaskPolicy(m_pSinogramMask),			// sinogram mask
-		ReconstructionMaskPolicy(m_pVolumeMask),		// reconstruction mask
-		DefaultFPPolicy(m_pVolume, m_pSinogram),		// forward projection
-		m_bUseSinogramMask, m_bUseVolumeMask, true		// options on/off
-	); 
+	CDataProjectorInterface	*pForwardProjector;
+	if (m_pVolume->isFloat32Memory() && m_pSinogram->isFloat32Memory()) {
+		pForwardProjector = dispatchDataProjector(
+			m_pProjector, 
+			SinogramMaskPolicy(m_pSinogramMask),			// sinogram mask
+			ReconstructionMaskPolicy(pVolumeMask),			// reconstruction mask
+			DefaultFPPolicy(m_pVolume, m_pSinogram),		// forward projection
+			m_bUseSinogramMask, bUseVolumeMask, true		// options on/off
+		); 
+	} else if (m_pVolume->isFloat16Memory()) {
+		pForwardProjector = dispatchConvertingFP<float16>(m_pProjector, m_pVolume, m_pSinogram, pVolumeMask, m_pSinogramMask, bUseVolumeMask, m_bUseSinogramMask);
+	} else if (m_pVolume->isBFloat16Memory()) {
+		pForwardProjector = dispatchConvertingFP<bfloat16>(m_pProjector, m_pVolume, m_pSinogram, pVolumeMask, m_pSinogramMask, bUseVolumeMask, m_bUseSinogramMask);
+	} else {
+		pForwardProjector = dispatchConvertingFP<float32>(m_pProjector, m_pVolume, m_pSinogram, pVolumeMask, m_pSinogramMask, bUseVolumeMask, m_bUseSinogramMask);
+	}
+
+	// only visit the active rays and pixels of the masks
+	std::unique_ptr<CMaskIndex> pMaskIndex;
+	if (m_bUseSinogramMask || bUseVolumeMask)
+		pMaskIndex = std::make_unique<CMaskIndex>(m_pProjector->getProjectionGeometry(), m_pProjector->getVolumeGeometry(),
+		                                          m_bUseSinogramMask ? m_pSinogramMask : nullptr, pVolumeMask);
+	pForwardProjector->setMaskIndex(pMaskIndex.get());
 
 	m_pSinogram->setData(0.0f);
 
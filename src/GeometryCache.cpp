@@ -0,0 +1,85 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+#include "astra/GeometryCache.h"
+
+namespace astra {
+
+CGeometryCache::CGeometryCache(const CGeometryCache &_other)
+{
+	std::lock_guard<std::mutex> lock(_other.m_mutex);
+	m_entries = _other.m_entries;
+}
+
+CGeometryCache &CGeometryCache::operator=(const CGeometryCache &_other)
+{
+	if (this == &_other)
+		return *this;
+
+	std::vector<std::pair<std::string, std::shared_ptr<const void> > > entries;
+	{
+		std::lock_guard<std::mutex> lock(_other.m_mutex);
+		entries = _other.m_entries;
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_entries.swap(entries);
+	return *this;
+}
+
+void CGeometryCache::invalidate()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_entries.clear();
+}
+
+std::shared_ptr<const void> CGeometryCache::_get(const std::string &_sKey) const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for (const auto &e : m_entries) {
+		if (e.first == _sKey) {
+			m_iHits++;
+			return e.second;
+		}
+	}
+	m_iMisses++;
+	return nullptr;
+}
+
+void CGeometryCache::_set(const std::string &_sKey, std::shared_ptr<const void> _pValue)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for (auto &e : m_entries) {
+		if (e.first == _sKey) {
+			e.second = std::move(_pValue);
+			return;
+		}
+	}
+	m_entries.emplace_back(_sKey, std::move(_pValue));
+}
+
+}
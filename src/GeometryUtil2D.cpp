@@ -354,8 +354,8 @@ bool convertAstraGeometry_dims(const CVolumeGeometry2D* pVolGeom,
 }
 
 
-Geometry2DParameters convertAstraGeometry(const CVolumeGeometry2D* pVolGeom,
-                                          const CProjectionGeometry2D* pProjGeom)
+static Geometry2DParameters convertAstraGeometry_uncached(const CVolumeGeometry2D* pVolGeom,
+                                                          const CProjectionGeometry2D* pProjGeom)
 {
 	const CParallelProjectionGeometry2D* parProjGeom = dynamic_cast<const CParallelProjectionGeometry2D*>(pProjGeom);
 	const CParallelVecProjectionGeometry2D* parVecProjGeom = dynamic_cast<const CParallelVecProjectionGeometry2D*>(pProjGeom);
@@ -396,5 +396,47 @@ Geometry2DParameters convertAstraGeometry(const CVolumeGeometry2D* pVolGeom,
 }
 
 
+namespace {
+// The volume geometry a cached conversion was made for
+struct SVolumeKey2D {
+	int iCols, iRows;
+	float32 fMinX, fMaxX, fMinY, fMaxY;
+
+	SVolumeKey2D(const CVolumeGeometry2D* pVolGeom)
+		: iCols(pVolGeom->getGridColCount()), iRows(pVolGeom->getGridRowCount()),
+		  fMinX(pVolGeom->getWindowMinX()), fMaxX(pVolGeom->getWindowMaxX()),
+		  fMinY(pVolGeom->getWindowMinY()), fMaxY(pVolGeom->getWindowMaxY()) { }
+
+	bool operator==(const SVolumeKey2D &o) const {
+		return iCols == o.iCols && iRows == o.iRows &&
+		       fMinX == o.fMinX && fMaxX == o.fMaxX &&
+		       fMinY == o.fMinY && fMaxY == o.fMaxY;
+	}
+};
+
+struct SCachedGeometry2DParameters {
+	SVolumeKey2D vol;
+	Geometry2DParameters params;
+};
+}
+
+Geometry2DParameters convertAstraGeometry(const CVolumeGeometry2D* pVolGeom,
+                                          const CProjectionGeometry2D* pProjGeom)
+{
+	// The result of the last conversion is cached in the projection geometry
+	CGeometryCache &cache = pProjGeom->getCache();
+	SVolumeKey2D key(pVolGeom);
+
+	std::shared_ptr<const SCachedGeometry2DParameters> cached = cache.get<SCachedGeometry2DParameters>("Geometry2DParameters");
+	if (cached && cached->vol == key)
+		return cached->params;
+
+	Geometry2DParameters params = convertAstraGeometry_uncached(pVolGeom, pProjGeom);
+	if (params.isValid())
+		cache.set<SCachedGeometry2DParameters>("Geometry2DParameters", std::make_shared<const SCachedGeometry2DParameters>(SCachedGeometry2DParameters{key, params}));
+
+	return params;
+}
+
 
 }
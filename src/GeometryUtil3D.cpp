@@ -172,12 +172,12 @@ std::vector<SPar3DProjection> genPar3DProjections(unsigned int iProjAngles,
 }
 
 
-// Utility function to get newly allocated copy of projection vectors for any geometry
+// Utility function to generate projection vectors for any geometry
 template<class V, class P>
-static std::vector<V> getProjectionVectors(const P* geom);
+static std::vector<V> genProjectionVectors(const P* geom);
 
 template<>
-std::vector<SConeProjection> getProjectionVectors(const CConeProjectionGeometry3D* pProjGeom)
+std::vector<SConeProjection> genProjectionVectors(const CConeProjectionGeometry3D* pProjGeom)
 {
 	return genConeProjections(pProjGeom->getProjectionCount(),
 	                          pProjGeom->getDetectorColCount(),
@@ -190,7 +190,7 @@ std::vector<SConeProjection> getProjectionVectors(const CConeProjectionGeometry3
 }
 
 template<>
-std::vector<SConeProjection> getProjectionVectors(const CConeVecProjectionGeometry3D* pProjGeom)
+std::vector<SConeProjection> genProjectionVectors(const CConeVecProjectionGeometry3D* pProjGeom)
 {
 	int nth = pProjGeom->getProjectionCount();
 
@@ -204,7 +204,7 @@ std::vector<SConeProjection> getProjectionVectors(const CConeVecProjectionGeomet
 }
 
 template<>
-std::vector<SPar3DProjection> getProjectionVectors(const CParallelProjectionGeometry3D* pProjGeom)
+std::vector<SPar3DProjection> genProjectionVectors(const CParallelProjectionGeometry3D* pProjGeom)
 {
 	return genPar3DProjections(pProjGeom->getProjectionCount(),
 	                           pProjGeom->getDetectorColCount(),
@@ -215,7 +215,7 @@ std::vector<SPar3DProjection> getProjectionVectors(const CParallelProjectionGeom
 }
 
 template<>
-std::vector<SPar3DProjection> getProjectionVectors(const CParallelVecProjectionGeometry3D* pProjGeom)
+std::vector<SPar3DProjection> genProjectionVectors(const CParallelVecProjectionGeometry3D* pProjGeom)
 {
 	int nth = pProjGeom->getProjectionCount();
 
@@ -229,7 +229,7 @@ std::vector<SPar3DProjection> getProjectionVectors(const CParallelVecProjectionG
 }
 
 template<>
-std::vector<SCylConeProjection> getProjectionVectors(const CCylConeVecProjectionGeometry3D* pProjGeom)
+std::vector<SCylConeProjection> genProjectionVectors(const CCylConeVecProjectionGeometry3D* pProjGeom)
 {
 	int nth = pProjGeom->getProjectionCount();
 
@@ -243,6 +243,24 @@ std::vector<SCylConeProjection> getProjectionVectors(const CCylConeVecProjection
 }
 
 
+// Projection vectors of a geometry. These are generated once, and shared
+// through the cache of the geometry.
+template<class V, class P>
+static std::shared_ptr<const std::vector<V> > getSharedProjectionVectors(const P* geom)
+{
+	return geom->getCache().template getOrCompute<std::vector<V> >("ProjectionVectors", [geom]() {
+		return std::make_shared<const std::vector<V> >(genProjectionVectors<V>(geom));
+	});
+}
+
+// Utility function to get newly allocated copy of projection vectors for any geometry
+template<class V, class P>
+static std::vector<V> getProjectionVectors(const P* geom)
+{
+	return *getSharedProjectionVectors<V>(geom);
+}
+
+
 // Translate detector location along u axis
 template<class V>
 static void translateDetectorVectorsU(std::vector<V> &projs, double du)
@@ -446,44 +464,44 @@ CProjectionGeometry3D* getSubProjectionGeometry_Angle(const CProjectionGeometry3
 	const CCylConeVecProjectionGeometry3D* cylconevec3dgeom = dynamic_cast<const CCylConeVecProjectionGeometry3D*>(pProjGeom);
 
 	if (conegeom || conevec3dgeom) {
-		std::vector<SConeProjection> coneProjs;
+		std::shared_ptr<const std::vector<SConeProjection> > coneProjs;
 		if (conegeom) {
-			coneProjs = getProjectionVectors<SConeProjection>(conegeom);
+			coneProjs = getSharedProjectionVectors<SConeProjection>(conegeom);
 		} else {
-			coneProjs = getProjectionVectors<SConeProjection>(conevec3dgeom);
+			coneProjs = getSharedProjectionVectors<SConeProjection>(conevec3dgeom);
 		}
 
 		CProjectionGeometry3D* ret = new CConeVecProjectionGeometry3D(size,
 		                                                              pProjGeom->getDetectorRowCount(),
 		                                                              pProjGeom->getDetectorColCount(),
-									      std::vector<SConeProjection>(coneProjs.begin() + th,
-										                           coneProjs.begin() + th+size));
+									      std::vector<SConeProjection>(coneProjs->begin() + th,
+										                           coneProjs->begin() + th+size));
 
 
 		return ret;
 	} else if (par3dgeom || parvec3dgeom) {
-		std::vector<SPar3DProjection> parProjs;
+		std::shared_ptr<const std::vector<SPar3DProjection> > parProjs;
 		if (par3dgeom) {
-			parProjs = getProjectionVectors<SPar3DProjection>(par3dgeom);
+			parProjs = getSharedProjectionVectors<SPar3DProjection>(par3dgeom);
 		} else {
-			parProjs = getProjectionVectors<SPar3DProjection>(parvec3dgeom);
+			parProjs = getSharedProjectionVectors<SPar3DProjection>(parvec3dgeom);
 		}
 
 		CProjectionGeometry3D* ret = new CParallelVecProjectionGeometry3D(size,
 		                                                                  pProjGeom->getDetectorRowCount(),
 		                                                                  pProjGeom->getDetectorColCount(),
-		                                                                  std::vector<SPar3DProjection>(parProjs.begin() + th,
-		                                                                                                parProjs.begin() + th+size));
+		                                                                  std::vector<SPar3DProjection>(parProjs->begin() + th,
+		                                                                                                parProjs->begin() + th+size));
 
 		return ret;
 	} else if (cylconevec3dgeom) {
-		std::vector<SCylConeProjection> cylConeProjs = getProjectionVectors<SCylConeProjection>(cylconevec3dgeom);
+		std::shared_ptr<const std::vector<SCylConeProjection> > cylConeProjs = getSharedProjectionVectors<SCylConeProjection>(cylconevec3dgeom);
 
 		CProjectionGeometry3D* ret = new CCylConeVecProjectionGeometry3D(size,
 		                                                                 pProjGeom->getDetectorRowCount(),
 		                                                                 pProjGeom->getDetectorColCount(),
-		                                                                 std::vector<SCylConeProjection>(cylConeProjs.begin() + th,
-		                                                                                                 cylConeProjs.begin() + th+size));
+		                                                                 std::vector<SCylConeProjection>(cylConeProjs->begin() + th,
+		                                                                                                 cylConeProjs->begin() + th+size));
 
 		return ret;
 	} else {
@@ -539,6 +557,18 @@ void computeBP_UV_Coeffs(const SConeProjection& proj, double &fUX, double &fUY,
 }
 
 
+void computeBP_UV_Coeffs(const SPar3DProjection& proj, SPar3DBPCoeffs &c)
+{
+	computeBP_UV_Coeffs(proj, c.fUX, c.fUY, c.fUZ, c.fUC, c.fVX, c.fVY, c.fVZ, c.fVC);
+}
+
+void computeBP_UV_Coeffs(const SConeProjection& proj, SConeBPCoeffs &c)
+{
+	computeBP_UV_Coeffs(proj, c.fUX, c.fUY, c.fUZ, c.fUC, c.fVX, c.fVY, c.fVZ, c.fVC,
+	                    c.fDX, c.fDY, c.fDZ, c.fDC);
+}
+
+
 void getCylConeAxes(const SCylConeProjection &p, Vec3 &cyla, Vec3 &cylb, Vec3 &cylc, Vec3 &cylaxis)
 {
 	double R = p.fDetR;
@@ -648,12 +678,8 @@ static bool convertAstraGeometry(const CVolumeGeometry3D* pVolGeom,
 
 	int nth = pProjGeom->getProjectionCount();
 
-	projs = genPar3DProjections(nth,
-	                             pProjGeom->getDetectorColCount(),
-	                             pProjGeom->getDetectorRowCount(),
-	                             pProjGeom->getDetectorSpacingX(),
-	                             pProjGeom->getDetectorSpacingY(),
-	                             pProjGeom->getProjectionAngles());
+	projs = getProjectionVectors<SPar3DProjection>(pProjGeom);
+	assert(projs.size() == (size_t)nth);
 
 	bool ok;
 
@@ -672,9 +698,8 @@ static bool convertAstraGeometry(const CVolumeGeometry3D* pVolGeom,
 
 	int nth = pProjGeom->getProjectionCount();
 
-	projs.resize(nth);
-	for (int i = 0; i < nth; ++i)
-		projs[i] = pProjGeom->getProjectionVectors()[i];
+	projs = getProjectionVectors<SPar3DProjection>(pProjGeom);
+	assert(projs.size() == (size_t)nth);
 
 	bool ok;
 
@@ -693,14 +718,8 @@ static bool convertAstraGeometry(const CVolumeGeometry3D* pVolGeom,
 
 	int nth = pProjGeom->getProjectionCount();
 
-	projs = genConeProjections(nth,
-	                            pProjGeom->getDetectorColCount(),
-	                            pProjGeom->getDetectorRowCount(),
-	                            pProjGeom->getOriginSourceDistance(),
-	                            pProjGeom->getOriginDetectorDistance(),
-	                            pProjGeom->getDetectorSpacingX(),
-	                            pProjGeom->getDetectorSpacingY(),
-	                            pProjGeom->getProjectionAngles());
+	projs = getProjectionVectors<SConeProjection>(pProjGeom);
+	assert(projs.size() == (size_t)nth);
 
 	bool ok;
 
@@ -719,9 +738,8 @@ static bool convertAstraGeometry(const CVolumeGeometry3D* pVolGeom,
 
 	int nth = pProjGeom->getProjectionCount();
 
-	projs.resize(nth);
-	for (int i = 0; i < nth; ++i)
-		projs[i] = pProjGeom->getProjectionVectors()[i];
+	projs = getProjectionVectors<SConeProjection>(pProjGeom);
+	assert(projs.size() == (size_t)nth);
 
 	bool ok;
 
@@ -740,9 +758,8 @@ static bool convertAstraGeometry(const CVolumeGeometry3D* pVolGeom,
 
 	int nth = pProjGeom->getProjectionCount();
 
-	projs.resize(nth);
-	for (int i = 0; i < nth; ++i)
-		projs[i] = pProjGeom->getProjectionVectors()[i];
+	projs = getProjectionVectors<SCylConeProjection>(pProjGeom);
+	assert(projs.size() == (size_t)nth);
 
 	bool ok;
 
@@ -751,8 +768,8 @@ static bool convertAstraGeometry(const CVolumeGeometry3D* pVolGeom,
 	return ok;
 }
 
-Geometry3DParameters convertAstraGeometry(const CVolumeGeometry3D* pVolGeom,
-                                          const CProjectionGeometry3D* pProjGeom)
+static Geometry3DParameters convertAstraGeometry_uncached(const CVolumeGeometry3D* pVolGeom,
+                                                          const CProjectionGeometry3D* pProjGeom)
 {
 	const CConeProjectionGeometry3D* conegeom = dynamic_cast<const CConeProjectionGeometry3D*>(pProjGeom);
 	const CParallelProjectionGeometry3D* par3dgeom = dynamic_cast<const CParallelProjectionGeometry3D*>(pProjGeom);
@@ -805,7 +822,80 @@ Geometry3DParameters convertAstraGeometry(const CVolumeGeometry3D* pVolGeom,
 }
 
 
+namespace {
+// The volume geometry a cached conversion was made for
+struct SVolumeKey3D {
+	int iCols, iRows, iSlices;
+	float32 fMinX, fMaxX, fMinY, fMaxY, fMinZ, fMaxZ;
+
+	SVolumeKey3D(const CVolumeGeometry3D* pVolGeom)
+		: iCols(pVolGeom->getGridColCount()), iRows(pVolGeom->getGridRowCount()),
+		  iSlices(pVolGeom->getGridSliceCount()),
+		  fMinX(pVolGeom->getWindowMinX()), fMaxX(pVolGeom->getWindowMaxX()),
+		  fMinY(pVolGeom->getWindowMinY()), fMaxY(pVolGeom->getWindowMaxY()),
+		  fMinZ(pVolGeom->getWindowMinZ()), fMaxZ(pVolGeom->getWindowMaxZ()) { }
+
+	bool operator==(const SVolumeKey3D &o) const {
+		return iCols == o.iCols && iRows == o.iRows && iSlices == o.iSlices &&
+		       fMinX == o.fMinX && fMaxX == o.fMaxX && fMinY == o.fMinY &&
+		       fMaxY == o.fMaxY && fMinZ == o.fMinZ && fMaxZ == o.fMaxZ;
+	}
+};
+
+struct SCachedGeometry3DParameters {
+	SVolumeKey3D vol;
+	Geometry3DParameters params;
+};
+}
+
+Geometry3DParameters convertAstraGeometry(const CVolumeGeometry3D* pVolGeom,
+                                          const CProjectionGeometry3D* pProjGeom)
+{
+	// The result of the last conversion is cached in the projection geometry
+	CGeometryCache &cache = pProjGeom->getCache();
+	SVolumeKey3D key(pVolGeom);
+
+	std::shared_ptr<const SCachedGeometry3DParameters> cached = cache.get<SCachedGeometry3DParameters>("Geometry3DParameters");
+	if (cached && cached->vol == key)
+		return cached->params;
+
+	Geometry3DParameters params = convertAstraGeometry_uncached(pVolGeom, pProjGeom);
+	if (params.isValid())
+		cache.set<SCachedGeometry3DParameters>("Geometry3DParameters", std::make_shared<const SCachedGeometry3DParameters>(SCachedGeometry3DParameters{key, params}));
+
+	return params;
+}
+
+
+template<class V, class C, class P>
+static std::shared_ptr<const std::vector<C> > getBP_UV_Coeffs(const P* pProjGeom)
+{
+	return pProjGeom->getCache().template getOrCompute<std::vector<C> >("BP_UV_Coeffs", [pProjGeom]() {
+		std::shared_ptr<const std::vector<V> > projs = getSharedProjectionVectors<V>(pProjGeom);
+		auto coeffs = std::make_shared<std::vector<C> >(projs->size());
+		for (size_t i = 0; i < projs->size(); ++i)
+			computeBP_UV_Coeffs((*projs)[i], (*coeffs)[i]);
+		return std::shared_ptr<const std::vector<C> >(std::move(coeffs));
+	});
+}
+
+std::shared_ptr<const std::vector<SPar3DBPCoeffs> > getParallelBP_UV_Coeffs(const CProjectionGeometry3D* pProjGeom)
+{
+	if (auto g = dynamic_cast<const CParallelProjectionGeometry3D*>(pProjGeom))
+		return getBP_UV_Coeffs<SPar3DProjection, SPar3DBPCoeffs>(g);
+	if (auto g = dynamic_cast<const CParallelVecProjectionGeometry3D*>(pProjGeom))
+		return getBP_UV_Coeffs<SPar3DProjection, SPar3DBPCoeffs>(g);
+	return nullptr;
+}
 
+std::shared_ptr<const std::vector<SConeBPCoeffs> > getConeBP_UV_Coeffs(const CProjectionGeometry3D* pProjGeom)
+{
+	if (auto g = dynamic_cast<const CConeProjectionGeometry3D*>(pProjGeom))
+		return getBP_UV_Coeffs<SConeProjection, SConeBPCoeffs>(g);
+	if (auto g = dynamic_cast<const CConeVecProjectionGeometry3D*>(pProjGeom))
+		return getBP_UV_Coeffs<SConeProjection, SConeBPCoeffs>(g);
+	return nullptr;
+}
 
 
 }
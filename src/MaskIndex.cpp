@@ -0,0 +1,150 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+#include "astra/MaskIndex.h"
+
+#include "astra/Data2D.h"
+
+namespace astra {
+
+CMaskIndex::CMaskIndex(const CProjectionGeometry2D &_projGeom, const CVolumeGeometry2D &_volGeom,
+                       const CFloat32ProjectionData2D *_pSinogramMask,
+                       const CFloat32VolumeData2D *_pReconstructionMask)
+{
+	m_iAngleCount = _projGeom.getProjectionAngleCount();
+	m_iDetectorCount = _projGeom.getDetectorCount();
+
+	// Active rays: per angle, link every detector to the first active
+	// detector at or after it
+	m_iRaysPerAngle.assign(m_iAngleCount, m_iDetectorCount);
+	m_iActiveRays = (size_t)m_iAngleCount * m_iDetectorCount;
+	if (_pSinogramMask) {
+		const float32 *pfMask = _pSinogramMask->getFloat32Memory();
+		ASTRA_ASSERT(pfMask);
+		m_iNextRay.resize((size_t)m_iAngleCount * m_iDetectorCount);
+		m_iActiveRays = 0;
+		for (int iAngle = 0; iAngle < m_iAngleCount; ++iAngle) {
+			const size_t iOffset = (size_t)iAngle * m_iDetectorCount;
+			int iNext = m_iDetectorCount;
+			int iCount = 0;
+			for (int iDetector = m_iDetectorCount - 1; iDetector >= 0; --iDetector) {
+				if (pfMask[iOffset + iDetector] != 0.0f) {
+					iNext = iDetector;
+					iCount++;
+				}
+				m_iNextRay[iOffset + iDetector] = iNext;
+			}
+			m_iRaysPerAngle[iAngle] = iCount;
+			m_iActiveRays += iCount;
+		}
+		m_subset.iDetectorCount = m_iDetectorCount;
+		m_subset.piNextRay = m_iNextRay.data();
+	}
+
+	// Active pixels: span of active columns per row and of active rows
+	// per column, and the window bounding them. Empty spans are stored as
+	// [count, 0), so they don't overlap any range of pixels in the volume.
+	const int iRowCount = _volGeom.getGridRowCount();
+	const int iColCount = _volGeom.getGridColCount();
+	m_iActivePixels = (size_t)iRowCount * iColCount;
+	if (_pReconstructionMask) {
+		const float32 *pfMask = _pReconstructionMask->getFloat32Memory();
+		ASTRA_ASSERT(pfMask);
+		m_iRowSpans.resize(2 * iRowCount);
+		m_iColSpans.resize(2 * iColCount);
+		for (int iCol = 0; iCol < iColCount; ++iCol) {
+			m_iColSpans[2*iCol] = iRowCount;
+			m_iColSpans[2*iCol+1] = 0;
+		}
+		m_iActivePixels = 0;
+		for (int iRow = 0; iRow < iRowCount; ++iRow) {
+			m_iRowSpans[2*iRow] = iColCount;
+			m_iRowSpans[2*iRow+1] = 0;
+			const float32 *pfRow = pfMask + (size_t)iRow * iColCount;
+			for (int iCol = 0; iCol < iColCount; ++iCol) {
+				if (pfRow[iCol] == 0.0f)
+					continue;
+				m_iActivePixels++;
+				m_iRowSpans[2*iRow] = std::min(m_iRowSpans[2*iRow], iCol);
+				m_iRowSpans[2*iRow+1] = iCol + 1;
+				m_iColSpans[2*iCol] = std::min(m_iColSpans[2*iCol], iRow);
+				m_iColSpans[2*iCol+1] = iRow + 1;
+			}
+		}
+
+		m_subset.iRowFrom = iRowCount;
+		m_subset.iRowTo = 0;
+		m_subset.iColFrom = iColCount;
+		m_subset.iColTo = 0;
+		for (int iRow = 0; iRow < iRowCount; ++iRow) {
+			if (m_iRowSpans[2*iRow] < m_iRowSpans[2*iRow+1]) {
+				m_subset.iRowFrom = std::min(m_subset.iRowFrom, iRow);
+				m_subset.iRowTo = iRow + 1;
+			}
+		}
+		for (int iCol = 0; iCol < iColCount; ++iCol) {
+			if (m_iColSpans[2*iCol] < m_iColSpans[2*iCol+1]) {
+				m_subset.iColFrom = std::min(m_subset.iColFrom, iCol);
+				m_subset.iColTo = iCol + 1;
+			}
+		}
+		if (m_iActivePixels == 0) {
+			m_subset.iRowFrom = m_subset.iColFrom = 0;
+		}
+		m_subset.piRowSpans = m_iRowSpans.data();
+		m_subset.piColSpans = m_iColSpans.data();
+	}
+}
+
+int CMaskIndex::getActiveRayCount(int _iAngle) const
+{
+	ASTRA_ASSERT(_iAngle >= 0 && _iAngle < m_iAngleCount);
+	return m_iRaysPerAngle[_iAngle];
+}
+
+CFloat32VolumeData2D *createWindowMask(const CVolumeGeometry2D &_volGeom,
+                                       const SVolumeWindow &_window,
+                                       const CFloat32VolumeData2D *_pMask)
+{
+	CFloat32VolumeData2D *pWindowMask = createCFloat32VolumeData2DMemory(_volGeom);
+	float32 *pfWindowMask = pWindowMask->getFloat32Memory();
+	const float32 *pfMask = _pMask ? _pMask->getFloat32Memory() : nullptr;
+
+	const int iColCount = _volGeom.getGridColCount();
+	pWindowMask->setData(0.0f);
+	for (int iRow = _window.iRowFrom; iRow < _window.iRowTo; ++iRow) {
+		for (int iCol = _window.iColFrom; iCol < _window.iColTo; ++iCol) {
+			const size_t iIndex = (size_t)iRow * iColCount + iCol;
+			if (!pfMask || pfMask[iIndex] != 0.0f)
+				pfWindowMask[iIndex] = 1.0f;
+		}
+	}
+
+	return pWindowMask;
+}
+
+} // end namespace
@@ -64,6 +64,7 @@ bool CParallelVecProjectionGeometry2D::initialize(int _iProjectionAngleCount,
                                                   std::vector<SParProjection>&& _pProjectionAngles)
 {
 	assert(!m_bInitialized);
+	m_cache.invalidate();
 
 	m_iProjectionAngleCount = _iProjectionAngleCount;
 	m_iDetectorCount = _iDetectorCount;
@@ -99,7 +100,7 @@ bool CParallelVecProjectionGeometry2D::initializeAngles(const Config& _cfg)
 	ConfigReader<CProjectionGeometry2D> CR("ParallelVecProjectionGeometry2D", this, _cfg);
 
 	// Required: Vectors
-	vector<double> data;
+	ConfigNumericalArray data;
 	if (!CR.getRequiredNumericalArray("Vectors", data))
 		return false;
 	ASTRA_CONFIG_CHECK(data.size() % 6 == 0, "ParallelVecProjectionGeometry2D", "Vectors doesn't consist of 6-tuples.");
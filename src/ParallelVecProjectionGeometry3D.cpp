@@ -30,6 +30,7 @@ along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
 #include "astra/XMLConfig.h"
 #include "astra/Logging.h"
 
+#include <algorithm>
 #include <cstring>
 
 using namespace std;
@@ -82,7 +83,7 @@ bool CParallelVecProjectionGeometry3D::initializeAngles(const Config& _cfg)
 	ConfigReader<CProjectionGeometry3D> CR("ParallelVecProjectionGeometry3D", this, _cfg);
 
 	// Required: Vectors
-	vector<double> data;
+	ConfigNumericalArray data;
 	if (!CR.getRequiredNumericalArray("Vectors", data))
 		return false;
 	ASTRA_CONFIG_CHECK(data.size() % 12 == 0, "ParallelVecProjectionGeometry3D", "Vectors doesn't consist of 12-tuples.");
@@ -118,6 +119,8 @@ bool CParallelVecProjectionGeometry3D::initialize(int _iProjectionAngleCount,
                                                   int _iDetectorColCount, 
                                                   std::vector<SPar3DProjection> &&_ProjectionAngles)
 {
+	m_cache.invalidate();
+
 	m_iProjectionAngleCount = _iProjectionAngleCount;
 	m_iDetectorRowCount = _iDetectorRowCount;
 	m_iDetectorColCount = _iDetectorColCount;
@@ -219,6 +222,48 @@ void CParallelVecProjectionGeometry3D::projectPoint(double fX, double fY, double
 
 //----------------------------------------------------------------------------------------
 
+void CParallelVecProjectionGeometry3D::getProjectedBBoxSingleAngle(int iAngle,
+                                             double fXMin, double fXMax,
+                                             double fYMin, double fYMax,
+                                             double fZMin, double fZMax,
+                                             double &fUMin, double &fUMax,
+                                             double &fVMin, double &fVMax) const
+{
+	ASTRA_ASSERT(iAngle >= 0);
+	ASTRA_ASSERT(iAngle < m_iProjectionAngleCount);
+
+	// Use the cached per-angle coefficients instead of recomputing them
+	// for every corner
+	auto coeffs = getParallelBP_UV_Coeffs(this);
+	assert(coeffs);
+
+	const SPar3DBPCoeffs &c = (*coeffs)[iAngle];
+
+	double vol_u[8];
+	double vol_v[8];
+
+	for (int j = 0; j < 8; ++j) {
+		double fX = (j & 4) ? fXMax : fXMin;
+		double fY = (j & 2) ? fYMax : fYMin;
+		double fZ = (j & 1) ? fZMax : fZMin;
+
+		// The -0.5f shifts from corner to center of detector pixels
+		vol_u[j] = (c.fUX*fX + c.fUY*fY + c.fUZ*fZ + c.fUC) - 0.5;
+		vol_v[j] = (c.fVX*fX + c.fVY*fY + c.fVZ*fZ + c.fVC) - 0.5;
+	}
+
+	fUMin = fUMax = vol_u[0];
+	fVMin = fVMax = vol_v[0];
+	for (int j = 1; j < 8; ++j) {
+		fUMin = std::min(fUMin, vol_u[j]);
+		fUMax = std::max(fUMax, vol_u[j]);
+		fVMin = std::min(fVMin, vol_v[j]);
+		fVMax = std::max(fVMax, vol_v[j]);
+	}
+}
+
+//----------------------------------------------------------------------------------------
+
 bool CParallelVecProjectionGeometry3D::_check()
 {
 	ASTRA_CONFIG_CHECK(m_ProjectionAngles.size() == (size_t)m_iProjectionAngleCount, "ParallelVecProjectionGeometry3D", "Number of vectors does not match number of angles");
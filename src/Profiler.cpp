@@ -0,0 +1,105 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+#include "astra/Profiler.h"
+
+namespace astra {
+
+// Like the memory pool, the profiler is never destroyed, so that phases can
+// still be referenced from static function-local references during static
+// destruction.
+template<> CProfiler& Singleton<CProfiler>::getSingleton() {
+	static CProfiler *instance = new CProfiler();
+	return *instance;
+}
+
+std::atomic<bool> CProfiler::s_bEnabled(false);
+
+//----------------------------------------------------------------------------------------
+
+SProfilePhaseStats CProfilePhase::getStats() const
+{
+	SProfilePhaseStats stats;
+	stats.sName = m_sName;
+	stats.iCalls = m_iCalls.load(std::memory_order_relaxed);
+	stats.fSeconds = 1e-9 * m_iNanoseconds.load(std::memory_order_relaxed);
+	stats.iRays = m_iRays.load(std::memory_order_relaxed);
+	stats.iNonZeros = m_iNonZeros.load(std::memory_order_relaxed);
+	stats.iBytes = m_iBytes.load(std::memory_order_relaxed);
+	return stats;
+}
+
+void CProfilePhase::reset()
+{
+	m_iCalls.store(0, std::memory_order_relaxed);
+	m_iNanoseconds.store(0, std::memory_order_relaxed);
+	m_iRays.store(0, std::memory_order_relaxed);
+	m_iNonZeros.store(0, std::memory_order_relaxed);
+	m_iBytes.store(0, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------
+
+CProfiler::CProfiler()
+{
+
+}
+
+CProfiler::~CProfiler()
+{
+
+}
+
+CProfilePhase &CProfiler::getPhase(const std::string &_sName)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	std::unique_ptr<CProfilePhase> &phase = m_phases[_sName];
+	if (!phase)
+		phase.reset(new CProfilePhase(_sName));
+	return *phase;
+}
+
+std::vector<SProfilePhaseStats> CProfiler::getStats() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	std::vector<SProfilePhaseStats> stats;
+	for (const auto &p : m_phases) {
+		SProfilePhaseStats s = p.second->getStats();
+		if (s.iCalls > 0)
+			stats.push_back(s);
+	}
+	return stats;
+}
+
+void CProfiler::resetStats()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for (auto &p : m_phases)
+		p.second->reset();
+}
+
+} // end namespace
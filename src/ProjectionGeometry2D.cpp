@@ -81,6 +81,7 @@ bool CProjectionGeometry2D::_check()
 bool CProjectionGeometry2D::initialize(const Config& _cfg)
 {
 	assert(!m_bInitialized);
+	m_cache.invalidate();
 
 	ConfigReader<CProjectionGeometry2D> CR("ProjectionGeometry2D", this, _cfg);
 
@@ -114,7 +115,7 @@ bool CProjectionGeometry2D::initializeAngles(const Config& _cfg)
 		return false;
 
 	// Required: ProjectionAngles
-	vector<double> angles;
+	ConfigNumericalArray angles;
 	if (!CR.getRequiredNumericalArray("ProjectionAngles", angles))
 		return false;
 	m_iProjectionAngleCount = angles.size();
@@ -136,6 +137,7 @@ bool CProjectionGeometry2D::_initialize(int _iProjectionAngleCount,
                                         std::vector<float32> &&_pfProjectionAngles)
 {
 	assert(!m_bInitialized);
+	m_cache.invalidate();
 
 	// copy parameters
 	m_iProjectionAngleCount = _iProjectionAngleCount;
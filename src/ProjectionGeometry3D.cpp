@@ -93,6 +93,7 @@ CProjectionGeometry3D::CProjectionGeometry3D(int _iAngleCount,
 bool CProjectionGeometry3D::initialize(const Config& _cfg)
 {
 	assert(!m_bInitialized);
+	m_cache.invalidate();
 
 	ConfigReader<CProjectionGeometry3D> CR("ProjectionGeometry3D", this, _cfg);
 
@@ -123,7 +124,7 @@ bool CProjectionGeometry3D::initializeAngles(const Config& _cfg)
 	if (!ok)
 		return false;
 	// Required: ProjectionAngles
-	vector<double> angles;
+	ConfigNumericalArray angles;
 	if (!CR.getRequiredNumericalArray("ProjectionAngles", angles))
 		return false;
 	m_iProjectionAngleCount = angles.size();
@@ -147,6 +148,7 @@ bool CProjectionGeometry3D::_initialize(int _iProjectionAngleCount,
                                         std::vector<float32> &&_pfProjectionAngles)
 {
 	assert(!m_bInitialized);
+	m_cache.invalidate();
 
 	// copy parameters
 	m_iProjectionAngleCount = _iProjectionAngleCount;
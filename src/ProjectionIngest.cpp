@@ -0,0 +1,118 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+#include "astra/ProjectionIngest.h"
+
+#include "astra/ThreadPool.h"
+#include "astra/Logging.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace astra {
+
+// Minimum number of pixels per thread
+static const size_t INGEST_GRAIN = 1 << 16;
+
+template<typename T>
+bool ingestRawProjections(const T *_pRaw, int _iFirstAngle, int _iAngleCount,
+                          const float32 *_pfFlat, const float32 *_pfDark,
+                          CFloat32ProjectionData3D *_pData,
+                          const SRawIngestOptions &_options)
+{
+	ASTRA_ASSERT(_pRaw);
+	ASTRA_ASSERT(_pData);
+
+	if (!_pData->isFloat32Memory()) {
+		ASTRA_ERROR("ingestRawProjections: data is not float32 host memory");
+		return false;
+	}
+	if (_pData->isReadOnly()) {
+		ASTRA_ERROR("ingestRawProjections: data is read-only");
+		return false;
+	}
+	if (_iFirstAngle < 0 || _iAngleCount < 0 || _iFirstAngle + _iAngleCount > _pData->getAngleCount()) {
+		ASTRA_ERROR("ingestRawProjections: projections %d to %d out of range", _iFirstAngle, _iFirstAngle + _iAngleCount);
+		return false;
+	}
+
+	const size_t iRows = _pData->getDetectorRowCount();
+	const size_t iCols = _pData->getDetectorColCount();
+	const size_t iAngles = _pData->getAngleCount();
+	const size_t iPixels = iRows * iCols;
+
+	// Precompute the per-pixel correction raw * gain - offset. Dead pixels
+	// (flat <= dark) get a transmission of 1, so they add nothing to the
+	// line integrals instead of the same large value at every angle.
+	std::vector<float32> gain(iPixels), offset(iPixels);
+	for (size_t i = 0; i < iPixels; ++i) {
+		float32 fDark = _pfDark ? _pfDark[i] : 0.0f;
+		float32 fRange = _pfFlat ? _pfFlat[i] - fDark : 1.0f;
+		if (fRange > 0.0f) {
+			gain[i] = 1.0f / fRange;
+			offset[i] = fDark * gain[i];
+		} else {
+			gain[i] = 0.0f;
+			offset[i] = -1.0f;
+		}
+	}
+
+	float32 *pfOut = _pData->getFloat32Memory();
+	const bool bLog = _options.bLog;
+	const float32 fMinTransmission = _options.fMinTransmission;
+
+	// One detector row of one projection per line
+	const int iLines = (int)iRows * _iAngleCount;
+	const int iGrain = (int)std::max<size_t>(INGEST_GRAIN / std::max<size_t>(iCols, 1), 1);
+
+	parallelFor(0, iLines, iGrain, [&](int iFrom, int iTo) {
+		for (int l = iFrom; l < iTo; ++l) {
+			size_t r = l / _iAngleCount;
+			size_t a = l % _iAngleCount;
+			const T *src = _pRaw + (a * iRows + r) * iCols;
+			float32 *dst = pfOut + (r * iAngles + _iFirstAngle + a) * iCols;
+			const float32 *g = &gain[r * iCols];
+			const float32 *o = &offset[r * iCols];
+			if (bLog) {
+				for (size_t c = 0; c < iCols; ++c)
+					dst[c] = -std::log(std::max((float32)src[c] * g[c] - o[c], fMinTransmission));
+			} else {
+				for (size_t c = 0; c < iCols; ++c)
+					dst[c] = (float32)src[c] * g[c] - o[c];
+			}
+		}
+	});
+
+	return true;
+}
+
+template _AstraExport bool ingestRawProjections<uint16_t>(const uint16_t *, int, int, const float32 *, const float32 *, CFloat32ProjectionData3D *, const SRawIngestOptions &);
+template _AstraExport bool ingestRawProjections<uint32_t>(const uint32_t *, int, int, const float32 *, const float32 *, CFloat32ProjectionData3D *, const SRawIngestOptions &);
+template _AstraExport bool ingestRawProjections<float32>(const float32 *, int, int, const float32 *, const float32 *, CFloat32ProjectionData3D *, const SRawIngestOptions &);
+
+} // end namespace astra
@@ -0,0 +1,283 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+#include "astra/ProjectionOperator.h"
+
+#include "astra/Data2D.h"
+#include "astra/Data3D.h"
+#include "astra/Projector2D.h"
+#include "astra/Projector3D.h"
+#include "astra/ForwardProjectionAlgorithm.h"
+#include "astra/BackProjectionAlgorithm.h"
+#include "astra/Logging.h"
+
+#ifdef ASTRA_CUDA
+#include "astra/CudaProjector2D.h"
+#include "astra/CudaForwardProjectionAlgorithm.h"
+#include "astra/CudaBackProjectionAlgorithm.h"
+#include "astra/CompositeGeometryManager.h"
+#endif
+
+namespace astra {
+
+//----------------------------------------------------------------------------------------
+// 2D
+
+CProjectionOperator2D::CProjectionOperator2D(CProjector2D *_pProjector, EProjectionOperation _eOperation)
+	: m_pProjector(_pProjector), m_eOperation(_eOperation), m_bIsInitialized(false),
+	  m_pVolumeStorage(nullptr), m_pProjectionStorage(nullptr)
+{
+	if (!m_pProjector || !m_pProjector->isInitialized()) {
+		ASTRA_ERROR("CProjectionOperator2D: projector not initialized");
+		return;
+	}
+
+	// The data objects take ownership of the storage
+	m_pVolumeStorage = new CDataMemoryView<float32>();
+	m_pProjectionStorage = new CDataMemoryView<float32>();
+	m_pVolume = std::make_unique<CFloat32VolumeData2D>(m_pProjector->getVolumeGeometry(), m_pVolumeStorage);
+	m_pProjection = std::make_unique<CFloat32ProjectionData2D>(m_pProjector->getProjectionGeometry(), m_pProjectionStorage);
+
+	m_pAlgorithm.reset(createAlgorithm(m_pVolume.get(), m_pProjection.get()));
+	if (!m_pAlgorithm) {
+		ASTRA_ERROR("CProjectionOperator2D: failed to initialize algorithm");
+		return;
+	}
+
+	m_bIsInitialized = true;
+}
+
+CProjectionOperator2D::~CProjectionOperator2D()
+{
+	// Delete the algorithm before the data objects it refers to
+	m_pAlgorithm.reset();
+}
+
+size_t CProjectionOperator2D::getInputSize() const
+{
+	if (!m_bIsInitialized)
+		return 0;
+	return (m_eOperation == OPERATION_FP) ? m_pVolume->getSize() : m_pProjection->getSize();
+}
+
+size_t CProjectionOperator2D::getOutputSize() const
+{
+	if (!m_bIsInitialized)
+		return 0;
+	return (m_eOperation == OPERATION_FP) ? m_pProjection->getSize() : m_pVolume->getSize();
+}
+
+CAlgorithm *CProjectionOperator2D::createAlgorithm(CFloat32VolumeData2D *_pVolume, CFloat32ProjectionData2D *_pProjection) const
+{
+	CAlgorithm *pAlg = nullptr;
+
+#ifdef ASTRA_CUDA
+	if (dynamic_cast<CCudaProjector2D*>(m_pProjector)) {
+		if (m_eOperation == OPERATION_FP) {
+			CCudaForwardProjectionAlgorithm *pFP = new CCudaForwardProjectionAlgorithm();
+			pFP->initialize(m_pProjector, _pVolume, _pProjection);
+			pAlg = pFP;
+		} else {
+			CCudaBackProjectionAlgorithm *pBP = new CCudaBackProjectionAlgorithm();
+			pBP->initialize(m_pProjector, _pProjection, _pVolume);
+			pAlg = pBP;
+		}
+	}
+#endif
+
+	if (!pAlg) {
+		if (m_eOperation == OPERATION_FP)
+			pAlg = new CForwardProjectionAlgorithm(m_pProjector, _pVolume, _pProjection);
+		else
+			pAlg = new CBackProjectionAlgorithm(m_pProjector, _pProjection, _pVolume);
+	}
+
+	if (!pAlg->isInitialized()) {
+		delete pAlg;
+		return nullptr;
+	}
+
+	return pAlg;
+}
+
+bool CProjectionOperator2D::apply(const float32 *_pfIn, float32 *_pfOut)
+{
+	ASTRA_ASSERT(m_bIsInitialized);
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	// The input is only read by the algorithm
+	float32 *pfIn = const_cast<float32*>(_pfIn);
+	if (m_eOperation == OPERATION_FP) {
+		m_pVolumeStorage->setData(pfIn);
+		m_pProjectionStorage->setData(_pfOut);
+	} else {
+		m_pProjectionStorage->setData(pfIn);
+		m_pVolumeStorage->setData(_pfOut);
+	}
+
+	bool ok = m_pAlgorithm->run(1);
+
+	m_pVolumeStorage->setData(nullptr);
+	m_pProjectionStorage->setData(nullptr);
+
+	return ok;
+}
+
+bool CProjectionOperator2D::apply(const CData2D *_pIn, CData2D *_pOut)
+{
+	ASTRA_ASSERT(m_bIsInitialized);
+
+	CData2D *pIn = const_cast<CData2D*>(_pIn);
+	CFloat32VolumeData2D *pVolume;
+	CFloat32ProjectionData2D *pProjection;
+	if (m_eOperation == OPERATION_FP) {
+		pVolume = dynamic_cast<CFloat32VolumeData2D*>(pIn);
+		pProjection = dynamic_cast<CFloat32ProjectionData2D*>(_pOut);
+	} else {
+		pVolume = dynamic_cast<CFloat32VolumeData2D*>(_pOut);
+		pProjection = dynamic_cast<CFloat32ProjectionData2D*>(pIn);
+	}
+
+	if (!pVolume || !pProjection) {
+		ASTRA_ERROR("CProjectionOperator2D: wrong data types");
+		return false;
+	}
+	if (pVolume->getShape() != m_pVolume->getShape() || pProjection->getShape() != m_pProjection->getShape()) {
+		ASTRA_ERROR("CProjectionOperator2D: data dimensions do not match the projector");
+		return false;
+	}
+
+	std::unique_ptr<CAlgorithm> pAlg(createAlgorithm(pVolume, pProjection));
+	if (!pAlg)
+		return false;
+
+	return pAlg->run(1);
+}
+
+//----------------------------------------------------------------------------------------
+// 3D
+
+CProjectionOperator3D::CProjectionOperator3D(CProjector3D *_pProjector, EProjectionOperation _eOperation)
+	: m_pProjector(_pProjector), m_eOperation(_eOperation), m_bIsInitialized(false),
+	  m_pVolumeStorage(nullptr), m_pProjectionStorage(nullptr)
+{
+#ifdef ASTRA_CUDA
+	if (!m_pProjector || !m_pProjector->isInitialized()) {
+		ASTRA_ERROR("CProjectionOperator3D: projector not initialized");
+		return;
+	}
+
+	m_pVolumeStorage = new CDataMemoryView<float32>();
+	m_pProjectionStorage = new CDataMemoryView<float32>();
+	m_pVolume = std::make_unique<CFloat32VolumeData3D>(m_pProjector->getVolumeGeometry(), m_pVolumeStorage);
+	m_pProjection = std::make_unique<CFloat32ProjectionData3D>(m_pProjector->getProjectionGeometry(), m_pProjectionStorage);
+
+	m_bIsInitialized = true;
+#else
+	ASTRA_ERROR("CProjectionOperator3D: CUDA support is not enabled");
+#endif
+}
+
+CProjectionOperator3D::~CProjectionOperator3D()
+{
+
+}
+
+size_t CProjectionOperator3D::getInputSize() const
+{
+	if (!m_bIsInitialized)
+		return 0;
+	return (m_eOperation == OPERATION_FP) ? m_pVolume->getSize() : m_pProjection->getSize();
+}
+
+size_t CProjectionOperator3D::getOutputSize() const
+{
+	if (!m_bIsInitialized)
+		return 0;
+	return (m_eOperation == OPERATION_FP) ? m_pProjection->getSize() : m_pVolume->getSize();
+}
+
+bool CProjectionOperator3D::apply(const float32 *_pfIn, float32 *_pfOut)
+{
+	ASTRA_ASSERT(m_bIsInitialized);
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	float32 *pfIn = const_cast<float32*>(_pfIn);
+	if (m_eOperation == OPERATION_FP) {
+		m_pVolumeStorage->setData(pfIn);
+		m_pProjectionStorage->setData(_pfOut);
+	} else {
+		m_pProjectionStorage->setData(pfIn);
+		m_pVolumeStorage->setData(_pfOut);
+	}
+
+	bool ok = apply(m_pVolume.get(), m_pProjection.get());
+
+	m_pVolumeStorage->setData(nullptr);
+	m_pProjectionStorage->setData(nullptr);
+
+	return ok;
+}
+
+bool CProjectionOperator3D::apply(const CData3D *_pIn, CData3D *_pOut)
+{
+	ASTRA_ASSERT(m_bIsInitialized);
+
+#ifdef ASTRA_CUDA
+	CData3D *pIn = const_cast<CData3D*>(_pIn);
+	CFloat32VolumeData3D *pVolume;
+	CFloat32ProjectionData3D *pProjection;
+	if (m_eOperation == OPERATION_FP) {
+		pVolume = dynamic_cast<CFloat32VolumeData3D*>(pIn);
+		pProjection = dynamic_cast<CFloat32ProjectionData3D*>(_pOut);
+	} else {
+		pVolume = dynamic_cast<CFloat32VolumeData3D*>(_pOut);
+		pProjection = dynamic_cast<CFloat32ProjectionData3D*>(pIn);
+	}
+
+	if (!pVolume || !pProjection) {
+		ASTRA_ERROR("CProjectionOperator3D: wrong data types");
+		return false;
+	}
+	if (pVolume->getShape() != m_pVolume->getShape() || pProjection->getShape() != m_pProjection->getShape()) {
+		ASTRA_ERROR("CProjectionOperator3D: data dimensions do not match the projector");
+		return false;
+	}
+
+	CCompositeGeometryManager m;
+	if (m_eOperation == OPERATION_FP)
+		return m.doFP(m_pProjector, pVolume, pProjection);
+	else
+		return m.doBP(m_pProjector, pVolume, pProjection);
+#else
+	return false;
+#endif
+}
+
+}
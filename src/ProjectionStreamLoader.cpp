@@ -0,0 +1,595 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+#include "astra/ProjectionStreamLoader.h"
+
+#include "astra/Logging.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+namespace astra {
+
+namespace {
+
+size_t sampleSize(CProjectionStreamLoader::ESampleType _eType)
+{
+	return (_eType == CProjectionStreamLoader::SAMPLE_UINT16) ? 2 : 4;
+}
+
+bool isBigEndian()
+{
+	uint16_t x = 1;
+	char c;
+	memcpy(&c, &x, 1);
+	return c == 0;
+}
+
+void swapBytes(char *_pData, size_t _iCount, size_t _iSize)
+{
+	for (size_t i = 0; i < _iCount; ++i)
+		std::reverse(_pData + i * _iSize, _pData + (i + 1) * _iSize);
+}
+
+/**
+ * Minimal reader for uncompressed, single-channel classic TIFF files.
+ */
+class CTiffFile {
+public:
+	struct SPage {
+		int iWidth;
+		int iHeight;
+		CProjectionStreamLoader::ESampleType eType;
+		std::vector<uint32_t> stripOffsets;
+		std::vector<uint32_t> stripByteCounts;
+	};
+
+	bool open(const std::string &_sFile, std::string &_sError)
+	{
+		m_file.open(_sFile, std::ios::binary);
+		if (!m_file) {
+			_sError = "Failed to open " + _sFile;
+			return false;
+		}
+		char header[4];
+		if (!m_file.read(header, 4)) {
+			_sError = "Failed to read TIFF header of " + _sFile;
+			return false;
+		}
+		if (header[0] == 'I' && header[1] == 'I')
+			m_bSwap = isBigEndian();
+		else if (header[0] == 'M' && header[1] == 'M')
+			m_bSwap = !isBigEndian();
+		else {
+			_sError = _sFile + " is not a TIFF file";
+			return false;
+		}
+		uint16_t iMagic = get16(header + 2);
+		uint32_t iFirstIFD;
+		if (iMagic != 42 || !read32(iFirstIFD)) {
+			_sError = _sFile + " is not a classic TIFF file";
+			return false;
+		}
+		m_iFirstIFD = iFirstIFD;
+		m_sName = _sFile;
+		return true;
+	}
+
+	/** Offsets of the first _iCount pages */
+	bool getPageOffsets(int _iCount, std::vector<uint32_t> &_offsets, std::string &_sError)
+	{
+		_offsets.clear();
+		uint32_t iOffset = m_iFirstIFD;
+		while ((int)_offsets.size() < _iCount) {
+			uint16_t iEntries;
+			if (iOffset == 0 || !m_file.seekg(iOffset) || !read16(iEntries)) {
+				_sError = m_sName + " has fewer pages than expected";
+				return false;
+			}
+			_offsets.push_back(iOffset);
+			m_file.seekg(iOffset + 2 + 12 * (uint32_t)iEntries);
+			if (!read32(iOffset)) {
+				_sError = "Failed to read " + m_sName;
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool readPageInfo(uint32_t _iOffset, SPage &_page, std::string &_sError)
+	{
+		uint16_t iEntries;
+		if (!m_file.seekg(_iOffset) || !read16(iEntries)) {
+			_sError = "Failed to read " + m_sName;
+			return false;
+		}
+		std::vector<char> entries(12 * (size_t)iEntries);
+		if (!m_file.read(entries.data(), entries.size())) {
+			_sError = "Failed to read " + m_sName;
+			return false;
+		}
+
+		_page.iWidth = _page.iHeight = 0;
+		int iBits = 0, iSampleFormat = 1, iCompression = 1, iSamples = 1;
+		bool bTiled = false;
+		for (uint16_t e = 0; e < iEntries; ++e) {
+			const char *entry = &entries[12 * e];
+			uint16_t iTag = get16(entry);
+			std::vector<uint32_t> values;
+			if (!readValues(entry, values)) {
+				_sError = "Failed to read " + m_sName;
+				return false;
+			}
+			if (values.empty())
+				continue;
+			switch (iTag) {
+			case 256: _page.iWidth = values[0]; break;
+			case 257: _page.iHeight = values[0]; break;
+			case 258: iBits = values[0]; break;
+			case 259: iCompression = values[0]; break;
+			case 273: _page.stripOffsets = values; break;
+			case 277: iSamples = values[0]; break;
+			case 279: _page.stripByteCounts = values; break;
+			case 322: bTiled = true; break;
+			case 339: iSampleFormat = values[0]; break;
+			}
+		}
+
+		if (iCompression != 1 || bTiled || iSamples != 1) {
+			_sError = m_sName + ": only uncompressed, untiled, single channel TIFF files are supported";
+			return false;
+		}
+		if (iBits == 16 && iSampleFormat == 1)
+			_page.eType = CProjectionStreamLoader::SAMPLE_UINT16;
+		else if (iBits == 32 && iSampleFormat == 1)
+			_page.eType = CProjectionStreamLoader::SAMPLE_UINT32;
+		else if (iBits == 32 && iSampleFormat == 3)
+			_page.eType = CProjectionStreamLoader::SAMPLE_FLOAT32;
+		else {
+			_sError = m_sName + ": only 16/32 bit unsigned integer and 32 bit float TIFF files are supported";
+			return false;
+		}
+		if (_page.stripOffsets.empty() || _page.stripOffsets.size() != _page.stripByteCounts.size()) {
+			_sError = m_sName + ": invalid strip layout";
+			return false;
+		}
+		return true;
+	}
+
+	bool readPixels(const SPage &_page, char *_pDst, std::string &_sError)
+	{
+		size_t iSample = sampleSize(_page.eType);
+		size_t iTotal = (size_t)_page.iWidth * _page.iHeight * iSample;
+		size_t iDone = 0;
+		for (size_t s = 0; s < _page.stripOffsets.size() && iDone < iTotal; ++s) {
+			size_t n = std::min<size_t>(_page.stripByteCounts[s], iTotal - iDone);
+			if (!m_file.seekg(_page.stripOffsets[s]) || !m_file.read(_pDst + iDone, n)) {
+				_sError = "Failed to read image data of " + m_sName;
+				return false;
+			}
+			iDone += n;
+		}
+		if (iDone != iTotal) {
+			_sError = m_sName + ": image data too short";
+			return false;
+		}
+		if (m_bSwap)
+			swapBytes(_pDst, iTotal / iSample, iSample);
+		return true;
+	}
+
+private:
+	uint16_t get16(const char *_p) const
+	{
+		char b[2] = { _p[0], _p[1] };
+		if (m_bSwap)
+			std::swap(b[0], b[1]);
+		uint16_t v;
+		memcpy(&v, b, 2);
+		return v;
+	}
+
+	uint32_t get32(const char *_p) const
+	{
+		char b[4] = { _p[0], _p[1], _p[2], _p[3] };
+		if (m_bSwap)
+			std::reverse(b, b + 4);
+		uint32_t v;
+		memcpy(&v, b, 4);
+		return v;
+	}
+
+	bool read16(uint16_t &_v)
+	{
+		char b[2];
+		if (!m_file.read(b, 2))
+			return false;
+		_v = get16(b);
+		return true;
+	}
+
+	bool read32(uint32_t &_v)
+	{
+		char b[4];
+		if (!m_file.read(b, 4))
+			return false;
+		_v = get32(b);
+		return true;
+	}
+
+	/** Values of a SHORT or LONG tag entry */
+	bool readValues(const char *_pEntry, std::vector<uint32_t> &_values)
+	{
+		uint16_t iType = get16(_pEntry + 2);
+		uint32_t iCount = get32(_pEntry + 4);
+		size_t iSize;
+		if (iType == 3)
+			iSize = 2;
+		else if (iType == 4)
+			iSize = 4;
+		else
+			return true; // not a tag we use
+
+		std::vector<char> raw(iSize * iCount);
+		if (raw.size() <= 4) {
+			memcpy(raw.data(), _pEntry + 8, raw.size());
+		} else {
+			if (!m_file.seekg(get32(_pEntry + 8)) || !m_file.read(raw.data(), raw.size()))
+				return false;
+		}
+		_values.resize(iCount);
+		for (uint32_t i = 0; i < iCount; ++i)
+			_values[i] = (iSize == 2) ? get16(&raw[2 * i]) : get32(&raw[4 * i]);
+		return true;
+	}
+
+	std::ifstream m_file;
+	std::string m_sName;
+	bool m_bSwap = false;
+	uint32_t m_iFirstIFD = 0;
+};
+
+}
+
+//----------------------------------------------------------------------------------------
+CProjectionStreamLoader::CProjectionStreamLoader()
+	: m_eFormat(FORMAT_RAW), m_eType(SAMPLE_UINT16), m_iHeaderBytes(0),
+	  m_bCorrect(false), m_iBlockSize(16), m_iThreads(2),
+	  m_pCallback(nullptr), m_pCallbackContext(nullptr),
+	  m_pData(nullptr), m_iAngles(0), m_iRows(0), m_iCols(0), m_iProjectionsPerFile(0),
+	  m_iNextBlock(0), m_bAbort(false), m_iRunning(0)
+{
+
+}
+
+CProjectionStreamLoader::~CProjectionStreamLoader()
+{
+	abort();
+	joinThreads();
+}
+
+void CProjectionStreamLoader::setFiles(const std::vector<std::string> &_files, EFormat _eFormat)
+{
+	m_files = _files;
+	m_eFormat = _eFormat;
+}
+
+void CProjectionStreamLoader::setRawLayout(ESampleType _eType, size_t _iHeaderBytes)
+{
+	m_eType = _eType;
+	m_iHeaderBytes = _iHeaderBytes;
+}
+
+bool CProjectionStreamLoader::setBlockSize(int _iBlockSize)
+{
+	// The block layout is used by the loader threads and by waitForAngles()
+	if (!m_threads.empty()) {
+		ASTRA_ERROR("CProjectionStreamLoader: the block size can not be changed after start()");
+		return false;
+	}
+	m_iBlockSize = _iBlockSize;
+	return true;
+}
+
+void CProjectionStreamLoader::setCorrection(const std::vector<float32> &_flat, const std::vector<float32> &_dark, const SRawIngestOptions &_options)
+{
+	m_bCorrect = true;
+	m_flat = _flat;
+	m_dark = _dark;
+	m_options = _options;
+}
+
+//----------------------------------------------------------------------------------------
+bool CProjectionStreamLoader::start(CFloat32ProjectionData3D *_pData)
+{
+	joinThreads();
+
+	ASTRA_ASSERT(_pData);
+	if (!_pData->isFloat32Memory()) {
+		ASTRA_ERROR("CProjectionStreamLoader: data is not float32 host memory");
+		return false;
+	}
+	if (_pData->isReadOnly()) {
+		ASTRA_ERROR("CProjectionStreamLoader: data is read-only");
+		return false;
+	}
+	m_pData = _pData;
+	m_iAngles = _pData->getAngleCount();
+	m_iRows = _pData->getDetectorRowCount();
+	m_iCols = _pData->getDetectorColCount();
+
+	if (m_files.empty() || m_iAngles % m_files.size() != 0) {
+		ASTRA_ERROR("CProjectionStreamLoader: the number of projections (%d) is not a multiple of the number of files (%zu)", m_iAngles, m_files.size());
+		return false;
+	}
+	m_iProjectionsPerFile = m_iAngles / m_files.size();
+
+	size_t iPixels = (size_t)m_iRows * m_iCols;
+	if ((!m_flat.empty() && m_flat.size() != iPixels) || (!m_dark.empty() && m_dark.size() != iPixels)) {
+		ASTRA_ERROR("CProjectionStreamLoader: flat/dark field size does not match the detector");
+		return false;
+	}
+
+	// Check the first file, and get the sample type of TIFF files.
+	// The page offsets of all TIFF files are read here once, since finding
+	// a page means walking the chain of pages from the start of the file.
+	std::string sError;
+	m_pageOffsets.clear();
+	if (m_eFormat == FORMAT_TIFF) {
+		m_pageOffsets.resize(m_files.size());
+		for (size_t i = 0; i < m_files.size(); ++i) {
+			CTiffFile tiff;
+			if (!tiff.open(m_files[i], sError) || !tiff.getPageOffsets(m_iProjectionsPerFile, m_pageOffsets[i], sError)) {
+				ASTRA_ERROR("CProjectionStreamLoader: %s", sError.c_str());
+				return false;
+			}
+		}
+		CTiffFile tiff;
+		CTiffFile::SPage page;
+		if (!tiff.open(m_files[0], sError) || !tiff.readPageInfo(m_pageOffsets[0][0], page, sError)) {
+			ASTRA_ERROR("CProjectionStreamLoader: %s", sError.c_str());
+			return false;
+		}
+		if (page.iWidth != m_iCols || page.iHeight != m_iRows) {
+			ASTRA_ERROR("CProjectionStreamLoader: image size %dx%d of %s does not match the detector size %dx%d", page.iWidth, page.iHeight, m_files[0].c_str(), m_iCols, m_iRows);
+			return false;
+		}
+		m_eType = page.eType;
+	} else {
+		std::ifstream f(m_files[0], std::ios::binary | std::ios::ate);
+		size_t iNeeded = m_iHeaderBytes + iPixels * sampleSize(m_eType) * m_iProjectionsPerFile;
+		if (!f || (size_t)f.tellg() < iNeeded) {
+			ASTRA_ERROR("CProjectionStreamLoader: %s is missing or too small", m_files[0].c_str());
+			return false;
+		}
+	}
+
+	int iBlockSize = std::max(m_iBlockSize, 1);
+	int iBlocks = (m_iAngles + iBlockSize - 1) / iBlockSize;
+	m_blockState.assign(iBlocks, BLOCK_PENDING);
+	m_sError.clear();
+	m_iNextBlock = 0;
+	m_bAbort = false;
+
+	int iThreads = std::min(std::max(m_iThreads, 1), std::max(iBlocks, 1));
+	m_iRunning = iThreads;
+	for (int i = 0; i < iThreads; ++i)
+		m_threads.emplace_back(&CProjectionStreamLoader::workerMain, this);
+
+	return true;
+}
+
+void CProjectionStreamLoader::joinThreads()
+{
+	for (std::thread &t : m_threads)
+		t.join();
+	m_threads.clear();
+}
+
+//----------------------------------------------------------------------------------------
+void CProjectionStreamLoader::workerMain()
+{
+	std::vector<char> buffer;
+	int iBlocks = m_blockState.size();
+	while (!m_bAbort) {
+		int iBlock = m_iNextBlock++;
+		if (iBlock >= iBlocks)
+			break;
+		bool ok = loadBlock(iBlock, buffer);
+		if (!ok)
+			m_bAbort = true;
+		finishBlock(iBlock, ok);
+	}
+
+	// The last thread to finish fails the blocks that were never loaded
+	std::vector<int> failed;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (--m_iRunning > 0)
+			return;
+		for (int b = 0; b < iBlocks; ++b)
+			if (m_blockState[b] == BLOCK_PENDING)
+				failed.push_back(b);
+	}
+	for (int b : failed)
+		finishBlock(b, false);
+}
+
+bool CProjectionStreamLoader::loadBlock(int _iBlock, std::vector<char> &_buffer)
+{
+	int iBlockSize = std::max(m_iBlockSize, 1);
+	int iFirst = _iBlock * iBlockSize;
+	int iCount = std::min(iBlockSize, m_iAngles - iFirst);
+	size_t iProjBytes = (size_t)m_iRows * m_iCols * sampleSize(m_eType);
+
+	_buffer.resize(iProjBytes * iCount);
+	for (int a = 0; a < iCount; ++a) {
+		if (m_bAbort)
+			return false;
+		if (!readProjection(iFirst + a, _buffer.data() + a * iProjBytes))
+			return false;
+	}
+
+	SRawIngestOptions options;
+	options.bLog = false;
+	const float32 *pfFlat = nullptr, *pfDark = nullptr;
+	if (m_bCorrect) {
+		options = m_options;
+		pfFlat = m_flat.empty() ? nullptr : m_flat.data();
+		pfDark = m_dark.empty() ? nullptr : m_dark.data();
+	}
+
+	bool ok = false;
+	switch (m_eType) {
+	case SAMPLE_UINT16:
+		ok = ingestRawProjections((const uint16_t*)_buffer.data(), iFirst, iCount, pfFlat, pfDark, m_pData, options);
+		break;
+	case SAMPLE_UINT32:
+		ok = ingestRawProjections((const uint32_t*)_buffer.data(), iFirst, iCount, pfFlat, pfDark, m_pData, options);
+		break;
+	case SAMPLE_FLOAT32:
+		ok = ingestRawProjections((const float32*)_buffer.data(), iFirst, iCount, pfFlat, pfDark, m_pData, options);
+		break;
+	}
+	if (!ok)
+		setError("Failed to store projections " + std::to_string(iFirst) + " to " + std::to_string(iFirst + iCount - 1) + " in the data object");
+	return ok;
+}
+
+bool CProjectionStreamLoader::readProjection(int _iAngle, char *_pDst)
+{
+	int iFile = _iAngle / m_iProjectionsPerFile;
+	const std::string &sFile = m_files[iFile];
+	int iIndex = _iAngle % m_iProjectionsPerFile;
+	size_t iProjBytes = (size_t)m_iRows * m_iCols * sampleSize(m_eType);
+	std::string sError;
+
+	if (m_eFormat == FORMAT_RAW) {
+		std::ifstream f(sFile, std::ios::binary);
+		if (!f || !f.seekg(m_iHeaderBytes + iIndex * iProjBytes) || !f.read(_pDst, iProjBytes)) {
+			setError("Failed to read projection " + std::to_string(_iAngle) + " from " + sFile);
+			return false;
+		}
+		// raw files are little endian
+		if (isBigEndian())
+			swapBytes(_pDst, iProjBytes / sampleSize(m_eType), sampleSize(m_eType));
+		return true;
+	}
+
+	CTiffFile tiff;
+	CTiffFile::SPage page;
+	if (!tiff.open(sFile, sError) || !tiff.readPageInfo(m_pageOffsets[iFile][iIndex], page, sError)) {
+		setError(sError);
+		return false;
+	}
+	if (page.iWidth != m_iCols || page.iHeight != m_iRows || page.eType != m_eType) {
+		setError(sFile + ": image size or sample type differs from the first projection");
+		return false;
+	}
+	if (!tiff.readPixels(page, _pDst, sError)) {
+		setError(sError);
+		return false;
+	}
+	return true;
+}
+
+void CProjectionStreamLoader::setError(const std::string &_sError)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (m_sError.empty())
+		m_sError = _sError;
+}
+
+void CProjectionStreamLoader::finishBlock(int _iBlock, bool _bSuccess)
+{
+	// Report the block before marking it, so that the callback is done
+	// when waitForAngles() returns
+	if (m_pCallback) {
+		int iBlockSize = std::max(m_iBlockSize, 1);
+		int iFirst = _iBlock * iBlockSize;
+		m_pCallback(m_pCallbackContext, iFirst, std::min(iBlockSize, m_iAngles - iFirst), _bSuccess);
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_blockState[_iBlock] = _bSuccess ? BLOCK_READY : BLOCK_FAILED;
+	}
+	m_blockDone.notify_all();
+}
+
+//----------------------------------------------------------------------------------------
+bool CProjectionStreamLoader::waitForAngles(int _iFirstAngle, int _iAngleCount)
+{
+	if (_iAngleCount <= 0)
+		return true;
+	if (_iFirstAngle < 0 || _iFirstAngle + _iAngleCount > m_iAngles)
+		return false;
+
+	int iBlockSize = std::max(m_iBlockSize, 1);
+	int iFirstBlock = _iFirstAngle / iBlockSize;
+	int iEndBlock = (_iFirstAngle + _iAngleCount - 1) / iBlockSize + 1;
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_blockDone.wait(lock, [&]() {
+		for (int b = iFirstBlock; b < iEndBlock; ++b)
+			if (m_blockState[b] == BLOCK_PENDING)
+				return false;
+		return true;
+	});
+	for (int b = iFirstBlock; b < iEndBlock; ++b)
+		if (m_blockState[b] != BLOCK_READY)
+			return false;
+	return true;
+}
+
+bool CProjectionStreamLoader::isAngleReady(int _iAngle) const
+{
+	if (_iAngle < 0 || _iAngle >= m_iAngles)
+		return false;
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_blockState[_iAngle / std::max(m_iBlockSize, 1)] == BLOCK_READY;
+}
+
+bool CProjectionStreamLoader::wait()
+{
+	return waitForAngles(0, m_iAngles);
+}
+
+void CProjectionStreamLoader::abort()
+{
+	m_bAbort = true;
+}
+
+std::string CProjectionStreamLoader::getError() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_sError;
+}
+
+} // end namespace astra
@@ -31,6 +31,7 @@ along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
 #include "astra/SparseMatrix.h"
 
 #include "astra/Logging.h"
+#include "astra/Profiler.h"
 
 namespace astra
 {
@@ -133,6 +134,8 @@ void CProjector2D::computeProjectionRayWeights(int _iProjection, SPixelWeight* _
 // explicit projection matrix
 CSparseMatrix* CProjector2D::getMatrix()
 {
+	ASTRA_PROFILE_SCOPE(profile, "project/getMatrix");
+
 	unsigned int iProjectionCount = m_pProjectionGeometry->getProjectionAngleCount();
 	unsigned int iDetectorCount = m_pProjectionGeometry->getDetectorCount();
 	unsigned int iRayCount = iProjectionCount * iDetectorCount;
@@ -169,6 +172,9 @@ CSparseMatrix* CProjector2D::getMatrix()
 
 	}
 	pMatrix->m_plRowStarts[iRayCount] = lMatrixIndex;
+
+	profile.addRays(iRayCount);
+	profile.addNonZeros(lMatrixIndex);
 	
 	delete[] pEntries;
 	return pMatrix;
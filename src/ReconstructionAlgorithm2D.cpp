@@ -28,12 +28,18 @@ along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
 #include "astra/ReconstructionAlgorithm2D.h"
 
 #include "astra/AstraObjectManager.h"
+#include "astra/DataProjector.h"
+#include "astra/DataProjectorPolicies.h"
+#include "astra/DataExpression.h"
+#include "astra/MaskIndex.h"
 #include "astra/Logging.h"
 
 using namespace std;
 
 namespace astra {
 
+#include "astra/Projector2DImpl.inl"
+
 //----------------------------------------------------------------------------------------
 // Constructor
 CReconstructionAlgorithm2D::CReconstructionAlgorithm2D() 
@@ -47,7 +53,9 @@ CReconstructionAlgorithm2D::CReconstructionAlgorithm2D()
 	  m_pReconstructionMask(nullptr),
 	  m_bUseReconstructionMask(false),
 	  m_pSinogramMask(nullptr),
-	  m_bUseSinogramMask(false)
+	  m_bUseSinogramMask(false),
+	  m_bUseVolumeWindow(false),
+	  m_pExteriorProjection(nullptr)
 {
 
 }
@@ -79,11 +87,7 @@ bool CReconstructionAlgorithm2D::initialize(const Config& _cfg)
 		}
 	}
 
-	ok &= CR.getRequiredID("ProjectionDataId", id);
-	m_pSinogram = dynamic_cast<CFloat32ProjectionData2D*>(CData2DManager::getSingleton().get(id));
-
-	ok &= CR.getRequiredID("ReconstructionDataId", id);
-	m_pReconstruction = dynamic_cast<CFloat32VolumeData2D*>(CData2DManager::getSingleton().get(id));
+	ok &= readDataIds(CR);
 
 	if (requiresProjector()) {
 		ASTRA_CONFIG_CHECK(m_pProjector, "Reconstruction2D", "No projector specified.");
@@ -101,6 +105,25 @@ bool CReconstructionAlgorithm2D::initialize(const Config& _cfg)
 		m_pSinogramMask = dynamic_cast<CFloat32ProjectionData2D*>(CData2DManager::getSingleton().get(id));
 	}
 
+	// volume window
+	if (CR.hasOption("VolumeWindow")) {
+		vector<int> window;
+		ok &= CR.getOptionIntArray("VolumeWindow", window);
+		if (window.size() != 4) {
+			ASTRA_ERROR("VolumeWindow must be of the form [RowFrom, RowTo, ColFrom, ColTo]");
+			return false;
+		}
+		m_bUseVolumeWindow = true;
+		m_volumeWindow.iRowFrom = window[0];
+		m_volumeWindow.iRowTo = window[1];
+		m_volumeWindow.iColFrom = window[2];
+		m_volumeWindow.iColTo = window[3];
+	}
+	if (CR.getOptionID("ExteriorProjectionDataId", id)) {
+		m_pExteriorProjection = dynamic_cast<CFloat32ProjectionData2D*>(CData2DManager::getSingleton().get(id));
+		ASTRA_CONFIG_CHECK(m_pExteriorProjection, "Reconstruction2D", "ExteriorProjectionDataId is not a valid projection data id.");
+	}
+
 	// Constraints - NEW
 	if (CR.hasOption("MinConstraint")) {
 		m_bUseMinConstraint = true;
@@ -131,6 +154,46 @@ bool CReconstructionAlgorithm2D::initialize(const Config& _cfg)
 	return _check();
 }
 
+//---------------------------------------------------------------------------------------
+// Initialize - Config, with data objects
+bool CReconstructionAlgorithm2D::initialize(const Config& _cfg,
+                                            CFloat32ProjectionData2D* _pSinogram,
+                                            CFloat32VolumeData2D* _pReconstruction)
+{
+	assert(!m_bIsInitialized);
+	ASTRA_ASSERT(_pSinogram && _pReconstruction);
+
+	m_pSinogram = _pSinogram;
+	m_pReconstruction = _pReconstruction;
+
+	// virtual, so the options of the derived algorithm are read as well
+	return initialize(_cfg);
+}
+
+//---------------------------------------------------------------------------------------
+// Read Data Ids
+bool CReconstructionAlgorithm2D::readDataIds(ConfigReader<CAlgorithm>& CR)
+{
+	int id = -1;
+
+	// data objects bound by initialize(_cfg, _pSinogram, _pReconstruction)
+	if (m_pSinogram && m_pReconstruction) {
+		CR.getOptionID("ProjectionDataId", id);
+		CR.getOptionID("ReconstructionDataId", id);
+		return true;
+	}
+
+	bool ok = true;
+
+	ok &= CR.getRequiredID("ProjectionDataId", id);
+	m_pSinogram = dynamic_cast<CFloat32ProjectionData2D*>(CData2DManager::getSingleton().get(id));
+
+	ok &= CR.getRequiredID("ReconstructionDataId", id);
+	m_pReconstruction = dynamic_cast<CFloat32VolumeData2D*>(CData2DManager::getSingleton().get(id));
+
+	return ok;
+}
+
 //----------------------------------------------------------------------------------------
 // Initialize - C++
 bool CReconstructionAlgorithm2D::initialize(CProjector2D* _pProjector, 
@@ -167,6 +230,8 @@ void CReconstructionAlgorithm2D::setReconstructionMask(CFloat32VolumeData2D* _pM
 	if (m_pReconstructionMask == NULL) {
 		m_bUseReconstructionMask = false;
 	}
+	m_pWindowMask.reset();
+	m_pMaskIndex.reset();
 }
 
 //----------------------------------------------------------------------------------------
@@ -179,7 +244,131 @@ void CReconstructionAlgorithm2D::setSinogramMask(CFloat32ProjectionData2D* _pMas
 	if (m_pSinogramMask == NULL) {
 		m_bUseSinogramMask = false;
 	}
-}//----------------------------------------------------------------------------------------
+	m_pMaskIndex.reset();
+}
+
+//----------------------------------------------------------------------------------------
+// Set Volume Window
+void CReconstructionAlgorithm2D::setVolumeWindow(const SVolumeWindow& _window, CFloat32ProjectionData2D* _pExteriorProjection)
+{
+	m_bUseVolumeWindow = true;
+	m_volumeWindow = _window;
+	m_pExteriorProjection = _pExteriorProjection;
+	m_pWindowMask.reset();
+	m_pExteriorSinogram.reset();
+	m_pWindowSinogram.reset();
+	m_pMaskIndex.reset();
+}
+
+//----------------------------------------------------------------------------------------
+// Reset
+void CReconstructionAlgorithm2D::reset()
+{
+	// the projection of the exterior is derived from the reconstruction data
+	m_pExteriorSinogram.reset();
+}
+
+//----------------------------------------------------------------------------------------
+// Get Mask Index
+const CMaskIndex* CReconstructionAlgorithm2D::getMaskIndex()
+{
+	// the index of the window mask lives as long as the mask itself
+	if (m_bUseVolumeWindow && m_pMaskIndex)
+		return m_pMaskIndex.get();
+
+	CFloat32VolumeData2D *pReconstructionMask = getEffectiveReconstructionMask();
+	if (!m_bUseSinogramMask && !pReconstructionMask) {
+		m_pMaskIndex.reset();
+		return nullptr;
+	}
+
+	m_pMaskIndex = std::make_unique<CMaskIndex>(m_pProjector->getProjectionGeometry(),
+	                                            m_pProjector->getVolumeGeometry(),
+	                                            m_bUseSinogramMask ? m_pSinogramMask : nullptr,
+	                                            pReconstructionMask);
+	return m_pMaskIndex.get();
+}
+
+//----------------------------------------------------------------------------------------
+// Prepare Volume Window
+void CReconstructionAlgorithm2D::prepareVolumeWindow(bool _bSubtractExterior)
+{
+	using namespace expr;
+
+	if (!m_bUseVolumeWindow)
+		return;
+
+	const CVolumeGeometry2D &volGeom = m_pReconstruction->getGeometry();
+	if (!m_pWindowMask) {
+		m_pWindowMask.reset(createWindowMask(volGeom, m_volumeWindow, m_bUseReconstructionMask ? m_pReconstructionMask : nullptr));
+		m_pMaskIndex.reset();
+	}
+
+	if (!_bSubtractExterior)
+		return;
+
+	if (!m_pExteriorProjection && !m_pExteriorSinogram) {
+		// forward project the reconstruction with the window cleared
+		std::unique_ptr<CFloat32VolumeData2D> pExterior(createCFloat32VolumeData2DPooled(volGeom));
+		pExterior->copyData(*m_pReconstruction);
+		float32 *pfExterior = pExterior->getFloat32Memory();
+		for (int iRow = m_volumeWindow.iRowFrom; iRow < m_volumeWindow.iRowTo; ++iRow)
+			for (int iCol = m_volumeWindow.iColFrom; iCol < m_volumeWindow.iColTo; ++iCol)
+				pfExterior[volGeom.pixelRowColToIndex(iRow, iCol)] = 0.0f;
+
+		// masked out pixels are not projected, as without a window
+		if (m_bUseReconstructionMask) {
+			const float32 *pfMask = m_pReconstructionMask->getFloat32Memory();
+			for (size_t i = 0; i < pExterior->getSize(); ++i)
+				if (pfMask[i] == 0.0f)
+					pfExterior[i] = 0.0f;
+		}
+
+		m_pExteriorSinogram.reset(createCFloat32ProjectionData2DPooled(m_pSinogram->getGeometry()));
+		std::unique_ptr<CDataProjectorInterface> pForwardProjector(dispatchDataProjector(m_pProjector,
+				DefaultFPPolicy(pExterior.get(), m_pExteriorSinogram.get())));
+		pForwardProjector->project();
+	}
+
+	// the window has to explain what the exterior does not
+	if (!m_pWindowSinogram)
+		m_pWindowSinogram.reset(createCFloat32ProjectionData2DPooled(m_pSinogram->getGeometry()));
+	const CFloat32ProjectionData2D *pExteriorSinogram = m_pExteriorProjection ? m_pExteriorProjection : m_pExteriorSinogram.get();
+	assign(*m_pWindowSinogram, lazy(*m_pSinogram) - lazy(*pExteriorSinogram));
+}
+
+//----------------------------------------------------------------------------------------
+// Effective Reconstruction Mask
+CFloat32VolumeData2D* CReconstructionAlgorithm2D::getEffectiveReconstructionMask() const
+{
+	if (m_bUseVolumeWindow)
+		return m_pWindowMask.get();
+	return m_bUseReconstructionMask ? m_pReconstructionMask : nullptr;
+}
+
+//----------------------------------------------------------------------------------------
+// Effective Sinogram
+CFloat32ProjectionData2D* CReconstructionAlgorithm2D::getEffectiveSinogram() const
+{
+	if (m_bUseVolumeWindow)
+		return m_pWindowSinogram.get();
+	return m_pSinogram;
+}
+
+//----------------------------------------------------------------------------------------
+// Update Window
+SVolumeWindow CReconstructionAlgorithm2D::getUpdateWindow() const
+{
+	if (m_bUseVolumeWindow)
+		return m_volumeWindow;
+
+	SVolumeWindow window;
+	window.iRowTo = m_pReconstruction->getGeometry().getGridRowCount();
+	window.iColTo = m_pReconstruction->getGeometry().getGridColCount();
+	return window;
+}
+
+//----------------------------------------------------------------------------------------
 // Check
 bool CReconstructionAlgorithm2D::_check() 
 {
@@ -201,6 +390,18 @@ bool CReconstructionAlgorithm2D::_check()
 		ASTRA_CONFIG_CHECK(m_pReconstruction->getGeometry().isEqual(m_pProjector->getVolumeGeometry()), "Reconstruction2D", "Reconstruction Data not compatible with the specified Projector.");
 	}
 
+	// check the volume window
+	if (m_bUseVolumeWindow) {
+		ASTRA_CONFIG_CHECK(supportsVolumeWindow(), "Reconstruction2D", "This algorithm does not support VolumeWindow.");
+		ASTRA_CONFIG_CHECK(m_volumeWindow.isValid(m_pReconstruction->getGeometry()), "Reconstruction2D", "VolumeWindow is empty or not inside the volume.");
+		ASTRA_CONFIG_CHECK(!m_bUseReconstructionMask || m_pReconstructionMask->isFloat32Memory(), "Reconstruction2D", "Reconstruction mask object not a float32 host memory object");
+	}
+	if (m_pExteriorProjection) {
+		ASTRA_CONFIG_CHECK(m_bUseVolumeWindow, "Reconstruction2D", "ExteriorProjectionDataId requires VolumeWindow.");
+		ASTRA_CONFIG_CHECK(m_pExteriorProjection->isFloat32Memory(), "Reconstruction2D", "Exterior projection data object not a float32 host memory object");
+		ASTRA_CONFIG_CHECK(m_pExteriorProjection->getGeometry().isEqual(m_pSinogram->getGeometry()), "Reconstruction2D", "Exterior projection data not compatible with the projection data.");
+	}
+
 	// success
 	return true;
 }
@@ -198,6 +198,7 @@ bool CReconstructionAlgorithm3D::_check()
 #endif
 	ASTRA_CONFIG_CHECK(m_pSinogram->isInitialized(), "Reconstruction3D", "Projection Data Object Not Initialized.");
 	ASTRA_CONFIG_CHECK(m_pReconstruction->isInitialized(), "Reconstruction3D", "Reconstruction Data Object Not Initialized.");
+	ASTRA_CONFIG_CHECK(!m_pReconstruction->isReadOnly(), "Reconstruction3D", "Reconstruction Data Object is read-only.");
 
 #if 0
 	// check compatibility between projector and data classes
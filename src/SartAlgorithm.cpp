@@ -29,8 +29,12 @@ along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
 
 #include "astra/AstraObjectManager.h"
 #include "astra/DataProjectorPolicies.h"
+#include "astra/DataExpression.h"
 
 #include "astra/Logging.h"
+#include "astra/Profiler.h"
+
+#include <limits>
 
 using namespace std;
 
@@ -126,9 +130,9 @@ bool CSartAlgorithm::initialize(const Config& _cfg)
 		return false;
 
 	// create data objects
-	m_pTotalRayLength = createCFloat32ProjectionData2DMemory(m_pProjector->getProjectionGeometry());
-	m_pTotalPixelWeight = createCFloat32VolumeData2DMemory(m_pProjector->getVolumeGeometry());
-	m_pDiffSinogram = createCFloat32ProjectionData2DMemory(m_pProjector->getProjectionGeometry());
+	m_pTotalRayLength = createCFloat32ProjectionData2DPooled(m_pProjector->getProjectionGeometry());
+	m_pTotalPixelWeight = createCFloat32VolumeData2DPooled(m_pProjector->getVolumeGeometry());
+	m_pDiffSinogram = createCFloat32ProjectionData2DPooled(m_pProjector->getProjectionGeometry());
 
 	// success
 	m_bIsInitialized = _check();
@@ -156,9 +160,9 @@ bool CSartAlgorithm::initialize(CProjector2D* _pProjector,
 	}
 
 	// create data objects
-	m_pTotalRayLength = createCFloat32ProjectionData2DMemory(m_pProjector->getProjectionGeometry());
-	m_pTotalPixelWeight = createCFloat32VolumeData2DMemory(m_pProjector->getVolumeGeometry());
-	m_pDiffSinogram = createCFloat32ProjectionData2DMemory(m_pProjector->getProjectionGeometry());
+	m_pTotalRayLength = createCFloat32ProjectionData2DPooled(m_pProjector->getProjectionGeometry());
+	m_pTotalPixelWeight = createCFloat32VolumeData2DPooled(m_pProjector->getVolumeGeometry());
+	m_pDiffSinogram = createCFloat32ProjectionData2DPooled(m_pProjector->getProjectionGeometry());
 
 	// success
 	m_bIsInitialized = _check();
@@ -187,9 +191,9 @@ bool CSartAlgorithm::initialize(CProjector2D* _pProjector,
 	}
 
 	// create data objects
-	m_pTotalRayLength = createCFloat32ProjectionData2DMemory(m_pProjector->getProjectionGeometry());
-	m_pTotalPixelWeight = createCFloat32VolumeData2DMemory(m_pProjector->getVolumeGeometry());
-	m_pDiffSinogram = createCFloat32ProjectionData2DMemory(m_pProjector->getProjectionGeometry());
+	m_pTotalRayLength = createCFloat32ProjectionData2DPooled(m_pProjector->getProjectionGeometry());
+	m_pTotalPixelWeight = createCFloat32VolumeData2DPooled(m_pProjector->getVolumeGeometry());
+	m_pDiffSinogram = createCFloat32ProjectionData2DPooled(m_pProjector->getProjectionGeometry());
 
 	// success
 	m_bIsInitialized = _check();
@@ -216,10 +220,22 @@ bool CSartAlgorithm::_check()
 	return true;
 }
 
+//----------------------------------------------------------------------------------------
+// Reset
+void CSartAlgorithm::reset()
+{
+	CReconstructionAlgorithm2D::reset();
+	m_iIterationCount = 0;
+}
+
 //----------------------------------------------------------------------------------------
 // Iterate
 bool CSartAlgorithm::run(int _iNrIterations)
 {
+	ASTRA_PROFILE_SCOPE(profile, "algorithm/SART");
+
+	using namespace expr;
+
 	// check initialized
 	ASTRA_ASSERT(m_bIsInitialized);
 
@@ -264,7 +280,18 @@ bool CSartAlgorithm::run(int _iNrIterations)
 			m_bUseSinogramMask, m_bUseReconstructionMask, true											 // options on/off
 		);
 
+	// only visit the active rays and pixels of the masks
+	const CMaskIndex *pMaskIndex = getMaskIndex();
+	pFirstForwardProjector->setMaskIndex(pMaskIndex);
+	pForwardProjector->setMaskIndex(pMaskIndex);
+	pBackProjector->setMaskIndex(pMaskIndex);
+
+
 
+	// bounds for the constraints, or infinite if not used
+	const float32 fMin = m_bUseMinConstraint ? m_fMinValue : -std::numeric_limits<float32>::infinity();
+	const float32 fMax = m_bUseMaxConstraint ? m_fMaxValue : std::numeric_limits<float32>::infinity();
+	const bool bConstrained = m_bUseMinConstraint || m_bUseMaxConstraint;
 
 	// iteration loop
 	for (int iIteration = 0; iIteration < _iNrIterations && !shouldAbort(); ++iIteration) {
@@ -282,10 +309,8 @@ bool CSartAlgorithm::run(int _iNrIterations)
 		// update iteration count
 		m_iIterationCount++;
 
-		if (m_bUseMinConstraint)
-			m_pReconstruction->clampMin(m_fMinValue);
-		if (m_bUseMaxConstraint)
-			m_pReconstruction->clampMax(m_fMaxValue);
+		if (bConstrained)
+			assign(*m_pReconstruction, clamp(lazy(*m_pReconstruction), fMin, fMax));
 	}
 
 
@@ -29,8 +29,12 @@ along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
 
 #include "astra/AstraObjectManager.h"
 #include "astra/DataProjectorPolicies.h"
+#include "astra/DataExpression.h"
 
 #include "astra/Logging.h"
+#include "astra/Profiler.h"
+
+#include <limits>
 
 using namespace std;
 
@@ -150,16 +154,20 @@ bool CSirtAlgorithm::initialize(CProjector2D* _pProjector,
 void CSirtAlgorithm::_init()
 {
 	// create data objects
-	m_pTotalRayLength = createCFloat32ProjectionData2DMemory(m_pProjector->getProjectionGeometry());
-	m_pTotalPixelWeight = createCFloat32VolumeData2DMemory(m_pProjector->getVolumeGeometry());
-	m_pDiffSinogram = createCFloat32ProjectionData2DMemory(m_pProjector->getProjectionGeometry());
-	m_pTmpVolume = createCFloat32VolumeData2DMemory(m_pProjector->getVolumeGeometry());
+	m_pTotalRayLength = createCFloat32ProjectionData2DPooled(m_pProjector->getProjectionGeometry());
+	m_pTotalPixelWeight = createCFloat32VolumeData2DPooled(m_pProjector->getVolumeGeometry());
+	m_pDiffSinogram = createCFloat32ProjectionData2DPooled(m_pProjector->getProjectionGeometry());
+	m_pTmpVolume = createCFloat32VolumeData2DPooled(m_pProjector->getVolumeGeometry());
 }
 
 //----------------------------------------------------------------------------------------
 // Iterate
 bool CSirtAlgorithm::run(int _iNrIterations)
 {
+	ASTRA_PROFILE_SCOPE(profile, "algorithm/SIRT");
+
+	using namespace expr;
+
 	// check initialized
 	ASTRA_ASSERT(m_bIsInitialized);
 
@@ -173,22 +181,29 @@ bool CSirtAlgorithm::run(int _iNrIterations)
 	m_pTotalRayLength->setData(0.0f);
 	m_pTotalPixelWeight->setData(0.0f);
 
+	// with a volume window, only its pixels are masked in and updated
+	prepareVolumeWindow();
+	CFloat32VolumeData2D *pReconstructionMask = getEffectiveReconstructionMask();
+	const bool bUseReconstructionMask = (pReconstructionMask != nullptr);
+	CFloat32ProjectionData2D *pSinogram = getEffectiveSinogram();
+	const SVolumeWindow window = getUpdateWindow();
+
 	// forward projection data projector
 	pForwardProjector = dispatchDataProjector(
 		m_pProjector, 
 			SinogramMaskPolicy(m_pSinogramMask),														// sinogram mask
-			ReconstructionMaskPolicy(m_pReconstructionMask),											// reconstruction mask
-			DiffFPPolicy(m_pReconstruction, m_pDiffSinogram, m_pSinogram),								// forward projection with difference calculation
-			m_bUseSinogramMask, m_bUseReconstructionMask, true											// options on/off
+			ReconstructionMaskPolicy(pReconstructionMask),											// reconstruction mask
+			DiffFPPolicy(m_pReconstruction, m_pDiffSinogram, pSinogram),								// forward projection with difference calculation
+			m_bUseSinogramMask, bUseReconstructionMask, true											// options on/off
 		); 
 
 	// backprojection data projector
 	pBackProjector = dispatchDataProjector(
 			m_pProjector, 
 			SinogramMaskPolicy(m_pSinogramMask),														// sinogram mask
-			ReconstructionMaskPolicy(m_pReconstructionMask),											// reconstruction mask
+			ReconstructionMaskPolicy(pReconstructionMask),											// reconstruction mask
 			DefaultBPPolicy(m_pTmpVolume, m_pDiffSinogram), // backprojection
-			m_bUseSinogramMask, m_bUseReconstructionMask, true // options on/off
+			m_bUseSinogramMask, bUseReconstructionMask, true // options on/off
 		); 
 
 	// first time forward projection data projector,
@@ -196,53 +211,41 @@ bool CSirtAlgorithm::run(int _iNrIterations)
 	pFirstForwardProjector = dispatchDataProjector(
 			m_pProjector, 
 			SinogramMaskPolicy(m_pSinogramMask),														// sinogram mask
-			ReconstructionMaskPolicy(m_pReconstructionMask),											// reconstruction mask
+			ReconstructionMaskPolicy(pReconstructionMask),											// reconstruction mask
 			Combine3Policy<DiffFPPolicy, TotalPixelWeightPolicy, TotalRayLengthPolicy>(					// 3 basic operations
-				DiffFPPolicy(m_pReconstruction, m_pDiffSinogram, m_pSinogram),								// forward projection with difference calculation
+				DiffFPPolicy(m_pReconstruction, m_pDiffSinogram, pSinogram),								// forward projection with difference calculation
 				TotalPixelWeightPolicy(m_pTotalPixelWeight),												// calculate the total pixel weights
 				TotalRayLengthPolicy(m_pTotalRayLength)),													// calculate the total ray lengths
-			m_bUseSinogramMask, m_bUseReconstructionMask, true											 // options on/off
+			m_bUseSinogramMask, bUseReconstructionMask, true											 // options on/off
 		);
 
+	// only visit the active rays and pixels of the masks
+	const CMaskIndex *pMaskIndex = getMaskIndex();
+	pForwardProjector->setMaskIndex(pMaskIndex);
+	pBackProjector->setMaskIndex(pMaskIndex);
+	pFirstForwardProjector->setMaskIndex(pMaskIndex);
+
 
 
 	// forward projection, difference calculation and raylength/pixelweight computation
 	pFirstForwardProjector->project();
 
-	float32* pfT = m_pTotalPixelWeight->getFloat32Memory();
-	for (size_t i = 0; i < m_pTotalPixelWeight->getSize(); ++i) {
-		float32 x = pfT[i];
-		if (x < -eps || x > eps)
-			x = 1.0f / x;
-		else
-			x = 0.0f;
-		pfT[i] = m_fLambda * x;
-	}
-	pfT = m_pTotalRayLength->getFloat32Memory();
-	for (size_t i = 0; i < m_pTotalRayLength->getSize(); ++i) {
-		float32 x = pfT[i];
-		if (x < -eps || x > eps)
-			x = 1.0f / x;
-		else
-			x = 0.0f;
-		pfT[i] = x;
-	}
+	assign(*m_pTotalPixelWeight, m_fLambda * safeInverse(lazy(*m_pTotalPixelWeight), eps));
+	assign(*m_pTotalRayLength, safeInverse(lazy(*m_pTotalRayLength), eps));
+
+	// bounds for the constraints, or infinite if not used
+	const float32 fMin = m_bUseMinConstraint ? m_fMinValue : -std::numeric_limits<float32>::infinity();
+	const float32 fMax = m_bUseMaxConstraint ? m_fMaxValue : std::numeric_limits<float32>::infinity();
 
 	// divide by line weights
-	(*m_pDiffSinogram) *= (*m_pTotalRayLength);
+	assign(*m_pDiffSinogram, lazy(*m_pDiffSinogram) * lazy(*m_pTotalRayLength));
 
-	// backprojection
-	m_pTmpVolume->setData(0.0f);
+	// backprojection; only the window is backprojected into and read
+	assign(*m_pTmpVolume, Scalar(0.0f), window);
 	pBackProjector->project();
 
-	// divide by pixel weights
-	(*m_pTmpVolume) *= (*m_pTotalPixelWeight);
-	(*m_pReconstruction) += (*m_pTmpVolume);
-
-	if (m_bUseMinConstraint)
-		m_pReconstruction->clampMin(m_fMinValue);
-	if (m_bUseMaxConstraint)
-		m_pReconstruction->clampMax(m_fMaxValue);
+	// divide by pixel weights, update and apply constraints
+	assign(*m_pReconstruction, clamp(lazy(*m_pReconstruction) + lazy(*m_pTmpVolume) * lazy(*m_pTotalPixelWeight), fMin, fMax), window);
 
 	// update iteration count
 	m_iIterationCount++;
@@ -257,21 +260,16 @@ bool CSirtAlgorithm::run(int _iNrIterations)
 		pForwardProjector->project();
 
 		// divide by line weights
-		(*m_pDiffSinogram) *= (*m_pTotalRayLength);
+		assign(*m_pDiffSinogram, lazy(*m_pDiffSinogram) * lazy(*m_pTotalRayLength));
 
 
 		// backprojection
-		m_pTmpVolume->setData(0.0f);
+		assign(*m_pTmpVolume, Scalar(0.0f), window);
 		pBackProjector->project();
 
-		// multiply with relaxation factor divided by pixel weights
-		(*m_pTmpVolume) *= (*m_pTotalPixelWeight);
-		(*m_pReconstruction) += (*m_pTmpVolume);
-
-		if (m_bUseMinConstraint)
-			m_pReconstruction->clampMin(m_fMinValue);
-		if (m_bUseMaxConstraint)
-			m_pReconstruction->clampMax(m_fMaxValue);
+		// multiply with relaxation factor divided by pixel weights,
+		// update and apply constraints
+		assign(*m_pReconstruction, clamp(lazy(*m_pReconstruction) + lazy(*m_pTmpVolume) * lazy(*m_pTotalPixelWeight), fMin, fMax), window);
 
 		// update iteration count
 		m_iIterationCount++;
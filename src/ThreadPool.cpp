@@ -0,0 +1,373 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+#include "astra/ThreadPool.h"
+
+#include "astra/Logging.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <string>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace astra {
+
+// Like the CDataMemoryPool, the pool is deliberately never destroyed, so
+// that it stays usable during static destruction.
+template<> CThreadPool& Singleton<CThreadPool>::getSingleton() {
+	static CThreadPool *instance = new CThreadPool();
+	return *instance;
+}
+
+static thread_local bool tl_bInParallelRegion = false;
+
+struct CThreadPool::SJob {
+	const std::function<void(int, int)> *pFunc;
+	int iRemaining;
+	std::exception_ptr exception;
+	std::mutex mutex;
+	std::condition_variable done;
+};
+
+static int getDefaultThreadCount()
+{
+	for (const char *name : { "ASTRA_NUM_THREADS", "OMP_NUM_THREADS" }) {
+		const char *value = getenv(name);
+		if (!value || !*value)
+			continue;
+		// OMP_NUM_THREADS may be a list of counts per nesting level
+		int n = atoi(value);
+		if (n > 0)
+			return n;
+		ASTRA_WARN("Ignoring invalid value of %s: %s", name, value);
+	}
+	return std::max(1u, std::thread::hardware_concurrency());
+}
+
+static bool getDefaultAffinity()
+{
+	for (const char *name : { "ASTRA_PROC_BIND", "OMP_PROC_BIND" }) {
+		const char *value = getenv(name);
+		if (!value || !*value)
+			continue;
+		std::string s(value);
+		std::transform(s.begin(), s.end(), s.begin(), ::tolower);
+		return s != "false" && s != "0";
+	}
+	return false;
+}
+
+CThreadPool::CThreadPool()
+	: m_iThreads(getDefaultThreadCount()), m_bPin(getDefaultAffinity()),
+	  m_iNextQueue(0), m_iPending(0), m_bStop(false),
+	  m_iActiveJobs(0), m_bStopping(false)
+{
+
+}
+
+CThreadPool::~CThreadPool()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	stopWorkers(lock);
+}
+
+void CThreadPool::setThreadCount(int _iThreads)
+{
+	// Stopping the workers would wait for the job running this chunk
+	if (tl_bInParallelRegion) {
+		ASTRA_WARN("CThreadPool: the thread count can not be changed inside a parallel region");
+		return;
+	}
+	std::unique_lock<std::mutex> lock(m_mutex);
+	stopWorkers(lock);
+	m_iThreads = (_iThreads > 0) ? _iThreads : getDefaultThreadCount();
+}
+
+int CThreadPool::getThreadCount() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_iThreads;
+}
+
+void CThreadPool::setAffinity(bool _bPin)
+{
+	if (tl_bInParallelRegion) {
+		ASTRA_WARN("CThreadPool: the affinity can not be changed inside a parallel region");
+		return;
+	}
+	std::unique_lock<std::mutex> lock(m_mutex);
+	if (_bPin == m_bPin)
+		return;
+	stopWorkers(lock);
+	m_bPin = _bPin;
+}
+
+bool CThreadPool::getAffinity() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_bPin;
+}
+
+bool CThreadPool::inParallelRegion()
+{
+	return tl_bInParallelRegion;
+}
+
+// Called with m_mutex held
+void CThreadPool::startWorkers()
+{
+	ASTRA_ASSERT(m_workers.empty() && !m_bStopping);
+	m_bStop = false;
+	m_iPending = 0;
+	int iWorkers = m_iThreads - 1;
+	m_queues.clear();
+	for (int i = 0; i < iWorkers; ++i)
+		m_queues.push_back(std::make_unique<SQueue>());
+	for (int i = 0; i < iWorkers; ++i)
+		m_workers.emplace_back(&CThreadPool::workerMain, this, i);
+	ASTRA_DEBUG("CThreadPool: started %d worker threads", iWorkers);
+}
+
+// Called with m_mutex held by _lock. It is released while joining the
+// workers, but m_bStopping keeps other threads from using or restarting
+// them in the meantime.
+void CThreadPool::stopWorkers(std::unique_lock<std::mutex> &_lock)
+{
+	m_lifecycle.wait(_lock, [this]() { return m_iActiveJobs == 0 && !m_bStopping; });
+	if (m_workers.empty())
+		return;
+	m_bStopping = true;
+	m_bStop = true;
+	m_wakeup.notify_all();
+
+	std::vector<std::thread> workers;
+	workers.swap(m_workers);
+	_lock.unlock();
+	for (std::thread &t : workers)
+		t.join();
+	_lock.lock();
+
+	m_queues.clear();
+	m_bStop = false;
+	m_bStopping = false;
+	m_lifecycle.notify_all();
+}
+
+void CThreadPool::workerMain(int _iIndex)
+{
+#ifdef __linux__
+	if (m_bPin) {
+		// The submitting thread is left free to run on core 0
+		unsigned int iCores = std::max(1u, std::thread::hardware_concurrency());
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		CPU_SET((_iIndex + 1) % iCores, &set);
+		if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0)
+			ASTRA_DEBUG("CThreadPool: failed to pin worker %d", _iIndex);
+	}
+#endif
+
+	tl_bInParallelRegion = true;
+
+	while (true) {
+		STask task;
+		if (popTask(_iIndex, task)) {
+			runTask(task);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_wakeup.wait(lock, [this]() { return m_bStop || m_iPending > 0; });
+		if (m_bStop)
+			return;
+	}
+}
+
+bool CThreadPool::popTask(int _iIndex, STask &_task)
+{
+	size_t n = m_queues.size();
+	if (n == 0)
+		return false;
+
+	// Own queue first (front), then steal from the others (back)
+	size_t iStart = (_iIndex >= 0) ? _iIndex : 0;
+	for (size_t k = 0; k < n; ++k) {
+		SQueue &q = *m_queues[(iStart + k) % n];
+		std::lock_guard<std::mutex> qlock(q.mutex);
+		if (q.tasks.empty())
+			continue;
+		if (k == 0 && _iIndex >= 0) {
+			_task = q.tasks.front();
+			q.tasks.pop_front();
+		} else {
+			_task = q.tasks.back();
+			q.tasks.pop_back();
+		}
+		// Not under m_mutex, which is taken before the queue mutexes. Only
+		// increments need the lock to avoid lost wake-ups.
+		m_iPending--;
+		return true;
+	}
+	return false;
+}
+
+void CThreadPool::runTask(const STask &_task)
+{
+	SJob *pJob = _task.pJob;
+
+	bool bWasInRegion = tl_bInParallelRegion;
+	tl_bInParallelRegion = true;
+	std::exception_ptr exception;
+	try {
+		(*pJob->pFunc)(_task.iFrom, _task.iTo);
+	} catch (...) {
+		exception = std::current_exception();
+	}
+	tl_bInParallelRegion = bWasInRegion;
+
+	// The job lives on the stack of the submitting thread, which may return
+	// as soon as it sees iRemaining drop to zero under the job mutex
+	std::lock_guard<std::mutex> lock(pJob->mutex);
+	if (exception && !pJob->exception)
+		pJob->exception = exception;
+	if (--pJob->iRemaining == 0)
+		pJob->done.notify_all();
+}
+
+void CThreadPool::parallelFor(int _iBegin, int _iEnd, int _iGrain, const std::function<void(int, int)> &_func)
+{
+	if (_iEnd <= _iBegin)
+		return;
+
+	int iCount = _iEnd - _iBegin;
+	int iGrain = std::max(_iGrain, 1);
+
+	SJob job;
+	int iChunks;
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		// Nested calls run inline, and the workers are not stopped while
+		// the outer job runs
+		if (!tl_bInParallelRegion)
+			m_lifecycle.wait(lock, [this]() { return !m_bStopping; });
+
+		if (m_iThreads <= 1 || tl_bInParallelRegion || iCount <= iGrain) {
+			iChunks = 0;
+		} else {
+			if (m_workers.empty())
+				startWorkers();
+			m_iActiveJobs++;
+
+			// A few chunks per thread for load balancing
+			iChunks = std::min((iCount + iGrain - 1) / iGrain, 4 * m_iThreads);
+			job.pFunc = &_func;
+			job.iRemaining = iChunks;
+
+			for (int c = 0; c < iChunks; ++c) {
+				STask task{ &job,
+				            _iBegin + (int)((long long)iCount * c / iChunks),
+				            _iBegin + (int)((long long)iCount * (c + 1) / iChunks) };
+				SQueue &q = *m_queues[m_iNextQueue++ % m_queues.size()];
+				std::lock_guard<std::mutex> qlock(q.mutex);
+				q.tasks.push_back(task);
+			}
+			m_iPending += iChunks;
+		}
+	}
+
+	if (iChunks == 0) {
+		_func(_iBegin, _iEnd);
+		return;
+	}
+
+	m_wakeup.notify_all();
+
+	// Help with the work (of any job) until the queues are empty
+	STask task;
+	while (popTask(-1, task))
+		runTask(task);
+
+	{
+		std::unique_lock<std::mutex> lock(job.mutex);
+		job.done.wait(lock, [&job]() { return job.iRemaining == 0; });
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (--m_iActiveJobs == 0)
+			m_lifecycle.notify_all();
+	}
+
+	if (job.exception)
+		std::rethrow_exception(job.exception);
+}
+
+void setNumThreads(int _iThreads)
+{
+	CThreadPool::getSingleton().setThreadCount(_iThreads);
+}
+
+int getNumThreads()
+{
+	return CThreadPool::getSingleton().getThreadCount();
+}
+
+void parallelFor(int _iBegin, int _iEnd, int _iGrain, const std::function<void(int, int)> &_func)
+{
+	CThreadPool::getSingleton().parallelFor(_iBegin, _iEnd, _iGrain, _func);
+}
+
+void parallelForBlocks(size_t _iSize, size_t _iGrain, const std::function<void(size_t, size_t)> &_func)
+{
+	if (_iSize == 0)
+		return;
+	size_t iGrain = std::max<size_t>(_iGrain, 1);
+	size_t iBlocks = (_iSize + iGrain - 1) / iGrain;
+	if (iBlocks <= 1) {
+		_func(0, _iSize);
+		return;
+	}
+	// Keep the block count in int range for parallelFor
+	if (iBlocks > (size_t)std::numeric_limits<int>::max()) {
+		iGrain = (_iSize + std::numeric_limits<int>::max() - 1) / std::numeric_limits<int>::max();
+		iBlocks = (_iSize + iGrain - 1) / iGrain;
+	}
+	CThreadPool::getSingleton().parallelFor(0, (int)iBlocks, 1, [&](int iFrom, int iTo) {
+		_func(iFrom * iGrain, std::min(iTo * iGrain, _iSize));
+	});
+}
+
+} // end namespace
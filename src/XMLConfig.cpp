@@ -122,6 +122,29 @@ bool XMLConfig::getDoubleArray(const std::string &name, std::vector<double> &val
 
 }
 
+bool XMLConfig::getDoubleArray(const std::string &name, ConfigNumericalArray &values) const
+{
+	values.clear();
+	XMLNode node = self.getSingleNode(name);
+	if (!node)
+		return false;
+
+	// Refer directly to binary arrays instead of copying them
+	const double *data;
+	int width, height;
+	if (node.getContentBinaryArray(data, width, height)) {
+		values.assign(data, (size_t)width * (height > 0 ? height : 1));
+		return true;
+	}
+
+	try {
+		values.assign(node.getContentNumericalArrayDouble());
+	} catch (const StringUtil::bad_cast &) {
+		return false;
+	}
+	return true;
+}
+
 bool XMLConfig::getIntArray(const std::string &name, std::vector<int> &values) const
 {
 	values.clear();
@@ -98,6 +98,7 @@ void XMLDocument::saveToFile(string sFilename)
 {
 	std::ofstream file(sFilename.c_str());
 
+	XMLNode::convertBinaryArraysToText(fDOMDocument);
 	file << *fDOMDocument;
 }
 
@@ -105,6 +106,7 @@ void XMLDocument::saveToFile(string sFilename)
 std::string XMLDocument::toString()
 {
 	std::stringstream ss;
+	XMLNode::convertBinaryArraysToText(fDOMDocument);
 	ss << *fDOMDocument->first_node();
 	return ss.str();
 }
@@ -39,6 +39,108 @@ using namespace astra;
 using namespace std;
 
 
+//-----------------------------------------------------------------------------
+// Binary numerical arrays
+//
+// Numerical lists and matrices are stored as raw doubles in the node value,
+// with their shape in an attribute: "W" for a list, "WxH" for a matrix.
+// They are converted to text only when printing.
+
+static const char *g_sBinaryArrayAttr = "astra_binary_array";
+
+template<typename T>
+static std::string setContentList_internal(const T* pfList, int _iSize);
+template<typename T>
+static std::string setContentMatrix_internal(const T* _pfMatrix, int _iWidth, int _iHeight, bool transposed);
+
+static bool getBinaryArray(const xml_node<> *n, const double *&data, int &width, int &height)
+{
+	const xml_attribute<> *attr = n->first_attribute(g_sBinaryArrayAttr);
+	if (!attr)
+		return false;
+
+	std::vector<std::string> dims;
+	StringUtil::splitString(dims, attr->value(), "x");
+	try {
+		if (dims.size() == 1) {
+			width = StringUtil::stringToInt(dims[0]);
+			height = 0;
+		} else if (dims.size() == 2) {
+			width = StringUtil::stringToInt(dims[0]);
+			height = StringUtil::stringToInt(dims[1]);
+		} else {
+			return false;
+		}
+	} catch (const StringUtil::bad_cast &) {
+		return false;
+	}
+
+	size_t count = (size_t)width * (height > 0 ? height : 1);
+	if (width <= 0 || height < 0 || n->value_size() != count * sizeof(double))
+		return false;
+
+	data = reinterpret_cast<const double*>(n->value());
+	return true;
+}
+
+static void removeBinaryArrayAttr(xml_node<> *n)
+{
+	xml_attribute<> *attr = n->first_attribute(g_sBinaryArrayAttr);
+	if (attr)
+		n->remove_attribute(attr);
+}
+
+static std::string binaryArrayToText(const double *data, int width, int height)
+{
+	if (height == 0)
+		return setContentList_internal<double>(data, width);
+	return setContentMatrix_internal<double>(data, width, height, false);
+}
+
+// Store a list (_iHeight == 0) or a matrix as a binary array.
+// See setContentMatrix_internal for the meaning of transposed.
+template<typename T>
+static void setBinaryArray(xml_node<> *n, const T *pfData, int _iWidth, int _iHeight, bool transposed)
+{
+	xml_document<> *doc = n->document();
+	removeBinaryArrayAttr(n);
+
+	size_t count = (size_t)_iWidth * (_iHeight > 0 ? _iHeight : 1);
+	// NB: memory from the rapidxml pool is pointer-aligned
+	char *buf = doc->allocate_string(0, count * sizeof(double));
+	double *data = reinterpret_cast<double*>(buf);
+
+	if (_iHeight == 0 || !transposed) {
+		for (size_t i = 0; i < count; ++i)
+			data[i] = pfData[i];
+	} else {
+		for (int y = 0; y < _iHeight; ++y)
+			for (int x = 0; x < _iWidth; ++x)
+				data[(size_t)y*_iWidth + x] = pfData[(size_t)x*_iHeight + y];
+	}
+	n->value(buf, count * sizeof(double));
+
+	std::string shape = std::to_string(_iWidth);
+	if (_iHeight > 0)
+		shape += "x" + std::to_string(_iHeight);
+	n->append_attribute(doc->allocate_attribute(g_sBinaryArrayAttr, doc->allocate_string(shape.c_str())));
+}
+
+void XMLNode::convertBinaryArraysToText(xml_node<>* n)
+{
+	const double *data;
+	int width, height;
+	if (n->type() == node_element && getBinaryArray(n, data, width, height)) {
+		std::string text = binaryArrayToText(data, width, height);
+		n->value(n->document()->allocate_string(text.c_str()));
+		removeBinaryArrayAttr(n);
+	}
+
+	for (xml_node<> *iter = n->first_node(); iter; iter = iter->next_sibling())
+		convertBinaryArraysToText(iter);
+}
+
+
 //-----------------------------------------------------------------------------
 // default constructor
 XMLNode::XMLNode() 
@@ -71,6 +173,7 @@ void XMLNode::setDOMNode(xml_node<>* n)
 // print XML Node
 void XMLNode::print() const
 {
+	convertBinaryArraysToText(fDOMElement);
 	std::cout << fDOMElement;
 }
 
@@ -79,6 +182,7 @@ void XMLNode::print() const
 std::string XMLNode::toString() const
 {
 	std::string s;
+	convertBinaryArraysToText(fDOMElement);
 	::print(std::back_inserter(s), *fDOMElement, 0);
 	return s;
 }
@@ -127,6 +231,11 @@ std::string XMLNode::getName() const
 // Get node content - STRING
 string XMLNode::getContent() const
 {
+	const double *data;
+	int width, height;
+	if (getBinaryArray(fDOMElement, data, width, height))
+		return binaryArrayToText(data, width, height);
+
 	return fDOMElement->value();
 }
 
@@ -155,14 +264,38 @@ bool XMLNode::getContentBool() const
 // NB: A 2D matrix is returned as a linear list
 vector<float32> XMLNode::getContentNumericalArray() const
 {
+	const double *data;
+	int width, height;
+	if (getBinaryArray(fDOMElement, data, width, height))
+		return vector<float32>(data, data + (size_t)width * (height > 0 ? height : 1));
+
 	return StringUtil::stringToFloatVector(getContent());
 }
 
 vector<double> XMLNode::getContentNumericalArrayDouble() const
 {
+	const double *data;
+	int width, height;
+	if (getBinaryArray(fDOMElement, data, width, height))
+		return vector<double>(data, data + (size_t)width * (height > 0 ? height : 1));
+
 	return StringUtil::stringToDoubleVector(getContent());
 }
 
+//-----------------------------------------------------------------------------	
+// Get node content - BINARY ARRAY
+bool XMLNode::isContentBinaryArray() const
+{
+	const double *data;
+	int width, height;
+	return getBinaryArray(fDOMElement, data, width, height);
+}
+
+bool XMLNode::getContentBinaryArray(const double *&_pfData, int &_iWidth, int &_iHeight) const
+{
+	return getBinaryArray(fDOMElement, _pfData, _iWidth, _iHeight);
+}
+
 //-----------------------------------------------------------------------------	
 // Is attribute?
 bool XMLNode::hasAttribute(string _sName) const
@@ -344,6 +477,7 @@ void XMLNode::setContent(string _sText)
 	xml_document<> *doc = fDOMElement->document();
 	char *text = doc->allocate_string(_sText.c_str());
 	fDOMElement->value(text);
+	removeBinaryArrayAttr(fDOMElement);
 }
 
 //-----------------------------------------------------------------------------	
@@ -367,12 +501,18 @@ static std::string setContentList_internal(const T* pfList, int _iSize) {
 
 void XMLNode::setContent(const float32* pfList, int _iSize)
 {
-	setContent(setContentList_internal<float32>(pfList, _iSize));
+	if (_iSize > 0)
+		setBinaryArray(fDOMElement, pfList, _iSize, 0, false);
+	else
+		setContent(std::string());
 }
 
 void XMLNode::setContent(const double* pfList, int _iSize)
 {
-	setContent(setContentList_internal<double>(pfList, _iSize));
+	if (_iSize > 0)
+		setBinaryArray(fDOMElement, pfList, _iSize, 0, false);
+	else
+		setContent(std::string());
 }
 
 //-----------------------------------------------------------------------------	
@@ -409,12 +549,18 @@ static std::string setContentMatrix_internal(const T* _pfMatrix, int _iWidth, in
 
 void XMLNode::setContent(const float32* _pfMatrix, int _iWidth, int _iHeight, bool transposed)
 {
-	setContent(setContentMatrix_internal<float32>(_pfMatrix, _iWidth, _iHeight, transposed));
+	if (_iWidth > 0 && _iHeight > 0)
+		setBinaryArray(fDOMElement, _pfMatrix, _iWidth, _iHeight, transposed);
+	else
+		setContent(setContentMatrix_internal<float32>(_pfMatrix, _iWidth, _iHeight, transposed));
 }
 
 void XMLNode::setContent(const double* _pfMatrix, int _iWidth, int _iHeight, bool transposed)
 {
-	setContent(setContentMatrix_internal<double>(_pfMatrix, _iWidth, _iHeight, transposed));
+	if (_iWidth > 0 && _iHeight > 0)
+		setBinaryArray(fDOMElement, _pfMatrix, _iWidth, _iHeight, transposed);
+	else
+		setContent(setContentMatrix_internal<double>(_pfMatrix, _iWidth, _iHeight, transposed));
 }
 
 
@@ -0,0 +1,659 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+/** Stand-alone benchmark for the CPU 2D projectors and algorithms.
+ *
+ * For every projector in Projector2DTypeList and every projection geometry
+ * it accepts, this times forward projection, backprojection and getMatrix().
+ * It also times the CPU reconstruction algorithms (SIRT, SART, CGLS, ART and
+ * FBP) on top of each projector. All of this is repeated over a grid of
+ * volume sizes, angle counts and detector counts.
+ *
+ * Results are written as JSON, one result object per line. When a baseline
+ * file from a previous run is given, the timings are compared by name and
+ * the program exits with status 1 if any case got slower than the tolerance
+ * allows. This is meant to be used for release qualification:
+ *
+ *   ./benchmark.bin --output base.json
+ *   ...
+ *   ./benchmark.bin --baseline base.json --tolerance 0.1
+ *
+ * Run with --help for all options.
+ */
+
+#include "astra/Globals.h"
+#include "astra/AlgorithmTypelist.h"
+#include "astra/ProjectorTypelist.h"
+#include "astra/AstraObjectFactory.h"
+#include "astra/AstraObjectManager.h"
+#include "astra/Data2D.h"
+#include "astra/Logging.h"
+#include "astra/ReconstructionAlgorithm2D.h"
+#include "astra/SparseMatrix.h"
+#include "astra/ThreadPool.h"
+#include "astra/XMLConfig.h"
+#include "astra/XMLNode.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/resource.h>
+#endif
+
+using namespace astra;
+
+namespace {
+
+struct SOptions {
+	std::vector<int> sizes = { 128, 256 };
+	std::vector<int> angles = { 90, 180 };
+	std::vector<int> detectors = { 192, 384 };
+	int iIterations = 10;
+	int iRepeat = 3;
+	int iThreads = 0;
+	std::string sFilter;
+	std::string sOutput;
+	std::string sBaseline;
+	double fTolerance = 0.1;
+};
+
+struct SCase {
+	std::string sKind;
+	std::string sProjector;
+	std::string sGeometry;
+	int iSize;
+	int iAngles;
+	int iDetectors;
+	int iIterations;
+
+	std::string name() const {
+		std::ostringstream s;
+		s << sKind << "/" << sProjector << "/" << sGeometry << "/"
+		  << iSize << "x" << iSize << "/a" << iAngles << "/d" << iDetectors;
+		if (iIterations > 1)
+			s << "/i" << iIterations;
+		return s.str();
+	}
+};
+
+struct SResult {
+	SCase c;
+	double fSeconds;
+	double fRays;
+	double fVoxels;
+	double fBytes;
+	long iPeakRSS;
+	double fBaselineSeconds;
+};
+
+template<typename... Ts>
+std::vector<std::string> typeNames(TypeList<Ts...>)
+{
+	return { Ts::type... };
+}
+
+const char *const g_geometries[] = { "parallel", "parallel_vec", "fanflat", "fanflat_vec", "sparse_matrix" };
+
+//----------------------------------------------------------------------------------------
+// Peak resident set size in kB. On Linux the high water mark is reset before
+// each case if the kernel allows it, so this is a per-case value; otherwise it
+// is the peak of the whole process so far.
+void resetPeakRSS()
+{
+#ifdef __linux__
+	FILE *f = fopen("/proc/self/clear_refs", "w");
+	if (f) {
+		fputs("5", f);
+		fclose(f);
+	}
+#endif
+}
+
+long getPeakRSS()
+{
+#ifdef __linux__
+	std::ifstream status("/proc/self/status");
+	std::string line;
+	while (std::getline(status, line)) {
+		if (line.compare(0, 6, "VmHWM:") == 0)
+			return atol(line.c_str() + 6);
+	}
+	struct rusage ru;
+	if (getrusage(RUSAGE_SELF, &ru) == 0)
+		return ru.ru_maxrss;
+#endif
+	return -1;
+}
+
+//----------------------------------------------------------------------------------------
+// Configuration helpers
+
+void addProjectionGeometry(XMLNode node, const std::string &type, int iAngles, int iDetectors, int iMatrixId)
+{
+	XMLNode pg = node.addChildNode("ProjectionGeometry");
+	pg.addAttribute("type", type);
+
+	const double fDetWidth = 1.0;
+	const double fOriginSource = 1000.0, fOriginDetector = 500.0;
+	std::vector<double> angles(iAngles);
+	for (int i = 0; i < iAngles; ++i)
+		angles[i] = i * M_PI / iAngles;
+
+	if (type == "parallel" || type == "fanflat" || type == "sparse_matrix") {
+		pg.addChildNode("DetectorCount", (float32)iDetectors);
+		pg.addChildNode("DetectorWidth", (float32)fDetWidth);
+		pg.addChildNode("ProjectionAngles").setContent(&angles[0], iAngles);
+		if (type == "fanflat") {
+			pg.addChildNode("DistanceOriginSource", (float32)fOriginSource);
+			pg.addChildNode("DistanceOriginDetector", (float32)fOriginDetector);
+		} else if (type == "sparse_matrix") {
+			pg.addChildNode("MatrixID", (float32)iMatrixId);
+		}
+		return;
+	}
+
+	std::vector<double> vectors(6 * iAngles);
+	for (int i = 0; i < iAngles; ++i) {
+		double c = cos(angles[i]), s = sin(angles[i]);
+		double *v = &vectors[6 * i];
+		if (type == "parallel_vec") {
+			v[0] = s; v[1] = -c;
+			v[2] = 0.0; v[3] = 0.0;
+		} else {
+			v[0] = -s * fOriginSource; v[1] = c * fOriginSource;
+			v[2] = s * fOriginDetector; v[3] = -c * fOriginDetector;
+		}
+		v[4] = c * fDetWidth; v[5] = s * fDetWidth;
+	}
+	pg.addChildNode("DetectorCount", (float32)iDetectors);
+	pg.addChildNode("Vectors").setContent(&vectors[0], 6 * iAngles);
+}
+
+CProjector2D *createProjector(const std::string &type, const std::string &geometry, int iSize, int iAngles, int iDetectors, int iMatrixId)
+{
+	XMLConfig cfg("Projector2D");
+	cfg.self.addAttribute("type", type);
+	addProjectionGeometry(cfg.self, geometry, iAngles, iDetectors, iMatrixId);
+	XMLNode vg = cfg.self.addChildNode("VolumeGeometry");
+	vg.addChildNode("GridColCount", (float32)iSize);
+	vg.addChildNode("GridRowCount", (float32)iSize);
+
+	if (type == "blob") {
+		// A smooth blob of radius 2 pixels; the exact profile does not matter
+		// for timing
+		const int iSamples = 64;
+		const double fRadius = 2.0;
+		std::vector<double> values(iSamples);
+		for (int i = 0; i < iSamples; ++i) {
+			double r = (double)i / iSamples;
+			values[i] = (1.0 - r * r) * (1.0 - r * r);
+		}
+		XMLNode kernel = cfg.self.addChildNode("Kernel");
+		kernel.addChildNode("KernelSize", (float32)fRadius);
+		kernel.addChildNode("SampleRate", (float32)(fRadius / iSamples));
+		kernel.addChildNode("SampleCount", (float32)iSamples);
+		kernel.addChildNode("KernelValues").setContent(&values[0], iSamples);
+	}
+
+	CProjector2D *pProjector = CProjector2DFactory::getSingleton().create(type);
+	if (!pProjector)
+		return nullptr;
+	if (!pProjector->initialize(cfg)) {
+		delete pProjector;
+		return nullptr;
+	}
+	return pProjector;
+}
+
+CAlgorithm *createAlgorithm(const std::string &type, int iProjectorId, int iSinogramId, int iVolumeId)
+{
+	XMLConfig cfg("Algorithm");
+	cfg.self.addAttribute("type", type);
+	cfg.self.addChildNode("ProjectorId", (float32)iProjectorId);
+	cfg.self.addChildNode("ProjectionDataId", (float32)iSinogramId);
+	cfg.self.addChildNode(type == "FP" ? "VolumeDataId" : "ReconstructionDataId", (float32)iVolumeId);
+
+	CAlgorithm *pAlg = CAlgorithmFactory::getSingleton().create(type);
+	if (!pAlg)
+		return nullptr;
+	if (!pAlg->initialize(cfg)) {
+		delete pAlg;
+		return nullptr;
+	}
+	return pAlg;
+}
+
+//----------------------------------------------------------------------------------------
+// Benchmark driver
+
+class CBenchmark {
+public:
+	CBenchmark(const SOptions &opts) : m_opts(opts) { }
+
+	void run();
+	bool compare(const std::map<std::string, double> &baseline);
+	void write(std::ostream &out) const;
+
+private:
+	void runGridPoint(int iSize, int iAngles, int iDetectors);
+	void runProjector(const std::string &type, const std::string &geometry, int iSize, int iAngles, int iDetectors, int iMatrixId);
+
+	// Time f() (best of the repeats); setup() runs before each, untimed
+	template<typename S, typename F>
+	void measure(const SCase &c, double fRays, double fVoxels, double fBytes, S &&setup, F &&f);
+
+	bool selected(const SCase &c) const {
+		return m_opts.sFilter.empty() || c.name().find(m_opts.sFilter) != std::string::npos;
+	}
+
+	const SOptions &m_opts;
+	std::vector<SResult> m_results;
+};
+
+template<typename S, typename F>
+void CBenchmark::measure(const SCase &c, double fRays, double fVoxels, double fBytes, S &&setup, F &&f)
+{
+	fprintf(stderr, "%s ...", c.name().c_str());
+	fflush(stderr);
+
+	resetPeakRSS();
+	double fBest = -1.0;
+	for (int r = 0; r < std::max(m_opts.iRepeat, 1); ++r) {
+		setup();
+		auto t0 = std::chrono::steady_clock::now();
+		if (!f()) {
+			fprintf(stderr, " failed\n");
+			return;
+		}
+		double t = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+		if (fBest < 0.0 || t < fBest)
+			fBest = t;
+	}
+
+	SResult res;
+	res.c = c;
+	res.fSeconds = fBest;
+	res.fRays = fRays;
+	res.fVoxels = fVoxels;
+	res.fBytes = fBytes;
+	res.iPeakRSS = getPeakRSS();
+	res.fBaselineSeconds = -1.0;
+	m_results.push_back(res);
+
+	fprintf(stderr, " %.4f s\n", fBest);
+}
+
+void CBenchmark::run()
+{
+	for (int iSize : m_opts.sizes)
+		for (int iAngles : m_opts.angles)
+			for (int iDetectors : m_opts.detectors)
+				runGridPoint(iSize, iAngles, iDetectors);
+}
+
+void CBenchmark::runGridPoint(int iSize, int iAngles, int iDetectors)
+{
+	// The sparse_matrix geometry needs a stored matrix, taken from the line
+	// projector on the equivalent parallel geometry.
+	int iMatrixId = -1;
+	std::unique_ptr<CProjector2D> pLine(createProjector("line", "parallel", iSize, iAngles, iDetectors, -1));
+	if (pLine) {
+		CSparseMatrix *pMatrix = pLine->getMatrix();
+		if (pMatrix)
+			iMatrixId = CMatrixManager::getSingleton().store(pMatrix);
+	}
+
+	for (const std::string &type : typeNames(Projector2DTypeList{})) {
+		if (type == "cuda")
+			continue;
+		for (const char *geometry : g_geometries) {
+			if (std::string(geometry) == "sparse_matrix" && iMatrixId == -1)
+				continue;
+			runProjector(type, geometry, iSize, iAngles, iDetectors, iMatrixId);
+		}
+	}
+
+	if (iMatrixId != -1)
+		CMatrixManager::getSingleton().remove(iMatrixId);
+}
+
+void CBenchmark::runProjector(const std::string &type, const std::string &geometry, int iSize, int iAngles, int iDetectors, int iMatrixId)
+{
+	CProjector2D *pProjector = createProjector(type, geometry, iSize, iAngles, iDetectors, iMatrixId);
+	if (!pProjector)
+		return;
+	int iProjectorId = CProjector2DManager::getSingleton().store(pProjector);
+
+	CFloat32VolumeData2D *pVolume = createCFloat32VolumeData2DMemory(pProjector->getVolumeGeometry());
+	CFloat32ProjectionData2D *pSinogram = createCFloat32ProjectionData2DMemory(pProjector->getProjectionGeometry());
+	int iVolumeId = CData2DManager::getSingleton().store(pVolume);
+	int iSinogramId = CData2DManager::getSingleton().store(pSinogram);
+
+	// A disc phantom, and its forward projection as input for the
+	// reconstruction algorithms
+	float32 *pfVolume = pVolume->getFloat32Memory();
+	for (int y = 0; y < iSize; ++y)
+		for (int x = 0; x < iSize; ++x) {
+			double dx = x - 0.5 * iSize + 0.5, dy = y - 0.5 * iSize + 0.5;
+			pfVolume[y * iSize + x] = (dx * dx + dy * dy < 0.16 * iSize * iSize) ? 1.0f : 0.0f;
+		}
+	std::unique_ptr<CAlgorithm> pFP(createAlgorithm("FP", iProjectorId, iSinogramId, iVolumeId));
+	if (pFP)
+		pFP->run();
+
+	const double fRays = (double)iAngles * iDetectors;
+	const double fVoxels = (double)iSize * iSize;
+	// Every FP or BP pass reads one of volume/sinogram and writes the other
+	const double fPassBytes = sizeof(float32) * (fRays + fVoxels);
+
+	SCase c { "", type, geometry, iSize, iAngles, iDetectors, 1 };
+
+	if (pFP) {
+		c.sKind = "FP";
+		if (selected(c))
+			measure(c, fRays, fVoxels, fPassBytes, []() {}, [&]() { return pFP->run(); });
+	}
+
+	std::vector<float32> sinogram(pSinogram->getFloat32Memory(), pSinogram->getFloat32Memory() + pSinogram->getSize());
+	auto resetData = [&]() {
+		std::copy(sinogram.begin(), sinogram.end(), pSinogram->getFloat32Memory());
+		std::fill(pfVolume, pfVolume + pVolume->getSize(), 0.0f);
+	};
+
+	c.sKind = "matrix";
+	if (selected(c)) {
+		double fBytes = 0.0;
+		measure(c, fRays, fVoxels, 0.0, []() {}, [&]() {
+			std::unique_ptr<CSparseMatrix> pMatrix(pProjector->getMatrix());
+			if (!pMatrix)
+				return false;
+			double nnz = pMatrix->m_plRowStarts[pMatrix->m_iHeight];
+			fBytes = nnz * (sizeof(float32) + sizeof(unsigned int)) + (pMatrix->m_iHeight + 1.0) * sizeof(unsigned long);
+			return true;
+		});
+		if (!m_results.empty() && m_results.back().c.name() == c.name())
+			m_results.back().fBytes = fBytes;
+	}
+
+	struct SAlgorithmRun {
+		const char *type;
+		int iIterations;
+		// Number of FP/BP passes over all rays per run
+		double fPasses;
+	};
+	const int iSirt = m_opts.iIterations;
+	const SAlgorithmRun algorithms[] = {
+		{ "BP", 1, 1.0 },
+		{ "FBP", 1, 1.0 },
+		{ "SIRT", iSirt, 2.0 * iSirt },
+		{ "CGLS", iSirt, 2.0 * iSirt },
+		// One SART/ART iteration handles a single angle/ray; run a full sweep
+		{ "SART", iAngles, 2.0 },
+		{ "ART", iAngles * iDetectors, 2.0 },
+	};
+
+	for (const SAlgorithmRun &a : algorithms) {
+		c.sKind = a.type;
+		c.iIterations = a.iIterations;
+		if (!selected(c))
+			continue;
+		resetData();
+		std::unique_ptr<CAlgorithm> pAlg(createAlgorithm(a.type, iProjectorId, iSinogramId, iVolumeId));
+		if (!pAlg)
+			continue;
+		// Every repeat starts from the same data and algorithm state
+		CReconstructionAlgorithm2D *pRec = dynamic_cast<CReconstructionAlgorithm2D*>(pAlg.get());
+		measure(c, a.fPasses * fRays, a.fPasses * fVoxels, a.fPasses * fPassBytes, [&]() {
+			if (pRec)
+				pRec->reset();
+			resetData();
+		}, [&]() {
+			return pAlg->run(a.iIterations);
+		});
+	}
+
+	CData2DManager::getSingleton().remove(iSinogramId);
+	CData2DManager::getSingleton().remove(iVolumeId);
+	CProjector2DManager::getSingleton().remove(iProjectorId);
+}
+
+std::string jsonString(const std::string &s)
+{
+	std::string r = "\"";
+	for (char ch : s) {
+		if (ch == '"' || ch == '\\')
+			r += '\\';
+		r += ch;
+	}
+	return r + "\"";
+}
+
+void CBenchmark::write(std::ostream &out) const
+{
+	out << "{\n";
+	out << "\"astra_version\": " << jsonString(getVersionString()) << ",\n";
+	out << "\"threads\": " << getNumThreads() << ",\n";
+	out << "\"repeat\": " << m_opts.iRepeat << ",\n";
+	out << "\"results\": [\n";
+	for (size_t i = 0; i < m_results.size(); ++i) {
+		const SResult &r = m_results[i];
+		char buf[512];
+		snprintf(buf, sizeof(buf),
+		         "\"seconds\": %.6g, \"rays_per_s\": %.6g, \"voxels_per_s\": %.6g, \"bytes\": %.6g, \"peak_rss_kb\": %ld",
+		         r.fSeconds, r.fRays / r.fSeconds, r.fVoxels / r.fSeconds, r.fBytes, r.iPeakRSS);
+		out << "{\"name\": " << jsonString(r.c.name())
+		    << ", \"kind\": " << jsonString(r.c.sKind)
+		    << ", \"projector\": " << jsonString(r.c.sProjector)
+		    << ", \"geometry\": " << jsonString(r.c.sGeometry)
+		    << ", \"volume\": " << r.c.iSize
+		    << ", \"angles\": " << r.c.iAngles
+		    << ", \"detectors\": " << r.c.iDetectors
+		    << ", \"iterations\": " << r.c.iIterations
+		    << ", " << buf;
+		if (r.fBaselineSeconds > 0.0) {
+			snprintf(buf, sizeof(buf), ", \"baseline_seconds\": %.6g, \"ratio\": %.4f",
+			         r.fBaselineSeconds, r.fSeconds / r.fBaselineSeconds);
+			out << buf;
+		}
+		out << "}" << (i + 1 < m_results.size() ? "," : "") << "\n";
+	}
+	out << "]\n}\n";
+}
+
+//----------------------------------------------------------------------------------------
+// Baseline comparison. This only parses the files written by write(), which
+// have one result object per line.
+
+bool readBaseline(const std::string &filename, std::map<std::string, double> &baseline)
+{
+	std::ifstream in(filename);
+	if (!in)
+		return false;
+	std::string line;
+	while (std::getline(in, line)) {
+		size_t n = line.find("{\"name\": \"");
+		size_t s = line.find("\"seconds\": ");
+		if (n == std::string::npos || s == std::string::npos)
+			continue;
+		n += 10;
+		size_t e = line.find('"', n);
+		if (e == std::string::npos)
+			continue;
+		baseline[line.substr(n, e - n)] = atof(line.c_str() + s + 11);
+	}
+	return true;
+}
+
+bool CBenchmark::compare(const std::map<std::string, double> &baseline)
+{
+	int iRegressions = 0, iCompared = 0;
+	for (SResult &r : m_results) {
+		auto it = baseline.find(r.c.name());
+		if (it == baseline.end() || it->second <= 0.0)
+			continue;
+		r.fBaselineSeconds = it->second;
+		++iCompared;
+		double fRatio = r.fSeconds / r.fBaselineSeconds;
+		if (fRatio > 1.0 + m_opts.fTolerance) {
+			fprintf(stderr, "REGRESSION %s: %.4f s vs %.4f s baseline (%+.1f%%)\n",
+			        r.c.name().c_str(), r.fSeconds, r.fBaselineSeconds, 100.0 * (fRatio - 1.0));
+			++iRegressions;
+		}
+	}
+	fprintf(stderr, "%d cases compared to baseline, %d regressions\n", iCompared, iRegressions);
+	return iRegressions == 0;
+}
+
+//----------------------------------------------------------------------------------------
+
+bool parseIntList(const char *s, std::vector<int> &values)
+{
+	values.clear();
+	std::istringstream in(s);
+	std::string item;
+	while (std::getline(in, item, ',')) {
+		int v = atoi(item.c_str());
+		if (v <= 0)
+			return false;
+		values.push_back(v);
+	}
+	return !values.empty();
+}
+
+void usage(const char *prog)
+{
+	fprintf(stderr,
+	        "Usage: %s [options]\n"
+	        "  --sizes N,...        volume sizes (default 128,256)\n"
+	        "  --angles N,...       angle counts (default 90,180)\n"
+	        "  --detectors N,...    detector counts (default 192,384)\n"
+	        "  --iterations N       SIRT/CGLS iterations (default 10)\n"
+	        "  --repeat N           repetitions per case, best time is kept (default 3)\n"
+	        "  --threads N          CPU thread count (default: all cores)\n"
+	        "  --filter STR         only run cases whose name contains STR\n"
+	        "  --quick              small grid for smoke testing\n"
+	        "  --output FILE        write JSON to FILE instead of stdout\n"
+	        "  --baseline FILE      compare against a previous JSON output\n"
+	        "  --tolerance X        allowed relative slowdown (default 0.1)\n",
+	        prog);
+}
+
+}
+
+int main(int argc, char **argv)
+{
+	SOptions opts;
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+		bool ok = true;
+		if (arg == "--quick") {
+			opts.sizes = { 64 };
+			opts.angles = { 45 };
+			opts.detectors = { 96 };
+			opts.iIterations = 2;
+			opts.iRepeat = 1;
+		} else if (arg == "--help" || arg == "-h") {
+			usage(argv[0]);
+			return 0;
+		} else if (!hasValue) {
+			ok = false;
+		} else if (arg == "--sizes") {
+			ok = parseIntList(argv[++i], opts.sizes);
+		} else if (arg == "--angles") {
+			ok = parseIntList(argv[++i], opts.angles);
+		} else if (arg == "--detectors") {
+			ok = parseIntList(argv[++i], opts.detectors);
+		} else if (arg == "--iterations") {
+			opts.iIterations = atoi(argv[++i]);
+			ok = opts.iIterations > 0;
+		} else if (arg == "--repeat") {
+			opts.iRepeat = atoi(argv[++i]);
+			ok = opts.iRepeat > 0;
+		} else if (arg == "--threads") {
+			opts.iThreads = atoi(argv[++i]);
+			ok = opts.iThreads > 0;
+		} else if (arg == "--filter") {
+			opts.sFilter = argv[++i];
+		} else if (arg == "--output") {
+			opts.sOutput = argv[++i];
+		} else if (arg == "--baseline") {
+			opts.sBaseline = argv[++i];
+		} else if (arg == "--tolerance") {
+			opts.fTolerance = atof(argv[++i]);
+		} else {
+			ok = false;
+		}
+		if (!ok) {
+			usage(argv[0]);
+			return 2;
+		}
+	}
+
+	// Unsupported projector/geometry combinations are expected; keep the
+	// output readable
+	CLogger::disableScreen();
+
+	if (opts.iThreads > 0)
+		setNumThreads(opts.iThreads);
+
+	std::map<std::string, double> baseline;
+	if (!opts.sBaseline.empty() && !readBaseline(opts.sBaseline, baseline)) {
+		fprintf(stderr, "Could not read baseline %s\n", opts.sBaseline.c_str());
+		return 2;
+	}
+
+	CBenchmark bench(opts);
+	bench.run();
+
+	bool ok = opts.sBaseline.empty() || bench.compare(baseline);
+
+	if (opts.sOutput.empty()) {
+		bench.write(std::cout);
+	} else {
+		std::ofstream out(opts.sOutput);
+		bench.write(out);
+		if (!out) {
+			fprintf(stderr, "Could not write %s\n", opts.sOutput.c_str());
+			return 2;
+		}
+	}
+
+	return ok ? 0 : 1;
+}
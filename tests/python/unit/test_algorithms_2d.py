@@ -168,7 +168,9 @@ def get_algorithm_output(algorithm_config, n_iter=None):
     ('parallel_vec', 'linear'),
     ('fanflat', 'line_fanflat'),
     ('fanflat', 'strip_fanflat'),
+    ('fanflat', 'distance_driven_fanflat'),
     ('fanflat_vec', 'line_fanflat'),
+    ('fanflat_vec', 'distance_driven_fanflat'),
     ('sparse_matrix', 'sparse_matrix')
 ], indirect=True)
 @pytest.mark.parametrize('algorithm_type', ['FP', 'BP', 'FBP', 'SIRT', 'SART', 'ART', 'CGLS'])
@@ -180,6 +182,40 @@ def test_cpu_algorithms(projector, proj_geom, algorithm_type):
     assert not np.allclose(output, DATA_INIT_VALUE)
 
 
+@pytest.mark.parametrize('proj_geom, projector', [
+    ('parallel', 'line'),
+    ('parallel_vec', 'linear'),
+    ('fanflat', 'strip_fanflat'),
+    ('fanflat_vec', 'distance_driven_fanflat'),
+    ('sparse_matrix', 'sparse_matrix')
+], indirect=True)
+@pytest.mark.parametrize('algorithm_type', ['FP', 'BP', 'FBP', 'SIRT', 'SART', 'CGLS'])
+@pytest.mark.parametrize('use_masks', [False, True])
+def test_cpu_algorithms_num_threads(proj_geom, projector, algorithm_type, use_masks,
+                                    sinogram_mask, reconstruction_mask):
+    # Projections are split over blocks of angles on the thread pool, and
+    # back projections sum the volumes of the blocks, which only changes
+    # the rounding (relative to the largest values, due to cancellation)
+    if algorithm_type == 'FBP' and proj_geom['type'] != 'parallel':
+        pytest.skip('Not implemented')
+    options = {}
+    if use_masks and algorithm_type not in ('FP', 'FBP'):
+        options['SinogramMaskId'] = sinogram_mask
+        options['ReconstructionMaskId'] = reconstruction_mask
+    if algorithm_type == 'SART':
+        options['ProjectionOrder'] = 'sequential'
+    outputs = []
+    try:
+        for num_threads in [1, 4]:
+            astra.set_num_threads(num_threads)
+            outputs.append(get_algorithm_output(
+                make_algorithm_config(algorithm_type, proj_geom, projector, options)))
+    finally:
+        astra.set_num_threads(0)
+    assert not np.allclose(outputs[0], DATA_INIT_VALUE)
+    assert np.allclose(outputs[0], outputs[1], rtol=1e-5, atol=1e-5 * np.abs(outputs[0]).max())
+
+
 @pytest.mark.parametrize(
     'proj_geom,', ['parallel', 'parallel_vec', 'fanflat', 'fanflat_vec'], indirect=True
 )
@@ -490,3 +526,346 @@ class TestOptionsGPU:
         astra.algorithm.run(algorithm_id, 2)
         reconstruction_without = get_algorithm_output(algorithm_config)
         assert np.allclose(reconstruction_with, reconstruction_without)
+
+
+@pytest.mark.parametrize('proj_geom, projector', [
+    ('parallel', 'line'),
+    ('parallel', 'strip'),
+    ('parallel', 'linear'),
+    ('fanflat', 'line_fanflat'),
+    ('fanflat', 'strip_fanflat'),
+    ('fanflat', 'distance_driven_fanflat'),
+], indirect=True)
+@pytest.mark.parametrize('algorithm_type', ['SIRT', 'SART', 'CGLS'])
+def test_roi_mask_matches_matrix(proj_geom, projector, algorithm_type, sinogram_mask):
+    # Masked projection only traverses the active region of the masks, while
+    # the explicit matrix of the same projector visits all pixels on each ray
+    y, x = np.mgrid[:N_ROWS, :N_COLS]
+    roi = ((x - 0.3 * N_COLS) ** 2 + (y - 0.6 * N_ROWS) ** 2 < 0.04 * N_ROWS * N_COLS)
+    assert roi.mean() < 0.2
+    mask_id = astra.data2d.create('-vol', VOL_GEOM, roi)
+    matrix_id = astra.projector.matrix(projector)
+    matrix_geom = astra.create_proj_geom('sparse_matrix', DET_SPACING, DET_COUNT, ANGLES, matrix_id)
+    matrix_projector = astra.create_projector('sparse_matrix', matrix_geom, VOL_GEOM)
+    options = {'ReconstructionMaskId': mask_id, 'SinogramMaskId': sinogram_mask}
+    if algorithm_type == 'SART':
+        # Make sure both runs use the same projection order
+        options['ProjectionOrder'] = 'sequential'
+    try:
+        reconstruction = get_algorithm_output(
+            make_algorithm_config(algorithm_type, proj_geom, projector, options))
+        reconstruction_matrix = get_algorithm_output(
+            make_algorithm_config(algorithm_type, matrix_geom, matrix_projector, options))
+    finally:
+        astra.projector.delete(matrix_projector)
+        astra.matrix.delete(matrix_id)
+        astra.data2d.delete(mask_id)
+    assert not np.allclose(reconstruction[roi], DATA_INIT_VALUE)
+    assert np.allclose(reconstruction[~roi], DATA_INIT_VALUE)
+    assert np.allclose(reconstruction, reconstruction_matrix, rtol=1e-4, atol=1e-4)
+
+
+@pytest.fixture
+def blob_projector(proj_geom):
+    samples = np.linspace(0, 1, 64, endpoint=False)
+    projector_config = astra.astra_dict('blob')
+    projector_config['ProjectionGeometry'] = proj_geom
+    projector_config['VolumeGeometry'] = VOL_GEOM
+    projector_config['Kernel'] = {'KernelSize': 2, 'SampleRate': 2 / 64, 'SampleCount': 64,
+                                  'KernelValues': (1 - samples ** 2) ** 2}
+    projector_id = astra.projector.create(projector_config)
+    yield projector_id
+    astra.projector.delete(projector_id)
+
+
+@pytest.mark.parametrize('proj_geom', ['parallel', 'parallel_vec'], indirect=True)
+@pytest.mark.parametrize('algorithm_type', ['FP', 'BP', 'SIRT', 'SART', 'CGLS'])
+@pytest.mark.parametrize('use_masks', [False, True])
+def test_blob_footprint_matches_matrix(proj_geom, blob_projector, algorithm_type, use_masks, sinogram_mask):
+    # The blob projector splats pixel footprints for most policies, while its
+    # explicit matrix is built ray by ray
+    matrix_id = astra.projector.matrix(blob_projector)
+    matrix_geom = astra.create_proj_geom('sparse_matrix', DET_SPACING, DET_COUNT, ANGLES, matrix_id)
+    matrix_projector = astra.create_projector('sparse_matrix', matrix_geom, VOL_GEOM)
+    options = {}
+    if use_masks and algorithm_type != 'FP':
+        y, x = np.mgrid[:N_ROWS, :N_COLS]
+        roi = (x - 0.3 * N_COLS) ** 2 + (y - 0.6 * N_ROWS) ** 2 < 0.04 * N_ROWS * N_COLS
+        options['ReconstructionMaskId'] = astra.data2d.create('-vol', VOL_GEOM, roi)
+        options['SinogramMaskId'] = sinogram_mask
+    if algorithm_type == 'SART':
+        options['ProjectionOrder'] = 'sequential'
+    try:
+        output = get_algorithm_output(
+            make_algorithm_config(algorithm_type, proj_geom, blob_projector, options))
+        output_matrix = get_algorithm_output(
+            make_algorithm_config(algorithm_type, matrix_geom, matrix_projector, options))
+    finally:
+        astra.projector.delete(matrix_projector)
+        astra.matrix.delete(matrix_id)
+        if 'ReconstructionMaskId' in options:
+            astra.data2d.delete(options['ReconstructionMaskId'])
+    assert not np.allclose(output, DATA_INIT_VALUE)
+    assert np.allclose(output, output_matrix, rtol=1e-4, atol=1e-4)
+
+
+@pytest.mark.parametrize('proj_geom, projector', [
+    ('fanflat', 'distance_driven_fanflat'),
+    ('fanflat_vec', 'distance_driven_fanflat'),
+], indirect=True)
+@pytest.mark.parametrize('algorithm_type', ['FP', 'BP', 'CGLS'])
+def test_distance_driven_fanflat_matches_matrix(proj_geom, projector, algorithm_type):
+    # Rays are merged per row for most policies, while the explicit matrix is
+    # built ray by ray
+    matrix_id = astra.projector.matrix(projector)
+    matrix_geom = astra.create_proj_geom('sparse_matrix', DET_SPACING, DET_COUNT, ANGLES, matrix_id)
+    matrix_projector = astra.create_projector('sparse_matrix', matrix_geom, VOL_GEOM)
+    try:
+        output = get_algorithm_output(make_algorithm_config(algorithm_type, proj_geom, projector))
+        output_matrix = get_algorithm_output(
+            make_algorithm_config(algorithm_type, matrix_geom, matrix_projector))
+    finally:
+        astra.projector.delete(matrix_projector)
+        astra.matrix.delete(matrix_id)
+    assert np.allclose(output, output_matrix, rtol=1e-4, atol=1e-4)
+
+
+@pytest.mark.parametrize('proj_geom', ['fanflat'], indirect=True)
+def test_distance_driven_fanflat_matches_strip(proj_geom):
+    # Both kernels integrate over the full width of a detector pixel
+    y, x = np.mgrid[:N_ROWS, :N_COLS] + 0.5
+    volume = np.exp(-((x - N_COLS / 2) ** 2 + (y - N_ROWS / 2) ** 2) / (0.05 * N_ROWS * N_COLS))
+    sinograms = []
+    for projector_type in ['distance_driven_fanflat', 'strip_fanflat']:
+        projector_id = astra.create_projector(projector_type, proj_geom, VOL_GEOM)
+        try:
+            sinograms.append(_forward_project(projector_id, volume))
+        finally:
+            astra.projector.delete(projector_id)
+    assert np.abs(sinograms[0] - sinograms[1]).max() < 0.01 * sinograms[1].max()
+
+
+# Forward projection of the test volume below by the strip_fanflat projector
+# as it was before its detector tables were computed at initialization. Each
+# row is one angle.
+STRIP_FANFLAT_REFERENCE = np.array([
+    [75.3475, 75.779, 75.706, 75.2685, 75.1253, 75.3631, 75.1949, 74.6997, 74.7495, 75.0445,
+     74.6049, 74.5394, 75.3662, 75.1417, 74.9292, 75.1342, 75.2487, 75.428, 75.2909, 75.2994,
+     74.8994, 74.8636, 74.685, 74.8204, 74.8817, 74.8511, 75.2707, 75.3854, 74.9141, 74.885,
+     75.3622, 75.1568, 75.177, 75.2068, 75.6429, 75.5124, 75.7072, 74.8288, 74.629, 74.6568],
+    [85.2618, 89.1474, 90.6439, 92.0125, 94.6761, 94.7462, 94.5365, 96.9541, 98.7771,
+     100.506, 103.743, 104.564, 105.036, 106.93, 106.601, 105.431, 106.134, 106.424, 105.336,
+     104.533, 104.332, 103.857, 102.391, 101.952, 101.995, 102.336, 101.553, 100.469,
+     100.426, 101.132, 96.7416, 99.1628, 97.2493, 98.5494, 98.266, 95.4489, 93.8731, 92.2174,
+     91.3235, 90.3344],
+    [91.2034, 90.455, 90.7707, 90.6086, 90.3831, 90.7365, 89.6373, 90.0529, 90.1159, 90.44,
+     90.4548, 89.8237, 89.5743, 89.7135, 90.1045, 89.7929, 89.5767, 90.1675, 90.0887,
+     89.9992, 89.7995, 89.9041, 90.1286, 90.0424, 90.2296, 90.5135, 89.7149, 89.6879,
+     89.9151, 90.1013, 90.2188, 90.1955, 90.5168, 90.0239, 90.5772, 90.8534, 90.2662,
+     90.2974, 90.3707, 90.434],
+    [85.0486, 84.1287, 83.9898, 83.0814, 83.3772, 84.6108, 83.9909, 82.708, 82.3057, 82.3319,
+     82.6174, 82.9036, 82.4083, 81.3411, 81.7727, 81.9594, 81.9907, 81.2036, 80.9844,
+     80.0933, 80.772, 81.1018, 80.6311, 80.4365, 80.2442, 80.0397, 79.9955, 80.2696, 79.998,
+     78.9124, 78.9391, 78.7636, 79.1277, 79.2776, 79.0852, 78.3029, 78.2145, 79.3194,
+     78.5733, 76.2437],
+])
+
+
+def test_strip_fanflat_reference():
+    vol_geom = astra.create_vol_geom(50, 60, -30, 30, -25, 25)
+    angles = 2 * np.pi * np.array([0, 22, 45, 101]) / 180
+    proj_geom = astra.create_proj_geom('fanflat', 1.0, 40, angles, 100, 100)
+    rows, cols = np.mgrid[:50, :60]
+    volume = 1 + ((7 * rows + 3 * cols) % 11) / 10
+    projector_id = astra.create_projector('strip_fanflat', proj_geom, vol_geom)
+    try:
+        sino_id, sinogram = astra.create_sino(volume, projector_id)
+        astra.data2d.delete(sino_id)
+    finally:
+        astra.projector.delete(projector_id)
+    assert np.allclose(sinogram, STRIP_FANFLAT_REFERENCE, rtol=1e-4, atol=0)
+
+
+@pytest.mark.parametrize('proj_geom, projector', [('fanflat', 'strip_fanflat')], indirect=True)
+@pytest.mark.parametrize('algorithm_type', ['FP', 'BP', 'CGLS'])
+def test_strip_fanflat_matches_matrix(proj_geom, projector, algorithm_type):
+    # The detector tables are shared by full projections and the single
+    # rays the explicit matrix is built from
+    matrix_id = astra.projector.matrix(projector)
+    matrix_geom = astra.create_proj_geom('sparse_matrix', DET_SPACING, DET_COUNT, ANGLES, matrix_id)
+    matrix_projector = astra.create_projector('sparse_matrix', matrix_geom, VOL_GEOM)
+    try:
+        output = get_algorithm_output(make_algorithm_config(algorithm_type, proj_geom, projector))
+        output_matrix = get_algorithm_output(
+            make_algorithm_config(algorithm_type, matrix_geom, matrix_projector))
+    finally:
+        astra.projector.delete(matrix_projector)
+        astra.matrix.delete(matrix_id)
+    assert np.allclose(output, output_matrix, rtol=1e-4, atol=1e-4)
+
+
+VOLUME_WINDOW = [10, 30, 15, 40]
+
+
+def _volume_window_mask():
+    window = np.zeros([N_ROWS, N_COLS], dtype=bool)
+    window[VOLUME_WINDOW[0]:VOLUME_WINDOW[1], VOLUME_WINDOW[2]:VOLUME_WINDOW[3]] = True
+    return window
+
+
+def _forward_project(projector, volume):
+    sino_id, sino = astra.create_sino(volume, projector)
+    astra.data2d.delete(sino_id)
+    return sino
+
+
+@pytest.mark.parametrize('proj_geom, projector', [
+    ('parallel', 'line'),
+    ('parallel', 'strip'),
+    ('fanflat', 'strip_fanflat'),
+], indirect=True)
+@pytest.mark.parametrize('algorithm_type', ['SIRT', 'CGLS'])
+def test_volume_window(proj_geom, projector, algorithm_type):
+    # Reconstructing a window with a fixed exterior is the same as reconstructing
+    # a rectangular mask from the sinogram minus the projection of the exterior
+    window = _volume_window_mask()
+    volume = np.random.rand(N_ROWS, N_COLS).astype(np.float32)
+    exterior = np.where(window, 0, volume).astype(np.float32)
+    sinogram = _forward_project(projector, volume)
+    sinogram_exterior = _forward_project(projector, exterior)
+
+    def reconstruct(initial, sino, options):
+        algorithm_config = astra.astra_dict(algorithm_type)
+        algorithm_config['ProjectorId'] = projector
+        algorithm_config['ReconstructionDataId'] = astra.data2d.create('-vol', VOL_GEOM, initial)
+        algorithm_config['ProjectionDataId'] = astra.data2d.create('-sino', proj_geom, sino)
+        algorithm_config['option'] = options
+        return get_algorithm_output(algorithm_config, 5)
+
+    exterior_id = astra.data2d.create('-sino', proj_geom, sinogram_exterior)
+    mask_id = astra.data2d.create('-vol', VOL_GEOM, window)
+    try:
+        reconstruction = reconstruct(exterior, sinogram, {'VolumeWindow': VOLUME_WINDOW})
+        reconstruction_given = reconstruct(exterior, sinogram, {'VolumeWindow': VOLUME_WINDOW,
+                                                                'ExteriorProjectionDataId': exterior_id})
+        reconstruction_mask = reconstruct(0, sinogram - sinogram_exterior, {'ReconstructionMaskId': mask_id})
+    finally:
+        astra.data2d.delete(exterior_id)
+        astra.data2d.delete(mask_id)
+    assert np.array_equal(reconstruction[~window], exterior[~window])
+    assert np.allclose(reconstruction, reconstruction_given, rtol=1e-4, atol=1e-4)
+    assert np.allclose(reconstruction[window], reconstruction_mask[window], rtol=1e-3, atol=1e-3)
+    # the window is close to the true volume
+    assert np.abs(reconstruction[window] - volume[window]).mean() < np.abs(volume[window] - volume[window].mean()).mean()
+
+
+@pytest.mark.parametrize('proj_geom, projector', [('parallel', 'line')], indirect=True)
+def test_volume_window_mask_and_sinogram_update(proj_geom, projector):
+    window = _volume_window_mask()
+    mask = np.ones([N_ROWS, N_COLS], dtype=np.float32)
+    mask[:5, :] = 0
+    mask[VOLUME_WINDOW[0], :] = 0
+    volume = np.random.rand(N_ROWS, N_COLS).astype(np.float32)
+    exterior = np.where(window, 0, volume).astype(np.float32)
+    sinogram = _forward_project(projector, volume)
+    # masked out pixels of the exterior are not projected
+    sinogram_exterior = _forward_project(projector, exterior * mask)
+
+    mask_id = astra.data2d.create('-vol', VOL_GEOM, mask)
+    window_mask_id = astra.data2d.create('-vol', VOL_GEOM, window * mask)
+    reconstruction_id = astra.data2d.create('-vol', VOL_GEOM, exterior)
+    sinogram_id = astra.data2d.create('-sino', proj_geom, 0)
+    algorithm_config = astra.astra_dict('SIRT')
+    algorithm_config['ProjectorId'] = projector
+    algorithm_config['ReconstructionDataId'] = reconstruction_id
+    algorithm_config['ProjectionDataId'] = sinogram_id
+    algorithm_config['option'] = {'VolumeWindow': VOLUME_WINDOW, 'ReconstructionMaskId': mask_id}
+    algorithm_id = astra.algorithm.create(algorithm_config)
+    try:
+        astra.algorithm.run(algorithm_id, 2)
+        # a new sinogram is used by the next run
+        astra.data2d.store(sinogram_id, sinogram)
+        astra.data2d.store(reconstruction_id, exterior)
+        astra.algorithm.run(algorithm_id, 5)
+        reconstruction = astra.data2d.get(reconstruction_id)
+        mask_config = astra.astra_dict('SIRT')
+        mask_config['ProjectorId'] = projector
+        mask_config['ReconstructionDataId'] = astra.data2d.create('-vol', VOL_GEOM, 0)
+        mask_config['ProjectionDataId'] = astra.data2d.create('-sino', proj_geom, sinogram - sinogram_exterior)
+        mask_config['option'] = {'ReconstructionMaskId': window_mask_id}
+        reconstruction_mask = get_algorithm_output(mask_config, 5)
+    finally:
+        astra.algorithm.delete(algorithm_id)
+        astra.data2d.delete([mask_id, window_mask_id, reconstruction_id, sinogram_id])
+    assert np.array_equal(reconstruction[~window], exterior[~window])
+    assert np.allclose(reconstruction[window], reconstruction_mask[window], rtol=1e-3, atol=1e-3)
+
+
+@pytest.mark.parametrize('proj_geom, projector', [
+    ('parallel', 'linear'),
+    ('fanflat', 'line_fanflat'),
+], indirect=True)
+def test_volume_window_fp_bp(proj_geom, projector):
+    window = _volume_window_mask()
+    volume = np.random.rand(N_ROWS, N_COLS).astype(np.float32)
+
+    algorithm_config = make_algorithm_config('FP', proj_geom, projector, {'VolumeWindow': VOLUME_WINDOW})
+    astra.data2d.store(algorithm_config['VolumeDataId'], volume)
+    projection = get_algorithm_output(algorithm_config)
+    assert np.allclose(projection, _forward_project(projector, np.where(window, volume, 0)), rtol=1e-5, atol=1e-5)
+
+    backprojection = get_algorithm_output(make_algorithm_config('BP', proj_geom, projector))
+    backprojection_window = get_algorithm_output(
+        make_algorithm_config('BP', proj_geom, projector, {'VolumeWindow': VOLUME_WINDOW}))
+    assert np.allclose(backprojection_window[window], backprojection[window], rtol=1e-5, atol=1e-5)
+    assert np.all(backprojection_window[~window] == 0)
+
+
+@pytest.mark.parametrize('proj_geom, projector', [('parallel', 'line')], indirect=True)
+@pytest.mark.parametrize('window', [[0, 0, 0, N_COLS], [0, N_ROWS + 1, 0, N_COLS], [0, N_ROWS, 0]])
+def test_volume_window_invalid(proj_geom, projector, window):
+    algorithm_config = make_algorithm_config('SIRT', proj_geom, projector, {'VolumeWindow': window})
+    try:
+        with pytest.raises(astra.log.AstraError):
+            astra.algorithm.create(algorithm_config)
+    finally:
+        delete_algorithm_objects(algorithm_config)
+
+
+@pytest.mark.parametrize('proj_geom', ['parallel'], indirect=True)
+@pytest.mark.parametrize('projector', ['linear'], indirect=True)
+@pytest.mark.parametrize('algorithm_type', ['FBP', 'SIRT', 'CGLS'])
+def test_run_batch(proj_geom, projector, algorithm_type):
+    rng = np.random.default_rng(0)
+    sinograms = rng.random((5, N_ANGLES, DET_COUNT), dtype=np.float32)
+    config = astra.astra_dict(algorithm_type)
+    config['ProjectorId'] = projector
+    progress = []
+    volumes = astra.algorithm.run_batch(config, sinograms, iterations=3, num_threads=3,
+                                        progress=lambda i, ok: progress.append((i, ok)))
+    assert sorted(progress) == [(i, True) for i in range(5)]
+    for i in range(5):
+        algorithm_config = make_algorithm_config(algorithm_type, proj_geom, projector)
+        astra.data2d.store(algorithm_config['ProjectionDataId'], sinograms[i])
+        astra.data2d.store(algorithm_config['ReconstructionDataId'], 0)
+        assert np.allclose(volumes[i], get_algorithm_output(algorithm_config, 3), atol=1e-5)
+
+
+@pytest.mark.parametrize('proj_geom', ['parallel'], indirect=True)
+@pytest.mark.parametrize('projector', ['linear'], indirect=True)
+def test_run_batch_errors(proj_geom, projector):
+    config = astra.astra_dict('SIRT')
+    config['ProjectorId'] = projector
+    with pytest.raises(ValueError):
+        astra.algorithm.run_batch(config, np.zeros((2, N_ANGLES, DET_COUNT + 1)))
+    for algorithm_type in ['UNKNOWN', 'FP']:
+        config['type'] = algorithm_type
+        with pytest.raises(astra.log.AstraError, match='initialize'):
+            astra.algorithm.run_batch(config, np.zeros((2, N_ANGLES, DET_COUNT)), num_threads=1)
+
+    def abort(i, ok):
+        raise KeyboardInterrupt
+    config = astra.astra_dict('SIRT')
+    config['ProjectorId'] = projector
+    with pytest.raises(KeyboardInterrupt):
+        astra.algorithm.run_batch(config, np.zeros((4, N_ANGLES, DET_COUNT)), num_threads=1, progress=abort)
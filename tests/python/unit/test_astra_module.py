@@ -40,3 +40,140 @@ def test_has_feature():
 
 def test_use_cuda():
     assert isinstance(astra.astra.use_cuda(), bool)
+
+
+def test_memory_pool():
+    vol_geom = astra.create_vol_geom(32, 32)
+    proj_geom = astra.create_proj_geom('parallel', 1.0, 48, [0, 1, 2])
+    proj_id = astra.create_projector('linear', proj_geom, vol_geom)
+    sino_id = astra.data2d.create('-sino', proj_geom, 1)
+    rec_id = astra.data2d.create('-vol', vol_geom)
+    cfg = astra.astra_dict('SIRT')
+    cfg['ProjectorId'] = proj_id
+    cfg['ProjectionDataId'] = sino_id
+    cfg['ReconstructionDataId'] = rec_id
+
+    limit = astra.astra.get_memory_pool_stats()['limit']
+    try:
+        astra.astra.set_memory_pool_limit(64 * 1024 * 1024)
+        astra.astra.clear_memory_pool()
+        astra.astra.reset_memory_pool_stats()
+        in_use = astra.astra.get_memory_pool_stats()['bytes_in_use']
+        for _ in range(2):
+            alg_id = astra.algorithm.create(cfg)
+            astra.algorithm.run(alg_id, 1)
+            assert astra.astra.get_memory_pool_stats()['bytes_in_use'] > in_use
+            astra.algorithm.delete(alg_id)
+        stats = astra.astra.get_memory_pool_stats()
+        assert stats['misses'] == 4
+        assert stats['hits'] == 4
+        assert stats['bytes_in_use'] == in_use
+        assert stats['bytes_held'] > 0
+        astra.astra.clear_memory_pool()
+        assert astra.astra.get_memory_pool_stats()['bytes_held'] == 0
+    finally:
+        astra.astra.set_memory_pool_limit(limit)
+        astra.data2d.delete([sino_id, rec_id])
+        astra.projector.delete(proj_id)
+
+
+def test_num_threads():
+    import numpy as np
+    vol_geom = astra.create_vol_geom(64, 64)
+    proj_geom = astra.create_proj_geom('parallel', 1.0, 96, np.linspace(0, np.pi, 90, endpoint=False))
+    projector_id = astra.create_projector('linear', proj_geom, vol_geom)
+    vol = np.random.default_rng(0).random((64, 64), dtype=np.float32)
+    try:
+        astra.set_num_threads(1)
+        assert astra.get_num_threads() == 1
+        _, sino_serial = astra.create_sino(vol, projector_id)
+        astra.set_num_threads(4)
+        assert astra.get_num_threads() == 4
+        _, sino_parallel = astra.create_sino(vol, projector_id)
+        assert np.array_equal(sino_serial, sino_parallel)
+    finally:
+        astra.set_num_threads(0)
+        astra.projector.delete(projector_id)
+        astra.data2d.clear()
+    assert astra.get_num_threads() >= 1
+
+
+def test_profiling():
+    import numpy as np
+    vol_geom = astra.create_vol_geom(32, 32)
+    proj_geom = astra.create_proj_geom('parallel', 1.0, 48, np.linspace(0, np.pi, 30, endpoint=False))
+    projector_id = astra.create_projector('line', proj_geom, vol_geom)
+    sino_id, _ = astra.create_sino(np.ones((32, 32), dtype=np.float32), projector_id)
+    rec_id = astra.data2d.create('-vol', vol_geom)
+    cfg = astra.astra_dict('SIRT')
+    cfg['ProjectorId'] = projector_id
+    cfg['ProjectionDataId'] = sino_id
+    cfg['ReconstructionDataId'] = rec_id
+    alg_id = astra.algorithm.create(cfg)
+    try:
+        astra.astra.reset_profile_stats()
+        astra.algorithm.run(alg_id, 2)
+        assert astra.astra.get_profile_stats() == {}
+
+        astra.astra.set_profiling(True)
+        assert astra.astra.is_profiling()
+        astra.algorithm.run(alg_id, 2)
+        astra.astra.set_profiling(False)
+
+        stats = astra.astra.get_profile_stats()
+        assert stats['algorithm/SIRT']['calls'] == 1
+        assert stats['algorithm/SIRT']['seconds'] > 0
+        # one forward and one backprojection per iteration
+        assert stats['project/line']['rays'] >= 2 * 2 * 30 * 48
+        assert stats['data/expression']['bytes'] > 0
+
+        astra.astra.reset_profile_stats()
+        assert astra.astra.get_profile_stats() == {}
+    finally:
+        astra.astra.set_profiling(False)
+        astra.algorithm.delete(alg_id)
+        astra.data2d.delete([sino_id, rec_id])
+        astra.projector.delete(projector_id)
+
+
+def test_plan_gpu_job():
+    import numpy as np
+    vol_geom = astra.create_vol_geom(64, 64, 64)
+    angles = np.linspace(0, 2 * np.pi, 90, endpoint=False)
+    proj_geom = astra.create_proj_geom('cone', 1.5, 1.5, 64, 96, angles, 500, 100)
+
+    plan = astra.astra.plan_gpu_job('FP', vol_geom, proj_geom, memory=1 << 30)
+    assert len(plan['outputs']) == 1
+    output = plan['outputs'][0]
+    assert output['part']['type'] == 'projection'
+    assert output['part']['shape'] == (96, 90, 64)
+    assert len(output['jobs']) == 1
+    assert output['jobs'][0]['input']['shape'] == (64, 64, 64)
+    assert plan['transfer_bytes'] == 4 * (96 * 90 * 64 + 64 ** 3)
+    assert plan['cost'] > 0
+
+    plan = astra.astra.plan_gpu_job('BP', vol_geom, proj_geom, memory=64 ** 3 * 4, num_devices=2)
+    assert len(plan['outputs']) > 1
+    assert len(plan['outputs']) % 2 == 0
+    assert sum(o['part']['shape'][2] for o in plan['outputs']) == 64
+    assert all(o['part']['type'] == 'volume' for o in plan['outputs'])
+
+    with pytest.raises(astra.log.AstraError):
+        astra.astra.plan_gpu_job('XYZ', vol_geom, proj_geom)
+
+
+def test_plan_gpu_job_cost_split():
+    import numpy as np
+    vol_geom = astra.create_vol_geom(128, 128, 128)
+    angles = np.linspace(0, 2 * np.pi, 180, endpoint=False)
+    proj_geom = astra.create_proj_geom('cone', 1, 1, 256, 256, angles, 100, 300)
+
+    linear = astra.astra.plan_gpu_job('BP', vol_geom, proj_geom, memory=8 << 20, num_devices=2)
+    cost = astra.astra.plan_gpu_job('BP', vol_geom, proj_geom, memory=8 << 20, num_devices=2, split='cost')
+    assert len(cost['outputs']) == len(linear['outputs'])
+    assert sum(o['part']['shape'][2] for o in cost['outputs']) == 128
+    # Slabs with a smaller footprint on the detector are made thicker
+    assert [o['part']['shape'] for o in cost['outputs']] != [o['part']['shape'] for o in linear['outputs']]
+
+    with pytest.raises(astra.log.AstraError):
+        astra.astra.plan_gpu_job('BP', vol_geom, proj_geom, split='xyz')
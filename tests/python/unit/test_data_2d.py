@@ -85,6 +85,37 @@ class TestAll:
         assert not np.allclose(astra_object_contents, shared_array)
         astra.data2d.delete(data_id)
 
+    def test_get_shared_dlpack(self, geometry_type, geometry, matrix_initializer):
+        data_id = astra.data2d.create(geometry_type, geometry, matrix_initializer)
+        shared_array = np.from_dlpack(astra.data2d.get_shared_dlpack(data_id))
+        assert np.allclose(shared_array, matrix_initializer)
+        # Assert writing to Astra object writes to shared array
+        astra.data2d.store(data_id, 2.0)
+        assert np.allclose(shared_array, 2.0)
+        astra.data2d.delete(data_id)
+
+    def test_link_noncontiguous(self, geometry_type, geometry, matrix_initializer):
+        strided = np.zeros((matrix_initializer.shape[0], 2 * matrix_initializer.shape[1]), dtype=np.float32)[:, ::2]
+        with pytest.raises(ValueError):
+            astra.data2d.link(geometry_type, geometry, strided)
+
+    def test_float16(self, geometry_type, geometry, matrix_initializer):
+        matrix_initializer = matrix_initializer.astype(np.float16)
+        data_id = astra.data2d.create(geometry_type, geometry, matrix_initializer)
+        data = astra.data2d.get(data_id)
+        assert data.dtype == np.float16
+        assert np.array_equal(data, matrix_initializer)
+        astra.data2d.store(data_id, 0.5)
+        assert np.all(astra.data2d.get_shared(data_id) == 0.5)
+        astra.data2d.delete(data_id)
+
+    def test_link_float16(self, geometry_type, geometry, matrix_initializer):
+        linked_array = matrix_initializer.astype(np.float16)
+        data_id = astra.data2d.link(geometry_type, geometry, linked_array)
+        astra.data2d.store(data_id, 2.0)
+        assert np.all(linked_array == 2.0)
+        astra.data2d.delete(data_id)
+
     def test_get_geometry(self, geometry_type, geometry):
         data_id = astra.data2d.create(geometry_type, geometry)
         geometry_in = geometry.copy()  # To safely use `pop` later
@@ -149,3 +180,31 @@ def test_shepp_logan(modified):
     data_id, data = astra.data2d.shepp_logan(geometry, modified)
     astra.data2d.delete(data_id)
     assert not np.allclose(data, 0.0)
+
+
+@pytest.mark.parametrize('vol_dtype,sino_dtype', [(np.float16, np.float32),
+                                                  (np.float32, np.float16),
+                                                  (np.float16, np.float16)])
+def test_float16_projection(vol_dtype, sino_dtype):
+    vol_geom = astra.create_vol_geom(N_ROWS, N_COLS)
+    proj_geom = astra.create_proj_geom('parallel', DET_SPACING, DET_COUNT, ANGLES)
+    proj_id = astra.create_projector('linear', proj_geom, vol_geom)
+    phantom = np.random.rand(N_ROWS, N_COLS).astype(vol_dtype)
+    vol_ref = astra.data2d.create('-vol', vol_geom, phantom.astype(np.float32))
+    sino_ref = astra.data2d.create('-sino', proj_geom, 0)
+    vol_id = astra.data2d.create('-vol', vol_geom, phantom)
+    sino_id = astra.data2d.create('-sino', proj_geom, np.zeros((N_ANGLES, DET_COUNT), dtype=sino_dtype))
+    for v, s in ((vol_ref, sino_ref), (vol_id, sino_id)):
+        cfg = astra.astra_dict('FP')
+        cfg['ProjectorId'] = proj_id
+        cfg['VolumeDataId'] = v
+        cfg['ProjectionDataId'] = s
+        alg_id = astra.algorithm.create(cfg)
+        astra.algorithm.run(alg_id)
+        astra.algorithm.delete(alg_id)
+    expected = astra.data2d.get(sino_ref)
+    result = astra.data2d.get(sino_id)
+    assert result.dtype == sino_dtype
+    assert np.allclose(result, expected, rtol=2e-3, atol=1e-2)
+    astra.data2d.delete([vol_ref, sino_ref, vol_id, sino_id])
+    astra.projector.delete(proj_id)
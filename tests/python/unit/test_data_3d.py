@@ -1,6 +1,7 @@
 import astra
 import numpy as np
 import pytest
+import time
 
 DET_SPACING_X = 1.0
 DET_SPACING_Y = 1.0
@@ -74,6 +75,58 @@ class TestAll:
         assert not np.allclose(astra_object_contents, linked_array)
         astra.data3d.delete(data_id)
 
+    def test_link_file(self, geometry_type, geometry, matrix_initializer, tmp_path):
+        filename = tmp_path / 'data.bin'
+        offset = 100
+        array = matrix_initializer.astype(np.float32)
+        with open(filename, 'wb') as f:
+            f.write(bytes(offset))
+            f.write(array.tobytes())
+        data_id = astra.data3d.link(geometry_type, geometry,
+                                    astra.data3d.FileLink(filename, 'r+', offset))
+        assert np.array_equal(astra.data3d.get(data_id), array)
+        # Assert writing to Astra object writes to the file
+        astra.data3d.store(data_id, 2.0)
+        astra.data3d.delete(data_id)
+        file_contents = np.fromfile(filename, dtype=np.float32, offset=offset)
+        assert np.allclose(file_contents, 2.0)
+
+    @pytest.mark.parametrize('mode', ['r', 'c'])
+    def test_link_file_unmodified(self, geometry_type, geometry, matrix_initializer, tmp_path, mode):
+        filename = tmp_path / 'data.bin'
+        array = matrix_initializer.astype(np.float32)
+        array.tofile(filename)
+        data_id = astra.data3d.link(geometry_type, geometry, astra.data3d.FileLink(filename, mode))
+        assert np.array_equal(astra.data3d.get(data_id), array)
+        if mode == 'r':
+            with pytest.raises(ValueError):
+                astra.data3d.store(data_id, 2.0)
+            assert not astra.data3d.get_shared(data_id).flags.writeable
+            if geometry_type == '-sino':
+                raw = np.ones((1, DET_ROW_COUNT, DET_COL_COUNT), dtype=np.uint16)
+                with pytest.raises(astra.log.AstraError):
+                    astra.data3d.ingest_raw(data_id, raw)
+        else:
+            astra.data3d.store(data_id, 2.0)
+            assert np.allclose(astra.data3d.get(data_id), 2.0)
+        astra.data3d.delete(data_id)
+        assert np.array_equal(np.fromfile(filename, dtype=np.float32), array.ravel())
+
+    def test_link_file_too_small(self, geometry_type, geometry, tmp_path):
+        filename = tmp_path / 'data.bin'
+        np.zeros(10, dtype=np.float32).tofile(filename)
+        with pytest.raises(astra.log.AstraError):
+            astra.data3d.link(geometry_type, geometry, astra.data3d.FileLink(filename))
+
+    def test_create_file(self, geometry_type, geometry, matrix_initializer, tmp_path):
+        filename = tmp_path / 'data.bin'
+        data_id = astra.data3d.create(geometry_type, geometry, filename=filename)
+        assert np.allclose(astra.data3d.get(data_id), 0.0)
+        astra.data3d.store(data_id, matrix_initializer)
+        astra.data3d.delete(data_id)
+        file_contents = np.fromfile(filename, dtype=np.float32)
+        assert np.allclose(file_contents, matrix_initializer.ravel())
+
     def test_get_shared(self, geometry_type, geometry, matrix_initializer):
         data_id = astra.data3d.create(geometry_type, geometry, matrix_initializer)
         shared_array = astra.data3d.get_shared(data_id)
@@ -89,6 +142,14 @@ class TestAll:
         assert not np.allclose(astra_object_contents, shared_array)
         astra.data3d.delete(data_id)
 
+    def test_float16(self, geometry_type, geometry, matrix_initializer):
+        matrix_initializer = matrix_initializer.astype(np.float16)
+        data_id = astra.data3d.create(geometry_type, geometry, matrix_initializer)
+        data = astra.data3d.get(data_id)
+        assert data.dtype == np.float16
+        assert np.array_equal(data, matrix_initializer)
+        astra.data3d.delete(data_id)
+
     def test_dimensions(self, geometry_type, geometry):
         data_id = astra.data3d.create(geometry_type, geometry)
         dimensions = astra.data3d.dimensions(data_id)
@@ -134,6 +195,27 @@ class TestAll:
                                                    'WindowMinY': 2, 'WindowMaxY': 3,
                                                    'WindowMinZ': 4, 'WindowMaxZ': 5}
 
+    def test_data_op(self, geometry_type, geometry, matrix_initializer):
+        x = matrix_initializer.astype(np.float32)
+        y = np.random.rand(*x.shape).astype(np.float32)
+        mask = (np.random.rand(*x.shape) > 0.5).astype(np.float32)
+        x_id = astra.data3d.create(geometry_type, geometry, x)
+        y_id = astra.data3d.create(geometry_type, geometry, y)
+        mask_id = astra.data3d.create(geometry_type, geometry, mask)
+        assert np.isclose(astra.data_op('dot', [x_id, y_id]), np.dot(x.ravel(), y.ravel().astype(np.float64)))
+        assert np.isclose(astra.data_op('norm', x_id, mask=mask_id), np.linalg.norm(x[mask > 0].astype(np.float64)))
+        astra.data_op('axpby', [y_id, x_id], [2.0, 0.5])
+        expected = 2 * x + 0.5 * y
+        assert np.allclose(astra.data3d.get(y_id), expected)
+        astra.data_op('clamp', y_id, [0.5, 1.5], mask=mask_id)
+        expected = np.where(mask > 0, np.clip(expected, 0.5, 1.5), expected)
+        assert np.allclose(astra.data3d.get(y_id), expected)
+        astra.data_op('$1*s1', x_id, 3.0)
+        assert np.allclose(astra.data3d.get(x_id), 3 * x)
+        with pytest.raises(astra.log.AstraError):
+            astra.data_op('$1.*$2', x_id)
+        astra.data3d.delete([x_id, y_id, mask_id])
+
     def test_delete(self, geometry_type, geometry):
         data_id = astra.data3d.create(geometry_type, geometry)
         astra.data3d.delete(data_id)
@@ -165,3 +247,118 @@ def test_shepp_logan(modified):
     data_id, data = astra.data3d.shepp_logan(geometry, modified)
     astra.data3d.delete(data_id)
     assert not np.allclose(data, 0.0)
+
+
+@pytest.mark.parametrize('dtype', [np.uint16, np.uint32])
+def test_ingest_raw(dtype):
+    proj_geom = astra.create_proj_geom('parallel3d', DET_SPACING_X, DET_SPACING_Y,
+                                       DET_ROW_COUNT, DET_COL_COUNT, ANGLES)
+    raw = np.random.randint(100, 4000, size=(N_ANGLES, DET_ROW_COUNT, DET_COL_COUNT)).astype(dtype)
+    dark = np.random.randint(0, 50, size=(DET_ROW_COUNT, DET_COL_COUNT)).astype(np.float32)
+    flat = np.full((DET_ROW_COUNT, DET_COL_COUNT), 5000, dtype=np.float32)
+    flat[0, 0] = dark[0, 0]  # dead pixel
+    with np.errstate(divide='ignore'):
+        expected = -np.log(np.maximum((raw - dark) / (flat - dark), 1e-6)).transpose(1, 0, 2)
+    expected[0, :, 0] = 0
+    proj_id = astra.data3d.create('-sino', proj_geom)
+    # In two blocks of projections
+    astra.data3d.ingest_raw(proj_id, raw[:100], flat, dark)
+    astra.data3d.ingest_raw(proj_id, raw[100:], flat, dark, first_angle=100)
+    assert np.allclose(astra.data3d.get(proj_id), expected, rtol=1e-5)
+    astra.data3d.ingest_raw(proj_id, raw[5], first_angle=5, log=False)
+    assert np.allclose(astra.data3d.get_shared(proj_id)[:, 5, :], raw[5])
+    astra.data3d.ingest_raw(proj_id, raw[5], flat, dark, first_angle=5, log=False)
+    assert astra.data3d.get_shared(proj_id)[0, 5, 0] == 1
+    with pytest.raises(ValueError):
+        astra.data3d.ingest_raw(proj_id, raw, first_angle=1)
+    with pytest.raises(TypeError):
+        astra.data3d.ingest_raw(proj_id, raw.astype(np.float32))
+    astra.data3d.delete(proj_id)
+
+
+def _write_tiff(filename, pages, byteorder='<'):
+    """Write an uncompressed, single strip (multi-page) TIFF file."""
+    import struct
+    pages = [np.asarray(p) for p in pages]
+    bits = pages[0].dtype.itemsize * 8
+    sample_format = 3 if pages[0].dtype.kind == 'f' else 1
+    out = bytearray(b'II' if byteorder == '<' else b'MM')
+    out += struct.pack(byteorder + 'HI', 42, 0)
+    ifd_pos = 4
+    for p in pages:
+        data_offset = len(out)
+        out += p.astype(p.dtype.newbyteorder(byteorder)).tobytes()
+        ifd = len(out)
+        out[ifd_pos:ifd_pos + 4] = struct.pack(byteorder + 'I', ifd)
+        tags = [(256, 4, p.shape[1]), (257, 4, p.shape[0]), (258, 3, bits),
+                (259, 3, 1), (273, 4, data_offset), (277, 3, 1),
+                (278, 4, p.shape[0]), (279, 4, p.nbytes), (339, 3, sample_format)]
+        out += struct.pack(byteorder + 'H', len(tags))
+        for tag, typ, value in tags:
+            packed = struct.pack(byteorder + ('H' if typ == 3 else 'I'), value).ljust(4, b'\0')
+            out += struct.pack(byteorder + 'HHI', tag, typ, 1) + packed
+        ifd_pos = len(out)
+        out += struct.pack(byteorder + 'I', 0)
+    with open(filename, 'wb') as f:
+        f.write(out)
+
+
+def test_load_projections(tmp_path):
+    angles = np.linspace(0, np.pi, 24, endpoint=False)
+    proj_geom = astra.create_proj_geom('parallel3d', 1.0, 1.0, 5, 7, angles)
+    raw = np.random.randint(100, 4000, size=(24, 5, 7)).astype(np.uint16)
+    flat = np.full((5, 7), 5000, dtype=np.float32)
+    proj_id = astra.data3d.create('-sino', proj_geom)
+
+    # One little endian TIFF file per projection, corrected
+    files = []
+    for a in range(24):
+        files.append(str(tmp_path / 'proj{:04d}.tif'.format(a)))
+        _write_tiff(files[-1], [raw[a]])
+    ready = []
+    stream = astra.data3d.load_projections(proj_id, files, flat=flat, block_size=5,
+                                           callback=lambda first, count, ok: ready.append((first, count, ok)))
+    stream.wait(0, 3)
+    assert stream.is_ready(0)
+    stream.wait()
+    assert sorted(ready) == [(0, 5, True), (5, 5, True), (10, 5, True), (15, 5, True), (20, 4, True)]
+    expected = -np.log(raw / flat).transpose(1, 0, 2)
+    assert np.allclose(astra.data3d.get(proj_id), expected, rtol=1e-5)
+
+    # Two big endian multi-page float32 TIFF files, uncorrected
+    data = np.random.rand(24, 5, 7).astype(np.float32)
+    files = [str(tmp_path / 'stack0.tif'), str(tmp_path / 'stack1.tif')]
+    _write_tiff(files[0], data[:12], '>')
+    _write_tiff(files[1], data[12:], '>')
+    astra.data3d.load_projections(proj_id, files, num_threads=3).wait()
+    assert np.array_equal(astra.data3d.get(proj_id), data.transpose(1, 0, 2))
+
+    # A single raw stack with a header
+    raw_file = tmp_path / 'stack.raw'
+    raw_file.write_bytes(b'x' * 16 + raw.astype('<u4').tobytes())
+    astra.data3d.load_projections(proj_id, [str(raw_file)], format='raw', dtype=np.uint32, header_bytes=16).wait()
+    assert np.array_equal(astra.data3d.get(proj_id), raw.transpose(1, 0, 2))
+
+    # Deleting the data object stops loading before freeing it
+    other_id = astra.data3d.create('-sino', proj_geom)
+    stream = astra.data3d.load_projections(other_id, [str(raw_file)], format='raw', dtype=np.uint32,
+                                           header_bytes=16, block_size=1, num_threads=1,
+                                           callback=lambda first, count, ok: time.sleep(0.02))
+    astra.data3d.delete(other_id)
+    with pytest.raises(astra.log.AstraError):
+        stream.wait()
+
+    # Missing raw files fail when waiting for them
+    stream = astra.data3d.load_projections(proj_id, [str(raw_file), str(tmp_path / 'missing.raw')],
+                                           format='raw', dtype=np.uint32, header_bytes=16)
+    with pytest.raises(astra.log.AstraError):
+        stream.wait()
+    # TIFF files are all indexed when starting, so missing or short ones fail right away
+    with pytest.raises(astra.log.AstraError):
+        astra.data3d.load_projections(proj_id, files[:1] + [str(tmp_path / 'missing.tif')])
+    _write_tiff(files[1], data[12:20])
+    with pytest.raises(astra.log.AstraError):
+        astra.data3d.load_projections(proj_id, files)
+    with pytest.raises(astra.log.AstraError):
+        astra.data3d.load_projections(proj_id, [str(tmp_path / 'missing.tif')])
+    astra.data3d.delete(proj_id)
@@ -97,6 +97,16 @@ class TestAll:
         astra.data2d.delete(vol_data_id)
         assert np.allclose(vol_buffer, vol_data_ref)
 
+    def test_direct_FP2D_strided(self, proj_geom, projector, vol_data):
+        # Strided arrays are copied in and out
+        vol_strided = np.zeros([N_ROWS, 2 * N_COLS], dtype=np.float32)[:, ::2]
+        vol_strided[:] = vol_data
+        proj_strided = np.zeros([2 * N_ANGLES, DET_COUNT], dtype=np.float32)[::2]
+        astra.experimental.direct_FP2D(projector, vol_strided, proj_strided)
+        proj_data_id, proj_data_ref = astra.create_sino(vol_data, projector)
+        astra.data2d.delete(proj_data_id)
+        assert np.allclose(proj_strided, proj_data_ref)
+
     def test_direct_FP(self, proj_geom, projector, vol_data, proj_buffer):
         astra.projector.direct_FP(projector, vol_data, out=proj_buffer)
         assert not np.allclose(proj_buffer, 0.0)
@@ -110,3 +120,30 @@ class TestAll:
         vol_data_id, vol_data_ref = astra.create_backprojection(proj_data, projector)
         astra.data2d.delete(vol_data_id)
         assert np.allclose(vol_buffer, vol_data_ref)
+
+    def test_projection_operator_FP(self, proj_geom, projector, vol_data, proj_buffer):
+        op = astra.experimental.ProjectionOperator2D(projector, 'FP')
+        proj_buffer[:] = 1.0  # The output is overwritten
+        op.apply(vol_data, proj_buffer)
+        proj_data_id, proj_data_ref = astra.create_sino(vol_data, projector)
+        astra.data2d.delete(proj_data_id)
+        assert np.allclose(proj_buffer, proj_data_ref)
+        # Repeated application with a different (read-only) input
+        vol2 = 2 * vol_data
+        vol2.flags.writeable = False
+        op.apply(vol2, proj_buffer)
+        assert np.allclose(proj_buffer, 2 * proj_data_ref)
+
+    def test_projection_operator_BP(self, proj_geom, projector, proj_data, vol_buffer):
+        op = astra.experimental.ProjectionOperator2D(projector, 'BP')
+        op.apply(proj_data, vol_buffer)
+        vol_data_id, vol_data_ref = astra.create_backprojection(proj_data, projector)
+        astra.data2d.delete(vol_data_id)
+        assert np.allclose(vol_buffer, vol_data_ref)
+
+    def test_projection_operator_deleted_projector(self, proj_geom, projector, vol_data, proj_buffer):
+        proj_id = astra.create_projector('line', astra.create_proj_geom('parallel', 1.0, DET_COUNT, ANGLES), VOL_GEOM)
+        op = astra.experimental.ProjectionOperator2D(proj_id, 'FP')
+        astra.projector.delete(proj_id)
+        with pytest.raises(astra.log.AstraError):
+            op.apply(vol_data, proj_buffer)
@@ -0,0 +1,346 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <boost/test/auto_unit_test.hpp>
+
+#include "astra/CompositeGeometryManager.h"
+#include "astra/VolumeGeometry3D.h"
+#include "astra/ConeProjectionGeometry3D.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <vector>
+
+typedef astra::CCompositeGeometryManager CGM;
+
+struct TestCompositeGeometryManager {
+	TestCompositeGeometryManager()
+		: vol(64, 64, 64),
+		  proj(90, 64, 96, 1.5f, 1.5f, angles(90), 500.0f, 100.0f)
+	{ }
+
+	static std::vector<astra::float32> angles(int n) {
+		std::vector<astra::float32> a(n);
+		for (int i = 0; i < n; ++i)
+			a[i] = 2.0f * 3.1415926f * i / n;
+		return a;
+	}
+
+	// Check that the output parts tile the full output along one axis
+	static void checkTiling(const CGM::SJobPlan &plan, size_t full, int axis) {
+		size_t offset = 0;
+		for (const CGM::SPlanOutput &out : plan.outputs) {
+			BOOST_CHECK_EQUAL(out.part.offset[axis], offset);
+			offset += out.part.dims[axis];
+		}
+		BOOST_CHECK_EQUAL(offset, full);
+	}
+
+	astra::CVolumeGeometry3D vol;
+	astra::CConeProjectionGeometry3D proj;
+};
+
+BOOST_FIXTURE_TEST_CASE( testCompositeGeometryManager_PlanSingle, TestCompositeGeometryManager )
+{
+	CGM::SJobPlan plan;
+	BOOST_REQUIRE(CGM::planJob(CGM::JOB_FP, vol, proj, 1024*1024*1024, 1, 16384, plan));
+
+	BOOST_REQUIRE_EQUAL(plan.outputs.size(), 1U);
+	const CGM::SPlanOutput &out = plan.outputs[0];
+	BOOST_CHECK(!out.part.bVolume);
+	BOOST_CHECK_EQUAL(out.part.dims[0], 96U);
+	BOOST_CHECK_EQUAL(out.part.dims[1], 90U);
+	BOOST_CHECK_EQUAL(out.part.dims[2], 64U);
+	BOOST_CHECK_EQUAL(out.iUploadBytes, 0U);
+	BOOST_CHECK_EQUAL(out.iDownloadBytes, 96U * 90 * 64 * 4);
+
+	BOOST_REQUIRE_EQUAL(out.jobs.size(), 1U);
+	BOOST_CHECK(out.jobs[0].input.bVolume);
+	BOOST_CHECK_EQUAL(out.jobs[0].eMode, CGM::MODE_SET);
+	BOOST_CHECK_EQUAL(out.jobs[0].iInputBytes, 64U * 64 * 64 * 4);
+	BOOST_CHECK_GT(out.jobs[0].fCost, 0.0);
+
+	BOOST_CHECK_EQUAL(plan.iTransferBytes, (96U * 90 * 64 + 64U * 64 * 64) * 4);
+	BOOST_CHECK_CLOSE(plan.fCost, out.jobs[0].fCost, 1e-6);
+}
+
+BOOST_FIXTURE_TEST_CASE( testCompositeGeometryManager_PlanSplit, TestCompositeGeometryManager )
+{
+	// Room for about a quarter of the projection data
+	size_t memory = 96 * 90 * 64 * 4;
+
+	CGM::SJobPlan plan;
+	BOOST_REQUIRE(CGM::planJob(CGM::JOB_FP, vol, proj, memory, 2, 16384, plan));
+
+	BOOST_CHECK_GT(plan.outputs.size(), 1U);
+	BOOST_CHECK_EQUAL(plan.outputs.size() % 2, 0U);
+	// Projection data is split over the angles
+	checkTiling(plan, 90, 1);
+
+	size_t transfer = 0;
+	for (const CGM::SPlanOutput &out : plan.outputs) {
+		BOOST_REQUIRE(!out.jobs.empty());
+		BOOST_CHECK_EQUAL(out.jobs[0].eMode, CGM::MODE_SET);
+		for (size_t i = 1; i < out.jobs.size(); ++i)
+			BOOST_CHECK_EQUAL(out.jobs[i].eMode, CGM::MODE_ADD);
+		transfer += out.iUploadBytes + out.iDownloadBytes;
+		for (const CGM::SPlanJob &job : out.jobs) {
+			BOOST_CHECK(job.eType == CGM::JOB_FP || job.eType == CGM::JOB_NOP);
+			if (job.eType == CGM::JOB_FP)
+				BOOST_CHECK_LE(job.iInputBytes + out.iDownloadBytes, plan.iMaxSize * 4);
+			transfer += job.iInputBytes;
+		}
+	}
+	BOOST_CHECK_EQUAL(transfer, plan.iTransferBytes);
+}
+
+BOOST_FIXTURE_TEST_CASE( testCompositeGeometryManager_PlanBP, TestCompositeGeometryManager )
+{
+	CGM::SJobPlan plan;
+	BOOST_REQUIRE(CGM::planJob(CGM::JOB_BP, vol, proj, 64 * 64 * 64 * 4, 1, 16384, plan));
+
+	BOOST_CHECK_GT(plan.outputs.size(), 1U);
+	// Volume data is split over z
+	checkTiling(plan, 64, 2);
+	for (const CGM::SPlanOutput &out : plan.outputs) {
+		BOOST_CHECK(out.part.bVolume);
+		for (const CGM::SPlanJob &job : out.jobs)
+			if (job.eType != CGM::JOB_NOP)
+				BOOST_CHECK(!job.input.bVolume);
+	}
+
+	// A small maximum block dimension splits the input further
+	CGM::SJobPlan plan2;
+	BOOST_REQUIRE(CGM::planJob(CGM::JOB_BP, vol, proj, 1024*1024*1024, 1, 32, plan2));
+	BOOST_REQUIRE_EQUAL(plan2.outputs.size(), 1U);
+	BOOST_CHECK_GT(plan2.outputs[0].jobs.size(), 1U);
+	for (const CGM::SPlanJob &job : plan2.outputs[0].jobs)
+		for (int i = 0; i < 3; ++i)
+			BOOST_CHECK_LE(job.input.dims[i], 32U);
+
+	BOOST_CHECK(!CGM::planJob(CGM::JOB_NOP, vol, proj, 0, 1, 16384, plan));
+	BOOST_CHECK(!CGM::planJob(CGM::JOB_BP, vol, proj, 0, 0, 16384, plan));
+}
+
+// Largest cost of an output part of a plan, as fraction of that of the full
+// job, with compute and transfers weighted equally
+static double maxPartCost(const CGM::SJobPlan &plan, const CGM::SJobPlan &full)
+{
+	double result = 0.0;
+	for (const CGM::SPlanOutput &out : plan.outputs) {
+		double compute = 0.0;
+		double transfer = out.iUploadBytes + out.iDownloadBytes;
+		for (const CGM::SPlanJob &job : out.jobs) {
+			compute += job.fCost;
+			transfer += job.iInputBytes;
+		}
+		result = std::max(result, compute / full.fCost + transfer / full.iTransferBytes);
+	}
+	return result;
+}
+
+BOOST_AUTO_TEST_CASE( testCompositeGeometryManager_PlanCostSplit )
+{
+	// Cone beam with the source close to the volume, so the detector rows
+	// used by a volume slab depend strongly on its z position
+	astra::CVolumeGeometry3D vol(128, 128, 128);
+	astra::CConeProjectionGeometry3D proj(180, 256, 256, 1.0f, 1.0f, TestCompositeGeometryManager::angles(180), 100.0f, 300.0f);
+	size_t memory = 8 * 1024 * 1024;
+
+	CGM::SJobPlan full, linear, cost;
+	BOOST_REQUIRE(CGM::planJob(CGM::JOB_BP, vol, proj, 1024*1024*1024, 1, 16384, full));
+	BOOST_REQUIRE_EQUAL(full.outputs.size(), 1U);
+	BOOST_REQUIRE(CGM::planJob(CGM::JOB_BP, vol, proj, memory, 2, 16384, linear, astra::SPLIT_LINEAR));
+	BOOST_REQUIRE(CGM::planJob(CGM::JOB_BP, vol, proj, memory, 2, 16384, cost, astra::SPLIT_COST));
+
+	BOOST_CHECK_EQUAL(cost.outputs.size(), linear.outputs.size());
+	BOOST_CHECK_EQUAL(cost.outputs.size() % 2, 0U);
+	TestCompositeGeometryManager::checkTiling(cost, 128, 2);
+
+	// Same total compute, but the most expensive part is cheaper
+	BOOST_CHECK_CLOSE(cost.fCost, linear.fCost, 1e-6);
+	BOOST_CHECK_LT(maxPartCost(cost, full), maxPartCost(linear, full));
+
+	// Parts still fit: the output and an input part together with
+	// the texture for the input
+	for (const CGM::SPlanOutput &out : cost.outputs) {
+		size_t outputSize = out.part.dims[0] * out.part.dims[1] * out.part.dims[2];
+		BOOST_CHECK_LE(outputSize, cost.iMaxSize / 3);
+	}
+
+	// Without a difference in footprints, both strategies agree
+	CGM::SJobPlan fpLinear, fpCost;
+	BOOST_REQUIRE(CGM::planJob(CGM::JOB_FP, vol, proj, memory, 2, 16384, fpLinear, astra::SPLIT_LINEAR));
+	BOOST_REQUIRE(CGM::planJob(CGM::JOB_FP, vol, proj, memory, 2, 16384, fpCost, astra::SPLIT_COST));
+	BOOST_REQUIRE_EQUAL(fpCost.outputs.size(), fpLinear.outputs.size());
+	for (size_t i = 0; i < fpCost.outputs.size(); ++i)
+		BOOST_CHECK_EQUAL(fpCost.outputs[i].part.dims[1], fpLinear.outputs[i].part.dims[1]);
+}
+
+// Runs entries in host memory, keeping track of the inputs it would have to
+// upload if it kept the last one resident like the GPU devices do
+class CHostJobDevice : public CGM::CJobDevice {
+public:
+	CHostJobDevice(std::mutex &mutex, std::map<const void*, int> &ran)
+		: m_mutex(mutex), m_ran(ran), m_bResident(false), m_iUploads(0), m_pFailOn(nullptr) { }
+
+	virtual bool runEntry(const CGM::TJobSetInternal::value_type &entry) override {
+		for (const CGM::SJobInternal &job : entry.second) {
+			CGM::SPartKey key = job.pInput->getKey();
+			if (!m_bResident || !(key == m_resident)) {
+				m_iUploads++;
+				m_resident = key;
+				m_bResident = true;
+			}
+		}
+		std::unique_lock lock{m_mutex};
+		m_ran[&entry]++;
+		return &entry != m_pFailOn;
+	}
+
+	std::mutex &m_mutex;
+	std::map<const void*, int> &m_ran;
+	bool m_bResident;
+	CGM::SPartKey m_resident;
+	int m_iUploads;
+	const void *m_pFailOn;
+};
+
+struct TestJobScheduler {
+	// Output projection parts, with inputs alternating between three
+	// volume parts
+	TestJobScheduler()
+		: vol(16, 16, 16),
+		  proj(10, 16, 16, 1.0f, 1.0f, TestCompositeGeometryManager::angles(10), 100.0f, 100.0f)
+	{
+		for (int i = 0; i < 12; ++i)
+			addEntry(10 * i, 16 * (i % 3));
+	}
+
+	void addEntry(unsigned int outputAngle, unsigned int inputZ) {
+		CGM::CProjectionPart *output = new CGM::CProjectionPart();
+		output->pGeom = proj.clone();
+		output->subY = outputAngle;
+		CGM::CVolumePart *input = new CGM::CVolumePart();
+		input->pGeom = vol.clone();
+		input->subZ = inputZ;
+
+		CGM::SJobInternal job{std::unique_ptr<CGM::CPart>(input)};
+		job.eType = CGM::JOB_FP;
+		job.eMode = CGM::MODE_SET;
+		CGM::TJobListInternal L;
+		L.push_back(std::move(job));
+		jobs.push_back(std::make_pair(std::unique_ptr<CGM::CPart>(output), std::move(L)));
+	}
+
+	astra::CVolumeGeometry3D vol;
+	astra::CConeProjectionGeometry3D proj;
+	CGM::TJobSetInternal jobs;
+	std::mutex mutex;
+	std::map<const void*, int> ran;
+};
+
+BOOST_FIXTURE_TEST_CASE( testCompositeGeometryManager_ScheduleSingle, TestJobScheduler )
+{
+	CHostJobDevice device(mutex, ran);
+	std::vector<CGM::CJobDevice*> devices{&device};
+	BOOST_REQUIRE(CGM::runJobs(jobs, devices));
+
+	BOOST_CHECK_EQUAL(ran.size(), 12U);
+	for (const auto &r : ran)
+		BOOST_CHECK_EQUAL(r.second, 1);
+	// Entries sharing an input are run consecutively
+	BOOST_CHECK_EQUAL(device.m_iUploads, 3);
+}
+
+BOOST_FIXTURE_TEST_CASE( testCompositeGeometryManager_ScheduleThreads, TestJobScheduler )
+{
+	std::vector<std::unique_ptr<CHostJobDevice>> hosts;
+	std::vector<CGM::CJobDevice*> devices;
+	for (int i = 0; i < 3; ++i) {
+		hosts.emplace_back(new CHostJobDevice(mutex, ran));
+		devices.push_back(hosts.back().get());
+	}
+	BOOST_REQUIRE(CGM::runJobs(jobs, devices));
+
+	BOOST_CHECK_EQUAL(ran.size(), 12U);
+	for (const auto &r : ran)
+		BOOST_CHECK_EQUAL(r.second, 1);
+
+	// A failing entry is reported
+	ran.clear();
+	hosts[1]->m_pFailOn = &*std::next(jobs.begin(), 4);
+	hosts[0]->m_pFailOn = hosts[2]->m_pFailOn = hosts[1]->m_pFailOn;
+	BOOST_CHECK(!CGM::runJobs(jobs, devices));
+}
+
+BOOST_FIXTURE_TEST_CASE( testCompositeGeometryManager_ScheduleSteal, TestJobScheduler )
+{
+	// Two more entries for the first input: four groups, of 6, 4, 4 and
+	// 2 entries (the last with a new input)
+	addEntry(120, 0);
+	addEntry(130, 0);
+	addEntry(140, 48);
+	addEntry(150, 48);
+
+	CGM::CJobScheduler scheduler(jobs, 2);
+	BOOST_CHECK_EQUAL(scheduler.getGroupCount(), 4U);
+
+	// Worker 0 gets the groups of 6 and 2 entries, worker 1 the two
+	// groups of 4
+	std::map<const void*, int> ran1;
+	const CGM::TJobSetInternal::value_type *entry;
+	for (int i = 0; i < 8; ++i) {
+		BOOST_REQUIRE(scheduler.receive(1, entry));
+		ran1[entry]++;
+	}
+	BOOST_CHECK_EQUAL(scheduler.getStealCount(), 0U);
+
+	// Worker 1 is out of entries, and steals from the back of worker 0
+	BOOST_REQUIRE(scheduler.receive(1, entry));
+	ran1[entry]++;
+	BOOST_CHECK_EQUAL(scheduler.getStealCount(), 1U);
+
+	int count0 = 0;
+	while (scheduler.receive(0, entry)) {
+		ran1[entry]++;
+		count0++;
+	}
+	BOOST_CHECK_EQUAL(count0, 7);
+	BOOST_CHECK_EQUAL(ran1.size(), 16U);
+	BOOST_CHECK(!scheduler.receive(1, entry));
+
+	CGM::CJobScheduler failing(jobs, 2);
+	failing.flagFailure("error");
+	BOOST_CHECK(failing.hasFailed());
+	BOOST_CHECK(!failing.receive(0, entry));
+	BOOST_CHECK_EQUAL(failing.getError(), "error");
+}
@@ -0,0 +1,166 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <boost/test/auto_unit_test.hpp>
+
+#include "astra/DLPack.h"
+#include "astra/Data2D.h"
+
+#include <vector>
+
+namespace {
+
+// A host tensor that records whether its deleter was called
+struct STestTensor {
+	DLManagedTensor managed;
+	int64_t shape[2];
+	int64_t strides[2];
+	bool deleted = false;
+
+	STestTensor(float *data, int64_t rows, int64_t cols, int64_t rowStride, int64_t colStride) {
+		shape[0] = rows; shape[1] = cols;
+		strides[0] = rowStride; strides[1] = colStride;
+		managed.dl_tensor.data = data;
+		managed.dl_tensor.device = DLDevice{kDLCPU, 0};
+		managed.dl_tensor.ndim = 2;
+		managed.dl_tensor.dtype = DLDataType{kDLFloat, 32, 1};
+		managed.dl_tensor.shape = shape;
+		managed.dl_tensor.strides = strides;
+		managed.dl_tensor.byte_offset = 0;
+		managed.manager_ctx = this;
+		managed.deleter = [](DLManagedTensor *self) { static_cast<STestTensor*>(self->manager_ctx)->deleted = true; };
+	}
+};
+
+}
+
+BOOST_AUTO_TEST_CASE( testDLPack_WrapContiguous )
+{
+	std::vector<float> buf(12, 1.0f);
+	STestTensor t(buf.data(), 3, 4, 4, 1);
+	std::string error;
+
+	astra::CDataStorage *s = astra::wrapDLTensorCPU(&t.managed, std::array<int, 2>{4, 3}, error);
+	BOOST_REQUIRE( s );
+	astra::CDataMemory<float> *m = dynamic_cast<astra::CDataMemory<float>*>(s);
+	BOOST_REQUIRE( m );
+	BOOST_CHECK( m->getData() == buf.data() );
+
+	delete s;
+	BOOST_CHECK( t.deleted );
+}
+
+BOOST_AUTO_TEST_CASE( testDLPack_WrapStrided )
+{
+	// Every other column of a 3x8 buffer
+	std::vector<float> buf(24);
+	for (int i = 0; i < 24; ++i)
+		buf[i] = i;
+	STestTensor t(buf.data(), 3, 4, 8, 2);
+	std::string error;
+
+	BOOST_CHECK( !astra::wrapDLTensorCPU(&t.managed, std::array<int, 2>{4, 3}, error, false) );
+	BOOST_CHECK( !t.deleted );
+
+	astra::CDataStorage *s = astra::wrapDLTensorCPU(&t.managed, std::array<int, 2>{4, 3}, error);
+	BOOST_REQUIRE( s );
+	float *data = dynamic_cast<astra::CDataMemory<float>*>(s)->getData();
+	BOOST_CHECK( data != buf.data() );
+	BOOST_CHECK( data[0] == 0.0f && data[1] == 2.0f && data[4] == 8.0f && data[11] == 22.0f );
+
+	// Changes are copied back on destruction
+	data[5] = -1.0f;
+	delete s;
+	BOOST_CHECK( buf[10] == -1.0f );
+	BOOST_CHECK( buf[11] == 11.0f );
+	BOOST_CHECK( t.deleted );
+}
+
+BOOST_AUTO_TEST_CASE( testDLPack_ReadOnly )
+{
+	std::vector<float> buf(24, 1.0f);
+	STestTensor t(buf.data(), 3, 4, 8, 2);
+	DLManagedTensorVersioned v;
+	v.version = DLPackVersion{DLPACK_MAJOR_VERSION, DLPACK_MINOR_VERSION};
+	v.manager_ctx = &t;
+	v.deleter = [](DLManagedTensorVersioned *self) { static_cast<STestTensor*>(self->manager_ctx)->deleted = true; };
+	v.flags = DLPACK_FLAG_BITMASK_READ_ONLY;
+	v.dl_tensor = t.managed.dl_tensor;
+	std::string error;
+
+	// Contiguous
+	t.strides[0] = 4; t.strides[1] = 1;
+	astra::CDataStorage *s = astra::wrapDLTensorCPU(&v, std::array<int, 2>{4, 3}, error);
+	BOOST_REQUIRE( s );
+	BOOST_CHECK( s->isReadOnly() );
+	delete s;
+
+	// Strided: the copy is not written back
+	t.strides[0] = 8; t.strides[1] = 2;
+	s = astra::wrapDLTensorCPU(&v, std::array<int, 2>{4, 3}, error);
+	BOOST_REQUIRE( s );
+	BOOST_CHECK( s->isReadOnly() );
+	dynamic_cast<astra::CDataMemory<float>*>(s)->getData()[0] = -1.0f;
+	delete s;
+	BOOST_CHECK( buf[0] == 1.0f );
+	BOOST_CHECK( t.deleted );
+}
+
+BOOST_AUTO_TEST_CASE( testDLPack_WrongShape )
+{
+	std::vector<float> buf(12);
+	STestTensor t(buf.data(), 3, 4, 4, 1);
+	std::string error;
+
+	BOOST_CHECK( !astra::wrapDLTensorCPU(&t.managed, std::array<int, 2>{3, 4}, error) );
+	BOOST_CHECK( !error.empty() );
+	BOOST_CHECK( !t.deleted );
+}
+
+BOOST_AUTO_TEST_CASE( testDLPack_Export )
+{
+	astra::CVolumeGeometry2D geom(4, 3);
+	astra::CFloat32VolumeData2D *data = astra::createCFloat32VolumeData2DMemory(geom);
+	bool deleted = false;
+	std::string error;
+
+	DLManagedTensorVersioned *t = astra::exportDLTensor<DLManagedTensorVersioned>(data, [&deleted]() { deleted = true; }, error);
+	BOOST_REQUIRE( t );
+	BOOST_CHECK( t->dl_tensor.data == data->getFloat32Memory() );
+	BOOST_CHECK( t->dl_tensor.device.device_type == kDLCPU );
+	BOOST_CHECK( t->dl_tensor.ndim == 2 );
+	BOOST_CHECK( t->dl_tensor.shape[0] == 3 && t->dl_tensor.shape[1] == 4 );
+	BOOST_CHECK( t->dl_tensor.strides[0] == 4 && t->dl_tensor.strides[1] == 1 );
+	BOOST_CHECK( t->version.major == DLPACK_MAJOR_VERSION );
+
+	t->deleter(t);
+	BOOST_CHECK( deleted );
+
+	delete data;
+}
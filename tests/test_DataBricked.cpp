@@ -0,0 +1,93 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <boost/test/auto_unit_test.hpp>
+
+#include "astra/DataBricked.h"
+
+#include <vector>
+
+BOOST_AUTO_TEST_CASE( testDataBricked_RoundTrip )
+{
+	// dimensions deliberately not multiples of the brick size
+	const int x = 19, y = 9, z = 11;
+	astra::CDataBricked<astra::float32> data(x, y, z, 8);
+
+	BOOST_CHECK( data.getBrickSize() == 8 );
+	BOOST_CHECK( data.getBrickCounts()[0] == 3 );
+	BOOST_CHECK( data.getBrickCounts()[1] == 2 );
+	BOOST_CHECK( data.getBrickCounts()[2] == 2 );
+	BOOST_CHECK( !data.isMemory() );
+
+	std::vector<astra::float32> linear(x * y * z);
+	for (size_t i = 0; i < linear.size(); ++i)
+		linear[i] = (astra::float32)i;
+
+	data.copyFromLinear(&linear[0]);
+
+	BOOST_CHECK( data.at(0, 0, 0) == 0.0f );
+	BOOST_CHECK( data.at(18, 8, 10) == (astra::float32)(x * y * z - 1) );
+	BOOST_CHECK( data.at(9, 3, 7) == (astra::float32)((7 * y + 3) * x + 9) );
+	BOOST_CHECK( data.getBrick(1, 0, 0)[0] == 8.0f );
+
+	std::vector<astra::float32> out(x * y * z, -1.0f);
+	data.copyToLinear(&out[0]);
+	BOOST_CHECK( out == linear );
+}
+
+BOOST_AUTO_TEST_CASE( testDataBricked_SubBlock )
+{
+	const int x = 13, y = 17, z = 5;
+	astra::CDataBricked<astra::float32> data(x, y, z, 4);
+
+	std::vector<astra::float32> linear(x * y * z);
+	for (size_t i = 0; i < linear.size(); ++i)
+		linear[i] = (astra::float32)i;
+	data.copyFromLinear(&linear[0]);
+
+	// slab crossing brick boundaries in all directions
+	const int x0 = 3, y0 = 2, z0 = 1, nx = 7, ny = 11, nz = 3;
+	std::vector<astra::float32> slab(nx * ny * nz);
+	data.copySubToLinear(x0, y0, z0, nx, ny, nz, &slab[0]);
+
+	bool ok = true;
+	for (int k = 0; k < nz; ++k)
+		for (int j = 0; j < ny; ++j)
+			for (int i = 0; i < nx; ++i)
+				ok &= slab[(k * ny + j) * nx + i] == linear[((k + z0) * y + j + y0) * x + i + x0];
+	BOOST_CHECK( ok );
+
+	for (auto &v : slab)
+		v = -v;
+	data.copySubFromLinear(x0, y0, z0, nx, ny, nz, &slab[0]);
+
+	BOOST_CHECK( data.at(x0, y0, z0) == -linear[(z0 * y + y0) * x + x0] );
+	BOOST_CHECK( data.at(x0 - 1, y0, z0) == linear[(z0 * y + y0) * x + x0 - 1] );
+	BOOST_CHECK( data.at(x0 + nx, y0 + ny, z0 + nz) == linear[((z0 + nz) * y + y0 + ny) * x + x0 + nx] );
+}
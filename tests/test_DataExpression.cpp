@@ -0,0 +1,103 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <boost/test/auto_unit_test.hpp>
+
+#include "astra/DataExpression.h"
+#include "astra/Data2D.h"
+#include "astra/Data3D.h"
+#include "astra/ThreadPool.h"
+
+#include <cmath>
+#include <limits>
+
+using namespace astra::expr;
+
+struct TestDataExpression {
+	// Larger than a single block, so the expressions are split over threads
+	TestDataExpression()
+		: x(300, 300, new astra::CDataMemory<astra::float32>(300*300)),
+		  w(300, 300, new astra::CDataMemory<astra::float32>(300*300))
+	{
+		astra::setNumThreads(4);
+		for (size_t i = 0; i < x.getSize(); ++i) {
+			x.getFloat32Memory()[i] = (float)(i % 11) - 5.0f;
+			w.getFloat32Memory()[i] = (float)(i % 3);
+		}
+	}
+	~TestDataExpression() { astra::setNumThreads(0); }
+
+	astra::CData2D x, w;
+};
+
+BOOST_FIXTURE_TEST_CASE( testDataExpression_Assign, TestDataExpression )
+{
+	// The destination may appear in the expression
+	assign(x, clamp(lazy(x) + 0.5f * lazy(w) * lazy(x), -4.0f, 4.0f));
+	for (size_t i = 0; i < x.getSize(); ++i) {
+		float v = (float)(i % 11) - 5.0f;
+		v = v + 0.5f * (float)(i % 3) * v;
+		v = std::min(std::max(v, -4.0f), 4.0f);
+		BOOST_REQUIRE( x.getFloat32Memory()[i] == v );
+	}
+
+	assign(w, safeInverse(lazy(w), 1e-6f) - 1.0f);
+	for (size_t i = 0; i < w.getSize(); ++i) {
+		float v = (float)(i % 3);
+		BOOST_REQUIRE( w.getFloat32Memory()[i] == (v != 0.0f ? 1.0f / v : 0.0f) - 1.0f );
+	}
+}
+
+BOOST_FIXTURE_TEST_CASE( testDataExpression_NaN, TestDataExpression )
+{
+	// Clamping passes NaN through, like CData2D::clampMin/clampMax
+	x.getFloat32Memory()[7] = std::numeric_limits<float>::quiet_NaN();
+	assign(x, clamp(lazy(x), -1.0f, 1.0f));
+	BOOST_CHECK( std::isnan(x.getFloat32Memory()[7]) );
+	BOOST_CHECK( x.getFloat32Memory()[0] == -1.0f );
+}
+
+BOOST_FIXTURE_TEST_CASE( testDataExpression_Sum, TestDataExpression )
+{
+	double expected = 0.0;
+	for (size_t i = 0; i < x.getSize(); ++i)
+		expected += ((float)(i % 11) - 5.0f) * (float)(i % 3);
+
+	double s4 = sum(lazy(x) * lazy(w));
+	BOOST_CHECK_CLOSE( s4, expected, 1e-9 );
+
+	// The result does not depend on the number of threads
+	astra::setNumThreads(1);
+	BOOST_CHECK( sum(lazy(x) * lazy(w)) == s4 );
+
+	astra::CData3D y(10, 10, 10, new astra::CDataMemory<astra::float32>(1000));
+	assign(y, Scalar(1.0f));
+	assign(y, -maximum(lazy(y), 2.0f));
+	BOOST_CHECK( sum(sqr(lazy(y))) == 4000.0 );
+}
@@ -0,0 +1,97 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <boost/test/auto_unit_test.hpp>
+
+#include "astra/Data.h"
+
+BOOST_AUTO_TEST_CASE( testDataMemory_Alignment )
+{
+	astra::CDataMemory<astra::float32> data(1001);
+
+	BOOST_CHECK( data.isAligned() );
+	BOOST_CHECK( data.isAligned(astra::DATA_MEMORY_ALIGNMENT) );
+	BOOST_CHECK( ((size_t)data.getData() % 64) == 0 );
+}
+
+BOOST_AUTO_TEST_CASE( testDataMemory_ParallelFirstTouch )
+{
+	astra::SDataMemoryOptions saved = astra::getDataMemoryOptions();
+
+	astra::SDataMemoryOptions options = saved;
+	options.bParallelFirstTouch = true;
+	options.iFirstTouchThreshold = 0;
+	options.iFirstTouchThreads = 3;
+	astra::setDataMemoryOptions(options);
+
+	const size_t size = 300001;
+	astra::CDataMemory<astra::float32> data(size);
+
+	astra::setDataMemoryOptions(saved);
+
+	BOOST_REQUIRE( data.getData() );
+	BOOST_CHECK( data.isAligned() );
+
+	bool zero = true;
+	for (size_t i = 0; i < size; ++i)
+		zero &= data.getData()[i] == 0.0f;
+	BOOST_CHECK( zero );
+}
+
+BOOST_AUTO_TEST_CASE( testDataMemory_ConvertFloat16 )
+{
+	const size_t size = 5;
+	const astra::float32 values[size] = { 0.0f, 1.0f, -2.5f, 65504.0f, 1e-7f };
+
+	astra::CDataMemory<astra::float32> src(size);
+	for (size_t i = 0; i < size; ++i)
+		src.getData()[i] = values[i];
+
+	astra::CDataMemory<astra::float16> half(size);
+	astra::CDataMemory<astra::bfloat16> bhalf(size);
+	astra::CDataMemory<astra::float32> dst(size);
+	astra::copyConvertMemory(&src, 0, &half, 0, size);
+	astra::copyConvertMemory(&src, 0, &bhalf, 0, size);
+
+	BOOST_CHECK( half.isFloat16() );
+	BOOST_CHECK( bhalf.isBFloat16() );
+	for (size_t i = 0; i < 4; ++i) {
+		BOOST_CHECK_EQUAL( (astra::float32)half.getData()[i], values[i] );
+		BOOST_CHECK_CLOSE( (astra::float32)bhalf.getData()[i], values[i], 0.5f );
+	}
+	// smallest float16 subnormal is 2^-24
+	BOOST_CHECK_CLOSE( (astra::float32)half.getData()[4], 5.9604645e-8f * 2, 1e-3f );
+
+	astra::copyConvertMemory(&half, 1, &dst, 0, 2);
+	BOOST_CHECK_EQUAL( dst.getData()[0], 1.0f );
+	BOOST_CHECK_EQUAL( dst.getData()[1], -2.5f );
+
+	astra::fillMemory(&half, 0, size, 0.5f);
+	BOOST_CHECK_EQUAL( (astra::float32)half.getData()[size-1], 0.5f );
+}
@@ -0,0 +1,123 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <boost/test/auto_unit_test.hpp>
+
+#include "astra/DataOperations.h"
+#include "astra/Data2D.h"
+#include "astra/Data3D.h"
+#include "astra/ThreadPool.h"
+
+#include <cmath>
+
+struct TestDataOperations {
+	// Larger than a single block, so the operations are split over threads
+	TestDataOperations()
+		: x(64, 64, 20, new astra::CDataMemory<astra::float32>(64*64*20)),
+		  y(64, 64, 20, new astra::CDataMemory<astra::float32>(64*64*20)),
+		  mask(64, 64, 20, new astra::CDataMemory<astra::float32>(64*64*20))
+	{
+		astra::setNumThreads(4);
+		for (size_t i = 0; i < x.getSize(); ++i) {
+			x.getFloat32Memory()[i] = (float)(i % 7) - 3.0f;
+			y.getFloat32Memory()[i] = (float)(i % 5);
+			mask.getFloat32Memory()[i] = (i % 2) ? 1.0f : 0.0f;
+		}
+	}
+	~TestDataOperations() { astra::setNumThreads(0); }
+
+	astra::CData3D x, y, mask;
+};
+
+BOOST_FIXTURE_TEST_CASE( testDataOperations_ElementWise, TestDataOperations )
+{
+	const astra::float32 *px = x.getFloat32Memory();
+	const astra::float32 *py = y.getFloat32Memory();
+
+	BOOST_REQUIRE( astra::axpby<3>(2.0f, x, 0.5f, y) );
+	for (size_t i = 0; i < y.getSize(); ++i)
+		BOOST_REQUIRE( py[i] == 2.0f * ((float)(i % 7) - 3.0f) + 0.5f * (float)(i % 5) );
+
+	BOOST_REQUIRE( astra::clamp<3>(y, -1.0f, 1.0f) );
+	for (size_t i = 0; i < y.getSize(); ++i)
+		BOOST_REQUIRE( py[i] >= -1.0f && py[i] <= 1.0f );
+
+	BOOST_REQUIRE( astra::addScalar<3>(4.0f, y) );
+	BOOST_REQUIRE( astra::divideSafe<3>(x, y, 0.5f) );
+	for (size_t i = 0; i < y.getSize(); ++i) {
+		if (px[i] == 0.0f)
+			BOOST_REQUIRE( py[i] == 0.0f );
+		else
+			BOOST_REQUIRE( std::isfinite(py[i]) );
+	}
+}
+
+BOOST_FIXTURE_TEST_CASE( testDataOperations_Masked, TestDataOperations )
+{
+	const astra::float32 *py = y.getFloat32Memory();
+
+	BOOST_REQUIRE( astra::multiply<3>(x, y, &mask) );
+	for (size_t i = 0; i < y.getSize(); ++i) {
+		float expected = (float)(i % 5);
+		if (i % 2)
+			expected *= (float)(i % 7) - 3.0f;
+		BOOST_REQUIRE( py[i] == expected );
+	}
+}
+
+BOOST_FIXTURE_TEST_CASE( testDataOperations_Reductions, TestDataOperations )
+{
+	double expectedDot = 0.0, expectedMaskedNorm = 0.0;
+	for (size_t i = 0; i < x.getSize(); ++i) {
+		expectedDot += ((float)(i % 7) - 3.0) * (float)(i % 5);
+		if (i % 2)
+			expectedMaskedNorm += ((float)(i % 7) - 3.0) * ((float)(i % 7) - 3.0);
+	}
+	expectedMaskedNorm = std::sqrt(expectedMaskedNorm);
+
+	double d4, d1, n;
+	BOOST_REQUIRE( astra::dot<3>(x, y, d4) );
+	BOOST_CHECK_CLOSE( d4, expectedDot, 1e-9 );
+	BOOST_REQUIRE( astra::norm<3>(x, n, &mask) );
+	BOOST_CHECK_CLOSE( n, expectedMaskedNorm, 1e-9 );
+
+	// The result does not depend on the number of threads
+	astra::setNumThreads(1);
+	BOOST_REQUIRE( astra::dot<3>(x, y, d1) );
+	BOOST_CHECK( d1 == d4 );
+}
+
+BOOST_FIXTURE_TEST_CASE( testDataOperations_SizeMismatch, TestDataOperations )
+{
+	astra::CData2D z(4, 4, new astra::CDataMemory<astra::float32>(16));
+	astra::CData3D w(4, 4, 1, new astra::CDataMemory<astra::float32>(16));
+	double r;
+	BOOST_CHECK( !astra::dot<3>(x, w, r) );
+	BOOST_CHECK( astra::norm<2>(z, r) );
+}
@@ -0,0 +1,120 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <boost/test/auto_unit_test.hpp>
+
+#include "astra/ParallelProjectionGeometry2D.h"
+#include "astra/VolumeGeometry2D.h"
+#include "astra/GeometryUtil2D.h"
+#include "astra/ConeVecProjectionGeometry3D.h"
+#include "astra/VolumeGeometry3D.h"
+#include "astra/GeometryUtil3D.h"
+
+#include <memory>
+
+static std::vector<astra::SConeProjection> makeConeVectors(int iAngles)
+{
+	std::vector<astra::SConeProjection> vecs(iAngles);
+	for (int i = 0; i < iAngles; ++i) {
+		double a = 0.1 * i;
+		vecs[i] = astra::SConeProjection{
+			-100*sin(a), 100*cos(a), 0,
+			50*sin(a) - 4*cos(a), -50*cos(a) - 4*sin(a), -4,
+			cos(a), sin(a), 0,
+			0, 0, 1 };
+	}
+	return vecs;
+}
+
+BOOST_AUTO_TEST_CASE( testGeometryCache_Convert2D )
+{
+	std::vector<float> angles{ 0.0f, 1.0f, 2.0f, 3.0f };
+	astra::CParallelProjectionGeometry2D geom(4, 8, 0.5f, std::move(angles));
+	astra::CVolumeGeometry2D vol(8, 8);
+
+	astra::Geometry2DParameters p1 = astra::convertAstraGeometry(&vol, &geom);
+	astra::Geometry2DParameters p2 = astra::convertAstraGeometry(&vol, &geom);
+
+	BOOST_REQUIRE( p1.isParallel() );
+	BOOST_CHECK( p1.getParallel() == p2.getParallel() );
+	BOOST_CHECK( geom.getCache().getHitCount() >= 1 );
+
+	// A different volume geometry must not reuse the conversion
+	astra::CVolumeGeometry2D vol2(16, 16);
+	astra::Geometry2DParameters p3 = astra::convertAstraGeometry(&vol2, &geom);
+	BOOST_REQUIRE( p3.isParallel() );
+	BOOST_CHECK( p3.getParallel() != p1.getParallel() );
+	BOOST_CHECK( p3.getDims().iVolWidth == 16 );
+}
+
+BOOST_AUTO_TEST_CASE( testGeometryCache_Convert3D )
+{
+	astra::CConeVecProjectionGeometry3D geom(8, 4, 6, makeConeVectors(8));
+	astra::CVolumeGeometry3D vol(6, 6, 4);
+
+	BOOST_REQUIRE( geom.isInitialized() );
+
+	astra::Geometry3DParameters p1 = astra::convertAstraGeometry(&vol, &geom);
+	astra::Geometry3DParameters p2 = astra::convertAstraGeometry(&vol, &geom);
+
+	BOOST_REQUIRE( p1.isCone() );
+	BOOST_CHECK( p1.getCone() == p2.getCone() );
+
+	// Copies of the geometry share the cache entries
+	std::unique_ptr<astra::CProjectionGeometry3D> clone(geom.clone());
+	astra::Geometry3DParameters p3 = astra::convertAstraGeometry(&vol, clone.get());
+	BOOST_CHECK( p3.getCone() == p1.getCone() );
+
+	// Reinitializing invalidates the cache
+	geom.initialize(8, 4, 6, makeConeVectors(8));
+	astra::Geometry3DParameters p4 = astra::convertAstraGeometry(&vol, &geom);
+	BOOST_REQUIRE( p4.isCone() );
+	BOOST_CHECK( p4.getCone() != p1.getCone() );
+}
+
+BOOST_AUTO_TEST_CASE( testGeometryCache_BPCoeffs )
+{
+	astra::CConeVecProjectionGeometry3D geom(8, 4, 6, makeConeVectors(8));
+
+	std::shared_ptr<const std::vector<astra::SConeBPCoeffs> > c1 = astra::getConeBP_UV_Coeffs(&geom);
+	std::shared_ptr<const std::vector<astra::SConeBPCoeffs> > c2 = astra::getConeBP_UV_Coeffs(&geom);
+
+	BOOST_REQUIRE( c1 );
+	BOOST_REQUIRE( c1->size() == 8 );
+	BOOST_CHECK( c1 == c2 );
+
+	std::vector<astra::SConeProjection> vecs = makeConeVectors(8);
+	for (int i = 0; i < 8; ++i) {
+		astra::SConeBPCoeffs c;
+		astra::computeBP_UV_Coeffs(vecs[i], c);
+		BOOST_CHECK_SMALL( c.fUX - (*c1)[i].fUX, 1e-6 );
+		BOOST_CHECK_SMALL( c.fVC - (*c1)[i].fVC, 1e-6 );
+		BOOST_CHECK_SMALL( c.fDZ - (*c1)[i].fDZ, 1e-6 );
+	}
+}
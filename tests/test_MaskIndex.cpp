@@ -0,0 +1,203 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <boost/test/auto_unit_test.hpp>
+
+#include "astra/MaskIndex.h"
+#include "astra/DataProjector.h"
+#include "astra/ParallelBeamLineKernelProjector2D.h"
+#include "astra/FanFlatBeamStripKernelProjector2D.h"
+#include "astra/FanFlatProjectionGeometry2D.h"
+
+#include <cmath>
+#include <memory>
+
+using namespace std;
+
+namespace astra {
+
+#include "astra/Projector2DImpl.inl"
+
+}
+
+namespace {
+
+std::vector<astra::float32> makeAngles(int n, float fRange)
+{
+	std::vector<astra::float32> angles(n);
+	for (int i = 0; i < n; ++i)
+		angles[i] = fRange * i / n;
+	return angles;
+}
+
+// Forward project with both masks, with and without a mask index, and check
+// that the active rays are equal. Inactive rays must not be touched.
+void checkMaskedFP(astra::CProjector2D *pProjector)
+{
+	using namespace astra;
+
+	const CVolumeGeometry2D &volGeom = pProjector->getVolumeGeometry();
+	const CProjectionGeometry2D &projGeom = pProjector->getProjectionGeometry();
+	std::unique_ptr<CFloat32VolumeData2D> pVolume(createCFloat32VolumeData2DMemory(volGeom));
+	std::unique_ptr<CFloat32VolumeData2D> pVolumeMask(createCFloat32VolumeData2DMemory(volGeom));
+	std::unique_ptr<CFloat32ProjectionData2D> pSinogramMask(createCFloat32ProjectionData2DMemory(projGeom));
+	std::unique_ptr<CFloat32ProjectionData2D> pReference(createCFloat32ProjectionData2DMemory(projGeom));
+	std::unique_ptr<CFloat32ProjectionData2D> pSinogram(createCFloat32ProjectionData2DMemory(projGeom));
+
+	// small off-centre disc as region of interest
+	const int iRows = volGeom.getGridRowCount(), iCols = volGeom.getGridColCount();
+	for (int y = 0; y < iRows; ++y) {
+		for (int x = 0; x < iCols; ++x) {
+			float dx = x - 0.3f * iCols, dy = y - 0.6f * iRows;
+			pVolumeMask->getFloat32Memory()[y * iCols + x] = (dx * dx + dy * dy < 0.04f * iRows * iCols) ? 1.0f : 0.0f;
+			pVolume->getFloat32Memory()[y * iCols + x] = 1.0f + (x + 2 * y) % 5;
+		}
+	}
+	for (size_t i = 0; i < pSinogramMask->getSize(); ++i)
+		pSinogramMask->getFloat32Memory()[i] = (i % 7 == 3 || i % 11 == 5) ? 0.0f : 1.0f;
+	pReference->setData(-1.0f);
+	pSinogram->setData(-1.0f);
+
+	std::unique_ptr<CDataProjectorInterface> pRef(dispatchDataProjector(pProjector,
+			SinogramMaskPolicy(pSinogramMask.get()),
+			ReconstructionMaskPolicy(pVolumeMask.get()),
+			DefaultFPPolicy(pVolume.get(), pReference.get()),
+			true, true, true));
+	pRef->project();
+
+	CMaskIndex index(projGeom, volGeom, pSinogramMask.get(), pVolumeMask.get());
+	std::unique_ptr<CDataProjectorInterface> pFP(dispatchDataProjector(pProjector,
+			SinogramMaskPolicy(pSinogramMask.get()),
+			ReconstructionMaskPolicy(pVolumeMask.get()),
+			DefaultFPPolicy(pVolume.get(), pSinogram.get()),
+			true, true, true));
+	pFP->setMaskIndex(&index);
+	pFP->project();
+
+	int iNonZero = 0;
+	for (size_t i = 0; i < pSinogram->getSize(); ++i) {
+		astra::float32 a = pReference->getFloat32Memory()[i];
+		astra::float32 b = pSinogram->getFloat32Memory()[i];
+		BOOST_CHECK_SMALL(a - b, 1e-4f * (1.0f + std::fabs(a)));
+		if (a > 0.0f)
+			iNonZero++;
+	}
+	BOOST_CHECK( iNonZero > 0 );
+}
+
+}
+
+BOOST_AUTO_TEST_CASE( testMaskIndex_Rays )
+{
+	std::vector<astra::float32> angles = makeAngles(2, 1.0f);
+	astra::CParallelProjectionGeometry2D projGeom(2, 4, 1.0f, std::move(angles));
+	astra::CVolumeGeometry2D volGeom(4, 4);
+	std::unique_ptr<astra::CFloat32ProjectionData2D> pMask(astra::createCFloat32ProjectionData2DMemory(projGeom));
+	const astra::float32 mask[] = { 1.0f, 0.0f, 0.0f, 1.0f,  0.0f, 0.0f, 0.0f, 0.0f };
+	std::copy(mask, mask + 8, pMask->getFloat32Memory());
+
+	astra::CMaskIndex index(projGeom, volGeom, pMask.get(), nullptr);
+	const astra::SProjectionSubset &subset = index.getSubset();
+
+	BOOST_CHECK_EQUAL( index.getActiveRayCount(), 2 );
+	BOOST_CHECK_EQUAL( index.getActiveRayCount(0), 2 );
+	BOOST_CHECK_EQUAL( index.getActiveRayCount(1), 0 );
+	BOOST_CHECK_EQUAL( subset.firstRay(0, 0), 0 );
+	BOOST_CHECK_EQUAL( subset.firstRay(0, 1), 3 );
+	BOOST_CHECK_EQUAL( subset.firstRay(0, 4), 4 );
+	BOOST_CHECK_EQUAL( subset.firstRay(1, 0), 4 );
+
+	// no reconstruction mask: all pixels
+	BOOST_CHECK_EQUAL( index.getActivePixelCount(), 16 );
+	BOOST_CHECK( subset.piRowSpans == nullptr );
+	BOOST_CHECK( subset.rowOverlaps(0, -1, 1) );
+}
+
+BOOST_AUTO_TEST_CASE( testMaskIndex_Pixels )
+{
+	std::vector<astra::float32> angles = makeAngles(2, 1.0f);
+	astra::CParallelProjectionGeometry2D projGeom(2, 4, 1.0f, std::move(angles));
+	astra::CVolumeGeometry2D volGeom(5, 4);
+	std::unique_ptr<astra::CFloat32VolumeData2D> pMask(astra::createCFloat32VolumeData2DMemory(volGeom));
+	pMask->setData(0.0f);
+	astra::float32 *pfMask = pMask->getFloat32Memory();
+	pfMask[1 * 5 + 2] = 1.0f;
+	pfMask[1 * 5 + 3] = 1.0f;
+	pfMask[2 * 5 + 1] = 1.0f;
+
+	astra::CMaskIndex index(projGeom, volGeom, nullptr, pMask.get());
+	const astra::SProjectionSubset &subset = index.getSubset();
+
+	BOOST_CHECK_EQUAL( index.getActiveRayCount(), 8 );
+	BOOST_CHECK_EQUAL( subset.firstRay(1, 2), 2 );
+	BOOST_CHECK_EQUAL( index.getActivePixelCount(), 3 );
+
+	BOOST_CHECK_EQUAL( subset.iRowFrom, 1 );
+	BOOST_CHECK_EQUAL( subset.iRowTo, 3 );
+	BOOST_CHECK_EQUAL( subset.iColFrom, 1 );
+	BOOST_CHECK_EQUAL( subset.iColTo, 4 );
+
+	BOOST_CHECK( !subset.rowOverlaps(0, 0, 4) );
+	BOOST_CHECK( !subset.rowOverlaps(1, 0, 1) );
+	BOOST_CHECK( subset.rowOverlaps(1, 0, 2) );
+	BOOST_CHECK( !subset.rowOverlaps(1, 4, 6) );
+	BOOST_CHECK( subset.colOverlaps(1, 0, 2) );
+	BOOST_CHECK( !subset.colOverlaps(4, 0, 3) );
+
+	int iFrom = -1, iTo = 4;
+	subset.clipRow(1, iFrom, iTo);
+	BOOST_CHECK_EQUAL( iFrom, 2 );
+	BOOST_CHECK_EQUAL( iTo, 3 );
+
+	iFrom = 0; iTo = 4;
+	subset.clipRow(3, iFrom, iTo);
+	BOOST_CHECK( iFrom > iTo );
+}
+
+BOOST_AUTO_TEST_CASE( testMaskIndex_ProjectParallelLine )
+{
+	std::vector<astra::float32> angles = makeAngles(45, 3.14159265f);
+	astra::CParallelProjectionGeometry2D projGeom(45, 48, 1.0f, std::move(angles));
+	astra::CVolumeGeometry2D volGeom(40, 32);
+	astra::CParallelBeamLineKernelProjector2D projector(projGeom, volGeom);
+	BOOST_REQUIRE( projector.isInitialized() );
+
+	checkMaskedFP(&projector);
+}
+
+BOOST_AUTO_TEST_CASE( testMaskIndex_ProjectFanFlatStrip )
+{
+	std::vector<astra::float32> angles = makeAngles(45, 2.0f * 3.14159265f);
+	astra::CFanFlatProjectionGeometry2D projGeom(45, 48, 1.0f, std::move(angles), 100.0f, 100.0f);
+	astra::CVolumeGeometry2D volGeom(40, 32);
+	astra::CFanFlatBeamStripKernelProjector2D projector(projGeom, volGeom);
+	BOOST_REQUIRE( projector.isInitialized() );
+
+	checkMaskedFP(&projector);
+}
@@ -0,0 +1,100 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <boost/test/auto_unit_test.hpp>
+
+#include "astra/Profiler.h"
+#include "astra/ThreadPool.h"
+
+#include <string>
+#include <vector>
+
+struct TestProfiler {
+	TestProfiler() { astra::CProfiler::getSingleton().resetStats(); }
+	~TestProfiler() {
+		astra::CProfiler::getSingleton().setEnabled(false);
+		astra::CProfiler::getSingleton().resetStats();
+	}
+
+	static astra::SProfilePhaseStats find(const std::string &name) {
+		for (const astra::SProfilePhaseStats &s : astra::CProfiler::getSingleton().getStats())
+			if (s.sName == name)
+				return s;
+		return astra::SProfilePhaseStats();
+	}
+};
+
+static void instrumented(size_t rays)
+{
+	ASTRA_PROFILE_SCOPE(profile, "test/instrumented");
+	profile.addRays(rays);
+	profile.addNonZeros(2 * rays);
+	profile.addBytes(4 * rays);
+}
+
+BOOST_FIXTURE_TEST_CASE( testProfiler_Disabled, TestProfiler )
+{
+	instrumented(10);
+	BOOST_CHECK_EQUAL(find("test/instrumented").iCalls, 0);
+}
+
+BOOST_FIXTURE_TEST_CASE( testProfiler_Counters, TestProfiler )
+{
+	astra::CProfiler::getSingleton().setEnabled(true);
+	instrumented(10);
+	instrumented(5);
+	astra::CProfiler::getSingleton().setEnabled(false);
+	instrumented(100);
+
+	astra::SProfilePhaseStats s = find("test/instrumented");
+	BOOST_CHECK_EQUAL(s.iCalls, 2);
+	BOOST_CHECK_EQUAL(s.iRays, 15);
+	BOOST_CHECK_EQUAL(s.iNonZeros, 30);
+	BOOST_CHECK_EQUAL(s.iBytes, 60);
+	BOOST_CHECK(s.fSeconds >= 0.0);
+
+	astra::CProfiler::getSingleton().resetStats();
+	BOOST_CHECK_EQUAL(find("test/instrumented").iCalls, 0);
+}
+
+BOOST_FIXTURE_TEST_CASE( testProfiler_Threads, TestProfiler )
+{
+	astra::setNumThreads(4);
+	astra::CProfiler::getSingleton().setEnabled(true);
+	astra::parallelFor(0, 1000, 1, [](int from, int to) {
+		for (int i = from; i < to; ++i)
+			instrumented(1);
+	});
+	astra::CProfiler::getSingleton().setEnabled(false);
+	astra::setNumThreads(0);
+
+	astra::SProfilePhaseStats s = find("test/instrumented");
+	BOOST_CHECK_EQUAL(s.iCalls, 1000);
+	BOOST_CHECK_EQUAL(s.iRays, 1000);
+}
@@ -0,0 +1,114 @@
+/*
+-----------------------------------------------------------------------
+Copyright: 2010-2022, imec Vision Lab, University of Antwerp
+           2014-2022, CWI, Amsterdam
+
+Contact: astra@astra-toolbox.com
+Website: http://www.astra-toolbox.com/
+
+This file is part of the ASTRA Toolbox.
+
+
+The ASTRA Toolbox is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The ASTRA Toolbox is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
+
+-----------------------------------------------------------------------
+*/
+
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <boost/test/auto_unit_test.hpp>
+
+#include "astra/ThreadPool.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+struct TestThreadPool {
+	TestThreadPool() { astra::setNumThreads(4); }
+	~TestThreadPool() { astra::setNumThreads(0); }
+};
+
+BOOST_FIXTURE_TEST_CASE( testThreadPool_Coverage, TestThreadPool )
+{
+	BOOST_REQUIRE( astra::getNumThreads() == 4 );
+
+	std::vector<std::atomic<int>> counts(1000);
+	astra::parallelFor(0, 1000, 7, [&](int iFrom, int iTo) {
+		BOOST_CHECK( iTo - iFrom >= 7 || iTo == 1000 );
+		for (int i = iFrom; i < iTo; ++i)
+			counts[i]++;
+	});
+	for (int i = 0; i < 1000; ++i)
+		BOOST_CHECK( counts[i] == 1 );
+
+	std::atomic<size_t> total(0);
+	astra::parallelForBlocks(100003, 1000, [&](size_t iFrom, size_t iTo) {
+		total += iTo - iFrom;
+	});
+	BOOST_CHECK( total == 100003 );
+}
+
+BOOST_FIXTURE_TEST_CASE( testThreadPool_Nested, TestThreadPool )
+{
+	std::atomic<int> nestedCalls(0);
+	std::atomic<int> total(0);
+	astra::parallelFor(0, 8, 1, [&](int iFrom, int iTo) {
+		BOOST_CHECK( astra::CThreadPool::inParallelRegion() );
+		for (int i = iFrom; i < iTo; ++i) {
+			// A nested parallelFor runs as a single call on this thread
+			astra::parallelFor(0, 100, 1, [&](int iFrom2, int iTo2) {
+				nestedCalls++;
+				total += iTo2 - iFrom2;
+			});
+		}
+	});
+	BOOST_CHECK( !astra::CThreadPool::inParallelRegion() );
+	BOOST_CHECK( nestedCalls == 8 );
+	BOOST_CHECK( total == 800 );
+}
+
+BOOST_FIXTURE_TEST_CASE( testThreadPool_Exception, TestThreadPool )
+{
+	BOOST_CHECK_THROW(
+		astra::parallelFor(0, 100, 1, [](int iFrom, int iTo) {
+			if (iFrom <= 50 && 50 < iTo)
+				throw std::runtime_error("test");
+		}),
+		std::runtime_error );
+
+	// The pool is still usable afterwards
+	std::atomic<int> total(0);
+	astra::parallelFor(0, 100, 1, [&](int iFrom, int iTo) { total += iTo - iFrom; });
+	BOOST_CHECK( total == 100 );
+}
+
+BOOST_FIXTURE_TEST_CASE( testThreadPool_ConcurrentRestart, TestThreadPool )
+{
+	// Restarting the workers while other threads submit work
+	std::atomic<int> total(0);
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 3; ++t) {
+		threads.emplace_back([&total]() {
+			for (int n = 0; n < 50; ++n)
+				astra::parallelFor(0, 100, 1, [&](int iFrom, int iTo) { total += iTo - iFrom; });
+		});
+	}
+	for (int n = 0; n < 20; ++n)
+		astra::setNumThreads(2 + n % 3);
+	for (std::thread &t : threads)
+		t.join();
+	BOOST_CHECK( total == 3 * 50 * 100 );
+}
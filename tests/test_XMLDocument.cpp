@@ -170,3 +170,48 @@ BOOST_AUTO_TEST_CASE( testXMLDocument_Config )
 
 	delete cfg;
 }
+
+BOOST_AUTO_TEST_CASE( testXMLDocument_BinaryMatrix )
+{
+	astra::XMLDocument *doc = astra::XMLDocument::createDocument("test");
+	BOOST_REQUIRE(doc);
+
+	astra::XMLNode root = doc->getRootNode();
+	astra::XMLNode node = root.addChildNode("child");
+	BOOST_REQUIRE(node);
+
+	// 2 rows, 3 columns, C order
+	double m[] = { 1.0, 2.0, 3.0, 4.0, 5.0, 0.1 };
+	node.setContent(m, 3, 2, false);
+
+	const double *data = 0;
+	int width = 0, height = 0;
+	BOOST_REQUIRE(node.isContentBinaryArray());
+	BOOST_REQUIRE(node.getContentBinaryArray(data, width, height));
+	BOOST_CHECK_EQUAL(width, 3);
+	BOOST_CHECK_EQUAL(height, 2);
+	for (int i = 0; i < 6; ++i)
+		BOOST_CHECK_EQUAL(data[i], m[i]);
+
+	std::vector<double> d = node.getContentNumericalArrayDouble();
+	BOOST_REQUIRE_EQUAL(d.size(), 6U);
+	BOOST_CHECK_EQUAL(d[5], 0.1);
+
+	// Printing converts the array to text
+	doc->saveToFile("test4.xml");
+	BOOST_CHECK(!node.isContentBinaryArray());
+	BOOST_CHECK(node.getContent() == "1,2,3;4,5,0.10000000000000001;");
+
+	delete doc;
+
+	doc = astra::XMLDocument::readFromFile("test4.xml");
+	BOOST_REQUIRE(doc);
+	node = doc->getRootNode().getSingleNode("child");
+	BOOST_REQUIRE(node);
+	d = node.getContentNumericalArrayDouble();
+	BOOST_REQUIRE_EQUAL(d.size(), 6U);
+	for (int i = 0; i < 6; ++i)
+		BOOST_CHECK_EQUAL(d[i], m[i]);
+
+	delete doc;
+}